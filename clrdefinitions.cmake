@@ -86,6 +86,7 @@ if(CLR_CMAKE_TARGET_ARCH_AMD64 OR CLR_CMAKE_TARGET_ARCH_ARM OR CLR_CMAKE_TARGET_
 endif()
 
 add_definitions(-DFEATURE_ASYNC_IO)
+add_definitions(-DFEATURE_BASICFREEZE)
 add_definitions(-DFEATURE_BCL_FORMATTING)
 add_definitions(-DFEATURE_COLLECTIBLE_TYPES)
 
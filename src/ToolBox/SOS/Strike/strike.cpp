@@ -5845,6 +5845,10 @@ HRESULT PrintSpecialThreads()
         {
             type += "Finalizer ";
         }
+        if (ThreadType & ThreadType_FinalizerHelper)
+        {
+            type += "FinalizerHelper ";
+        }
         if (ThreadType & ThreadType_ADUnloadHelper)
         {
             type += "ADUnloadHelper ";
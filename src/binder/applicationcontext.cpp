@@ -84,6 +84,7 @@ namespace BINDER_SPACE
         m_contextCS = NULL;
         m_pTrustedPlatformAssemblyMap = nullptr;
         m_pFileNameHash = nullptr;
+        m_pProbingIndex = nullptr;
     }
 
     ApplicationContext::~ApplicationContext()
@@ -106,6 +107,11 @@ namespace BINDER_SPACE
         {
             delete m_pFileNameHash;
         }
+
+        if (m_pProbingIndex != nullptr)
+        {
+            delete m_pProbingIndex;
+        }
     }
 
     HRESULT ApplicationContext::Init()
@@ -439,11 +445,49 @@ namespace BINDER_SPACE
             BINDER_LOG_STRING(W("ApplicationContext::SetupBindingPaths: Added App NI Path"), pathName);
         }
 
+#ifndef CROSSGEN_COMPILE
+        //
+        // Load the TPA probing index
+        //
+        {
+            NewArrayHolder<WCHAR> wszProbingIndexPath = CLRConfig::GetConfigValue(CLRConfig::EXTERNAL_TpaProbingIndex);
+            if (wszProbingIndexPath != nullptr && *wszProbingIndexPath != W('\0'))
+            {
+                NewHolder<ProbingIndex> pProbingIndex;
+                SAFE_NEW(pProbingIndex, ProbingIndex);
+
+                SString probingIndexPath(wszProbingIndexPath);
+                // S_FALSE just means that there is no usable index yet
+                IF_FAIL_GO(pProbingIndex->Init(probingIndexPath));
+                hr = S_OK;
+
+                m_pProbingIndex = pProbingIndex.Extract();
+                BINDER_LOG_STRING(W("ApplicationContext::SetupBindingPaths: Using probing index"), probingIndexPath);
+            }
+        }
+#endif // !CROSSGEN_COMPILE
+
     Exit:
         BINDER_LOG_LEAVE_HR(W("ApplicationContext::SetupBindingPaths"), hr);
         return hr;
     }
 
+    HRESULT ApplicationContext::SaveProbingIndex()
+    {
+        HRESULT hr = S_OK;
+        BINDER_LOG_ENTER(W("ApplicationContext::SaveProbingIndex"));
+
+        CRITSEC_Holder contextLock(GetCriticalSectionCookie());
+
+        if (m_pProbingIndex != nullptr)
+        {
+            hr = m_pProbingIndex->Save();
+        }
+
+        BINDER_LOG_LEAVE_HR(W("ApplicationContext::SaveProbingIndex"), hr);
+        return hr;
+    }
+
     HRESULT ApplicationContext::GetAssemblyIdentity(LPCSTR                 szTextualIdentity,
                                                     AssemblyIdentityUTF8 **ppAssemblyIdentity)
     {
@@ -20,6 +20,7 @@
 #include "loadcontext.hpp"
 #include "bindresult.inl"
 #include "failurecache.hpp"
+#include "probingindex.hpp"
 #ifdef FEATURE_VERSIONING_LOG
 #include "bindinglog.hpp"
 #endif // FEATURE_VERSIONING_LOG
@@ -1342,34 +1343,57 @@ namespace BINDER_SPACE
             SimpleNameToFileNameMap * tpaMap = pApplicationContext->GetTpaList();
             const SimpleNameToFileNameMapEntry *pTpaEntry = tpaMap->LookupPtr(simpleName.GetUnicode());
             ReleaseHolder<Assembly> pTPAAssembly;
+            SString tpaFileName;
+            BOOL fTpaExplicitBindToNativeImage = FALSE;
             if (pTpaEntry != nullptr)
             {
-                if (pTpaEntry->m_wszNIFileName != nullptr)
-                {
-                    SString fileName(pTpaEntry->m_wszNIFileName);
+                fTpaExplicitBindToNativeImage = (pTpaEntry->m_wszNIFileName != nullptr);
+                _ASSERTE(fTpaExplicitBindToNativeImage || pTpaEntry->m_wszILFileName != nullptr);
+                tpaFileName.Set(fTpaExplicitBindToNativeImage ? pTpaEntry->m_wszNIFileName : pTpaEntry->m_wszILFileName);
 
-                    // A GetAssembly overload perhaps, or just another parameter to the existing method
-                    hr = GetAssembly(fileName,
-                                        fInspectionOnly,
-                                        TRUE, /* fIsInGAC */
-                                        TRUE /* fExplicitBindToNativeImage */,
-                                        &pTPAAssembly
-                                        );
+#ifndef CROSSGEN_COMPILE
+                // Consult the probing index first. If it has an up to date identity for the file that
+                // does not match the reference, there is no need to open the file at all.
+                ProbingIndex *pProbingIndex = fInspectionOnly ? nullptr : pApplicationContext->GetProbingIndex();
+                hr = S_FALSE;
+                if (pProbingIndex != nullptr)
+                {
+                    ReleaseHolder<AssemblyName> pIndexedAssemblyName;
+                    hr = pProbingIndex->GetAssemblyName(tpaFileName, &pIndexedAssemblyName);
+                    if (hr == S_OK &&
+                        !TestCandidateRefMatchesDef(pApplicationContext, pRequestedAssemblyName, pIndexedAssemblyName, true /*tpaListAssembly*/))
+                    {
+                        BINDER_LOG_STRING(W("AssemblyBinder::BindByTpaList: Probing index rules out"), tpaFileName);
+                        fPartialMatchOnTpa = true;
+                    }
+                    else if (FAILED(hr) && hr != HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+                    {
+                        // Let GetAssembly report the problem with the file
+                        hr = S_FALSE;
+                    }
                 }
-                else
+
+                if (hr == S_FALSE || (hr == S_OK && !fPartialMatchOnTpa))
+#endif // !CROSSGEN_COMPILE
                 {
-                    _ASSERTE(pTpaEntry->m_wszILFileName != nullptr);
-                    SString fileName(pTpaEntry->m_wszILFileName);
-                    
-                    hr = GetAssembly(fileName,
-                                        fInspectionOnly,
-                                        TRUE, /* fIsInGAC */
-                                        FALSE /* fExplicitBindToNativeImage */,
-                                        &pTPAAssembly);
+                    // A GetAssembly overload perhaps, or just another parameter to the existing method
+                    hr = GetAssembly(tpaFileName,
+                                     fInspectionOnly,
+                                     TRUE, /* fIsInGAC */
+                                     fTpaExplicitBindToNativeImage,
+                                     &pTPAAssembly);
+
+#ifndef CROSSGEN_COMPILE
+                    if (SUCCEEDED(hr) && pProbingIndex != nullptr)
+                    {
+                        // Failing to record the identity only costs a file open on the next run
+                        pProbingIndex->Record(tpaFileName, pTPAAssembly);
+                    }
+#endif // !CROSSGEN_COMPILE
                 }
 
                 // On file not found, simply fall back to app path probing
-                if (hr != HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+                if (hr != HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND) && !fPartialMatchOnTpa)
                 {
                     // Any other error is fatal
                     IF_FAIL_GO(hr);
@@ -1496,6 +1520,16 @@ namespace BINDER_SPACE
                         // TPA assembly.
                         if (fPartialMatchOnTpa)
                         {
+                            if (pTPAAssembly == nullptr)
+                            {
+                                // The probing index ruled the TPA candidate out without opening it
+                                IF_FAIL_GO(GetAssembly(tpaFileName,
+                                                       fInspectionOnly,
+                                                       TRUE, /* fIsInGAC */
+                                                       fTpaExplicitBindToNativeImage,
+                                                       &pTPAAssembly));
+                            }
+
                             if (TestCandidateRefMatchesDef(pApplicationContext, pAssembly->GetAssemblyName(), pTPAAssembly->GetAssemblyName(), true /*tpaListAssembly*/))
                             {
                                 // Fullname (SimpleName+Culture+PKT) matched for TPA and app assembly - so bind to TPA instance.
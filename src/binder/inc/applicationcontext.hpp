@@ -18,6 +18,7 @@
 #include "bindertypes.hpp"
 #include "failurecache.hpp"
 #include "assemblyidentitycache.hpp"
+#include "probingindex.hpp"
 #ifdef FEATURE_VERSIONING_LOG
 #include "bindinglog.hpp"
 #endif // FEATURE_VERSIONING_LOG
@@ -138,6 +139,7 @@ namespace BINDER_SPACE
         inline StringArrayList *GetAppPaths();
         inline SimpleNameToFileNameMap *GetTpaList();
         inline TpaFileNameHash *GetTpaFileNameList();
+        inline ProbingIndex *GetProbingIndex();
         inline StringArrayList *GetPlatformResourceRoots();
         inline StringArrayList *GetAppNiPaths();
         
@@ -147,6 +149,9 @@ namespace BINDER_SPACE
         inline LONG GetVersion();
         inline void IncrementVersion();
 
+        // Persists the identities recorded in the TPA probing index, if one is configured
+        HRESULT SaveProbingIndex();
+
 #ifdef FEATURE_VERSIONING_LOG
         inline BindingLog *GetBindingLog();
         inline void ClearBindingLog();
@@ -173,6 +178,7 @@ namespace BINDER_SPACE
 
         SimpleNameToFileNameMap * m_pTrustedPlatformAssemblyMap;
         TpaFileNameHash    * m_pFileNameHash;
+        ProbingIndex       * m_pProbingIndex;
         
 #if defined(FEATURE_HOST_ASSEMBLY_RESOLVER)      
         bool m_fCanExplicitlyBindToNativeImages;
@@ -79,6 +79,11 @@ TpaFileNameHash * ApplicationContext::GetTpaFileNameList()
     return m_pFileNameHash;
 }
 
+ProbingIndex * ApplicationContext::GetProbingIndex()
+{
+    return m_pProbingIndex;
+}
+
 StringArrayList * ApplicationContext::GetPlatformResourceRoots()
 {
     return &m_platformResourceRoots;
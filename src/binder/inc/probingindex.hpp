@@ -0,0 +1,157 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+// ============================================================
+//
+// ProbingIndex.hpp
+//
+
+
+//
+// Defines the ProbingIndex class
+//
+// The probing index is a file that remembers the identity of the assemblies on the
+// TPA list across runs. Each entry is keyed by the full path of the assembly and is
+// only trusted while the size and last write time of the file still match. This lets
+// the binder rule out TPA candidates whose identity does not match a reference without
+// opening them. If a file that is opened turns out to have another MVID than its
+// up to date entry says, time stamps can't be trusted and the index is rebuilt.
+//
+// ============================================================
+
+#ifndef __BINDER__PROBING_INDEX_HPP__
+#define __BINDER__PROBING_INDEX_HPP__
+
+#include "bindertypes.hpp"
+#include "utils.hpp"
+#include "sstring.h"
+#include "shash.h"
+
+namespace BINDER_SPACE
+{
+    class ProbingIndexEntry
+    {
+    public:
+        enum
+        {
+            ENTRY_FLAG_NONE              = 0x00,
+            ENTRY_FLAG_PUBLIC_KEY_TOKEN  = 0x01,
+            ENTRY_FLAG_RETARGETABLE      = 0x02,
+            ENTRY_FLAG_WINDOWS_RUNTIME   = 0x04,
+        };
+
+        // Fixed size part of an entry as it is laid out in the index file. It is followed by
+        // the simple name and the file name as NUL terminated WCHAR strings, and padded to
+        // the alignment of the record.
+        struct Record
+        {
+            ULONGLONG   m_ullFileSize;
+            ULONGLONG   m_ullLastWriteTime;
+            GUID        m_mvid;
+            USHORT      m_rgusVersion[4];
+            BYTE        m_rgbPublicKeyToken[8];
+            DWORD       m_dwFlags;
+            DWORD       m_dwArchitecture;
+            DWORD       m_cchSimpleName;
+            DWORD       m_cchFileName;
+        };
+
+        inline ProbingIndexEntry()
+        {
+            ZeroMemory(&m_record, sizeof(m_record));
+        }
+
+        inline SString &GetFileName()
+        {
+            return m_fileName;
+        }
+        inline SString &GetSimpleName()
+        {
+            return m_simpleName;
+        }
+        inline Record &GetRecord()
+        {
+            return m_record;
+        }
+
+    protected:
+        SString m_fileName;
+        SString m_simpleName;
+        Record  m_record;
+    };
+
+    class ProbingIndexHashTraits : public DefaultSHashTraits<ProbingIndexEntry *>
+    {
+    public:
+        typedef SString& key_t;
+
+        // GetKey, Equals, and Hash can throw due to SString
+        static const bool s_NoThrow = false;
+
+        static key_t GetKey(element_t pEntry)
+        {
+            return pEntry->GetFileName();
+        }
+        // Paths are compared ordinally: on case sensitive file systems paths that differ only
+        // in case are different files, and elsewhere a path spelled differently only misses
+        static BOOL Equals(key_t fileName1, key_t fileName2)
+        {
+            return fileName1.Equals(fileName2);
+        }
+        static count_t Hash(key_t fileName)
+        {
+            return fileName.Hash();
+        }
+        static const element_t Null()
+        {
+            return NULL;
+        }
+        static bool IsNull(const element_t &pEntry)
+        {
+            return (pEntry == NULL);
+        }
+    };
+
+    class AssemblyName;
+    class Assembly;
+
+    class ProbingIndex : protected SHash<ProbingIndexHashTraits>
+    {
+    private:
+        typedef SHash<ProbingIndexHashTraits> Hash;
+    public:
+        ProbingIndex();
+        ~ProbingIndex();
+
+        // Reads the index at the given path, if there is one
+        HRESULT Init(/* in */ SString &indexPath);
+
+        // Returns S_OK and the recorded identity if the index has an up to date entry for the
+        // file, S_FALSE if it does not, and ERROR_FILE_NOT_FOUND if the file does not exist.
+        HRESULT GetAssemblyName(/* in */  SString       &fileName,
+                                /* out */ AssemblyName **ppAssemblyName);
+
+        // Remembers the identity of an assembly that was opened from the given file
+        HRESULT Record(/* in */ SString  &fileName,
+                       /* in */ Assembly *pAssembly);
+
+        // Writes the index back if anything was recorded since it was read
+        HRESULT Save();
+
+    private:
+        static HRESULT GetFileStamp(/* in */  SString   &fileName,
+                                    /* out */ ULONGLONG *pullFileSize,
+                                    /* out */ ULONGLONG *pullLastWriteTime);
+
+        HRESULT ReadIndex(/* in */ const BYTE *pbIndex,
+                          /* in */ COUNT_T     cbIndex);
+
+        void RemoveAllEntries();
+
+        SString m_indexPath;
+        BOOL    m_fDirty;
+        BOOL    m_fStale;   // An entry was found to be wrong, the index is being rebuilt
+    };
+};
+
+#endif
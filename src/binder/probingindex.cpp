@@ -0,0 +1,488 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+// ============================================================
+//
+// ProbingIndex.cpp
+//
+
+
+//
+// Implements the ProbingIndex class
+//
+// ============================================================
+
+#include "probingindex.hpp"
+#include "assemblyname.hpp"
+#include "assembly.hpp"
+
+namespace BINDER_SPACE
+{
+    namespace
+    {
+        const DWORD PROBING_INDEX_SIGNATURE = 0x58495042; // 'BPIX'
+        const DWORD PROBING_INDEX_VERSION   = 2;
+
+        // Every entry starts at this alignment in the index file
+        const COUNT_T PROBING_INDEX_ENTRY_ALIGNMENT = sizeof(ULONGLONG);
+
+        struct ProbingIndexHeader
+        {
+            DWORD m_dwSignature;
+            DWORD m_dwVersion;
+            DWORD m_cEntries;
+            DWORD m_cbIndex;
+        };
+
+        inline ULONGLONG FileTimeToULONGLONG(const FILETIME &fileTime)
+        {
+            return ((ULONGLONG) fileTime.dwHighDateTime << 32) | fileTime.dwLowDateTime;
+        }
+
+        inline COUNT_T GetEntrySize(const ProbingIndexEntry::Record &record)
+        {
+            return (COUNT_T) ALIGN_UP(sizeof(ProbingIndexEntry::Record) + (record.m_cchSimpleName + record.m_cchFileName) * sizeof(WCHAR),
+                                      PROBING_INDEX_ENTRY_ALIGNMENT);
+        }
+    };
+
+    ProbingIndex::ProbingIndex() : SHash<ProbingIndexHashTraits>::SHash()
+    {
+        m_fDirty = FALSE;
+        m_fStale = FALSE;
+    }
+
+    ProbingIndex::~ProbingIndex()
+    {
+        RemoveAllEntries();
+    }
+
+    void ProbingIndex::RemoveAllEntries()
+    {
+        // Delete entries and contents array
+        for (Hash::Iterator i = Hash::Begin(), end = Hash::End(); i != end; i++)
+        {
+            const ProbingIndexEntry *pEntry = *i;
+            delete pEntry;
+        }
+        RemoveAll();
+    }
+
+    HRESULT ProbingIndex::Init(SString &indexPath)
+    {
+        HRESULT hr = S_OK;
+        BINDER_LOG_ENTER(W("ProbingIndex::Init"));
+        BINDER_LOG_STRING(W("indexPath"), indexPath);
+
+        m_indexPath.Set(indexPath);
+
+        {
+            HandleHolder hFile(WszCreateFile(indexPath.GetUnicode(),
+                                             GENERIC_READ,
+                                             FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                             NULL,
+                                             OPEN_EXISTING,
+                                             FILE_ATTRIBUTE_NORMAL,
+                                             NULL));
+            if (hFile == INVALID_HANDLE_VALUE)
+            {
+                // No index yet; it will be written out when the process shuts down
+                GO_WITH_HRESULT(S_FALSE);
+            }
+
+            DWORD cbIndex = GetFileSize(hFile, NULL);
+            if (cbIndex == INVALID_FILE_SIZE || cbIndex < sizeof(ProbingIndexHeader))
+            {
+                GO_WITH_HRESULT(S_FALSE);
+            }
+
+            HandleHolder hMap(WszCreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL));
+            if (hMap == NULL)
+            {
+                GO_WITH_HRESULT(S_FALSE);
+            }
+
+            MapViewHolder pView(MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0));
+            if (pView == NULL)
+            {
+                GO_WITH_HRESULT(S_FALSE);
+            }
+
+            hr = ReadIndex((const BYTE *) pView.GetValue(), cbIndex);
+            if (FAILED(hr))
+            {
+                // Don't keep the part that was read before the failure
+                RemoveAllEntries();
+
+                if (hr != E_OUTOFMEMORY)
+                {
+                    // A corrupt or outdated index is simply rebuilt
+                    BINDER_LOG_STRING(W("ProbingIndex::Init: discarding corrupt index"), indexPath);
+                    m_fDirty = TRUE;
+                    hr = S_FALSE;
+                }
+            }
+        }
+
+    Exit:
+        BINDER_LOG_LEAVE_HR(W("ProbingIndex::Init"), hr);
+        return hr;
+    }
+
+    HRESULT ProbingIndex::ReadIndex(const BYTE *pbIndex, COUNT_T cbIndex)
+    {
+        HRESULT hr = S_OK;
+
+        // The view is page aligned, but nothing else in the file is trusted to be:
+        // fixed size parts are copied out rather than accessed in place
+        ProbingIndexHeader header;
+        memcpy(&header, pbIndex, sizeof(header));
+
+        if (header.m_dwSignature != PROBING_INDEX_SIGNATURE ||
+            header.m_dwVersion != PROBING_INDEX_VERSION ||
+            header.m_cbIndex != cbIndex)
+        {
+            GO_WITH_HRESULT(COR_E_BADIMAGEFORMAT);
+        }
+
+        {
+            const BYTE *pbCurrent = pbIndex + ALIGN_UP(sizeof(ProbingIndexHeader), PROBING_INDEX_ENTRY_ALIGNMENT);
+            const BYTE *pbEnd = pbIndex + cbIndex;
+
+            for (DWORD i = 0; i < header.m_cEntries; i++)
+            {
+                ProbingIndexEntry::Record record;
+
+                if ((COUNT_T) (pbEnd - pbCurrent) < sizeof(ProbingIndexEntry::Record))
+                {
+                    GO_WITH_HRESULT(COR_E_BADIMAGEFORMAT);
+                }
+
+                memcpy(&record, pbCurrent, sizeof(record));
+
+                // Both strings are stored with their terminating NUL
+                if (record.m_cchSimpleName == 0 || record.m_cchFileName == 0 ||
+                    record.m_cchSimpleName > MAX_PATH_FNAME || record.m_cchFileName > MAXSHORT ||
+                    (COUNT_T) (pbEnd - pbCurrent) < GetEntrySize(record))
+                {
+                    GO_WITH_HRESULT(COR_E_BADIMAGEFORMAT);
+                }
+
+                // Every indexed assembly was opened, so it has an MVID
+                if (record.m_mvid == GUID_NULL)
+                {
+                    GO_WITH_HRESULT(COR_E_BADIMAGEFORMAT);
+                }
+
+                // Entries are aligned, so the strings are too
+                LPCWSTR wszSimpleName = (LPCWSTR) (pbCurrent + sizeof(ProbingIndexEntry::Record));
+                LPCWSTR wszFileName = wszSimpleName + record.m_cchSimpleName;
+                pbCurrent += GetEntrySize(record);
+
+                if (wszSimpleName[record.m_cchSimpleName - 1] != W('\0') ||
+                    wszFileName[record.m_cchFileName - 1] != W('\0'))
+                {
+                    GO_WITH_HRESULT(COR_E_BADIMAGEFORMAT);
+                }
+
+                NewHolder<ProbingIndexEntry> pEntry;
+                SAFE_NEW(pEntry, ProbingIndexEntry);
+
+                pEntry->GetSimpleName().Set(wszSimpleName);
+                pEntry->GetFileName().Set(wszFileName);
+                memcpy(&pEntry->GetRecord(), &record, sizeof(ProbingIndexEntry::Record));
+
+                if (Hash::Lookup(pEntry->GetFileName()) != NULL)
+                {
+                    GO_WITH_HRESULT(COR_E_BADIMAGEFORMAT);
+                }
+
+                Hash::Add(pEntry);
+                pEntry.SuppressRelease();
+            }
+
+            if (pbCurrent != pbEnd)
+            {
+                GO_WITH_HRESULT(COR_E_BADIMAGEFORMAT);
+            }
+        }
+
+    Exit:
+        return hr;
+    }
+
+    /* static */
+    HRESULT ProbingIndex::GetFileStamp(SString   &fileName,
+                                       ULONGLONG *pullFileSize,
+                                       ULONGLONG *pullLastWriteTime)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA attributeData;
+
+        if (!WszGetFileAttributesEx(fileName.GetUnicode(), GetFileExInfoStandard, &attributeData))
+        {
+            HRESULT hr = HRESULT_FROM_GetLastError();
+            return IsFileNotFound(hr) ? HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND) : hr;
+        }
+
+        *pullFileSize = ((ULONGLONG) attributeData.nFileSizeHigh << 32) | attributeData.nFileSizeLow;
+        *pullLastWriteTime = FileTimeToULONGLONG(attributeData.ftLastWriteTime);
+        return S_OK;
+    }
+
+    HRESULT ProbingIndex::GetAssemblyName(SString       &fileName,
+                                          AssemblyName **ppAssemblyName)
+    {
+        HRESULT hr = S_OK;
+        BINDER_LOG_ENTER(W("ProbingIndex::GetAssemblyName"));
+        BINDER_LOG_STRING(W("fileName"), fileName);
+
+        ReleaseHolder<AssemblyName> pAssemblyName;
+        ULONGLONG ullFileSize;
+        ULONGLONG ullLastWriteTime;
+
+        ProbingIndexEntry *pEntry = m_fStale ? NULL : Hash::Lookup(fileName);
+        if (pEntry == NULL)
+        {
+            GO_WITH_HRESULT(S_FALSE);
+        }
+
+        IF_FAIL_GO(GetFileStamp(fileName, &ullFileSize, &ullLastWriteTime));
+
+        {
+            ProbingIndexEntry::Record &record = pEntry->GetRecord();
+
+            if (record.m_ullFileSize != ullFileSize || record.m_ullLastWriteTime != ullLastWriteTime)
+            {
+                // The file changed since it was indexed
+                GO_WITH_HRESULT(S_FALSE);
+            }
+
+            SAFE_NEW(pAssemblyName, AssemblyName);
+
+            pAssemblyName->SetSimpleName(pEntry->GetSimpleName());
+
+            // Only assemblies with neutral culture are indexed
+            StackSString culture;
+            pAssemblyName->SetCulture(culture);
+
+            AssemblyVersion *pAssemblyVersion = pAssemblyName->GetVersion();
+            pAssemblyVersion->SetFeatureVersion(record.m_rgusVersion[0], record.m_rgusVersion[1]);
+            pAssemblyVersion->SetServiceVersion(record.m_rgusVersion[2], record.m_rgusVersion[3]);
+            pAssemblyName->SetHave(AssemblyIdentity::IDENTITY_FLAG_VERSION);
+
+            if (record.m_dwFlags & ProbingIndexEntry::ENTRY_FLAG_PUBLIC_KEY_TOKEN)
+            {
+                pAssemblyName->GetPublicKeyTokenBLOB().Set(record.m_rgbPublicKeyToken, sizeof(record.m_rgbPublicKeyToken));
+                pAssemblyName->SetHave(AssemblyIdentity::IDENTITY_FLAG_PUBLIC_KEY_TOKEN);
+            }
+
+            if (record.m_dwFlags & ProbingIndexEntry::ENTRY_FLAG_RETARGETABLE)
+            {
+                pAssemblyName->SetIsRetargetable(TRUE);
+            }
+
+            pAssemblyName->SetContentType((record.m_dwFlags & ProbingIndexEntry::ENTRY_FLAG_WINDOWS_RUNTIME) ?
+                                          AssemblyContentType_WindowsRuntime : AssemblyContentType_Default);
+            pAssemblyName->SetArchitecture((PEKIND) record.m_dwArchitecture);
+            pAssemblyName->SetIsDefinition(TRUE);
+        }
+
+        *ppAssemblyName = pAssemblyName.Extract();
+
+    Exit:
+        BINDER_LOG_LEAVE_HR(W("ProbingIndex::GetAssemblyName"), hr);
+        return hr;
+    }
+
+    HRESULT ProbingIndex::Record(SString  &fileName,
+                                 Assembly *pAssembly)
+    {
+        HRESULT hr = S_OK;
+        BINDER_LOG_ENTER(W("ProbingIndex::Record"));
+
+        AssemblyName *pAssemblyName = pAssembly->GetAssemblyName();
+        ProbingIndexEntry::Record record;
+        ZeroMemory(&record, sizeof(record));
+
+        if (!pAssemblyName->HaveNeutralCulture())
+        {
+            GO_WITH_HRESULT(S_FALSE);
+        }
+
+        {
+            SBuffer &publicKeyTokenBLOB = pAssemblyName->GetPublicKeyTokenBLOB();
+            if (publicKeyTokenBLOB.GetSize() > 0)
+            {
+                if (publicKeyTokenBLOB.GetSize() != sizeof(record.m_rgbPublicKeyToken))
+                {
+                    GO_WITH_HRESULT(S_FALSE);
+                }
+
+                memcpy(record.m_rgbPublicKeyToken, (const BYTE *) publicKeyTokenBLOB, sizeof(record.m_rgbPublicKeyToken));
+                record.m_dwFlags |= ProbingIndexEntry::ENTRY_FLAG_PUBLIC_KEY_TOKEN;
+            }
+        }
+
+        IF_FAIL_GO(GetFileStamp(fileName, &record.m_ullFileSize, &record.m_ullLastWriteTime));
+        IF_FAIL_GO(pAssembly->GetMVID(&record.m_mvid));
+
+        {
+            AssemblyVersion *pAssemblyVersion = pAssemblyName->GetVersion();
+            record.m_rgusVersion[0] = (USHORT) pAssemblyVersion->GetMajor();
+            record.m_rgusVersion[1] = (USHORT) pAssemblyVersion->GetMinor();
+            record.m_rgusVersion[2] = (USHORT) pAssemblyVersion->GetBuild();
+            record.m_rgusVersion[3] = (USHORT) pAssemblyVersion->GetRevision();
+        }
+
+        if (pAssemblyName->GetIsRetargetable())
+        {
+            record.m_dwFlags |= ProbingIndexEntry::ENTRY_FLAG_RETARGETABLE;
+        }
+        if (pAssemblyName->GetContentType() == AssemblyContentType_WindowsRuntime)
+        {
+            record.m_dwFlags |= ProbingIndexEntry::ENTRY_FLAG_WINDOWS_RUNTIME;
+        }
+        record.m_dwArchitecture = (DWORD) pAssemblyName->GetArchitecture();
+        record.m_cchSimpleName = pAssemblyName->GetSimpleName().GetCount() + 1;
+        record.m_cchFileName = fileName.GetCount() + 1;
+
+        {
+            ProbingIndexEntry *pEntry = Hash::Lookup(fileName);
+            if (pEntry != NULL)
+            {
+                ProbingIndexEntry::Record &oldRecord = pEntry->GetRecord();
+
+                if (memcmp(&oldRecord, &record, sizeof(record)) == 0 &&
+                    pEntry->GetSimpleName().Equals(pAssemblyName->GetSimpleName()))
+                {
+                    // Already up to date
+                    GO_WITH_HRESULT(S_OK);
+                }
+
+                if (!m_fStale &&
+                    oldRecord.m_ullFileSize == record.m_ullFileSize &&
+                    oldRecord.m_ullLastWriteTime == record.m_ullLastWriteTime &&
+                    oldRecord.m_mvid != record.m_mvid)
+                {
+                    // The file was replaced without changing its time stamp, so no entry can be
+                    // trusted. Stop using the index and only keep what is verified from now on.
+                    BINDER_LOG_STRING(W("ProbingIndex::Record: stale entry, rebuilding index"), fileName);
+                    RemoveAllEntries();
+                    m_fStale = TRUE;
+                    pEntry = NULL;
+                }
+            }
+
+            if (pEntry == NULL)
+            {
+                NewHolder<ProbingIndexEntry> pNewEntry;
+                SAFE_NEW(pNewEntry, ProbingIndexEntry);
+
+                pNewEntry->GetFileName().Set(fileName);
+                Hash::Add(pNewEntry);
+                pEntry = pNewEntry.Extract();
+            }
+
+            pEntry->GetSimpleName().Set(pAssemblyName->GetSimpleName());
+            memcpy(&pEntry->GetRecord(), &record, sizeof(record));
+            m_fDirty = TRUE;
+        }
+
+    Exit:
+        BINDER_LOG_LEAVE_HR(W("ProbingIndex::Record"), hr);
+        return hr;
+    }
+
+    HRESULT ProbingIndex::Save()
+    {
+        HRESULT hr = S_OK;
+        BINDER_LOG_ENTER(W("ProbingIndex::Save"));
+
+        NewArrayHolder<BYTE> pbIndex;
+        COUNT_T cbIndex = ALIGN_UP(sizeof(ProbingIndexHeader), PROBING_INDEX_ENTRY_ALIGNMENT);
+        DWORD cEntries = 0;
+        StackSString tempPath;
+
+        if (!m_fDirty || m_indexPath.IsEmpty())
+        {
+            GO_WITH_HRESULT(S_FALSE);
+        }
+
+        for (Hash::Iterator i = Hash::Begin(), end = Hash::End(); i != end; i++)
+        {
+            cbIndex += GetEntrySize((*i)->GetRecord());
+            cEntries++;
+        }
+
+        pbIndex = new (nothrow) BYTE[cbIndex];
+        if (pbIndex == NULL)
+        {
+            GO_WITH_HRESULT(E_OUTOFMEMORY);
+        }
+        ZeroMemory(pbIndex, cbIndex);
+
+        {
+            ProbingIndexHeader *pHeader = (ProbingIndexHeader *) pbIndex.GetValue();
+            pHeader->m_dwSignature = PROBING_INDEX_SIGNATURE;
+            pHeader->m_dwVersion = PROBING_INDEX_VERSION;
+            pHeader->m_cEntries = cEntries;
+            pHeader->m_cbIndex = cbIndex;
+
+            BYTE *pbCurrent = pbIndex + ALIGN_UP(sizeof(ProbingIndexHeader), PROBING_INDEX_ENTRY_ALIGNMENT);
+            for (Hash::Iterator i = Hash::Begin(), end = Hash::End(); i != end; i++)
+            {
+                ProbingIndexEntry *pEntry = *i;
+                ProbingIndexEntry::Record &record = pEntry->GetRecord();
+                BYTE *pbStrings = pbCurrent + sizeof(ProbingIndexEntry::Record);
+
+                memcpy(pbCurrent, &record, sizeof(ProbingIndexEntry::Record));
+                memcpy(pbStrings, pEntry->GetSimpleName().GetUnicode(), record.m_cchSimpleName * sizeof(WCHAR));
+                pbStrings += record.m_cchSimpleName * sizeof(WCHAR);
+                memcpy(pbStrings, pEntry->GetFileName().GetUnicode(), record.m_cchFileName * sizeof(WCHAR));
+
+                // The padding up to the next entry was zeroed above
+                pbCurrent += GetEntrySize(record);
+            }
+            _ASSERTE(pbCurrent == pbIndex + cbIndex);
+        }
+
+        // Write to a temporary file first so that concurrent readers never see a partial index
+        tempPath.Printf(W("%s.%u.tmp"), m_indexPath.GetUnicode(), GetCurrentProcessId());
+
+        {
+            HandleHolder hFile(WszCreateFile(tempPath.GetUnicode(),
+                                             GENERIC_WRITE,
+                                             0,
+                                             NULL,
+                                             CREATE_ALWAYS,
+                                             FILE_ATTRIBUTE_NORMAL,
+                                             NULL));
+            if (hFile == INVALID_HANDLE_VALUE)
+            {
+                GO_WITH_HRESULT(HRESULT_FROM_GetLastError());
+            }
+
+            DWORD cbWritten = 0;
+            if (!WriteFile(hFile, pbIndex, cbIndex, &cbWritten, NULL) || cbWritten != cbIndex)
+            {
+                hr = HRESULT_FROM_GetLastError();
+                hFile.Release();
+                WszDeleteFile(tempPath.GetUnicode());
+                GO_WITH_HRESULT(FAILED(hr) ? hr : E_FAIL);
+            }
+        }
+
+        if (!WszMoveFileEx(tempPath.GetUnicode(), m_indexPath.GetUnicode(), MOVEFILE_REPLACE_EXISTING))
+        {
+            hr = HRESULT_FROM_GetLastError();
+            WszDeleteFile(tempPath.GetUnicode());
+            GO_WITH_HRESULT(hr);
+        }
+
+        m_fDirty = FALSE;
+
+    Exit:
+        BINDER_LOG_LEAVE_HR(W("ProbingIndex::Save"), hr);
+        return hr;
+    }
+};
@@ -9343,6 +9343,8 @@ const NativeImageDumper::EnumMnemonics s_ReadyToRunFlags[] =
 {
 #define RTR_FLAGS(f) NativeImageDumper::EnumMnemonics(f, W(#f))
     RTR_FLAGS(READYTORUN_FLAG_PLATFORM_NEUTRAL_SOURCE),
+    RTR_FLAGS(READYTORUN_FLAG_SKIP_TYPE_VALIDATION),
+    RTR_FLAGS(READYTORUN_FLAG_LARGE_VERSION_BUBBLE),
 #undef RTR_FLAGS
 };
 
@@ -525,6 +525,7 @@ public:
         UNSUPPORTED_GCConfigLogFile,
         UNSUPPORTED_BGCSpinCount,
         UNSUPPORTED_BGCSpin,
+        UNSUPPORTED_GCLargePages,
         EXTERNAL_GCStressStart,
         INTERNAL_GCStressStartAtJit,
         INTERNAL_DbgDACSkipVerifyDlls,
@@ -33,6 +33,9 @@ struct VirtualReserveFlags
     {
         None = 0,
         WriteWatch = 1,
+        // Back the range with large pages where the OS can do so when it is
+        // committed; it falls back to normal pages otherwise
+        LargePages = 2,
     };
 };
 
@@ -140,6 +143,14 @@ public:
     //  true if it has succeeded, false if it has failed
     static bool GetWriteWatch(bool resetState, void* address, size_t size, void** pageAddresses, uintptr_t* pageAddressesCount);
 
+    // Get how much of the memory reserved with VirtualReserveFlags::LargePages is backed by large pages
+    // Parameters:
+    //  residentSize  - receives the resident size of the memory reserved with large pages
+    //  largePageSize - receives the part of the resident size that is backed by large pages
+    // Return:
+    //  true if it has succeeded, false if the OS does not report it
+    static bool GetLargePageUsage(uint64_t* residentSize, uint64_t* largePageSize);
+
     //
     // Thread and process
     //
@@ -4267,6 +4267,9 @@ heap_segment* get_initial_segment (size_t size, int h_number)
     return res;
 }
 
+// Set when GC segments and the card table are reserved with large pages
+static bool virtual_alloc_large_pages = false;
+
 void* virtual_alloc (size_t size)
 {
     size_t requested_size = size;
@@ -4288,6 +4291,10 @@ void* virtual_alloc (size_t size)
         flags = VirtualReserveFlags::WriteWatch;
     }
 #endif // !FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
+    if (virtual_alloc_large_pages)
+    {
+        flags |= VirtualReserveFlags::LargePages;
+    }
     void* prgmem = GCToOSInterface::VirtualReserve (0, requested_size, card_size * card_word_width, flags);
     void *aligned_mem = prgmem;
 
@@ -6932,6 +6939,11 @@ uint32_t* gc_heap::make_card_table (uint8_t* start, uint8_t* end)
     size_t alloc_size = sizeof (uint8_t)*(sizeof(card_table_info) + cs + bs + cb + wws + st + ms);
     size_t alloc_size_aligned = Align (alloc_size, g_SystemInfo.dwAllocationGranularity-1);
 
+    if (virtual_alloc_large_pages)
+    {
+        virtual_reserve_flags |= VirtualReserveFlags::LargePages;
+    }
+
     uint8_t* mem = (uint8_t*)GCToOSInterface::VirtualReserve (0, alloc_size_aligned, 0, virtual_reserve_flags);
 
     if (!mem)
@@ -7090,7 +7102,7 @@ int gc_heap::grow_brick_card_tables (uint8_t* start,
 #ifdef CARD_BUNDLE
         if (can_use_write_watch_for_card_table())
         {
-            virtual_reserve_flags = VirtualReserveFlags::WriteWatch;
+            virtual_reserve_flags |= VirtualReserveFlags::WriteWatch;
             cb = size_card_bundle_of (saved_g_lowest_address, saved_g_highest_address);
         }
 #endif //CARD_BUNDLE
@@ -7125,6 +7137,11 @@ int gc_heap::grow_brick_card_tables (uint8_t* start,
         dprintf (GC_TABLE_LOG, ("card table: %Id; brick table: %Id; card bundle: %Id; sw ww table: %Id; seg table: %Id; mark array: %Id",
                                   cs, bs, cb, wws, st, ms));
 
+        if (virtual_alloc_large_pages)
+        {
+            virtual_reserve_flags |= VirtualReserveFlags::LargePages;
+        }
+
         uint8_t* mem = (uint8_t*)GCToOSInterface::VirtualReserve (0, alloc_size_aligned, 0, virtual_reserve_flags);
 
         if (!mem)
@@ -9786,6 +9803,9 @@ HRESULT gc_heap::initialize_gc (size_t segment_size,
 #endif //BACKGROUND_GC
 #endif //WRITE_WATCH
 
+    virtual_alloc_large_pages = (CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_GCLargePages) != 0);
+    dprintf (GTC_LOG, ("reserving the GC heap with %s pages", (virtual_alloc_large_pages ? "large" : "small")));
+
     reserved_memory = 0;
     unsigned block_count;
 #ifdef MULTIPLE_HEAPS
@@ -19864,6 +19884,23 @@ size_t gc_heap::get_total_pinned_objects()
     return num_pinned_objects;
 #endif //MULTIPLE_HEAPS
 }
+
+// How much of the memory reserved with large pages is resident, and how much
+// of that the OS actually backs with large pages. The OS reports it for the
+// whole process, so it includes JIT code heaps reserved with large pages.
+// Both are 0 when the GC heap is reserved with small pages.
+void gc_heap::get_large_page_usage (uint64_t* resident_size, uint64_t* large_page_size)
+{
+    *resident_size = 0;
+    *large_page_size = 0;
+
+    if (virtual_alloc_large_pages)
+    {
+        GCToOSInterface::GetLargePageUsage (resident_size, large_page_size);
+        dprintf (GTC_LOG, ("%I64d of %I64d resident bytes reserved with large pages are backed by large pages",
+            *large_page_size, *resident_size));
+    }
+}
 #endif //ENABLE_PERF_COUNTERS || FEATURE_EVENT_TRACE
 
 void gc_heap::reset_mark_stack ()
@@ -33586,19 +33623,31 @@ BOOL GCHeap::IsPromoted(Object* object)
         gc_heap* hp = pGenGCHeap;
 #endif //MULTIPLE_HEAPS
 
+        BOOL is_marked;
+
 #ifdef BACKGROUND_GC
         if (gc_heap::settings.concurrent)
         {
-            BOOL is_marked = (!((o < hp->background_saved_highest_address) && (o >= hp->background_saved_lowest_address))||
+            is_marked = (!((o < hp->background_saved_highest_address) && (o >= hp->background_saved_lowest_address))||
                             hp->background_marked (o));
-            return is_marked;
         }
         else
 #endif //BACKGROUND_GC
         {
-            return (!((o < hp->highest_address) && (o >= hp->lowest_address))
+            is_marked = (!((o < hp->highest_address) && (o >= hp->lowest_address))
                     || hp->is_mark_set (o));
         }
+
+#ifdef FEATURE_BASICFREEZE
+        // Frozen objects are never reclaimed and may be referenced only from outside the GC heap,
+        // so they stay alive for weak handles and the sync block cache even when nothing marked them.
+        if (!is_marked && hp->ro_segments_in_range)
+        {
+            is_marked = gc_heap::frozen_object_p (object);
+        }
+#endif // FEATURE_BASICFREEZE
+
+        return is_marked;
     }
     else
     {
@@ -35686,7 +35735,7 @@ void GCHeap::SetReservedVMLimit (size_t vmlimit)
 
 #ifdef FEATURE_PREMORTEM_FINALIZATION
 
-Object* GCHeap::GetNextFinalizableObject()
+Object* GCHeap::GetNextFinalizableObject(BOOL only_non_critical)
 {
 
 #ifdef MULTIPLE_HEAPS
@@ -35699,6 +35748,8 @@ Object* GCHeap::GetNextFinalizableObject()
         if (O)
             return O;
     }
+    if (only_non_critical)
+        return 0;
     //return the first non crtitical/critical one in the first queue.
     for (int hn = 0; hn < gc_heap::n_heaps; hn++)
     {
@@ -35711,7 +35762,7 @@ Object* GCHeap::GetNextFinalizableObject()
 
 
 #else //MULTIPLE_HEAPS
-    return pGenGCHeap->finalize_queue->GetNextFinalizableObject();
+    return pGenGCHeap->finalize_queue->GetNextFinalizableObject(only_non_critical);
 #endif //MULTIPLE_HEAPS
 
 }
@@ -516,6 +516,7 @@ public:
 
     virtual void    SetFinalizationRun (Object* obj) = 0;
     virtual Object* GetNextFinalizable() = 0;
+    virtual Object* GetNextNonCriticalFinalizable() = 0;
     virtual size_t GetNumberOfFinalizable() = 0;
 
     virtual void SetFinalizeQueueForShutdown(BOOL fHasLock) = 0;
@@ -628,6 +629,9 @@ public:
     // frozen segment management functions
     virtual segment_handle RegisterFrozenSegment(segment_info *pseginfo) = 0;
     virtual void UnregisterFrozenSegment(segment_handle seg) = 0;
+    // Publishes objects appended to a registered frozen segment. The new objects must be fully
+    // initialized before this is called.
+    virtual void UpdateFrozenSegment(segment_handle seg, uint8_t* allocated, uint8_t* committed) = 0;
 #endif //FEATURE_BASICFREEZE
 
         // debug support 
@@ -229,7 +229,17 @@ void GCHeap::UpdatePostGCCounters()
     HeapInfo.HeapStats.SinkBlockCount =  total_num_sync_blocks;
     HeapInfo.HeapStats.GCHandleCount =  (uint32_t)total_num_gc_handles;
 
-    FireEtwGCHeapStats_V1(HeapInfo.HeapStats.GenInfo[0].GenerationSize, HeapInfo.HeapStats.GenInfo[0].TotalPromotedSize,
+    // Reading the large page usage from the OS is not free, only do it for the event
+    uint64_t large_page_resident_size = 0;
+    uint64_t large_page_backed_size = 0;
+#ifndef FEATURE_REDHAWK
+    if (EventEnabledGCHeapStats_V2())
+    {
+        gc_heap::get_large_page_usage (&large_page_resident_size, &large_page_backed_size);
+    }
+#endif // !FEATURE_REDHAWK
+
+    FireEtwGCHeapStats_V2(HeapInfo.HeapStats.GenInfo[0].GenerationSize, HeapInfo.HeapStats.GenInfo[0].TotalPromotedSize,
                     HeapInfo.HeapStats.GenInfo[1].GenerationSize, HeapInfo.HeapStats.GenInfo[1].TotalPromotedSize,
                     HeapInfo.HeapStats.GenInfo[2].GenerationSize, HeapInfo.HeapStats.GenInfo[2].TotalPromotedSize,
                     HeapInfo.HeapStats.GenInfo[3].GenerationSize, HeapInfo.HeapStats.GenInfo[3].TotalPromotedSize,
@@ -238,7 +248,9 @@ void GCHeap::UpdatePostGCCounters()
                     HeapInfo.HeapStats.PinnedObjectCount,
                     HeapInfo.HeapStats.SinkBlockCount,
                     HeapInfo.HeapStats.GCHandleCount, 
-                    GetClrInstanceId());
+                    GetClrInstanceId(),
+                    large_page_resident_size,
+                    large_page_backed_size);
 #endif // FEATURE_EVENT_TRACE
 
 #if defined(ENABLE_PERF_COUNTERS)
@@ -315,6 +327,7 @@ void GCHeap::UpdatePostGCCounters()
     _ASSERTE(FitsIn<size_t>(HeapInfo.HeapStats.FinalizationPromotedCount));
     GetPerfCounters().m_GC.cbPromotedFinalizationMem = static_cast<size_t>(HeapInfo.HeapStats.FinalizationPromotedSize);
     GetPerfCounters().m_GC.cSurviveFinalize = static_cast<size_t>(HeapInfo.HeapStats.FinalizationPromotedCount);
+    GetPerfCounters().m_GC.cFinalizationQueueLength = GetNumberFinalizableObjects();
     
     // Compute Time in GC
     PERF_COUNTER_TIMER_PRECISION _currentPerfCounterTimer = GET_CYCLE_COUNT();
@@ -875,6 +888,20 @@ void GCHeap::UnregisterFrozenSegment(segment_handle seg)
 
     heap->remove_ro_segment(reinterpret_cast<heap_segment*>(seg));
 }
+
+void GCHeap::UpdateFrozenSegment(segment_handle seg, uint8_t* allocated, uint8_t* committed)
+{
+    heap_segment* heap_seg = reinterpret_cast<heap_segment*>(seg);
+
+    assert (heap_segment_read_only_p (heap_seg));
+    assert (allocated >= heap_segment_allocated (heap_seg));
+    assert (committed <= heap_segment_reserved (heap_seg));
+
+    heap_segment_committed (heap_seg) = committed;
+    heap_segment_used (heap_seg) = allocated;
+    // The GC walks the segment up to allocated, so it must be published last.
+    VolatileStore (&heap_segment_allocated (heap_seg), allocated);
+}
 #endif // FEATURE_BASICFREEZE
 
 
@@ -205,6 +205,7 @@ public:
     unsigned GetGcCount();
 
     Object* GetNextFinalizable() { return GetNextFinalizableObject(); };
+    Object* GetNextNonCriticalFinalizable() { return GetNextFinalizableObject(TRUE); };
     size_t GetNumberOfFinalizable() { return GetNumberFinalizableObjects(); }
 
     PER_HEAP_ISOLATED HRESULT GetGcCounters(int gen, gc_counters* counters);
@@ -215,7 +216,7 @@ public:
 
     void SetReservedVMLimit (size_t vmlimit);
 
-    PER_HEAP_ISOLATED Object* GetNextFinalizableObject();
+    PER_HEAP_ISOLATED Object* GetNextFinalizableObject(BOOL only_non_critical = FALSE);
     PER_HEAP_ISOLATED size_t GetNumberFinalizableObjects();
     PER_HEAP_ISOLATED size_t GetFinalizablePromotedCount();
 
@@ -253,6 +254,7 @@ public:	// FIX
     // frozen segment management functions
     virtual segment_handle RegisterFrozenSegment(segment_info *pseginfo);
     virtual void UnregisterFrozenSegment(segment_handle seg);
+    virtual void UpdateFrozenSegment(segment_handle seg, uint8_t* allocated, uint8_t* committed);
 #endif // FEATURE_BASICFREEZE
 
     void    WaitUntilConcurrentGCComplete ();                               // Use in managd threads
@@ -2072,6 +2072,9 @@ protected:
 #if defined(ENABLE_PERF_COUNTERS) || defined(FEATURE_EVENT_TRACE)
     PER_HEAP_ISOLATED
     size_t get_total_pinned_objects();
+
+    PER_HEAP_ISOLATED
+    void get_large_page_usage (uint64_t* resident_size, uint64_t* large_page_size);
 #endif //ENABLE_PERF_COUNTERS || FEATURE_EVENT_TRACE
 
     PER_HEAP
@@ -276,6 +276,7 @@ uint32_t CLRConfig::GetConfigValue(ConfigDWORDInfo eType)
     case UNSUPPORTED_GCLogEnabled:
     case UNSUPPORTED_GCLogFile:
     case UNSUPPORTED_GCLogFileSize:
+    case UNSUPPORTED_GCLargePages:
     case EXTERNAL_GCStressStart:
     case INTERNAL_GCStressStartAtJit:
     case INTERNAL_DbgDACSkipVerifyDlls:
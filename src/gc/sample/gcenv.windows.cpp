@@ -244,6 +244,19 @@ bool GCToOSInterface::GetWriteWatch(bool resetState, void* address, size_t size,
     return false;
 }
 
+// Get how much of the memory reserved with VirtualReserveFlags::LargePages is backed by large pages
+// Parameters:
+//  residentSize  - receives the resident size of the memory reserved with large pages
+//  largePageSize - receives the part of the resident size that is backed by large pages
+// Return:
+//  true if it has succeeded, false if the OS does not report it
+bool GCToOSInterface::GetLargePageUsage(uint64_t* residentSize, uint64_t* largePageSize)
+{
+    *residentSize = 0;
+    *largePageSize = 0;
+    return false;
+}
+
 // Get size of the largest cache on the processor die
 // Parameters:
 //  trueSize - true to return true cache size, false to return scaled up size based on
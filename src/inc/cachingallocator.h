@@ -0,0 +1,82 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+#ifndef _CACHINGALLOCATOR_H_
+#define _CACHINGALLOCATOR_H_
+
+#include "iallocator.h"
+
+// The "CachingAllocator" serves small native allocations from per-thread
+// caches of fixed size blocks, so that threads allocating at the same time
+// do not contend on the process heap. Blocks are carved out of chunks that
+// each hold blocks of a single size class; a block has no header and the
+// size class of a freed block is found from its address. A thread only
+// takes the lock of a size class when its own cache of that class runs
+// empty or grows too large, and then moves a whole batch of blocks between
+// its cache and the list shared by all threads.
+//
+// There is one instance per process. Chunks are never returned to the OS,
+// and memory freed in one size class can only be reused by that class.
+class CachingAllocator : public IAllocator
+{
+    static CachingAllocator s_singleton;
+    static bool s_fEnabled;
+
+public:
+    // Larger requests are passed on to the process heap
+    static const size_t MaxBlockSize = 1024;
+
+    static const unsigned SizeClassCount = 20;
+
+    struct SizeClassStatistics
+    {
+        size_t  BlockSize;
+        // Blocks handed out and taken back. Threads add their counts when
+        // they go to the shared list or exit, so the most recent activity
+        // of running threads is not included.
+        UINT64  Allocations;
+        UINT64  Frees;
+        // Chunks carved into blocks of this size class
+        UINT64  Chunks;
+    };
+
+    void* Alloc(size_t sz);
+
+    void* ArrayAlloc(size_t elemSize, size_t numElems);
+
+    virtual void Free(void * p);
+
+    // Returns true if p is a block handed out by the allocator
+    static bool Owns(void * p);
+
+    // Moves the blocks cached by the current thread back to the shared
+    // lists. Must be called when a thread exits; the thread bypasses its
+    // cache for any allocation it makes afterwards.
+    static void FlushThreadCache();
+
+    static void GetStatistics(unsigned sizeClass, SizeClassStatistics * pStats);
+
+#ifdef LOGGING
+    static void LogStatistics();
+#endif
+
+    // The allocator works whether or not it is enabled; hosts use the flag
+    // to decide whether to route their small allocations through it.
+    static void Enable()
+    {
+        s_fEnabled = true;
+    }
+
+    static bool IsEnabled()
+    {
+        return s_fEnabled;
+    }
+
+    static CachingAllocator* Singleton()
+    {
+        return &s_singleton;
+    }
+};
+
+#endif // _CACHINGALLOCATOR_H_
@@ -1925,6 +1925,7 @@ extern bool g_fNGenWinMDResilient;
 
 #ifdef FEATURE_READYTORUN_COMPILER
 extern bool g_fReadyToRunCompilation;
+extern bool g_fLargeVersionBubble;
 #endif
 
 inline bool IsReadyToRunCompilation()
@@ -1936,4 +1937,15 @@ inline bool IsReadyToRunCompilation()
 #endif
 }
 
+// True if all assemblies visible to the compilation are treated as a single version bubble,
+// i.e. they are serviced as a set together with the image being compiled.
+inline bool IsLargeVersionBubbleEnabled()
+{
+#ifdef FEATURE_READYTORUN_COMPILER
+    return g_fReadyToRunCompilation && g_fLargeVersionBubble;
+#else
+    return false;
+#endif
+}
+
 #endif /* COR_COMPILE_H_ */
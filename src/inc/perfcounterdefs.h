@@ -221,6 +221,8 @@ public:
     
     DWORD cPinnedObj;                      // # of Pinned Objects
     DWORD cSinkBlocks;                     // # of sink blocks
+    DWORD cFinalizersRun;                  // # of finalizers run
+    DWORD cFinalizationQueueLength;        // # of objects waiting to be finalized
 };
 
 // *** Keep contents of Perf_GC_Wow64 and Perf_GC in sync ***
@@ -248,6 +250,8 @@ public:
     
     size_t cPinnedObj;                      // # of Pinned Objects
     size_t cSinkBlocks;                     // # of sink blocks
+    size_t cFinalizersRun;                  // # of finalizers run
+    size_t cFinalizationQueueLength;        // # of objects waiting to be finalized
 
     Perf_GC();
     Perf_GC(Perf_GC_Wow64& copyFrom);
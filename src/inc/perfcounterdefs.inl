@@ -40,6 +40,8 @@ inline Perf_GC::Perf_GC(Perf_GC_Wow64& copyFrom)
     timeInGCBase = copyFrom.timeInGCBase;
     cPinnedObj = (size_t) copyFrom.cPinnedObj;
     cSinkBlocks = (size_t) copyFrom.cSinkBlocks;        
+    cFinalizersRun = (size_t) copyFrom.cFinalizersRun;
+    cFinalizationQueueLength = (size_t) copyFrom.cFinalizationQueueLength;
 }
 
 inline Perf_Loading::Perf_Loading() {}
@@ -78,6 +78,7 @@ enum TlsThreadTypeFlag // flag used for thread type in Tls data
     ThreadType_ProfAPI_Detach           = 0x00008000,
     ThreadType_ETWRundownThread         = 0x00010000,
     ThreadType_GenericInstantiationCompare= 0x00020000, // Used to indicate that the thread is determining if a generic instantiation in an ngen image matches a lookup. 
+    ThreadType_FinalizerHelper          = 0x00040000,
 };
 
 #endif
@@ -16,7 +16,7 @@
 #define READYTORUN_SIGNATURE 0x00525452 // 'RTR'
 
 #define READYTORUN_MAJOR_VERSION 0x0002
-#define READYTORUN_MINOR_VERSION 0x0000
+#define READYTORUN_MINOR_VERSION 0x0001
 
 struct READYTORUN_HEADER
 {
@@ -43,6 +43,8 @@ enum ReadyToRunFlag
     // Set if the original IL assembly was platform-neutral
     READYTORUN_FLAG_PLATFORM_NEUTRAL_SOURCE         = 0x00000001,
     READYTORUN_FLAG_SKIP_TYPE_VALIDATION            = 0x00000002,
+    // Set if the image was compiled with all of its dependencies in its version bubble
+    READYTORUN_FLAG_LARGE_VERSION_BUBBLE            = 0x00000004,
 };
 
 enum ReadyToRunSectionType
@@ -57,6 +59,9 @@ enum ReadyToRunSectionType
     // 107 used by an older format of READYTORUN_SECTION_AVAILABLE_TYPES
     READYTORUN_SECTION_AVAILABLE_TYPES              = 108,
     READYTORUN_SECTION_INSTANCE_METHOD_ENTRYPOINTS  = 109,
+
+    // Added in V2.1
+    READYTORUN_SECTION_MANIFEST_METADATA            = 110, // Assembly references added for cross-module references within the version bubble
 };
 
 //
@@ -4816,6 +4816,15 @@ inline BOOL IsFinalizerThread ()
     return !!(((size_t)ClrFlsGetValue (TlsIdx_ThreadType)) & ThreadType_Finalizer);
 }
 
+inline BOOL IsFinalizerHelperThread ()
+{
+    STATIC_CONTRACT_NOTHROW;
+    STATIC_CONTRACT_GC_NOTRIGGER;
+    STATIC_CONTRACT_MODE_ANY;
+
+    return !!(((size_t)ClrFlsGetValue (TlsIdx_ThreadType)) & ThreadType_FinalizerHelper);
+}
+
 inline BOOL IsADUnloadHelperThread ()
 {
     STATIC_CONTRACT_NOTHROW;
@@ -61,6 +61,7 @@ HRESULT MDApplyEditAndContinue(         // S_OK or error.
 //*****************************************************************************
 MDInternalRO::MDInternalRO()
  :  m_pMethodSemanticsMap(0),
+    m_pTypeDefNameIndex(NULL),
     m_cRefs(1)
 {
 } // MDInternalRO::MDInternalRO
@@ -76,6 +77,9 @@ MDInternalRO::~MDInternalRO()
     if (m_pMethodSemanticsMap)
         delete[] m_pMethodSemanticsMap;
     m_pMethodSemanticsMap = 0;
+    if (m_pTypeDefNameIndex)
+        delete[] m_pTypeDefNameIndex;
+    m_pTypeDefNameIndex = NULL;
 } // MDInternalRO::~MDInternalRO
 
 //*****************************************************************************
@@ -1991,8 +1995,18 @@ MDInternalRO::FindTypeDef(
         _ASSERTE(TypeFromToken(tkEnclosingClass) == mdtTypeDef);
     }
     
+    // Use the name index to visit only the TypeDefs whose name hashes to the same bucket, if
+    // there is one. Chains are in RID order, so the result is the same as the linear search.
+    RID * pTypeDefNameIndex = NULL;
+#ifndef DACCESS_COMPILE
+    IfFailRet(GetTypeDefNameIndex(&pTypeDefNameIndex));
+#endif //!DACCESS_COMPILE
+    
+    ULONG cBuckets = GetTypeDefNameIndexBucketCount(cTypeDefRecs);
+    RID   i = (pTypeDefNameIndex != NULL) ? pTypeDefNameIndex[HashStringA(szTypeDefName) % cBuckets] : 1;
+    
     // Search for the TypeDef
-    for (ULONG i = 1; i <= cTypeDefRecs; i++)
+    for (; (i != 0) && (i <= cTypeDefRecs); i = (pTypeDefNameIndex != NULL) ? pTypeDefNameIndex[cBuckets + i] : (i + 1))
     {
         IfFailRet(m_LiteWeightStgdb.m_MiniMd.GetTypeDefRecord(i, &pTypeDefRec));
         
@@ -2040,6 +2054,62 @@ MDInternalRO::FindTypeDef(
     return CLDB_E_RECORD_NOTFOUND;
 } // MDInternalRO::FindTypeDef
 
+#ifndef DACCESS_COMPILE
+//*****************************************************************************
+// Return the hash index of the TypeDef table by name, building it on first use.
+// Small tables are searched linearly and get no index.
+//*****************************************************************************
+__checkReturn 
+HRESULT 
+MDInternalRO::GetTypeDefNameIndex(
+    RID ** ppTypeDefNameIndex)  // [OUT] The index, NULL if there is none.
+{
+    HRESULT hr = S_OK;
+    
+    ULONG cTypeDefRecs = m_LiteWeightStgdb.m_MiniMd.getCountTypeDefs();
+    
+    // Lazy initialization of m_pTypeDefNameIndex
+    if ((cTypeDefRecs > 16) && (m_pTypeDefNameIndex == NULL))
+    {
+        ULONG cBuckets = GetTypeDefNameIndexBucketCount(cTypeDefRecs);
+        S_UINT32 cEntries = S_UINT32(cBuckets) + S_UINT32(cTypeDefRecs) + S_UINT32(1);
+        if (cEntries.IsOverflow())
+        {
+            return COR_E_OVERFLOW;
+        }
+        
+        NewArrayHolder<RID> pTypeDefNameIndex = new (nothrow) RID[cEntries.Value()];
+        if (pTypeDefNameIndex != NULL)
+        {
+            memset(pTypeDefNameIndex, 0, cEntries.Value() * sizeof(RID));
+            
+            // Insert in reverse RID order so that each chain ends up in RID order.
+            for (RID ridCur = cTypeDefRecs; ridCur >= 1; ridCur--)
+            {
+                TypeDefRec * pTypeDefRec;
+                LPCUTF8      szName;
+                
+                IfFailRet(m_LiteWeightStgdb.m_MiniMd.GetTypeDefRecord(ridCur, &pTypeDefRec));
+                IfFailRet(m_LiteWeightStgdb.m_MiniMd.getNameOfTypeDef(pTypeDefRec, &szName));
+                
+                ULONG iBucket = HashStringA(szName) % cBuckets;
+                pTypeDefNameIndex[cBuckets + ridCur] = pTypeDefNameIndex[iBucket];
+                pTypeDefNameIndex[iBucket] = ridCur;
+            }
+            
+            if (InterlockedCompareExchangeT<RID *>(
+                &m_pTypeDefNameIndex, pTypeDefNameIndex, NULL) == NULL)
+            {   // The exchange did happen, supress of the allocated index
+                pTypeDefNameIndex.SuppressRelease();
+            }
+        }
+    }
+    
+    *ppTypeDefNameIndex = m_pTypeDefNameIndex;
+    return hr;
+} // MDInternalRO::GetTypeDefNameIndex
+#endif //!DACCESS_COMPILE
+
 //*****************************************************************************
 // Given a memberref, return a pointer to memberref's name and signature
 //*****************************************************************************
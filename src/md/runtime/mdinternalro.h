@@ -806,6 +806,26 @@ private:
     };
     CMethodSemanticsMap *m_pMethodSemanticsMap; // Possible array of method semantics pointers, ordered by method token.
 
+    // Possible hash index of the TypeDef table by type name, see GetTypeDefNameIndex. The first
+    // GetTypeDefNameIndexBucketCount() entries hold the first RID of each bucket, followed by the
+    // RID of the next TypeDef in the same bucket for each TypeDef. RID 0 terminates a chain.
+    // Only FindTypeDef, which the class loader calls, is indexed: the runtime resolves TypeRefs,
+    // MemberRefs and ExportedTypes by token or through the hash of available classes, and nothing
+    // looks MemberRefs up by name. FindTypeRefByName and FindExportedTypeByName only serve tools
+    // and profilers.
+    RID                 *m_pTypeDefNameIndex;
+
+    static ULONG GetTypeDefNameIndexBucketCount(ULONG cTypeDefRecs)
+    {
+        return cTypeDefRecs | 1;
+    }
+
+#ifndef DACCESS_COMPILE
+    __checkReturn 
+    HRESULT GetTypeDefNameIndex(
+        RID         **ppTypeDefNameIndex);  // [OUT] The index, NULL if there is none.
+#endif //!DACCESS_COMPILE
+
 #ifndef DACCESS_COMPILE
     class CMethodSemanticsMapSorter : public CQuickSort<CMethodSemanticsMap>
     {
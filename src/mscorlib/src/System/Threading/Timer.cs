@@ -36,11 +36,14 @@ namespace System.Threading
     //  - scheduled background tasks.  These typically do fire, but they usually have quite long durations.
     //    So the impact of spending a few extra cycles to fire these is negligible.
     //
-    // Because of this, we want to choose a data structure with very fast insert and delete times, but we can live
-    // with linear traversal times when firing timers.
+    // Because of this, we want to choose a data structure with very fast insert and delete times, and we want to
+    // avoid walking all of the timeouts every time a timer fires.
     //
-    // The data structure we've chosen is an unordered doubly-linked list of active timers.  This gives O(1) insertion
-    // and removal, and O(N) traversal when finding expired timers.
+    // The data structure we've chosen is a pair of unordered doubly-linked lists of active timers.  The "short" list
+    // holds the timers due before m_currentAbsoluteThreshold, which is at most ShortTimersThresholdMilliseconds
+    // ahead; the "long" list holds all the others.  This gives O(1) insertion and removal.  Firing timers walks the
+    // short list only, and the long list once per threshold period, when the timers that become due soon are moved
+    // to the short list.  Most timeouts are long compared to the threshold and are disposed while on the long list.
     //
     // Note that all instance methods of this class require that the caller hold a lock on TimerQueue.Instance.
     //
@@ -222,9 +225,17 @@ namespace System.Threading
         #region Firing timers
 
         //
-        // The list of timers
+        // The lists of timers.  A timer is on the short list if it is due before m_currentAbsoluteThreshold.
         //
-        TimerQueueTimer m_timers;
+        TimerQueueTimer m_shortTimers;
+        TimerQueueTimer m_longTimers;
+
+        //
+        // The tick count up to which timers go to the short list.  The long list is only walked once this is reached.
+        //
+        int m_currentAbsoluteThreshold = TickCount + ShortTimersThresholdMilliseconds;
+
+        const int ShortTimersThresholdMilliseconds = 333;
 
 
         volatile int m_pauseTicks = 0; // Time when Pause was called
@@ -265,39 +276,53 @@ namespace System.Threading
 
                     bool haveTimerToSchedule = false;
                     uint nextAppDomainTimerDuration = uint.MaxValue;      
-            
-                    TimerQueueTimer timer = m_timers;
-                    while (timer != null)
+
+                    // Every timer is re-baselined below, so sort them into the lists again from scratch
+                    TimerQueueTimer shortTimers = m_shortTimers;
+                    TimerQueueTimer longTimers = m_longTimers;
+                    m_shortTimers = null;
+                    m_longTimers = null;
+                    m_currentAbsoluteThreshold = resumedTicks + ShortTimersThresholdMilliseconds;
+
+                    for (int listNum = 0; listNum < 2; listNum++)
                     {
-                        Contract.Assert(timer.m_dueTime != Timeout.UnsignedInfinite);
-                        Contract.Assert(resumedTicks >= timer.m_startTicks);
+                        TimerQueueTimer timer = (listNum == 0) ? shortTimers : longTimers;
+                        while (timer != null)
+                        {
+                            Contract.Assert(timer.m_dueTime != Timeout.UnsignedInfinite);
+                            Contract.Assert(resumedTicks >= timer.m_startTicks);
 
-                        uint elapsed; // How much of the timer dueTime has already elapsed
+                            TimerQueueTimer nextTimer = timer.m_next;
+                            uint elapsed; // How much of the timer dueTime has already elapsed
 
-                        // Timers started before the paused event has to be sufficiently delayed to accomodate 
-                        // for the Pause time. However, timers started after the Paused event shouldnt be adjusted. 
-                        // E.g. ones created by the app in its Activated event should fire when it was designated.
-                        // The Resumed event which is where this routine is executing is after this Activated and hence 
-                        // shouldn't delay this timer
+                            // Timers started before the paused event has to be sufficiently delayed to accomodate 
+                            // for the Pause time. However, timers started after the Paused event shouldnt be adjusted. 
+                            // E.g. ones created by the app in its Activated event should fire when it was designated.
+                            // The Resumed event which is where this routine is executing is after this Activated and hence 
+                            // shouldn't delay this timer
 
-                        if(timer.m_startTicks <= pauseTicks)
-                            elapsed = (uint)(pauseTicks - timer.m_startTicks);
-                        else
-                            elapsed = (uint)(resumedTicks - timer.m_startTicks);
+                            if(timer.m_startTicks <= pauseTicks)
+                                elapsed = (uint)(pauseTicks - timer.m_startTicks);
+                            else
+                                elapsed = (uint)(resumedTicks - timer.m_startTicks);
 
-                        // Handling the corner cases where a Timer was already due by the time Resume is happening,
-                        // We shouldn't delay those timers. 
-                        // Example is a timer started in App's Activated event with a very small duration
-                        timer.m_dueTime = (timer.m_dueTime > elapsed) ? timer.m_dueTime - elapsed : 0;;
-                        timer.m_startTicks = resumedTicks; // re-baseline
+                            // Handling the corner cases where a Timer was already due by the time Resume is happening,
+                            // We shouldn't delay those timers. 
+                            // Example is a timer started in App's Activated event with a very small duration
+                            timer.m_dueTime = (timer.m_dueTime > elapsed) ? timer.m_dueTime - elapsed : 0;;
+                            timer.m_startTicks = resumedTicks; // re-baseline
 
-                        if (timer.m_dueTime < nextAppDomainTimerDuration)
-                        {
-                            haveTimerToSchedule = true;
-                            nextAppDomainTimerDuration = timer.m_dueTime;
-                        }
+                            if (timer.m_dueTime < nextAppDomainTimerDuration)
+                            {
+                                haveTimerToSchedule = true;
+                                nextAppDomainTimerDuration = timer.m_dueTime;
+                            }
 
-                        timer = timer.m_next;
+                            timer.m_short = timer.m_dueTime <= ShortTimersThresholdMilliseconds;
+                            LinkTimer(timer);
+
+                            timer = nextTimer;
+                        }
                     }
                     
                     if (haveTimerToSchedule)
@@ -336,68 +361,99 @@ namespace System.Threading
                     int nowTicks = TickCount;
 
                     //
-                    // Sweep through all timers.  The ones that have reached their due time
-                    // will fire.  We will calculate the next native timer due time from the
-                    // other timers.
+                    // Sweep through the short timers, and through the long timers too once the
+                    // threshold has been reached.  The ones that have reached their due time will
+                    // fire.  We will calculate the next native timer due time from the other timers.
+                    // Long timers that become due before the new threshold move to the short list.
                     //
-                    TimerQueueTimer timer = m_timers;
-                    while (timer != null)
+                    TimerQueueTimer timer = m_shortTimers;
+                    for (int listNum = 0; listNum < 2; listNum++)
                     {
-                        Contract.Assert(timer.m_dueTime != Timeout.UnsignedInfinite);
-
-                        uint elapsed = (uint)(nowTicks - timer.m_startTicks);
-                        if (elapsed >= timer.m_dueTime)
+                        while (timer != null)
                         {
+                            Contract.Assert(timer.m_dueTime != Timeout.UnsignedInfinite);
+
                             //
-                            // Remember the next timer in case we delete this one
+                            // Remember the next timer in case we delete or move this one
                             //
                             TimerQueueTimer nextTimer = timer.m_next;
 
-                            if (timer.m_period != Timeout.UnsignedInfinite)
+                            uint elapsed = (uint)(nowTicks - timer.m_startTicks);
+                            if (elapsed >= timer.m_dueTime)
                             {
-                                timer.m_startTicks = nowTicks;
-                                timer.m_dueTime = timer.m_period;
+                                if (timer.m_period != Timeout.UnsignedInfinite)
+                                {
+                                    timer.m_startTicks = nowTicks;
+                                    timer.m_dueTime = timer.m_period;
+
+                                    //
+                                    // This is a repeating timer; schedule it to run again.
+                                    //
+                                    if (timer.m_dueTime < nextAppDomainTimerDuration)
+                                    {
+                                        haveTimerToSchedule = true;
+                                        nextAppDomainTimerDuration = timer.m_dueTime;
+                                    }
+
+                                    bool shouldBeShort = (int)(nowTicks + timer.m_dueTime) - m_currentAbsoluteThreshold <= 0;
+                                    if (timer.m_short != shouldBeShort)
+                                        MoveTimerToCorrectList(timer, shouldBeShort);
+                                }
+                                else
+                                {
+                                    //
+                                    // Not repeating; remove it from the queue
+                                    //
+                                    DeleteTimer(timer);
+                                }
 
                                 //
-                                // This is a repeating timer; schedule it to run again.
+                                // If this is the first timer, we'll fire it on this thread.  Otherwise, queue it
+                                // to the ThreadPool.
                                 //
-                                if (timer.m_dueTime < nextAppDomainTimerDuration)
-                                {
-                                    haveTimerToSchedule = true;
-                                    nextAppDomainTimerDuration = timer.m_dueTime;
-                                }
+                                if (timerToFireOnThisThread == null)
+                                    timerToFireOnThisThread = timer;
+                                else
+                                    QueueTimerCompletion(timer);
                             }
                             else
                             {
                                 //
-                                // Not repeating; remove it from the queue
+                                // This timer hasn't fired yet.  Just update the next time the native timer fires.
                                 //
-                                DeleteTimer(timer);
-                            }
+                                uint remaining = timer.m_dueTime - elapsed;
+                                if (remaining < nextAppDomainTimerDuration)
+                                {
+                                    haveTimerToSchedule = true;
+                                    nextAppDomainTimerDuration = remaining;
+                                }
 
-                            //
-                            // If this is the first timer, we'll fire it on this thread.  Otherwise, queue it
-                            // to the ThreadPool.
-                            //
-                            if (timerToFireOnThisThread == null)
-                                timerToFireOnThisThread = timer;
-                            else
-                                QueueTimerCompletion(timer);
+                                if (!timer.m_short && remaining <= ShortTimersThresholdMilliseconds)
+                                    MoveTimerToCorrectList(timer, true);
+                            }
 
                             timer = nextTimer;
                         }
-                        else
+
+                        if (listNum == 0)
                         {
                             //
-                            // This timer hasn't fired yet.  Just update the next time the native timer fires.
+                            // Only look at the long timers once the threshold has been reached.  Until then,
+                            // make sure the native timer fires by the threshold if only long timers remain.
                             //
-                            uint remaining = timer.m_dueTime - elapsed;
-                            if (remaining < nextAppDomainTimerDuration)
+                            int remainingToThreshold = m_currentAbsoluteThreshold - nowTicks;
+                            if (remainingToThreshold > 0)
                             {
-                                haveTimerToSchedule = true;
-                                nextAppDomainTimerDuration = remaining;
+                                if (m_shortTimers == null && m_longTimers != null)
+                                {
+                                    haveTimerToSchedule = true;
+                                    nextAppDomainTimerDuration = Math.Min(nextAppDomainTimerDuration, (uint)remainingToThreshold + 1);
+                                }
+                                break;
                             }
-                            timer = timer.m_next;
+
+                            timer = m_longTimers;
+                            m_currentAbsoluteThreshold = nowTicks + ShortTimersThresholdMilliseconds;
                         }
                     }
 
@@ -438,31 +494,76 @@ namespace System.Threading
 
         public bool UpdateTimer(TimerQueueTimer timer, uint dueTime, uint period)
         {
+            int nowTicks = TickCount;
+
+            // The timer goes to the short list if it is due before the current threshold
+            bool shouldBeShort = m_currentAbsoluteThreshold - (int)(nowTicks + dueTime) >= 0;
+
             if (timer.m_dueTime == Timeout.UnsignedInfinite)
             {
-                // the timer is not in the list; add it (as the head of the list).
-                timer.m_next = m_timers;
-                timer.m_prev = null;
-                if (timer.m_next != null)
-                    timer.m_next.m_prev = timer;
-                m_timers = timer;
+                // the timer is not in a list; add it (as the head of the list).
+                timer.m_short = shouldBeShort;
+                LinkTimer(timer);
+            }
+            else if (timer.m_short != shouldBeShort)
+            {
+                MoveTimerToCorrectList(timer, shouldBeShort);
             }
+
             timer.m_dueTime = dueTime;
             timer.m_period = (period == 0) ? Timeout.UnsignedInfinite : period;
-            timer.m_startTicks = TickCount;
+            timer.m_startTicks = nowTicks;
             return EnsureAppDomainTimerFiresBy(dueTime);
         }
 
+        private void MoveTimerToCorrectList(TimerQueueTimer timer, bool shortList)
+        {
+            Contract.Assert(timer.m_dueTime != Timeout.UnsignedInfinite);
+            Contract.Assert(timer.m_short != shortList);
+
+            UnlinkTimer(timer);
+            timer.m_short = shortList;
+            LinkTimer(timer);
+        }
+
+        private void LinkTimer(TimerQueueTimer timer)
+        {
+            // Use timer.m_short to decide to which list to add.
+            if (timer.m_short)
+            {
+                timer.m_next = m_shortTimers;
+                m_shortTimers = timer;
+            }
+            else
+            {
+                timer.m_next = m_longTimers;
+                m_longTimers = timer;
+            }
+            timer.m_prev = null;
+            if (timer.m_next != null)
+                timer.m_next.m_prev = timer;
+        }
+
+        private void UnlinkTimer(TimerQueueTimer timer)
+        {
+            if (timer.m_next != null)
+                timer.m_next.m_prev = timer.m_prev;
+            if (timer.m_prev != null)
+                timer.m_prev.m_next = timer.m_next;
+            else if (timer.m_short)
+                m_shortTimers = timer.m_next;
+            else
+                m_longTimers = timer.m_next;
+
+            timer.m_prev = null;
+            timer.m_next = null;
+        }
+
         public void DeleteTimer(TimerQueueTimer timer)
         {
             if (timer.m_dueTime != Timeout.UnsignedInfinite)
             {
-                if (timer.m_next != null)
-                    timer.m_next.m_prev = timer.m_prev;
-                if (timer.m_prev != null)
-                    timer.m_prev.m_next = timer.m_next;
-                if (m_timers == timer)
-                    m_timers = timer.m_next;
+                UnlinkTimer(timer);
 
                 timer.m_dueTime = Timeout.UnsignedInfinite;
                 timer.m_period = Timeout.UnsignedInfinite;
@@ -483,11 +584,16 @@ namespace System.Threading
         //
         // All fields of this class are protected by a lock on TimerQueue.Instance.
         //
-        // The first four fields are maintained by TimerQueue itself.
+        // The first five fields are maintained by TimerQueue itself.
         //
         internal TimerQueueTimer m_next;
         internal TimerQueueTimer m_prev;
 
+        //
+        // Whether the timer is on the short list of TimerQueue, rather than the long one.
+        //
+        internal bool m_short;
+
         //
         // The time, according to TimerQueue.TickCount, when this timer's current interval started.
         //
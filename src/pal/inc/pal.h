@@ -830,6 +830,7 @@ typedef struct _SECURITY_ATTRIBUTES {
 #define FILE_ATTRIBUTE_NORMAL                   0x00000080
 
 #define FILE_FLAG_WRITE_THROUGH    0x80000000
+#define FILE_FLAG_OVERLAPPED       0x40000000
 #define FILE_FLAG_NO_BUFFERING     0x20000000
 #define FILE_FLAG_RANDOM_ACCESS    0x10000000
 #define FILE_FLAG_SEQUENTIAL_SCAN  0x08000000
@@ -1135,6 +1136,18 @@ SetFileAttributesW(
 
 typedef LPVOID LPOVERLAPPED;  // diff from winbase.h
 
+typedef struct _OVERLAPPED {
+    ULONG_PTR Internal;         // STATUS_PENDING while the I/O is in flight,
+                                // then the Win32 error code (diff from winbase.h)
+    ULONG_PTR InternalHigh;     // number of bytes transferred
+    DWORD Offset;
+    DWORD OffsetHigh;
+    HANDLE hEvent;
+} OVERLAPPED;
+
+#define HasOverlappedIoCompleted(lpOverlapped) \
+    (((OVERLAPPED *)(lpOverlapped))->Internal != (ULONG_PTR)STATUS_PENDING)
+
 PALIMPORT
 BOOL
 PALAPI
@@ -1155,6 +1168,32 @@ ReadFile(
      OUT LPDWORD lpNumberOfBytesRead,
      IN LPOVERLAPPED lpOverlapped);
 
+PALIMPORT
+BOOL
+PALAPI
+GetOverlappedResult(
+     IN HANDLE hFile,
+     IN LPOVERLAPPED lpOverlapped,
+     OUT LPDWORD lpNumberOfBytesTransferred,
+     IN BOOL bWait);
+
+typedef VOID (PALAPI *PIO_COMPLETION_HANDLER)(
+     DWORD dwErrorCode,
+     DWORD dwNumberOfBytesTransferred,
+     LPOVERLAPPED lpOverlapped,
+     PVOID pContext);
+
+// Registers a handler that is called, on a PAL thread, when an overlapped
+// read or write on hFile completes. This stands in for associating the
+// handle with an I/O completion port.
+PALIMPORT
+BOOL
+PALAPI
+PAL_BindIoCompletionCallback(
+     IN HANDLE hFile,
+     IN PIO_COMPLETION_HANDLER pfnCompletion,
+     IN PVOID pContext);
+
 #define STD_INPUT_HANDLE         ((DWORD)-10)
 #define STD_OUTPUT_HANDLE        ((DWORD)-11)
 #define STD_ERROR_HANDLE         ((DWORD)-12)
@@ -1733,6 +1772,61 @@ WaitForMultipleObjectsEx(
              IN DWORD dwMilliseconds,
              IN BOOL bAlertable);
 
+// A wait set lets a single thread wait for any number of objects. Each
+// object added to the set is watched through a descriptor that the PAL
+// makes readable whenever the object is left signaled (an eventfd watched
+// with epoll on Linux). PAL_WaitSetWait acquires the signaled objects, as
+// a zero timeout wait on each of them would, and returns the contexts
+// they were added with. An object that is still signaled after being
+// acquired (e.g. a manual reset event) is returned again by the next call.
+// Wait sets are not available on every platform, and do not support
+// objects shared with other processes; the functions fail with
+// ERROR_NOT_SUPPORTED in those cases. Process handles cannot be added to
+// a set.
+typedef struct _PAL_WAIT_SET *PAL_WAIT_SET;
+
+PALIMPORT
+PAL_WAIT_SET
+PALAPI
+PAL_CreateWaitSet(
+             VOID);
+
+PALIMPORT
+VOID
+PALAPI
+PAL_DeleteWaitSet(
+             IN PAL_WAIT_SET hWaitSet);
+
+// hObject must stay open until it is removed from the set. The same
+// object may be added more than once.
+PALIMPORT
+BOOL
+PALAPI
+PAL_WaitSetAdd(
+             IN PAL_WAIT_SET hWaitSet,
+             IN HANDLE hObject,
+             IN PVOID pvContext,
+             OUT PVOID *ppvRegistration);
+
+PALIMPORT
+VOID
+PALAPI
+PAL_WaitSetRemove(
+             IN PAL_WAIT_SET hWaitSet,
+             IN PVOID pvRegistration);
+
+// Returns the number of contexts stored in rgpvContexts, 0 if no object
+// could be acquired before dwMilliseconds elapsed, or WAIT_FAILED. Only
+// one thread may wait on a given set at a time.
+PALIMPORT
+DWORD
+PALAPI
+PAL_WaitSetWait(
+             IN PAL_WAIT_SET hWaitSet,
+             IN DWORD dwMilliseconds,
+             OUT PVOID *rgpvContexts,
+             IN DWORD nMaxContexts);
+
 PALIMPORT
 RHANDLE
 PALAPI
@@ -3273,6 +3367,31 @@ size_t
 PALAPI
 PAL_GetLogicalProcessorCacheSizeFromOS();
 
+typedef struct _PAL_CGROUP_LIMITS {
+    DWORD dwVersion;            // cgroup version the limits were read from, 0 if none
+    DWORD dwCpuLimit;           // CPUs allowed by the CPU quota, rounded up
+    DWORD dwCpuWeight;          // cpu.shares (v1) or cpu.weight (v2)
+    ULONGLONG ullMemoryLimit;   // bytes
+    ULONGLONG ullMemoryUsage;   // bytes charged against the memory limit, without inactive file cache
+} PAL_CGROUP_LIMITS;
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_GetCGroupLimits(
+    OUT PAL_CGROUP_LIMITS *lpLimits);
+
+typedef struct _PAL_LARGE_PAGE_USAGE {
+    ULONGLONG ullResidentSize;  // resident bytes of the regions reserved with MEM_LARGE_PAGES
+    ULONGLONG ullHugePageSize;  // part of the resident bytes backed by transparent huge pages
+} PAL_LARGE_PAGE_USAGE;
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_GetLargePageUsage(
+    OUT PAL_LARGE_PAGE_USAGE *lpUsage);
+
 typedef BOOL (*ReadMemoryWordCallback)(SIZE_T address, SIZE_T *value);
 
 PALIMPORT BOOL PALAPI PAL_VirtualUnwind(CONTEXT *context, KNONVOLATILE_CONTEXT_POINTERS *contextPointers);
@@ -3383,8 +3502,11 @@ SetErrorMode(
 #define MEM_MAPPED                      0x40000
 #define MEM_TOP_DOWN                    0x100000
 #define MEM_WRITE_WATCH                 0x200000
+#define MEM_LARGE_PAGES                 0x20000000 // back committed pages with transparent huge pages where supported
 #define MEM_RESERVE_EXECUTABLE          0x40000000 // reserve memory using executable memory allocator
 
+#define WRITE_WATCH_FLAG_RESET          0x01
+
 PALIMPORT
 HANDLE
 PALAPI
@@ -6888,6 +7010,7 @@ public:
 #define DBG_COMMAND_EXCEPTION            ((DWORD   )0x40010009L)    
 
 #define STATUS_USER_APC                  ((DWORD   )0x000000C0L)
+#define STATUS_PENDING                   ((DWORD   )0x00000103L)
 #define STATUS_GUARD_PAGE_VIOLATION      ((DWORD   )0x80000001L)
 #define STATUS_DATATYPE_MISALIGNMENT     ((DWORD   )0x80000002L)
 #define STATUS_BREAKPOINT                ((DWORD   )0x80000003L)
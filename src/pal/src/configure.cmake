@@ -997,6 +997,70 @@ int main()
 }" HAVE_FULLY_FEATURED_PTHREAD_MUTEXES)
 set(CMAKE_REQUIRED_LIBRARIES)
 
+check_cxx_source_compiles("
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#include <linux/userfaultfd.h>
+
+int main()
+{
+    struct uffdio_api api;
+    api.api = UFFD_API;
+    api.features = UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_UNPOPULATED;
+
+    struct pm_scan_arg arg;
+    arg.flags = PM_SCAN_WP_MATCHING | PM_SCAN_CHECK_WPASYNC;
+    arg.category_mask = PAGE_IS_WRITTEN;
+
+    return (int)syscall(__NR_userfaultfd, 0) + PAGEMAP_SCAN + UFFDIO_WRITEPROTECT;
+}" HAVE_PAGEMAP_SCAN)
+
+check_cxx_source_compiles("
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main()
+{
+    int word = 0;
+    return (int)syscall(SYS_futex, &word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME, 0, NULL, NULL, FUTEX_BITSET_MATCH_ANY);
+}" HAVE_FUTEX)
+
+check_cxx_source_compiles("
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main()
+{
+    struct io_uring_params params = {};
+    struct io_uring_probe probe = {};
+    return (int)syscall(__NR_io_uring_setup, 1, &params) + (int)syscall(__NR_io_uring_enter, 0, 1, 0, IORING_ENTER_GETEVENTS, NULL, 0) +
+           (int)syscall(__NR_io_uring_register, 0, IORING_REGISTER_PROBE, &probe, 0) + IORING_OP_READ + IORING_OP_WRITE + IO_URING_OP_SUPPORTED;
+}" HAVE_IO_URING)
+
+check_cxx_source_compiles("
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+int main()
+{
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event) + epoll_wait(epfd, &event, 1, 0);
+}" HAVE_EPOLL)
+
+check_cxx_source_compiles("
+#include <sys/mman.h>
+
+int main()
+{
+    return madvise(NULL, 0, MADV_HUGEPAGE);
+}" HAVE_MADV_HUGEPAGE)
+
 if(NOT CLR_CMAKE_PLATFORM_ARCH_ARM AND NOT CLR_CMAKE_PLATFORM_ARCH_ARM64)
   set(CMAKE_REQUIRED_LIBRARIES pthread)
   check_cxx_source_runs("
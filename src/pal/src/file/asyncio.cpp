@@ -0,0 +1,891 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*++
+
+
+
+Module Name:
+
+    asyncio.cpp
+
+Abstract:
+
+    Implementation of overlapped file I/O for the PAL.
+
+    Overlapped reads and writes on handles opened with FILE_FLAG_OVERLAPPED
+    are submitted to a process wide io_uring instance and completed by a
+    dedicated thread, which fills in the OVERLAPPED, signals its event and
+    calls the handler registered through PAL_BindIoCompletionCallback.
+    When io_uring is not available (or the ring is full) the operation is
+    performed synchronously at the requested offset and completed before
+    returning, which is also what happens for handles that were not opened
+    for overlapped I/O.
+
+
+
+--*/
+
+#include "pal/thread.hpp"
+#include "pal/file.hpp"
+#include "pal/event.hpp"
+#include "pal/synchobjects.hpp"
+#include "pal/handleapi.hpp"
+#include "pal/cs.hpp"
+#include "pal/malloc.hpp"
+#include "pal/dbgmsg.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/types.h>
+#if HAVE_IO_URING
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <linux/io_uring.h>
+#endif // HAVE_IO_URING
+
+using namespace CorUnix;
+
+SET_DEFAULT_DEBUG_CHANNEL(FILE);
+
+static CRITICAL_SECTION s_csAsyncIO;
+
+#if HAVE_IO_URING
+namespace
+{
+    struct AsyncIORequest
+    {
+        OVERLAPPED *pOverlapped;
+        IPalObject *pEventObject;
+        BOOL fWrite;
+        DWORD nNumberOfBytes;
+        PIO_COMPLETION_HANDLER pfnCompletion;
+        PVOID pCompletionContext;
+    };
+
+    enum AsyncIOState
+    {
+        AsyncIOUninitialized,
+        AsyncIORingActive,
+        AsyncIOSynchronousOnly,
+    };
+}
+
+static Volatile<LONG> s_asyncIOState = AsyncIOUninitialized;
+
+// Number of submission queue entries; the kernel sizes the completion queue
+// at twice that, so completions cannot overflow while at most this many
+// requests are in flight.
+static const unsigned AsyncIORingEntries = 256;
+
+static int s_ringFd = -1;
+static unsigned s_sqEntries;
+static unsigned *s_sqHead;
+static unsigned *s_sqTail;
+static unsigned *s_sqMask;
+static unsigned *s_sqArray;
+static struct io_uring_sqe *s_sqes;
+static unsigned *s_cqHead;
+static unsigned *s_cqTail;
+static unsigned *s_cqMask;
+static struct io_uring_cqe *s_cqes;
+static LONG s_lInFlight = 0;
+
+// The completion thread; it exits when it reaps a NOP submitted with a NULL
+// request by FILEShutdownAsyncIO
+static HANDLE s_hCompletionThread = NULL;
+static void *s_pSqRing = MAP_FAILED;
+static void *s_pCqRing = MAP_FAILED;
+static void *s_pSqes = MAP_FAILED;
+static size_t s_sqRingSize, s_cqRingSize, s_sqesSize;
+
+// How long shutdown waits for the completion thread, which may be running a
+// completion handler
+static const DWORD AsyncIOShutdownTimeout = 250;
+
+// Longest pause of the completion thread after io_uring_enter failed
+static const DWORD AsyncIOMaxErrorBackoff = 100;
+#endif // HAVE_IO_URING
+
+/*++
+Function:
+  FILEInitializeAsyncIO
+
+See declaration in pal/file.hpp
+--*/
+void
+FILEInitializeAsyncIO(void)
+{
+    InternalInitializeCriticalSection(&s_csAsyncIO);
+}
+
+/*++
+Function:
+  AsyncIOCompleteRequest
+
+Fills in the OVERLAPPED of a finished request, signals its event and
+calls the completion handler bound to the file, if any. pEventObject is
+the event of the OVERLAPPED, referenced when the request was issued.
+--*/
+static void
+AsyncIOCompleteRequest(
+    CPalThread *pThread,
+    OVERLAPPED *pOverlapped,
+    IPalObject *pEventObject,
+    DWORD dwError,
+    DWORD dwBytesTransferred,
+    PIO_COMPLETION_HANDLER pfnCompletion,
+    PVOID pCompletionContext)
+{
+    TRACE("Overlapped I/O %p completed [error=%u bytes=%u]\n",
+          pOverlapped, dwError, dwBytesTransferred);
+
+    pOverlapped->InternalHigh = dwBytesTransferred;
+
+    // Publish the status before signaling the event, so that a thread woken
+    // up by the event always finds the request complete. The OVERLAPPED may
+    // be reused and its event handle closed as soon as the status is
+    // published, so only the event object referenced at submission is used
+    // from here on.
+    __atomic_store_n(&pOverlapped->Internal, (ULONG_PTR)dwError, __ATOMIC_RELEASE);
+
+    if (NULL != pEventObject)
+    {
+        InternalSetEventObject(pThread, pEventObject, TRUE);
+    }
+
+#if HAVE_IO_URING
+    if (NULL == pEventObject)
+    {
+        // Wake up GetOverlappedResult, which waits on the status itself when
+        // there is no event. Only the address is used, so this is harmless
+        // if the OVERLAPPED was already reused.
+        syscall(__NR_futex, &pOverlapped->Internal, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+#endif // HAVE_IO_URING
+
+    if (NULL != pfnCompletion)
+    {
+        pfnCompletion(dwError, dwBytesTransferred, pOverlapped, pCompletionContext);
+    }
+}
+
+/*++
+Function:
+  AsyncIOGetResultError
+
+Maps the result of a read or write (a byte count, or -1 with errno set)
+to a Win32 error code, reporting end of file the way Windows does for
+positioned reads.
+--*/
+static DWORD
+AsyncIOGetResultError(BOOL fWrite, DWORD nNumberOfBytes, ssize_t res)
+{
+    if (res < 0)
+    {
+        return FILEGetLastErrorFromErrno();
+    }
+    if (!fWrite && 0 == res && 0 != nNumberOfBytes)
+    {
+        return ERROR_HANDLE_EOF;
+    }
+    return NO_ERROR;
+}
+
+#if HAVE_IO_URING
+/*++
+Function:
+  AsyncIOCompletionThread
+
+Reaps completions from the ring and completes the matching requests, until
+it reaps the NOP queued by FILEShutdownAsyncIO.
+--*/
+static DWORD
+PALAPI
+AsyncIOCompletionThread(LPVOID lpParameter)
+{
+    CPalThread *pThread = InternalGetCurrentThread();
+    DWORD dwBackoff = 0;
+
+    for (;;)
+    {
+        unsigned head = *s_cqHead;
+        unsigned tail = __atomic_load_n(s_cqTail, __ATOMIC_ACQUIRE);
+
+        if (head == tail)
+        {
+            if (syscall(__NR_io_uring_enter, s_ringFd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 &&
+                EINTR != errno && EAGAIN != errno && EBUSY != errno)
+            {
+                // Back off instead of spinning while the error persists
+                ERROR("io_uring_enter failed while waiting for completions [errno=%d (%s)]\n",
+                      errno, strerror(errno));
+                dwBackoff = (0 == dwBackoff) ? 1 : 2 * dwBackoff;
+                if (dwBackoff > AsyncIOMaxErrorBackoff)
+                {
+                    dwBackoff = AsyncIOMaxErrorBackoff;
+                }
+                poll(NULL, 0, dwBackoff);
+            }
+            else
+            {
+                dwBackoff = 0;
+            }
+            continue;
+        }
+
+        while (head != tail)
+        {
+            struct io_uring_cqe *pCqe = &s_cqes[head & *s_cqMask];
+            AsyncIORequest *pRequest = (AsyncIORequest *)(SIZE_T)pCqe->user_data;
+            int res = pCqe->res;
+
+            // Hand the slot back to the kernel before running the handler
+            head++;
+            __atomic_store_n(s_cqHead, head, __ATOMIC_RELEASE);
+
+            if (NULL == pRequest)
+            {
+                TRACE("Overlapped I/O completion thread exiting\n");
+                return 0;
+            }
+
+            if (res < 0)
+            {
+                errno = -res;
+            }
+
+            AsyncIOCompleteRequest(
+                pThread,
+                pRequest->pOverlapped,
+                pRequest->pEventObject,
+                AsyncIOGetResultError(pRequest->fWrite, pRequest->nNumberOfBytes, res),
+                (res < 0) ? 0 : (DWORD)res,
+                pRequest->pfnCompletion,
+                pRequest->pCompletionContext);
+
+            if (NULL != pRequest->pEventObject)
+            {
+                pRequest->pEventObject->ReleaseReference(pThread);
+            }
+            InternalDelete(pRequest);
+            InterlockedDecrement(&s_lInFlight);
+        }
+    }
+}
+
+/*++
+Function:
+  AsyncIOPushSqe
+
+Copies an entry to the submission queue and submits it. Returns false if
+the queue is full or the submission failed. Called with s_csAsyncIO held.
+--*/
+static bool
+AsyncIOPushSqe(const struct io_uring_sqe *pEntry)
+{
+    unsigned tail = *s_sqTail;
+    long lRet;
+
+    if (tail - __atomic_load_n(s_sqHead, __ATOMIC_ACQUIRE) >= s_sqEntries)
+    {
+        return false;
+    }
+
+    unsigned index = tail & *s_sqMask;
+    s_sqes[index] = *pEntry;
+    s_sqArray[index] = index;
+
+    __atomic_store_n(s_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    do
+    {
+        lRet = syscall(__NR_io_uring_enter, s_ringFd, 1, 0, 0, NULL, 0);
+    } while (lRet < 0 && (EINTR == errno || EAGAIN == errno || EBUSY == errno));
+
+    if (1 != lRet)
+    {
+        // Nothing was consumed, take the entry back
+        WARN("io_uring_enter failed to submit [errno=%d (%s)]\n", errno, strerror(errno));
+        __atomic_store_n(s_sqTail, tail, __ATOMIC_RELEASE);
+        return false;
+    }
+
+    return true;
+}
+
+/*++
+Function:
+  AsyncIOCreateRing
+
+Creates the io_uring instance and its completion thread. Returns false if
+the kernel does not support io_uring or the read and write operations.
+Called with s_csAsyncIO held.
+--*/
+static bool
+AsyncIOCreateRing(CPalThread *pThread)
+{
+    struct io_uring_params params;
+    struct io_uring_probe *pProbe = NULL;
+    const unsigned probeOps = 256;
+    void *pSqRing = MAP_FAILED;
+    void *pCqRing = MAP_FAILED;
+    void *pSqes = MAP_FAILED;
+    size_t sqRingSize = 0, cqRingSize = 0, sqesSize = 0;
+    HANDLE hThread = NULL;
+    DWORD dwThreadId;
+    PAL_ERROR palError;
+    bool fRet = false;
+    int fd;
+
+    memset(&params, 0, sizeof(params));
+    fd = (int)syscall(__NR_io_uring_setup, AsyncIORingEntries, &params);
+    if (fd < 0)
+    {
+        WARN("io_uring_setup failed [errno=%d (%s)], overlapped I/O will be synchronous\n",
+             errno, strerror(errno));
+        goto done;
+    }
+
+    // IORING_OP_READ and IORING_OP_WRITE are newer than io_uring itself
+    pProbe = (struct io_uring_probe *)InternalMalloc(
+        sizeof(struct io_uring_probe) + probeOps * sizeof(struct io_uring_probe_op));
+    if (NULL == pProbe)
+    {
+        goto done;
+    }
+    memset(pProbe, 0, sizeof(struct io_uring_probe) + probeOps * sizeof(struct io_uring_probe_op));
+    if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, pProbe, probeOps) < 0 ||
+        pProbe->last_op < IORING_OP_WRITE ||
+        0 == (pProbe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) ||
+        0 == (pProbe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED))
+    {
+        WARN("io_uring does not support read and write, overlapped I/O will be synchronous\n");
+        goto done;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        sqRingSize = cqRingSize = (sqRingSize > cqRingSize) ? sqRingSize : cqRingSize;
+    }
+
+    pSqRing = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == pSqRing)
+    {
+        ERROR("Unable to map the io_uring submission queue [errno=%d]\n", errno);
+        goto done;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        pCqRing = pSqRing;
+    }
+    else
+    {
+        pCqRing = mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == pCqRing)
+        {
+            ERROR("Unable to map the io_uring completion queue [errno=%d]\n", errno);
+            goto done;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    pSqes = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (MAP_FAILED == pSqes)
+    {
+        ERROR("Unable to map the io_uring submission entries [errno=%d]\n", errno);
+        goto done;
+    }
+
+    s_pSqRing = pSqRing;
+    s_pCqRing = pCqRing;
+    s_pSqes = pSqes;
+    s_sqRingSize = sqRingSize;
+    s_cqRingSize = cqRingSize;
+    s_sqesSize = sqesSize;
+    s_sqEntries = params.sq_entries;
+    s_sqHead = (unsigned *)((BYTE *)pSqRing + params.sq_off.head);
+    s_sqTail = (unsigned *)((BYTE *)pSqRing + params.sq_off.tail);
+    s_sqMask = (unsigned *)((BYTE *)pSqRing + params.sq_off.ring_mask);
+    s_sqArray = (unsigned *)((BYTE *)pSqRing + params.sq_off.array);
+    s_sqes = (struct io_uring_sqe *)pSqes;
+    s_cqHead = (unsigned *)((BYTE *)pCqRing + params.cq_off.head);
+    s_cqTail = (unsigned *)((BYTE *)pCqRing + params.cq_off.tail);
+    s_cqMask = (unsigned *)((BYTE *)pCqRing + params.cq_off.ring_mask);
+    s_cqes = (struct io_uring_cqe *)((BYTE *)pCqRing + params.cq_off.cqes);
+    s_ringFd = fd;
+
+    // The completion thread calls back into the bound handlers, which may
+    // run runtime code, so it is not a PAL worker thread
+    palError = InternalCreateThread(
+        pThread,
+        NULL,
+        0,
+        AsyncIOCompletionThread,
+        NULL,
+        0,
+        UserCreatedThread,
+        &dwThreadId,
+        &hThread);
+    if (NO_ERROR != palError)
+    {
+        ERROR("Unable to create the overlapped I/O completion thread [error=%u]\n", palError);
+        s_ringFd = -1;
+        goto done;
+    }
+
+    // Kept for FILEShutdownAsyncIO
+    s_hCompletionThread = hThread;
+    fRet = true;
+
+done:
+    if (!fRet)
+    {
+        if (MAP_FAILED != pSqes)
+        {
+            munmap(pSqes, sqesSize);
+        }
+        if (MAP_FAILED != pCqRing && pCqRing != pSqRing)
+        {
+            munmap(pCqRing, cqRingSize);
+        }
+        if (MAP_FAILED != pSqRing)
+        {
+            munmap(pSqRing, sqRingSize);
+        }
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        s_pSqRing = s_pCqRing = s_pSqes = MAP_FAILED;
+    }
+    if (NULL != pProbe)
+    {
+        InternalFree(pProbe);
+    }
+    return fRet;
+}
+
+/*++
+Function:
+  AsyncIOSubmit
+
+Queues a read or write on the ring. Returns false if the ring is full or
+the submission failed, in which case the caller completes the request
+synchronously.
+--*/
+static bool
+AsyncIOSubmit(
+    CPalThread *pThread,
+    int ifd,
+    UINT64 offset,
+    AsyncIORequest *pRequest,
+    LPVOID lpBuffer)
+{
+    bool fSubmitted = false;
+
+    if (InterlockedIncrement(&s_lInFlight) > (LONG)s_sqEntries)
+    {
+        InterlockedDecrement(&s_lInFlight);
+        return false;
+    }
+
+    struct io_uring_sqe sqe;
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = pRequest->fWrite ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe.fd = ifd;
+    sqe.off = offset;
+    sqe.addr = (UINT64)(SIZE_T)lpBuffer;
+    sqe.len = pRequest->nNumberOfBytes;
+    sqe.user_data = (UINT64)(SIZE_T)pRequest;
+
+    InternalEnterCriticalSection(pThread, &s_csAsyncIO);
+
+    // No new I/O goes to the ring once shutdown has started
+    if (AsyncIORingActive == s_asyncIOState)
+    {
+        fSubmitted = AsyncIOPushSqe(&sqe);
+    }
+
+    InternalLeaveCriticalSection(pThread, &s_csAsyncIO);
+
+    if (!fSubmitted)
+    {
+        InterlockedDecrement(&s_lInFlight);
+    }
+    return fSubmitted;
+}
+
+/*++
+Function:
+  AsyncIOIsRingActive
+
+Creates the ring on first use. Returns true if overlapped I/O can be
+submitted to it.
+--*/
+static bool
+AsyncIOIsRingActive(CPalThread *pThread)
+{
+    if (AsyncIOUninitialized == s_asyncIOState)
+    {
+        InternalEnterCriticalSection(pThread, &s_csAsyncIO);
+        if (AsyncIOUninitialized == s_asyncIOState)
+        {
+            s_asyncIOState = AsyncIOCreateRing(pThread) ? AsyncIORingActive : AsyncIOSynchronousOnly;
+        }
+        InternalLeaveCriticalSection(pThread, &s_csAsyncIO);
+    }
+
+    return AsyncIORingActive == s_asyncIOState;
+}
+#endif // HAVE_IO_URING
+
+/*++
+Function:
+  InternalOverlappedIO
+
+Performs a read or write described by an OVERLAPPED. Returns
+ERROR_IO_PENDING if the operation was queued, otherwise the operation has
+completed and its result is returned.
+
+See declaration in pal/file.hpp
+--*/
+PAL_ERROR
+CorUnix::InternalOverlappedIO(
+    CPalThread *pThread,
+    int ifd,
+    BOOL fWrite,
+    LPVOID lpBuffer,
+    DWORD nNumberOfBytes,
+    LPDWORD lpNumberOfBytesTransferred,
+    LPOVERLAPPED lpOverlapped,
+    BOOL fOverlappedHandle,
+    PIO_COMPLETION_HANDLER pfnCompletion,
+    PVOID pCompletionContext
+    )
+{
+    OVERLAPPED *pOverlapped = (OVERLAPPED *)lpOverlapped;
+    UINT64 offset = ((UINT64)pOverlapped->OffsetHigh << 32) | pOverlapped->Offset;
+    IPalObject *pEventObject = NULL;
+    PAL_ERROR palError;
+    DWORD dwError;
+    ssize_t res;
+
+    // The completion signals the event object rather than the handle, which
+    // the caller may close once the I/O has completed
+    if (NULL != pOverlapped->hEvent)
+    {
+        palError = InternalReferenceEvent(pThread, pOverlapped->hEvent, &pEventObject);
+        if (NO_ERROR != palError)
+        {
+            return palError;
+        }
+        InternalSetEventObject(pThread, pEventObject, FALSE);
+    }
+
+    pOverlapped->InternalHigh = 0;
+    pOverlapped->Internal = STATUS_PENDING;
+
+    if (!fOverlappedHandle)
+    {
+        // Only overlapped handles report completions asynchronously
+        pfnCompletion = NULL;
+    }
+#if HAVE_IO_URING
+    else if (AsyncIOIsRingActive(pThread))
+    {
+        AsyncIORequest *pRequest = InternalNew<AsyncIORequest>();
+
+        if (NULL != pRequest)
+        {
+            pRequest->pOverlapped = pOverlapped;
+            pRequest->pEventObject = pEventObject;
+            pRequest->fWrite = fWrite;
+            pRequest->nNumberOfBytes = nNumberOfBytes;
+            pRequest->pfnCompletion = pfnCompletion;
+            pRequest->pCompletionContext = pCompletionContext;
+
+            if (AsyncIOSubmit(pThread, ifd, offset, pRequest, lpBuffer))
+            {
+                // The request owns the reference to the event object now
+                TRACE("Queued overlapped %s of %u bytes at offset %llu on fd %d\n",
+                      fWrite ? "write" : "read", nNumberOfBytes, offset, ifd);
+                return ERROR_IO_PENDING;
+            }
+
+            InternalDelete(pRequest);
+        }
+    }
+#endif // HAVE_IO_URING
+
+    do
+    {
+        res = fWrite ? pwrite(ifd, lpBuffer, nNumberOfBytes, (off_t)offset) :
+                       pread(ifd, lpBuffer, nNumberOfBytes, (off_t)offset);
+    } while (res < 0 && EINTR == errno);
+
+    dwError = AsyncIOGetResultError(fWrite, nNumberOfBytes, res);
+
+    if (NULL != lpNumberOfBytesTransferred)
+    {
+        *lpNumberOfBytesTransferred = (res < 0) ? 0 : (DWORD)res;
+    }
+
+    AsyncIOCompleteRequest(
+        pThread,
+        pOverlapped,
+        pEventObject,
+        dwError,
+        (res < 0) ? 0 : (DWORD)res,
+        pfnCompletion,
+        pCompletionContext);
+
+    if (NULL != pEventObject)
+    {
+        pEventObject->ReleaseReference(pThread);
+    }
+
+    return dwError;
+}
+
+/*++
+Function:
+  FILEShutdownAsyncIO
+
+See declaration in pal/file.hpp
+--*/
+void
+FILEShutdownAsyncIO(void)
+{
+#if HAVE_IO_URING
+    CPalThread *pThread = InternalGetCurrentThread();
+    bool fStopping = false;
+
+    InternalEnterCriticalSection(pThread, &s_csAsyncIO);
+    if (AsyncIORingActive == s_asyncIOState)
+    {
+        // The completion thread exits when it reaps a NULL request
+        struct io_uring_sqe sqe;
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_NOP;
+        sqe.user_data = 0;
+
+        fStopping = AsyncIOPushSqe(&sqe);
+    }
+    // Overlapped I/O issued from now on completes synchronously
+    s_asyncIOState = AsyncIOSynchronousOnly;
+    InternalLeaveCriticalSection(pThread, &s_csAsyncIO);
+
+    if (NULL == s_hCompletionThread)
+    {
+        return;
+    }
+
+    if (fStopping &&
+        WAIT_OBJECT_0 == InternalWaitForMultipleObjectsEx(
+            pThread, 1, &s_hCompletionThread, FALSE, AsyncIOShutdownTimeout, FALSE) &&
+        0 == s_lInFlight)
+    {
+        // Nothing references the ring anymore
+        munmap(s_pSqes, s_sqesSize);
+        if (s_pCqRing != s_pSqRing)
+        {
+            munmap(s_pCqRing, s_cqRingSize);
+        }
+        munmap(s_pSqRing, s_sqRingSize);
+        close(s_ringFd);
+        s_ringFd = -1;
+    }
+    else
+    {
+        // The thread is stuck in a completion handler, or requests are still
+        // in flight: leave the ring to the process exit
+        WARN("Overlapped I/O completion thread did not stop, the ring is not torn down\n");
+    }
+
+    InternalCloseHandle(pThread, s_hCompletionThread);
+    s_hCompletionThread = NULL;
+#endif // HAVE_IO_URING
+}
+
+/*++
+Function:
+  GetOverlappedResult
+
+If the I/O is still in flight and bWait is set, waits on the event of the
+OVERLAPPED, or on its status when there is none (the PAL does not signal
+file handles). The status is published before the event is signaled, so
+the status is final once the event has been waited on.
+
+See MSDN doc.
+--*/
+BOOL
+PALAPI
+GetOverlappedResult(
+     IN HANDLE hFile,
+     IN LPOVERLAPPED lpOverlapped,
+     OUT LPDWORD lpNumberOfBytesTransferred,
+     IN BOOL bWait)
+{
+    CPalThread *pThread;
+    OVERLAPPED *pOverlapped = (OVERLAPPED *)lpOverlapped;
+    DWORD dwError = NO_ERROR;
+    BOOL bRet = FALSE;
+
+    PERF_ENTRY(GetOverlappedResult);
+    ENTRY("GetOverlappedResult(hFile=%p, lpOverlapped=%p, lpNumberOfBytesTransferred=%p, "
+          "bWait=%d)\n", hFile, lpOverlapped, lpNumberOfBytesTransferred, bWait);
+
+    pThread = InternalGetCurrentThread();
+
+    if (NULL == pOverlapped || NULL == lpNumberOfBytesTransferred)
+    {
+        ERROR("Invalid parameter\n");
+        dwError = ERROR_INVALID_PARAMETER;
+        goto done;
+    }
+
+    while ((ULONG_PTR)STATUS_PENDING == __atomic_load_n(&pOverlapped->Internal, __ATOMIC_ACQUIRE))
+    {
+        if (!bWait)
+        {
+            dwError = ERROR_IO_INCOMPLETE;
+            goto done;
+        }
+
+        if (NULL != pOverlapped->hEvent)
+        {
+            if (WAIT_FAILED == InternalWaitForMultipleObjectsEx(
+                    pThread, 1, &pOverlapped->hEvent, FALSE, INFINITE, FALSE))
+            {
+                dwError = pThread->GetLastError();
+                goto done;
+            }
+        }
+        else
+        {
+#if HAVE_IO_URING
+            // Sleep until the status changes; AsyncIOCompleteRequest wakes up
+            // the waiters of OVERLAPPEDs that have no event. Only the low
+            // half of Internal is compared, which holds the whole status.
+            syscall(__NR_futex, &pOverlapped->Internal, FUTEX_WAIT_PRIVATE,
+                    (UINT32)STATUS_PENDING, NULL, NULL, 0);
+#else // HAVE_IO_URING
+            // Without io_uring every request completes before it is issued
+            ASSERT("Overlapped I/O %p is pending without io_uring\n", pOverlapped);
+            dwError = ERROR_INTERNAL_ERROR;
+            goto done;
+#endif // HAVE_IO_URING
+        }
+    }
+
+    *lpNumberOfBytesTransferred = (DWORD)pOverlapped->InternalHigh;
+    dwError = (DWORD)pOverlapped->Internal;
+    bRet = (NO_ERROR == dwError);
+
+done:
+    if (NO_ERROR != dwError)
+    {
+        pThread->SetLastError(dwError);
+    }
+
+    LOGEXIT("GetOverlappedResult returns BOOL %d\n", bRet);
+    PERF_EXIT(GetOverlappedResult);
+    return bRet;
+}
+
+/*++
+Function:
+  PAL_BindIoCompletionCallback
+
+See declaration in pal.h
+--*/
+BOOL
+PALAPI
+PAL_BindIoCompletionCallback(
+     IN HANDLE hFile,
+     IN PIO_COMPLETION_HANDLER pfnCompletion,
+     IN PVOID pContext)
+{
+    CPalThread *pThread;
+    IPalObject *pFileObject = NULL;
+    IDataLock *pLocalDataLock = NULL;
+    CFileProcessLocalData *pLocalData = NULL;
+    PAL_ERROR palError;
+
+    PERF_ENTRY(PAL_BindIoCompletionCallback);
+    ENTRY("PAL_BindIoCompletionCallback(hFile=%p, pfnCompletion=%p, pContext=%p)\n",
+          hFile, pfnCompletion, pContext);
+
+    pThread = InternalGetCurrentThread();
+
+    if (NULL == pfnCompletion)
+    {
+        ERROR("pfnCompletion is NULL\n");
+        palError = ERROR_INVALID_PARAMETER;
+        goto done;
+    }
+
+    palError = g_pObjectManager->ReferenceObjectByHandle(
+        pThread,
+        hFile,
+        &aotFile,
+        0,
+        &pFileObject
+        );
+
+    if (NO_ERROR != palError)
+    {
+        goto done;
+    }
+
+    palError = pFileObject->GetProcessLocalData(
+        pThread,
+        WriteLock,
+        &pLocalDataLock,
+        reinterpret_cast<void**>(&pLocalData)
+        );
+
+    if (NO_ERROR != palError)
+    {
+        goto done;
+    }
+
+    if (NULL != pLocalData->pfnIoCompletion)
+    {
+        // Like a completion port association, a binding is permanent
+        ERROR("File handle %p already has a completion handler\n", hFile);
+        palError = ERROR_INVALID_PARAMETER;
+        goto done;
+    }
+
+    pLocalData->pfnIoCompletion = pfnCompletion;
+    pLocalData->pIoCompletionContext = pContext;
+
+done:
+    if (NULL != pLocalDataLock)
+    {
+        pLocalDataLock->ReleaseLock(pThread, NO_ERROR == palError);
+    }
+
+    if (NULL != pFileObject)
+    {
+        pFileObject->ReleaseReference(pThread);
+    }
+
+    if (NO_ERROR != palError)
+    {
+        pThread->SetLastError(palError);
+    }
+
+    LOGEXIT("PAL_BindIoCompletionCallback returns BOOL %d\n", NO_ERROR == palError);
+    PERF_EXIT(PAL_BindIoCompletionCallback);
+    return NO_ERROR == palError;
+}
@@ -133,6 +133,7 @@ typedef enum
 #define PAL_LEGAL_FLAGS_ATTRIBS (FILE_ATTRIBUTE_NORMAL| \
                                  FILE_FLAG_SEQUENTIAL_SCAN| \
                                  FILE_FLAG_WRITE_THROUGH| \
+                                 FILE_FLAG_OVERLAPPED| \
                                  FILE_FLAG_NO_BUFFERING| \
                                  FILE_FLAG_RANDOM_ACCESS| \
                                  FILE_FLAG_BACKUP_SEMANTICS)
@@ -750,6 +751,7 @@ CorUnix::InternalCreateFile(
     pLocalData->dwDesiredAccess = dwDesiredAccess;
     pLocalData->open_flags = open_flags;
     pLocalData->open_flags_deviceaccessonly = (dwDesiredAccess == 0);
+    pLocalData->overlapped = ((dwFlagsAndAttributes & FILE_FLAG_OVERLAPPED) != 0);
 
     //
     // Transfer the lock controller reference from our local variable
@@ -1880,6 +1882,9 @@ CorUnix::InternalWriteFile(
     IDataLock *pLocalDataLock = NULL;
     IFileTransactionLock *pTransactionLock = NULL;
     int ifd;
+    BOOL fOverlappedHandle = FALSE;
+    PIO_COMPLETION_HANDLER pfnIoCompletion = NULL;
+    PVOID pIoCompletionContext = NULL;
 
     LONG writeOffsetStartLow = 0, writeOffsetStartHigh = 0;
     int res;
@@ -1893,7 +1898,7 @@ CorUnix::InternalWriteFile(
 
         *lpNumberOfBytesWritten = 0;
     }
-    else
+    else if (NULL == lpOverlapped)
     {
         ASSERT( "lpNumberOfBytesWritten is NULL\n" );
         palError = ERROR_INVALID_PARAMETER;
@@ -1906,12 +1911,6 @@ CorUnix::InternalWriteFile(
         palError = ERROR_INVALID_HANDLE;
         goto done;
     }
-    else if ( lpOverlapped )
-    {
-        ASSERT( "lpOverlapped is not NULL, as it should be.\n" );
-        palError = ERROR_INVALID_PARAMETER;
-        goto done;
-    }
 
     palError = g_pObjectManager->ReferenceObjectByHandle(
         pThread,
@@ -1946,6 +1945,9 @@ CorUnix::InternalWriteFile(
     }
 
     ifd = pLocalData->unix_fd;
+    fOverlappedHandle = pLocalData->overlapped;
+    pfnIoCompletion = pLocalData->pfnIoCompletion;
+    pIoCompletionContext = pLocalData->pIoCompletionContext;
 
     //
     // Inform the lock controller for this file (if any) of our intention
@@ -1954,20 +1956,29 @@ CorUnix::InternalWriteFile(
     
     if (NULL != pLocalData->pLockController)
     {
-        /* Get the current file position to calculate the region to lock */
-        palError = InternalSetFilePointerForUnixFd(
-            ifd,
-            0,
-            &writeOffsetStartHigh,
-            FILE_CURRENT,
-            &writeOffsetStartLow
-            );
-
-        if (NO_ERROR != palError)
+        if (NULL != lpOverlapped)
         {
-            ASSERT("Failed to get the current file position\n");
-            palError = ERROR_INTERNAL_ERROR;
-            goto done;
+            /* The region to lock starts at the offset in the OVERLAPPED */
+            writeOffsetStartLow = ((OVERLAPPED *)lpOverlapped)->Offset;
+            writeOffsetStartHigh = ((OVERLAPPED *)lpOverlapped)->OffsetHigh;
+        }
+        else
+        {
+            /* Get the current file position to calculate the region to lock */
+            palError = InternalSetFilePointerForUnixFd(
+                ifd,
+                0,
+                &writeOffsetStartHigh,
+                FILE_CURRENT,
+                &writeOffsetStartLow
+                );
+
+            if (NO_ERROR != palError)
+            {
+                ASSERT("Failed to get the current file position\n");
+                palError = ERROR_INTERNAL_ERROR;
+                goto done;
+            }
         }
 
         palError = pLocalData->pLockController->GetTransactionLock(
@@ -1996,6 +2007,28 @@ CorUnix::InternalWriteFile(
     pLocalDataLock = NULL;
     pLocalData = NULL;
 
+    if (NULL != lpOverlapped)
+    {
+        //
+        // The transaction lock only covers the submission of an
+        // asynchronous write, not its completion
+        //
+
+        palError = InternalOverlappedIO(
+            pThread,
+            ifd,
+            TRUE,
+            const_cast<LPVOID>(lpBuffer),
+            nNumberOfBytesToWrite,
+            lpNumberOfBytesWritten,
+            lpOverlapped,
+            fOverlappedHandle,
+            pfnIoCompletion,
+            pIoCompletionContext
+            );
+        goto done;
+    }
+
 #if WRITE_0_BYTES_HANGS_TTY
     if( nNumberOfBytesToWrite == 0 && isatty(ifd) )
     {
@@ -2043,7 +2076,8 @@ Function:
   WriteFileW
 
 Note:
-  lpOverlapped always NULL.
+  lpOverlapped writes at the offset it specifies; the write is only
+  asynchronous on handles opened with FILE_FLAG_OVERLAPPED.
 
 See MSDN doc.
 --*/
@@ -2101,6 +2135,9 @@ CorUnix::InternalReadFile(
     IDataLock *pLocalDataLock = NULL;
     IFileTransactionLock *pTransactionLock = NULL;
     int ifd;
+    BOOL fOverlappedHandle = FALSE;
+    PIO_COMPLETION_HANDLER pfnIoCompletion = NULL;
+    PVOID pIoCompletionContext = NULL;
     
     LONG readOffsetStartLow = 0, readOffsetStartHigh = 0;
     int res;
@@ -2114,7 +2151,7 @@ CorUnix::InternalReadFile(
 
         *lpNumberOfBytesRead = 0;        
     }
-    else
+    else if (NULL == lpOverlapped)
     {
         ERROR( "lpNumberOfBytesRead is NULL\n" );
         palError = ERROR_INVALID_PARAMETER;
@@ -2127,12 +2164,6 @@ CorUnix::InternalReadFile(
         palError = ERROR_INVALID_HANDLE;
         goto done;
     }
-    else if (NULL != lpOverlapped)
-    {
-        ASSERT( "lpOverlapped is not NULL, as it should be.\n" );
-        palError = ERROR_INVALID_PARAMETER;
-        goto done;
-    }
     else if (NULL == lpBuffer)
     {
         ERROR( "Invalid parameter. (lpBuffer:%p)\n", lpBuffer);
@@ -2173,6 +2204,9 @@ CorUnix::InternalReadFile(
     }
 
     ifd = pLocalData->unix_fd;
+    fOverlappedHandle = pLocalData->overlapped;
+    pfnIoCompletion = pLocalData->pfnIoCompletion;
+    pIoCompletionContext = pLocalData->pIoCompletionContext;
 
     //
     // Inform the lock controller for this file (if any) of our intention
@@ -2181,20 +2215,29 @@ CorUnix::InternalReadFile(
     
     if (NULL != pLocalData->pLockController)
     {
-        /* Get the current file position to calculate the region to lock */
-        palError = InternalSetFilePointerForUnixFd(
-            ifd,
-            0,
-            &readOffsetStartHigh,
-            FILE_CURRENT,
-            &readOffsetStartLow
-            );
-
-        if (NO_ERROR != palError)
+        if (NULL != lpOverlapped)
         {
-            ASSERT("Failed to get the current file position\n");
-            palError = ERROR_INTERNAL_ERROR;
-            goto done;
+            /* The region to lock starts at the offset in the OVERLAPPED */
+            readOffsetStartLow = ((OVERLAPPED *)lpOverlapped)->Offset;
+            readOffsetStartHigh = ((OVERLAPPED *)lpOverlapped)->OffsetHigh;
+        }
+        else
+        {
+            /* Get the current file position to calculate the region to lock */
+            palError = InternalSetFilePointerForUnixFd(
+                ifd,
+                0,
+                &readOffsetStartHigh,
+                FILE_CURRENT,
+                &readOffsetStartLow
+                );
+
+            if (NO_ERROR != palError)
+            {
+                ASSERT("Failed to get the current file position\n");
+                palError = ERROR_INTERNAL_ERROR;
+                goto done;
+            }
         }
 
         palError = pLocalData->pLockController->GetTransactionLock(
@@ -2223,6 +2266,28 @@ CorUnix::InternalReadFile(
     pLocalDataLock = NULL;
     pLocalData = NULL;
 
+    if (NULL != lpOverlapped)
+    {
+        //
+        // The transaction lock only covers the submission of an
+        // asynchronous read, not its completion
+        //
+
+        palError = InternalOverlappedIO(
+            pThread,
+            ifd,
+            FALSE,
+            lpBuffer,
+            nNumberOfBytesToRead,
+            lpNumberOfBytesRead,
+            lpOverlapped,
+            fOverlappedHandle,
+            pfnIoCompletion,
+            pIoCompletionContext
+            );
+        goto done;
+    }
+
 Read:
     TRACE("Reading from file descriptor %d\n", ifd);
     res = read(ifd, lpBuffer, nNumberOfBytesToRead);
@@ -2267,7 +2332,8 @@ Function:
   ReadFile
 
 Note:
-  lpOverlapped always NULL.
+  lpOverlapped reads at the offset it specifies; the read is only
+  asynchronous on handles opened with FILE_FLAG_OVERLAPPED.
 
 See MSDN doc.
 --*/
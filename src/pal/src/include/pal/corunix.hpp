@@ -650,6 +650,20 @@ namespace CorUnix
             void
             ) = 0;
 
+        //
+        // GetNotificationFd returns a descriptor that becomes readable
+        // whenever the object is left signaled. It is owned by the object
+        // and closed when the object is destroyed. Reading it does not
+        // change the state of the object. Objects shared with other
+        // processes return ERROR_NOT_SUPPORTED.
+        //
+
+        virtual
+        PAL_ERROR
+        GetNotificationFd(
+            int *piFd
+            ) = 0;
+
         virtual
         void
         ReleaseController(
@@ -45,6 +45,20 @@ namespace CorUnix
         BOOL fSetEvent
         );
 
+    PAL_ERROR
+    InternalReferenceEvent(
+        CPalThread *pThread,
+        HANDLE hEvent,
+        IPalObject **ppobjEvent
+        );
+
+    PAL_ERROR
+    InternalSetEventObject(
+        CPalThread *pThread,
+        IPalObject *pobjEvent,
+        BOOL fSetEvent
+        );
+
     PAL_ERROR
     InternalOpenEvent(
         CPalThread *pThread,
@@ -46,6 +46,9 @@ namespace CorUnix
         BOOL open_flags_deviceaccessonly;
         char unix_filename[MAXPATHLEN];
         BOOL inheritable;
+        BOOL overlapped;       /* opened with FILE_FLAG_OVERLAPPED */
+        PIO_COMPLETION_HANDLER pfnIoCompletion; /* set by PAL_BindIoCompletionCallback */
+        PVOID pIoCompletionContext;
     };
 
     PAL_ERROR
@@ -81,6 +84,20 @@ namespace CorUnix
         LPOVERLAPPED lpOverlapped
         );
 
+    PAL_ERROR
+    InternalOverlappedIO(
+        CPalThread *pThread,
+        int ifd,
+        BOOL fWrite,
+        LPVOID lpBuffer,
+        DWORD nNumberOfBytes,
+        LPDWORD lpNumberOfBytesTransferred,
+        LPOVERLAPPED lpOverlapped,
+        BOOL fOverlappedHandle,
+        PIO_COMPLETION_HANDLER pfnCompletion,
+        PVOID pCompletionContext
+        );
+
     PAL_ERROR
     InternalSetEndOfFile(
         CPalThread *pThread,
@@ -337,6 +354,27 @@ Return value:
 --*/
 BOOL FILEInitStdHandles(void);
 
+/*++
+FILEInitializeAsyncIO
+
+Initialize the overlapped file I/O support. The io_uring instance itself is
+only created by the first overlapped read or write.
+
+(no parameters, no return value)
+--*/
+void FILEInitializeAsyncIO(void);
+
+/*++
+FILEShutdownAsyncIO
+
+Stops the overlapped I/O completion thread and tears down the io_uring
+instance, if they were created. Overlapped I/O issued afterwards completes
+synchronously.
+
+(no parameters, no return value)
+--*/
+void FILEShutdownAsyncIO(void);
+
 /*++
 FILECleanupStdHandles
 
@@ -54,6 +54,50 @@ FALSE otherwise
 --*/
 BOOL TIMEInitialize( void );
 
+/*++
+Function:
+CGROUPInitialize
+
+Finds the cgroups of the process and reads the CPU and memory limits that
+they impose. Not finding any cgroup is not an error: the process is then
+considered unlimited.
+--*/
+void CGROUPInitialize( void );
+
+/*++
+Function:
+CGROUPGetCpuLimit
+
+Return value:
+The number of CPUs that the CPU quota of the cgroup of the process allows,
+rounded up, or 0 if there is no quota
+--*/
+DWORD CGROUPGetCpuLimit( void );
+
+/*++
+Function:
+CGROUPGetMemoryLimit
+
+Return value:
+The memory limit of the cgroup of the process in bytes, or 0 if there is
+no limit below the physical memory of the machine
+--*/
+ULONGLONG CGROUPGetMemoryLimit( void );
+
+/*++
+Function:
+CGROUPGetMemoryUsage
+
+Reads the memory currently charged against the memory limit: the usage of
+the cgroup that sets the limit, less the inactive file pages of its page
+cache, which are reclaimed before the limit is hit.
+
+Return value:
+TRUE if the usage could be read
+FALSE otherwise
+--*/
+BOOL CGROUPGetMemoryUsage( ULONGLONG *pUsage );
+
 /*++
 Function :
     MsgBoxInitialize
@@ -88,7 +88,7 @@ namespace CorUnix
     {
         pthread_mutex_t     mutex;
         pthread_cond_t      cond;
-        int                 iPred;
+        int                 iPred;          // futex word when HAVE_FUTEX
         DWORD               dwObjectIndex;
         ThreadWakeupReason  twrWakeupReason;
         bool                fInitialized;
@@ -734,7 +734,13 @@ namespace CorUnix
 
     inline CPalThread *GetCurrentPalThread()
     {
-        return reinterpret_cast<CPalThread*>(pthread_getspecific(thObjKey));
+        return t_pCurrentPalThread;
+    }
+
+    inline int SetCurrentPalThread(CPalThread *pThread)
+    {
+        t_pCurrentPalThread = pThread;
+        return pthread_setspecific(thObjKey, pThread);
     }
 
     inline CPalThread *InternalGetCurrentThread()
@@ -58,6 +58,23 @@ namespace CorUnix
 
     extern pthread_key_t thObjKey;
 
+    //
+    // The calling thread's CPalThread is also cached in a __thread
+    // variable, which is much cheaper to read than pthread_getspecific.
+    // thObjKey is still needed for its destructor, which cleans up the
+    // thread when it exits. Both are updated by SetCurrentPalThread.
+    // A single pointer fits in the surplus static TLS that the loader
+    // keeps for libraries that are dlopen'ed with initial-exec variables.
+    //
+
+#if defined(__linux__)
+#define PAL_TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))
+#else
+#define PAL_TLS_INITIAL_EXEC
+#endif
+
+    extern __thread CPalThread *t_pCurrentPalThread PAL_TLS_INITIAL_EXEC;
+
     CPalThread *InternalGetCurrentThread();
 }
 
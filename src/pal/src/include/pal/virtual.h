@@ -27,8 +27,8 @@ extern "C"
 
 typedef struct _CMI {
 
-    struct _CMI * pNext;        /* Link to the next entry. */
-    struct _CMI * pPrevious;    /* Link to the previous entry. */
+    CRITICAL_SECTION regionLock; /* Protects the page state of the region, */
+                                 /* see virtual.cpp for the locking rules. */
 
     UINT_PTR startBoundary;     /* Starting location of the region. */
     SIZE_T   memSize;           /* Size of the entire region.. */
@@ -503,6 +503,9 @@ Initialize(
             goto CLEANUP6;
         }
 
+        /* Read the limits of the cgroups of the process. */
+        CGROUPInitialize();
+
         /* Initialize the File mapping critical section. */
         if (FALSE == MAPInitialize())
         {
@@ -518,6 +521,9 @@ Initialize(
             goto CLEANUP10;
         }
 
+        /* Initialize overlapped file I/O support. */
+        FILEInitializeAsyncIO();
+
         if (flags & PAL_INITIALIZE_STD_HANDLES)
         {
             /* create file objects for standard handles */
@@ -893,6 +899,10 @@ PALCommonCleanup()
     {
         cleanupDone = true;
 
+        // Stop the overlapped I/O completion thread while threads can still
+        // be waited for
+        FILEShutdownAsyncIO();
+
         //
         // Let the synchronization manager know we're about to shutdown
         //
@@ -117,7 +117,7 @@ AllocatePalThread(CPalThread **ppThread)
     palError = CreateThreadObject(pThread, pThread, &hThread);
     if (NO_ERROR != palError)
     {
-        pthread_setspecific(thObjKey, NULL);
+        SetCurrentPalThread(NULL);
         pThread->ReleaseThreadReference();
         goto exit;
     }
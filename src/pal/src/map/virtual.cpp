@@ -35,20 +35,51 @@ Abstract:
 #include <string.h>
 #include <unistd.h>
 #include <limits.h>
+#include <pthread.h>
 
 #if HAVE_VM_ALLOCATE
 #include <mach/vm_map.h>
 #include <mach/mach_init.h>
 #endif // HAVE_VM_ALLOCATE
 
+#if HAVE_PAGEMAP_SCAN
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#include <linux/userfaultfd.h>
+#endif // HAVE_PAGEMAP_SCAN
+
+#if HAVE_MADV_HUGEPAGE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#endif // HAVE_MADV_HUGEPAGE
+
 using namespace CorUnix;
 
 SET_DEFAULT_DEBUG_CHANNEL(VIRTUAL);
 
+// Locking of the region bookkeeping:
+//
+//  - virtual_critsec serializes the operations that add or remove regions
+//    (reserve and release) and the executable memory allocator.
+//  - virtual_index_lock protects the region index. Adding or removing a
+//    region takes it exclusively, while also owning virtual_critsec. Every
+//    other operation only takes it shared to look up its region, so commits,
+//    decommits, protection changes and queries do not serialize on a global
+//    lock.
+//  - The regionLock of each region protects its page state. It is taken
+//    after virtual_index_lock, and a region cannot be released while its
+//    lock is held because releasing needs virtual_index_lock exclusively.
 CRITICAL_SECTION virtual_critsec;
 
-// The first node in our list of allocated blocks.
-static PCMI pVirtualMemory;
+static pthread_rwlock_t virtual_index_lock;
+
+// The regions, sorted by start address, looked up with a binary search.
+static PCMI * pVirtualIndex;
+static SIZE_T nVirtualIndexCount;
+static SIZE_T nVirtualIndexCapacity;
 
 /* We need MAP_ANON. However on some platforms like HP-UX, it is defined as MAP_ANONYMOUS */
 #if !defined(MAP_ANON) && defined(MAP_ANONYMOUS)
@@ -73,6 +104,45 @@ static LPVOID ReserveVirtualMemory(
 // of virtual memory that is located near the CoreCLR library.
 static ExecutableMemoryAllocator g_executableMemoryAllocator;
 
+#if HAVE_PAGEMAP_SCAN
+// Write watching (MEM_WRITE_WATCH) is implemented with asynchronous userfaultfd
+// write protection. Watched regions are registered with the userfaultfd; the
+// kernel resolves a write to a protected page by itself and the page becomes
+// "written". PAGEMAP_SCAN on /proc/self/pagemap reports the written pages of a
+// range and can protect them again in the same call, which gives the atomic get
+// and reset of the Windows GetWriteWatch.
+//
+// Unpopulated pages are reported as written unless they are write protected,
+// which takes a page table entry per page. To keep the page tables in proportion
+// to the committed memory and not to the whole reservation, only committed pages
+// are write protected (when they are committed and when they are reset) and only
+// committed pages are scanned.
+//
+// Soft-dirty bits are not used because they can only be cleared for the whole
+// process, which would lose writes to other watched regions.
+static int s_writeWatchUffd = -1;
+static int s_writeWatchPagemap = -1;
+#endif // HAVE_PAGEMAP_SCAN
+
+static void VIRTUALInitializeWriteWatch( void );
+static void VIRTUALCleanupWriteWatch( void );
+static BOOL VIRTUALIsWriteWatchSupported( void );
+static BOOL VIRTUALWatchWrites( UINT_PTR startBoundary, SIZE_T memSize );
+static BOOL VIRTUALWriteProtect( UINT_PTR startBoundary, SIZE_T memSize );
+static BOOL VIRTUALFindCommittedRun( PCMI pInformation, UINT_PTR *pStart, UINT_PTR end, UINT_PTR *pRunEnd );
+static BOOL VIRTUALWriteProtectCommitted( PCMI pInformation, UINT_PTR startBoundary, SIZE_T memSize );
+
+#if HAVE_MADV_HUGEPAGE
+// Regions reserved with MEM_LARGE_PAGES are aligned to the transparent huge
+// page size, and their pages are advised with MADV_HUGEPAGE when they are
+// committed. Zero if the kernel does not support transparent huge pages, in
+// which case MEM_LARGE_PAGES is ignored and the pages stay small.
+static SIZE_T s_virtualLargePageSize = 0;
+
+static void VIRTUALInitializeLargePages( void );
+static LPVOID VIRTUALReserveLargePageAlignedMemory( CPalThread *pthrCurrent, SIZE_T MemSize );
+#endif // HAVE_MADV_HUGEPAGE
+
 //
 //
 // Virtual Memory Logging
@@ -163,13 +233,28 @@ VIRTUALInitialize(bool initializeExecutableMemoryAllocator)
 
     InternalInitializeCriticalSection(&virtual_critsec);
 
-    pVirtualMemory = NULL;
+    if (pthread_rwlock_init(&virtual_index_lock, NULL) != 0)
+    {
+        ERROR("pthread_rwlock_init() failed! Error(%d)=%s\n", errno, strerror(errno));
+        DeleteCriticalSection(&virtual_critsec);
+        return FALSE;
+    }
+
+    pVirtualIndex = NULL;
+    nVirtualIndexCount = 0;
+    nVirtualIndexCapacity = 0;
 
     if (initializeExecutableMemoryAllocator)
     {
         g_executableMemoryAllocator.Initialize();
     }
 
+    VIRTUALInitializeWriteWatch();
+
+#if HAVE_MADV_HUGEPAGE
+    VIRTUALInitializeLargePages();
+#endif // HAVE_MADV_HUGEPAGE
+
     return TRUE;
 }
 
@@ -183,28 +268,35 @@ extern "C"
 void VIRTUALCleanup()
 {
     PCMI pEntry;
-    PCMI pTempEntry;
+    SIZE_T index;
     CPalThread * pthrCurrent = InternalGetCurrentThread();
 
     InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_wrlock(&virtual_index_lock);
 
     // Clean up the allocated memory.
-    pEntry = pVirtualMemory;
-    while ( pEntry )
+    for ( index = 0; index < nVirtualIndexCount; index++ )
     {
+        pEntry = pVirtualIndex[ index ];
         WARN( "The memory at %d was not freed through a call to VirtualFree.\n",
               pEntry->startBoundary );
         free(pEntry->pAllocState);
         free(pEntry->pProtectionState );
-        pTempEntry = pEntry;
-        pEntry = pEntry->pNext;
-        free(pTempEntry );
+        DeleteCriticalSection(&pEntry->regionLock);
+        free(pEntry );
     }
-    pVirtualMemory = NULL;
+    free(pVirtualIndex);
+    pVirtualIndex = NULL;
+    nVirtualIndexCount = 0;
+    nVirtualIndexCapacity = 0;
 
+    VIRTUALCleanupWriteWatch();
+
+    pthread_rwlock_unlock(&virtual_index_lock);
     InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
 
     TRACE( "Deleting the Virtual Critical Sections. \n" );
+    pthread_rwlock_destroy(&virtual_index_lock);
     DeleteCriticalSection( &virtual_critsec );
 }
 
@@ -457,6 +549,38 @@ static BOOL VIRTUALSetAllocState( UINT nAction, SIZE_T nStartingBit,
                               nNumberOfBits, pInformation->pAllocState);
 }
 
+/****
+ *
+ * VIRTUALFindIndexPosition( )
+ *
+ *          IN UINT_PTR address - The address to look for.
+ *
+ *          Returns the position of the first region that starts after the
+ *          address, the region containing the address is just before it.
+ *          NOTE: The caller must own virtual_index_lock.
+ */
+static SIZE_T VIRTUALFindIndexPosition( IN UINT_PTR address )
+{
+    SIZE_T low = 0;
+    SIZE_T high = nVirtualIndexCount;
+
+    while ( low < high )
+    {
+        SIZE_T middle = low + ( high - low ) / 2;
+
+        if ( pVirtualIndex[ middle ]->startBoundary <= address )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
 /****
  *
  * VIRTUALFindRegionInformation( )
@@ -464,30 +588,27 @@ static BOOL VIRTUALSetAllocState( UINT nAction, SIZE_T nStartingBit,
  *          IN UINT_PTR address - The address to look for.
  *
  *          Returns the PCMI if found, NULL otherwise.
+ *          NOTE: The caller must own virtual_index_lock.
  */
 static PCMI VIRTUALFindRegionInformation( IN UINT_PTR address ) 
 {
     PCMI pEntry = NULL;
+    SIZE_T position;
     
     TRACE( "VIRTUALFindRegionInformation( %#x )\n", address );
 
-    pEntry = pVirtualMemory;
-    
-    while( pEntry )
+    position = VIRTUALFindIndexPosition( address );
+
+    if ( position > 0 )
     {
-        if ( pEntry->startBoundary > address )
+        pEntry = pVirtualIndex[ position - 1 ];
+
+        if ( pEntry->startBoundary + pEntry->memSize <= address )
         {
-            /* Gone past the possible location in the list. */
             pEntry = NULL;
-            break;
         }
-        if ( pEntry->startBoundary + pEntry->memSize > address ) 
-        {
-            break;
-        }
-        
-        pEntry = pEntry->pNext;
     }
+
     return pEntry;
 }
 
@@ -496,13 +617,16 @@ Function :
 
     VIRTUALReleaseMemory
     
-    Removes a PCMI entry from the list.
+    Removes a PCMI entry from the index.
+    NOTE: The caller must own the critical section and virtual_index_lock
+          exclusively.
     
     Returns true on success. FALSE otherwise.
 --*/
 static BOOL VIRTUALReleaseMemory( PCMI pMemoryToBeReleased )
 {
     BOOL bRetVal = TRUE;
+    SIZE_T position;
     
     if ( !pMemoryToBeReleased )
     {
@@ -510,41 +634,63 @@ static BOOL VIRTUALReleaseMemory( PCMI pMemoryToBeReleased )
         return FALSE;
     }
 
-    if ( pMemoryToBeReleased == pVirtualMemory )
-    {
-        /* This is either the first entry, or the only entry. */
-        pVirtualMemory = pMemoryToBeReleased->pNext;
-        if ( pMemoryToBeReleased->pNext )
-        {
-            pMemoryToBeReleased->pNext->pPrevious = NULL;
-        }
-    }
-    else /* Could be anywhere in the list. */
+    position = VIRTUALFindIndexPosition( pMemoryToBeReleased->startBoundary );
+
+    if ( position == 0 || pVirtualIndex[ position - 1 ] != pMemoryToBeReleased )
     {
-        /* Delete the entry from the linked list. */
-        if ( pMemoryToBeReleased->pPrevious )
-        {
-            pMemoryToBeReleased->pPrevious->pNext = pMemoryToBeReleased->pNext;
-        }
-        
-        if ( pMemoryToBeReleased->pNext )
-        {
-            pMemoryToBeReleased->pNext->pPrevious = pMemoryToBeReleased->pPrevious;
-        }
+        ASSERT( "The entry is not in the index.\n" );
+        return FALSE;
     }
 
+    /* Delete the entry from the index. */
+    memmove( &pVirtualIndex[ position - 1 ], &pVirtualIndex[ position ],
+             ( nVirtualIndexCount - position ) * sizeof(PCMI) );
+    nVirtualIndexCount--;
+
     free( pMemoryToBeReleased->pAllocState );
     pMemoryToBeReleased->pAllocState = NULL;
 
     free( pMemoryToBeReleased->pProtectionState );
     pMemoryToBeReleased->pProtectionState = NULL;
 
+    DeleteCriticalSection( &pMemoryToBeReleased->regionLock );
+
     free( pMemoryToBeReleased );
     pMemoryToBeReleased = NULL;
 
     return bRetVal;
 }
 
+/*++
+Function :
+
+    VIRTUALReleaseRegion
+    
+    Unmaps the region starting at the given address and removes it from the
+    index. Used to undo a reservation made by the same call, after the
+    region lock and virtual_index_lock have been released.
+--*/
+static void VIRTUALReleaseRegion( CPalThread *pthrCurrent, UINT_PTR startBoundary )
+{
+    PCMI pInformation;
+
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_wrlock(&virtual_index_lock);
+
+    pInformation = VIRTUALFindRegionInformation( startBoundary );
+    if ( pInformation != NULL )
+    {
+        munmap( (LPVOID)pInformation->startBoundary, pInformation->memSize );
+        if ( VIRTUALReleaseMemory( pInformation ) == FALSE )
+        {
+            ASSERT( "Unable to remove the PCMI entry from the index.\n" );
+        }
+    }
+
+    pthread_rwlock_unlock(&virtual_index_lock);
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+}
+
 /****
  *  VIRTUALConvertWinFlags() - 
  *          Converts win32 protection flags to
@@ -641,11 +787,12 @@ static void VIRTUALDisplayList( void  )
     SIZE_T index;
     CPalThread * pthrCurrent = InternalGetCurrentThread();
 
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_rdlock(&virtual_index_lock);
+
+    for ( count = 0; count < nVirtualIndexCount; count++ ) {
 
-    p = pVirtualMemory;
-    count = 0;
-    while ( p ) {
+        p = pVirtualIndex[ count ];
+        InternalEnterCriticalSection(pthrCurrent, &p->regionLock);
 
         DBGOUT( "Entry %d : \n", count );
         DBGOUT( "\t startBoundary %#x \n", p->startBoundary );
@@ -664,35 +811,33 @@ static void VIRTUALDisplayList( void  )
         DBGOUT( "\n" );
         DBGOUT( "\t accessProtection %d \n", p->accessProtection );
         DBGOUT( "\t allocationType %d \n", p->allocationType );
-        DBGOUT( "\t pNext %p \n", p->pNext );
-        DBGOUT( "\t pLast %p \n", p->pPrevious );
 
-        count++;
-        p = p->pNext;
+        InternalLeaveCriticalSection(pthrCurrent, &p->regionLock);
     }
     
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_unlock(&virtual_index_lock);
 }
 #endif
 
 #ifdef DEBUG
-void VerifyRightEntry(PCMI pEntry)
+void VerifyRightEntry(SIZE_T position)
 {
-    volatile PCMI pRight = pEntry->pNext;
+    PCMI pEntry = pVirtualIndex[position];
     SIZE_T endAddress;
-    if (pRight != nullptr)
+    if (position + 1 < nVirtualIndexCount)
     {
         endAddress = ((SIZE_T)pEntry->startBoundary) + pEntry->memSize;
-        _ASSERTE(endAddress <= (SIZE_T)pRight->startBoundary);
+        _ASSERTE(endAddress <= (SIZE_T)pVirtualIndex[position + 1]->startBoundary);
     }
 }
 
-void VerifyLeftEntry(PCMI pEntry)
+void VerifyLeftEntry(SIZE_T position)
 {
-    volatile PCMI pLeft = pEntry->pPrevious;
+    PCMI pEntry = pVirtualIndex[position];
     SIZE_T endAddress;
-    if (pLeft != NULL)
+    if (position > 0)
     {
+        PCMI pLeft = pVirtualIndex[position - 1];
         endAddress = ((SIZE_T)pLeft->startBoundary) + pLeft->memSize;
         _ASSERTE(endAddress <= (SIZE_T)pEntry->startBoundary);
     }
@@ -702,8 +847,9 @@ void VerifyLeftEntry(PCMI pEntry)
 /****
  *  VIRTUALStoreAllocationInfo()
  *
- *      Stores the allocation information in the linked list.
- *      NOTE: The caller must own the critical section.
+ *      Stores the allocation information in the index.
+ *      NOTE: The caller must own the critical section, virtual_index_lock is
+ *            taken here.
  */
 static BOOL VIRTUALStoreAllocationInfo( 
             IN UINT_PTR startBoundary,  /* Start of the region. */
@@ -712,8 +858,8 @@ static BOOL VIRTUALStoreAllocationInfo(
             IN DWORD flProtection )     /* Protections flags on the memory. */
 {
     PCMI pNewEntry       = nullptr;
-    PCMI pMemInfo        = nullptr;
     SIZE_T nBufferSize   = 0;
+    SIZE_T position      = 0;
 
     if ((memSize & VIRTUAL_PAGE_MASK) != 0)
     {
@@ -765,46 +911,53 @@ static BOOL VIRTUALStoreAllocationInfo(
         return FALSE;
     }
     
-    pMemInfo = pVirtualMemory;
+    pthread_rwlock_wrlock(&virtual_index_lock);
 
-    if (pMemInfo && pMemInfo->startBoundary < startBoundary)
+    if (nVirtualIndexCount == nVirtualIndexCapacity)
     {
-        /* Look for the correct insert point */
-        TRACE("Looking for the correct insert location.\n");
-        while (pMemInfo->pNext && (pMemInfo->pNext->startBoundary < startBoundary))
+        SIZE_T nNewCapacity = (nVirtualIndexCapacity == 0) ? 64 : nVirtualIndexCapacity * 2;
+        PCMI * pNewIndex = (PCMI *)InternalMalloc(nNewCapacity * sizeof(PCMI));
+
+        if (pNewIndex == nullptr)
         {
-            pMemInfo = pMemInfo->pNext;
-        }
+            pthread_rwlock_unlock(&virtual_index_lock);
 
-        pNewEntry->pNext = pMemInfo->pNext;
-        pNewEntry->pPrevious = pMemInfo;
+            ERROR( "Unable to allocate memory for the index.\n");
 
-        if (pNewEntry->pNext)
-        {
-            pNewEntry->pNext->pPrevious = pNewEntry;
-        }
+            free(pNewEntry->pProtectionState);
+            free(pNewEntry->pAllocState);
+            free(pNewEntry);
 
-        pMemInfo->pNext = pNewEntry;
-    }
-    else
-    {
-        /* This is the first entry in the list. */
-        pNewEntry->pNext = pMemInfo;
-        pNewEntry->pPrevious = nullptr;
+            return FALSE;
+        }
 
-        if (pNewEntry->pNext)
+        if (nVirtualIndexCount != 0)
         {
-            pNewEntry->pNext->pPrevious = pNewEntry;
+            memcpy(pNewIndex, pVirtualIndex, nVirtualIndexCount * sizeof(PCMI));
         }
 
-        pVirtualMemory = pNewEntry ;
+        free(pVirtualIndex);
+        pVirtualIndex = pNewIndex;
+        nVirtualIndexCapacity = nNewCapacity;
     }
 
+    InternalInitializeCriticalSection(&pNewEntry->regionLock);
+
+    /* Look for the correct insert point */
+    position = VIRTUALFindIndexPosition(startBoundary);
+
+    memmove(&pVirtualIndex[position + 1], &pVirtualIndex[position],
+            (nVirtualIndexCount - position) * sizeof(PCMI));
+    pVirtualIndex[position] = pNewEntry;
+    nVirtualIndexCount++;
+
 #ifdef DEBUG
-    VerifyRightEntry(pNewEntry);
-    VerifyLeftEntry(pNewEntry);
+    VerifyRightEntry(position);
+    VerifyLeftEntry(position);
 #endif // DEBUG
 
+    pthread_rwlock_unlock(&virtual_index_lock);
+
     return TRUE;
 }
 
@@ -846,6 +999,17 @@ static LPVOID VIRTUALReserveMemory(
         pRetVal = g_executableMemoryAllocator.AllocateMemory(MemSize);
     }
 
+#if HAVE_MADV_HUGEPAGE
+    // Align the region to the huge page size so that its first huge page
+    // is not lost to a misaligned start.
+    if ((pRetVal == NULL) && (lpAddress == NULL) &&
+        ((flAllocationType & MEM_LARGE_PAGES) != 0) &&
+        (s_virtualLargePageSize != 0) && (MemSize >= s_virtualLargePageSize))
+    {
+        pRetVal = VIRTUALReserveLargePageAlignedMemory(pthrCurrent, MemSize);
+    }
+#endif // HAVE_MADV_HUGEPAGE
+
     if (pRetVal == NULL)
     {
         // Try to reserve memory from the OS
@@ -870,6 +1034,17 @@ static LPVOID VIRTUALReserveMemory(
             munmap( pRetVal, MemSize );
             pRetVal = NULL;
         }
+        else if ( ( flAllocationType & MEM_WRITE_WATCH ) != 0 &&
+                  !VIRTUALWatchWrites( StartBoundary, MemSize ) )
+        {
+            ERROR( "Unable to watch writes to the region.\n");
+            pthrCurrent->SetLastError( ERROR_NOT_ENOUGH_MEMORY );
+            pthread_rwlock_wrlock(&virtual_index_lock);
+            VIRTUALReleaseMemory( VIRTUALFindRegionInformation( StartBoundary ) );
+            pthread_rwlock_unlock(&virtual_index_lock);
+            munmap( pRetVal, MemSize );
+            pRetVal = NULL;
+        }
     }
 
     LogVaOperation(
@@ -972,6 +1147,9 @@ static LPVOID ReserveVirtualMemory(
  *      NOTE: I call SetLastError in here, because many different error states
  *              exists, and that would be very complicated to work around.
  *
+ *      NOTE: Takes virtual_index_lock shared and the lock of the region, the
+ *              caller must not own either of them.
+ *
  */
 static LPVOID 
 VIRTUALCommitMemory(
@@ -984,6 +1162,8 @@ VIRTUALCommitMemory(
     UINT_PTR StartBoundary      = 0;
     SIZE_T MemSize              = 0;
     PCMI pInformation           = 0;
+    PCMI pLockedRegion          = NULL;
+    BOOL IsIndexLocked          = FALSE;
     LPVOID pRetVal              = NULL;
     BOOL IsLocallyReserved      = FALSE;
     SIZE_T totalPages;
@@ -1009,13 +1189,21 @@ VIRTUALCommitMemory(
     }
 
     /* See if we have already reserved this memory. */
+    pthread_rwlock_rdlock(&virtual_index_lock);
+    IsIndexLocked = TRUE;
+
     pInformation = VIRTUALFindRegionInformation( StartBoundary );
     
     if ( !pInformation )
     {
         /* According to the new MSDN docs, if MEM_COMMIT is specified,
         and the memory is not reserved, you reserve and then commit.
+        Reserving changes the index, so it cannot be done under the
+        shared lock.
         */
+        pthread_rwlock_unlock(&virtual_index_lock);
+        IsIndexLocked = FALSE;
+
         LPVOID pReservedMemory = 
                 VIRTUALReserveMemory( pthrCurrent, lpAddress, dwSize, 
                                       flAllocationType, flProtect );
@@ -1029,6 +1217,9 @@ VIRTUALCommitMemory(
             MemSize = ( ((UINT_PTR)pReservedMemory + dwSize + VIRTUAL_PAGE_MASK) 
                         & ~VIRTUAL_PAGE_MASK ) - StartBoundary;
             
+            pthread_rwlock_rdlock(&virtual_index_lock);
+            IsIndexLocked = TRUE;
+
             pInformation = VIRTUALFindRegionInformation( StartBoundary );
 
             if ( !pInformation )
@@ -1048,6 +1239,9 @@ VIRTUALCommitMemory(
             goto done;
         }
     }
+
+    InternalEnterCriticalSection(pthrCurrent, &pInformation->regionLock);
+    pLockedRegion = pInformation;
                
     TRACE( "Committing the memory now..\n");
     
@@ -1109,6 +1303,26 @@ VIRTUALCommitMemory(
 
             VIRTUALSetAllocState(MEM_COMMIT, runStart, runLength, pInformation);
 
+            // Newly committed pages are not written yet
+            if ((pInformation->allocationType & MEM_WRITE_WATCH) != 0 &&
+                !VIRTUALWriteProtect(StartBoundary, MemSize))
+            {
+                goto error;
+            }
+
+#if HAVE_MADV_HUGEPAGE
+            // The advice is lost when the pages are decommitted, since that
+            // maps them again, so it is given on every commit. Failing only
+            // means that the pages stay small.
+            if ((pInformation->allocationType & MEM_LARGE_PAGES) != 0 &&
+                s_virtualLargePageSize != 0 &&
+                madvise((void *) StartBoundary, MemSize, MADV_HUGEPAGE) != 0)
+            {
+                WARN("madvise(MADV_HUGEPAGE) failed! Error(%d)=%s\n",
+                     errno, strerror(errno));
+            }
+#endif // HAVE_MADV_HUGEPAGE
+
             if (nProtect == (PROT_WRITE | PROT_READ))
             {
                 // Handle this case specially so we don't bother
@@ -1148,20 +1362,30 @@ VIRTUALCommitMemory(
 error:
     if ( flAllocationType & MEM_RESERVE || IsLocallyReserved )
     {
-        munmap( pRetVal, MemSize );
-        if ( VIRTUALReleaseMemory( pInformation ) == FALSE )
-        {
-            ASSERT( "Unable to remove the PCMI entry from the list.\n" );
-            pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
-            pRetVal = NULL;
-            goto done;
-        }
+        /* The region was reserved by this call, nobody else can be using it. */
+        UINT_PTR RegionStart = pInformation->startBoundary;
+
+        InternalLeaveCriticalSection(pthrCurrent, &pLockedRegion->regionLock);
+        pLockedRegion = NULL;
+        pthread_rwlock_unlock(&virtual_index_lock);
+        IsIndexLocked = FALSE;
+
+        VIRTUALReleaseRegion( pthrCurrent, RegionStart );
         pInformation = NULL;
         pRetVal = NULL;
     }
 
 done:
 
+    if ( pLockedRegion != NULL )
+    {
+        InternalLeaveCriticalSection(pthrCurrent, &pLockedRegion->regionLock);
+    }
+    if ( IsIndexLocked )
+    {
+        pthread_rwlock_unlock(&virtual_index_lock);
+    }
+
     LogVaOperation(
         VirtualMemoryLogging::VirtualOperation::Commit,
         lpAddress,
@@ -1179,7 +1403,9 @@ Function:
   VirtualAlloc
 
 Note:
-  MEM_TOP_DOWN, MEM_PHYSICAL, MEM_WRITE_WATCH are not supported.
+  MEM_TOP_DOWN, MEM_PHYSICAL are not supported.
+  MEM_WRITE_WATCH is only supported when the kernel provides asynchronous
+  userfaultfd write protection and PAGEMAP_SCAN.
   Unsupported flags are ignored.
   
   Page size on i386 is set to 4k.
@@ -1205,15 +1431,19 @@ VirtualAlloc(
 
     if ( ( flAllocationType & MEM_WRITE_WATCH )  != 0 )
     {
-        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
-        goto done;
+        /* Write watching is set up when the region is reserved, and needs kernel support. */
+        if ( ( flAllocationType & MEM_RESERVE ) == 0 || !VIRTUALIsWriteWatchSupported() )
+        {
+            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+            goto done;
+        }
     }
 
     /* Test for un-supported flags. */
-    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE ) ) != 0 )
+    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_WRITE_WATCH | MEM_LARGE_PAGES | MEM_RESERVE_EXECUTABLE ) ) != 0 )
     {
         ASSERT( "flAllocationType can be one, or any combination of MEM_COMMIT, \
-               MEM_RESERVE, MEM_TOP_DOWN, or MEM_RESERVE_EXECUTABLE.\n" );
+               MEM_RESERVE, MEM_TOP_DOWN, MEM_WRITE_WATCH, MEM_LARGE_PAGES, or MEM_RESERVE_EXECUTABLE.\n" );
         pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
         goto done;
     }
@@ -1254,7 +1484,7 @@ VirtualAlloc(
 
     if ( flAllocationType & MEM_COMMIT )
     {
-        InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+        /* VIRTUALCommitMemory only locks the region it commits in. */
         if ( pRetVal != NULL )
         {
             /* We are reserving and committing. */
@@ -1267,7 +1497,6 @@ VirtualAlloc(
             pRetVal = VIRTUALCommitMemory( pthrCurrent, lpAddress, dwSize, 
                                     flAllocationType, flProtect );
         }
-        InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
     }                      
     
 done:
@@ -1295,13 +1524,15 @@ VirtualFree(
 {
     BOOL bRetVal = TRUE;
     CPalThread *pthrCurrent;
+    BOOL IsCritsecHeld = FALSE;
+    BOOL IsIndexLocked = FALSE;
+    PCMI pLockedRegion = NULL;
 
     PERF_ENTRY(VirtualFree);
     ENTRY("VirtualFree(lpAddress=%p, dwSize=%u, dwFreeType=%#x)\n",
           lpAddress, dwSize, dwFreeType);
 
     pthrCurrent = InternalGetCurrentThread();
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
 
     /* Sanity Checks. */
     if ( !lpAddress )
@@ -1351,6 +1582,10 @@ VirtualFree(
 
         StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
 
+        /* Decommitting only changes the page state of the region. */
+        pthread_rwlock_rdlock(&virtual_index_lock);
+        IsIndexLocked = TRUE;
+
         PCMI pUnCommittedMem;
         pUnCommittedMem = VIRTUALFindRegionInformation( StartBoundary );
         if (!pUnCommittedMem)
@@ -1361,6 +1596,9 @@ VirtualFree(
             goto VirtualFreeExit;
         }
 
+        InternalEnterCriticalSection(pthrCurrent, &pUnCommittedMem->regionLock);
+        pLockedRegion = pUnCommittedMem;
+
         TRACE( "Un-committing the following page(s) %d to %d.\n", 
                StartBoundary, MemSize );
 
@@ -1391,6 +1629,15 @@ VirtualFree(
             VIRTUALSetAllocState( MEM_RESERVE, index, 
                                   nNumOfPagesToChange, pUnCommittedMem );
 
+            /* The new mapping is not registered for write watching anymore. */
+            if ( ( pUnCommittedMem->allocationType & MEM_WRITE_WATCH ) != 0 &&
+                 !VIRTUALWatchWrites( StartBoundary, MemSize ) )
+            {
+                ASSERT( "Unable to watch writes to the decommitted pages.\n" );
+                pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+                bRetVal = FALSE;
+            }
+
             goto VirtualFreeExit;
         }
         else
@@ -1404,6 +1651,12 @@ VirtualFree(
     
     if ( dwFreeType & MEM_RELEASE )
     {
+        /* Releasing removes the region from the index. */
+        InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+        IsCritsecHeld = TRUE;
+        pthread_rwlock_wrlock(&virtual_index_lock);
+        IsIndexLocked = TRUE;
+
         PCMI pMemoryToBeReleased = 
             VIRTUALFindRegionInformation( (UINT_PTR)lpAddress );
         
@@ -1458,7 +1711,18 @@ VirtualFreeExit:
         NULL,
         bRetVal);
 
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    if ( pLockedRegion != NULL )
+    {
+        InternalLeaveCriticalSection(pthrCurrent, &pLockedRegion->regionLock);
+    }
+    if ( IsIndexLocked )
+    {
+        pthread_rwlock_unlock(&virtual_index_lock);
+    }
+    if ( IsCritsecHeld )
+    {
+        InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    }
     LOGEXIT( "VirtualFree returning %s.\n", bRetVal == TRUE ? "TRUE" : "FALSE" );
     PERF_EXIT(VirtualFree);
     return bRetVal;
@@ -1494,7 +1758,7 @@ VirtualProtect(
           lpAddress, dwSize, flNewProtect, lpflOldProtect);
 
     pthrCurrent = InternalGetCurrentThread();
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_rdlock(&virtual_index_lock);
     
     StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
     MemSize = (((UINT_PTR)(dwSize) + ((UINT_PTR)(lpAddress) & VIRTUAL_PAGE_MASK)
@@ -1519,6 +1783,8 @@ VirtualProtect(
     pEntry = VIRTUALFindRegionInformation( StartBoundary );
     if ( NULL != pEntry )
     {
+        InternalEnterCriticalSection(pthrCurrent, &pEntry->regionLock);
+
         /* See if the pages are committed. */
         Index = OffSet = StartBoundary - pEntry->startBoundary == 0 ?
              0 : ( StartBoundary - pEntry->startBoundary ) / VIRTUAL_PAGE_SIZE;
@@ -1577,7 +1843,11 @@ VirtualProtect(
         }
     }
 ExitVirtualProtect:
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    if ( pEntry != NULL )
+    {
+        InternalLeaveCriticalSection(pthrCurrent, &pEntry->regionLock);
+    }
+    pthread_rwlock_unlock(&virtual_index_lock);
 
 #if defined _DEBUG
     VIRTUALDisplayList();
@@ -1750,7 +2020,7 @@ VirtualQuery(
           lpAddress, lpBuffer, dwLength);
 
     pthrCurrent = InternalGetCurrentThread();
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_rdlock(&virtual_index_lock);
 
     if ( !lpBuffer)
     {
@@ -1817,6 +2087,8 @@ VirtualQuery(
     }
     else
     {
+        InternalEnterCriticalSection(pthrCurrent, &pEntry->regionLock);
+
         /* Starting page. */
         SIZE_T Index = ( StartBoundary - pEntry->startBoundary ) / VIRTUAL_PAGE_SIZE;
 
@@ -1849,21 +2121,461 @@ VirtualQuery(
         lpBuffer->State =
             ( AllocationType == MEM_COMMIT ? MEM_COMMIT : MEM_RESERVE );
         WARN( "Ignoring lpBuffer->Type. \n" );
+
+        InternalLeaveCriticalSection(pthrCurrent, &pEntry->regionLock);
     }
 
 ExitVirtualQuery:
 
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_unlock(&virtual_index_lock);
     
     LOGEXIT( "VirtualQuery returning %d.\n", sizeof( *lpBuffer ) );
     PERF_EXIT(VirtualQuery);
     return sizeof( *lpBuffer );
 }
 
+/*++
+Function:
+  PAL_GetLargePageUsage
+
+Returns how much of the memory reserved with MEM_LARGE_PAGES is resident,
+and how much of that is backed by transparent huge pages, from the Rss and
+AnonHugePages of the mappings in /proc/self/smaps that start in such a
+region. Both are zero when transparent huge pages are not supported.
+
+--*/
+BOOL
+PALAPI
+PAL_GetLargePageUsage(
+    OUT PAL_LARGE_PAGE_USAGE *lpUsage)
+{
+    BOOL fRetVal = FALSE;
+#if HAVE_MADV_HUGEPAGE
+    FILE *smapsFile = NULL;
+    char *line = NULL;
+    size_t lineLen = 0;
+    BOOL fInRegion = FALSE;
+    PCMI pInformation;
+    UINT_PTR vmaStart;
+    UINT_PTR vmaEnd;
+#endif // HAVE_MADV_HUGEPAGE
+
+    PERF_ENTRY(PAL_GetLargePageUsage);
+    ENTRY("PAL_GetLargePageUsage (lpUsage=%p)\n", lpUsage);
+
+    if (lpUsage == NULL)
+    {
+        ERROR("lpUsage is NULL\n");
+        InternalGetCurrentThread()->SetLastError(ERROR_INVALID_PARAMETER);
+        goto done;
+    }
+
+    lpUsage->ullResidentSize = 0;
+    lpUsage->ullHugePageSize = 0;
+
+#if HAVE_MADV_HUGEPAGE
+    if (s_virtualLargePageSize != 0)
+    {
+        smapsFile = fopen("/proc/self/smaps", "r");
+        if (smapsFile == NULL)
+        {
+            ERROR("Unable to open /proc/self/smaps, errno is %d (%s).\n", errno, strerror(errno));
+            InternalGetCurrentThread()->SetLastError(ERROR_ACCESS_DENIED);
+            goto done;
+        }
+
+        while (getline(&line, &lineLen, smapsFile) != -1)
+        {
+            // A mapping starts with its address range, followed by one
+            // "Key: value kB" line for each of its statistics
+            if (sscanf(line, "%zx-%zx ", &vmaStart, &vmaEnd) == 2)
+            {
+                pthread_rwlock_rdlock(&virtual_index_lock);
+                pInformation = VIRTUALFindRegionInformation(vmaStart);
+                fInRegion = (pInformation != NULL) &&
+                            ((pInformation->allocationType & MEM_LARGE_PAGES) != 0);
+                pthread_rwlock_unlock(&virtual_index_lock);
+            }
+            else if (fInRegion && strncmp(line, "Rss:", 4) == 0)
+            {
+                lpUsage->ullResidentSize += strtoull(line + 4, NULL, 10) * 1024;
+            }
+            else if (fInRegion && strncmp(line, "AnonHugePages:", 14) == 0)
+            {
+                lpUsage->ullHugePageSize += strtoull(line + 14, NULL, 10) * 1024;
+            }
+        }
+
+        free(line); // We didn't allocate line, but as per contract of getline we should free it
+        fclose(smapsFile);
+    }
+#endif // HAVE_MADV_HUGEPAGE
+
+    fRetVal = TRUE;
+
+done:
+    LOGEXIT("PAL_GetLargePageUsage returns %d\n", fRetVal);
+    PERF_EXIT(PAL_GetLargePageUsage);
+    return fRetVal;
+}
+
+#if HAVE_MADV_HUGEPAGE
+/*++
+Function:
+    VIRTUALInitializeLargePages()
+
+    Reads the transparent huge page size. THP is left off when it is disabled
+    system wide, since MADV_HUGEPAGE would then have no effect.
+
+--*/
+static void VIRTUALInitializeLargePages( void )
+{
+    char buffer[32];
+    ssize_t cbRead;
+    int fd;
+    SIZE_T largePageSize;
+
+    s_virtualLargePageSize = 0;
+
+    fd = open("/sys/kernel/mm/transparent_hugepage/enabled", O_RDONLY);
+    if (fd == -1)
+    {
+        TRACE("Transparent huge pages are not supported\n");
+        return;
+    }
+    cbRead = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (cbRead <= 0)
+    {
+        return;
+    }
+    buffer[cbRead] = '\0';
+
+    // The active setting is the one in brackets
+    if (strstr(buffer, "[never]") != NULL)
+    {
+        TRACE("Transparent huge pages are disabled\n");
+        return;
+    }
+
+    // Kernels that do not export the size only support PMD sized huge pages
+    // on 4K pages
+    largePageSize = 0x200000;
+
+    fd = open("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", O_RDONLY);
+    if (fd != -1)
+    {
+        cbRead = read(fd, buffer, sizeof(buffer) - 1);
+        close(fd);
+        if (cbRead > 0)
+        {
+            buffer[cbRead] = '\0';
+            largePageSize = (SIZE_T)strtoull(buffer, NULL, 10);
+        }
+    }
+    else if (VIRTUAL_PAGE_SIZE != 0x1000)
+    {
+        return;
+    }
+
+    if (largePageSize <= VIRTUAL_PAGE_SIZE ||
+        (largePageSize & (largePageSize - 1)) != 0)
+    {
+        WARN("Unexpected huge page size %zu\n", largePageSize);
+        return;
+    }
+
+    s_virtualLargePageSize = largePageSize;
+}
+
+/*++
+Function:
+    VIRTUALReserveLargePageAlignedMemory()
+
+    Reserves MemSize bytes at an address aligned to the huge page size by
+    reserving an extra huge page and unmapping what lies outside the aligned
+    range. Returns NULL, without setting the last error, if that fails; the
+    caller then reserves the memory normally.
+
+--*/
+static LPVOID VIRTUALReserveLargePageAlignedMemory(
+                IN CPalThread *pthrCurrent, /* Currently executing thread */
+                IN SIZE_T MemSize)          /* Size of Region */
+{
+    SIZE_T reserveSize = MemSize + s_virtualLargePageSize;
+    UINT_PTR reserveStart;
+    UINT_PTR alignedStart;
+    UINT_PTR alignedEnd;
+
+    if (reserveSize < MemSize)
+    {
+        return NULL;
+    }
+
+    reserveStart = (UINT_PTR)mmap(NULL, reserveSize, PROT_NONE,
+                                  MAP_ANON | MAP_PRIVATE, -1, 0);
+    if ((LPVOID)reserveStart == MAP_FAILED)
+    {
+        TRACE("Unable to reserve %zu bytes for a huge page aligned region\n", reserveSize);
+        return NULL;
+    }
+
+    alignedStart = (reserveStart + s_virtualLargePageSize - 1) & ~(s_virtualLargePageSize - 1);
+    alignedEnd = alignedStart + MemSize;
+
+    if (alignedStart != reserveStart)
+    {
+        munmap((LPVOID)reserveStart, alignedStart - reserveStart);
+    }
+    if (alignedEnd != reserveStart + reserveSize)
+    {
+        munmap((LPVOID)alignedEnd, reserveStart + reserveSize - alignedEnd);
+    }
+
+#if MMAP_ANON_IGNORES_PROTECTION
+    if (mprotect((LPVOID)alignedStart, MemSize, PROT_NONE) != 0)
+    {
+        ERROR("mprotect failed to protect the region!\n");
+        munmap((LPVOID)alignedStart, MemSize);
+        return NULL;
+    }
+#endif  // MMAP_ANON_IGNORES_PROTECTION
+
+    return (LPVOID)alignedStart;
+}
+#endif // HAVE_MADV_HUGEPAGE
+
+/****
+ *
+ *  VIRTUALInitializeWriteWatch()
+ *      Opens the userfaultfd used for write watching, if the kernel supports it.
+ *
+ */
+static void VIRTUALInitializeWriteWatch( void )
+{
+#if HAVE_PAGEMAP_SCAN
+    int flags = O_CLOEXEC | O_NONBLOCK;
+#ifdef UFFD_USER_MODE_ONLY
+    /* Faults are never delivered to us, so do not require the privilege for kernel mode faults. */
+    flags |= UFFD_USER_MODE_ONLY;
+#endif // UFFD_USER_MODE_ONLY
+
+    int uffd = syscall( __NR_userfaultfd, flags );
+    if ( uffd == -1 )
+    {
+        TRACE( "userfaultfd is not available, errno is %d (%s).\n", errno, strerror(errno) );
+        return;
+    }
+
+    struct uffdio_api api;
+    memset( &api, 0, sizeof(api) );
+    api.api = UFFD_API;
+    api.features = UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_UNPOPULATED;
+
+    if ( ioctl( uffd, UFFDIO_API, &api ) != 0 ||
+         ( api.features & ( UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_UNPOPULATED ) ) !=
+            ( UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_UNPOPULATED ) )
+    {
+        TRACE( "Asynchronous userfaultfd write protection is not available.\n" );
+        close( uffd );
+        return;
+    }
+
+    int pagemap = open( "/proc/self/pagemap", O_RDONLY | O_CLOEXEC );
+    if ( pagemap == -1 )
+    {
+        TRACE( "Unable to open /proc/self/pagemap, errno is %d (%s).\n", errno, strerror(errno) );
+        close( uffd );
+        return;
+    }
+
+    s_writeWatchUffd = uffd;
+    s_writeWatchPagemap = pagemap;
+#endif // HAVE_PAGEMAP_SCAN
+}
+
+/****
+ *
+ *  VIRTUALCleanupWriteWatch()
+ *      Closes the descriptors used for write watching.
+ *
+ */
+static void VIRTUALCleanupWriteWatch( void )
+{
+#if HAVE_PAGEMAP_SCAN
+    if ( s_writeWatchPagemap != -1 )
+    {
+        close( s_writeWatchPagemap );
+        s_writeWatchPagemap = -1;
+    }
+    if ( s_writeWatchUffd != -1 )
+    {
+        close( s_writeWatchUffd );
+        s_writeWatchUffd = -1;
+    }
+#endif // HAVE_PAGEMAP_SCAN
+}
+
+/****
+ *
+ *  VIRTUALIsWriteWatchSupported()
+ *      Returns TRUE if regions can be reserved with MEM_WRITE_WATCH.
+ *
+ */
+static BOOL VIRTUALIsWriteWatchSupported( void )
+{
+#if HAVE_PAGEMAP_SCAN
+    return s_writeWatchUffd != -1;
+#else // HAVE_PAGEMAP_SCAN
+    return FALSE;
+#endif // HAVE_PAGEMAP_SCAN
+}
+
+/****
+ *
+ *  VIRTUALWatchWrites()
+ *      Registers a mapping for write watching. Its pages are write protected
+ *      when they are committed.
+ *
+ *      NOTE: The caller must own the critical section or the region lock.
+ */
+static BOOL VIRTUALWatchWrites( UINT_PTR startBoundary, SIZE_T memSize )
+{
+#if HAVE_PAGEMAP_SCAN
+    struct uffdio_register reg;
+    memset( &reg, 0, sizeof(reg) );
+    reg.range.start = startBoundary;
+    reg.range.len = memSize;
+    reg.mode = UFFDIO_REGISTER_MODE_WP;
+
+    if ( ioctl( s_writeWatchUffd, UFFDIO_REGISTER, &reg ) != 0 )
+    {
+        ERROR( "UFFDIO_REGISTER failed, errno is %d (%s).\n", errno, strerror(errno) );
+        return FALSE;
+    }
+
+    return TRUE;
+#else // HAVE_PAGEMAP_SCAN
+    return FALSE;
+#endif // HAVE_PAGEMAP_SCAN
+}
+
+/****
+ *
+ *  VIRTUALWriteProtect()
+ *      Write protects a range of a watched region, so that its pages are not
+ *      reported as written until they are written to again.
+ *
+ *      NOTE: The caller must own the region lock.
+ */
+static BOOL VIRTUALWriteProtect( UINT_PTR startBoundary, SIZE_T memSize )
+{
+#if HAVE_PAGEMAP_SCAN
+    struct uffdio_writeprotect wp;
+    memset( &wp, 0, sizeof(wp) );
+    wp.range.start = startBoundary;
+    wp.range.len = memSize;
+    wp.mode = UFFDIO_WRITEPROTECT_MODE_WP;
+
+    if ( ioctl( s_writeWatchUffd, UFFDIO_WRITEPROTECT, &wp ) != 0 )
+    {
+        ERROR( "UFFDIO_WRITEPROTECT failed, errno is %d (%s).\n", errno, strerror(errno) );
+        return FALSE;
+    }
+
+    return TRUE;
+#else // HAVE_PAGEMAP_SCAN
+    return FALSE;
+#endif // HAVE_PAGEMAP_SCAN
+}
+
+/****
+ *
+ *  VIRTUALFindCommittedRun()
+ *      Finds the first run of committed pages of a region in [*pStart, end).
+ *      On success *pStart and *pRunEnd are set to the bounds of the run.
+ *
+ *      NOTE: The caller must own the region lock.
+ */
+static BOOL VIRTUALFindCommittedRun( PCMI pInformation, UINT_PTR *pStart, UINT_PTR end, UINT_PTR *pRunEnd )
+{
+    SIZE_T index = ( *pStart - pInformation->startBoundary ) / VIRTUAL_PAGE_SIZE;
+    SIZE_T endIndex = ( end - pInformation->startBoundary ) / VIRTUAL_PAGE_SIZE;
+
+    while ( index < endIndex && !VIRTUALIsPageCommitted( index, pInformation ) )
+    {
+        index++;
+    }
+    if ( index == endIndex )
+    {
+        return FALSE;
+    }
+
+    *pStart = pInformation->startBoundary + index * VIRTUAL_PAGE_SIZE;
+
+    while ( index < endIndex && VIRTUALIsPageCommitted( index, pInformation ) )
+    {
+        index++;
+    }
+
+    *pRunEnd = pInformation->startBoundary + index * VIRTUAL_PAGE_SIZE;
+    return TRUE;
+}
+
+/****
+ *
+ *  VIRTUALWriteProtectCommitted()
+ *      Write protects the committed pages of a range of a watched region.
+ *
+ *      NOTE: The caller must own the region lock.
+ */
+static BOOL VIRTUALWriteProtectCommitted( PCMI pInformation, UINT_PTR startBoundary, SIZE_T memSize )
+{
+    UINT_PTR end = startBoundary + memSize;
+    UINT_PTR runEnd;
+
+    while ( VIRTUALFindCommittedRun( pInformation, &startBoundary, end, &runEnd ) )
+    {
+        if ( !VIRTUALWriteProtect( startBoundary, runEnd - startBoundary ) )
+        {
+            return FALSE;
+        }
+        startBoundary = runEnd;
+    }
+
+    return TRUE;
+}
+
+/****
+ *
+ *  VIRTUALFindWriteWatchRegion()
+ *      Returns the region reserved with MEM_WRITE_WATCH that contains the whole
+ *      range, NULL otherwise.
+ *
+ *      NOTE: The caller must own virtual_index_lock.
+ */
+static PCMI VIRTUALFindWriteWatchRegion( UINT_PTR startBoundary, SIZE_T memSize )
+{
+    PCMI pInformation = VIRTUALFindRegionInformation( startBoundary );
+
+    if ( pInformation == NULL ||
+         ( pInformation->allocationType & MEM_WRITE_WATCH ) == 0 ||
+         memSize > pInformation->startBoundary + pInformation->memSize - startBoundary )
+    {
+        return NULL;
+    }
+
+    return pInformation;
+}
+
 /*++
 Function:
   GetWriteWatch
 
+Note:
+  Pages are reported at the granularity of VIRTUAL_PAGE_SIZE. When lpAddresses
+  fills up, only the reported pages are reset.
+
 See MSDN doc.
 --*/
 UINT 
@@ -1877,11 +2589,135 @@ GetWriteWatch(
   OUT PULONG lpdwGranularity
 )
 {
-    // TODO: implement this method
-    *lpAddresses = NULL;
-    *lpdwCount = 0;
-    // Until it is implemented, return non-zero value as an indicator of failure
-    return 1;
+    UINT uRetVal = 1;
+    CPalThread *pthrCurrent;
+
+    PERF_ENTRY(GetWriteWatch);
+    ENTRY("GetWriteWatch(dwFlags=%#x, lpBaseAddress=%p, dwRegionSize=%u, lpAddresses=%p, "
+          "lpdwCount=%p, lpdwGranularity=%p)\n", dwFlags, lpBaseAddress, dwRegionSize,
+          lpAddresses, lpdwCount, lpdwGranularity);
+
+    pthrCurrent = InternalGetCurrentThread();
+
+#if HAVE_PAGEMAP_SCAN
+    if ( ( dwFlags & ~WRITE_WATCH_FLAG_RESET ) != 0 || lpAddresses == NULL || lpdwCount == NULL ||
+         lpdwGranularity == NULL || !VIRTUALIsWriteWatchSupported() )
+    {
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        goto done;
+    }
+
+    {
+        UINT_PTR StartBoundary = (UINT_PTR)lpBaseAddress & ~VIRTUAL_PAGE_MASK;
+        UINT_PTR EndBoundary = ((UINT_PTR)lpBaseAddress + dwRegionSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK;
+
+        /* The kernel reports whole OS pages, which can be bigger than VIRTUAL_PAGE_SIZE. */
+        SIZE_T nPagesPerOsPage = max( (SIZE_T)getpagesize() / VIRTUAL_PAGE_SIZE, (SIZE_T)1 );
+
+        ULONG_PTR nCapacity = *lpdwCount;
+        ULONG_PTR nCount = 0;
+
+        const int MaxRegions = 64;
+        struct page_region regions[MaxRegions];
+
+        PCMI pInformation;
+
+        pthread_rwlock_rdlock(&virtual_index_lock);
+
+        pInformation = VIRTUALFindWriteWatchRegion( StartBoundary, EndBoundary - StartBoundary );
+        if ( pInformation == NULL )
+        {
+            ERROR( "The range was not reserved with MEM_WRITE_WATCH.\n" );
+            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+            pthread_rwlock_unlock(&virtual_index_lock);
+            goto done;
+        }
+
+        /* Keeps decommit from mapping over the range while it is scanned. */
+        InternalEnterCriticalSection(pthrCurrent, &pInformation->regionLock);
+
+        uRetVal = 0;
+
+        /* Uncommitted pages are not write protected and would all be reported. */
+        UINT_PTR RunEnd = StartBoundary;
+        while ( nCapacity - nCount >= nPagesPerOsPage )
+        {
+            if ( StartBoundary >= RunEnd )
+            {
+                if ( !VIRTUALFindCommittedRun( pInformation, &StartBoundary, EndBoundary, &RunEnd ) )
+                {
+                    break;
+                }
+            }
+
+            struct pm_scan_arg arg;
+            memset( &arg, 0, sizeof(arg) );
+            arg.size = sizeof(arg);
+            arg.flags = PM_SCAN_CHECK_WPASYNC;
+            if ( ( dwFlags & WRITE_WATCH_FLAG_RESET ) != 0 )
+            {
+                /* Write protect the pages that are reported, in the same walk. */
+                arg.flags |= PM_SCAN_WP_MATCHING;
+            }
+            arg.start = StartBoundary;
+            arg.end = RunEnd;
+            arg.vec = (UINT_PTR)regions;
+            arg.vec_len = MaxRegions;
+            arg.max_pages = ( nCapacity - nCount ) / nPagesPerOsPage;
+            arg.category_mask = PAGE_IS_WRITTEN;
+            arg.return_mask = PAGE_IS_WRITTEN;
+
+            int nRegions = ioctl( s_writeWatchPagemap, PAGEMAP_SCAN, &arg );
+            if ( nRegions < 0 )
+            {
+                ERROR( "PAGEMAP_SCAN failed, errno is %d (%s).\n", errno, strerror(errno) );
+                pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+                uRetVal = 1;
+                break;
+            }
+
+            for ( int i = 0; i < nRegions; i++ )
+            {
+                for ( UINT_PTR page = regions[i].start; page < regions[i].end; page += VIRTUAL_PAGE_SIZE )
+                {
+                    _ASSERTE( nCount < nCapacity );
+                    lpAddresses[nCount++] = (PVOID)page;
+                }
+            }
+
+            if ( arg.walk_end <= StartBoundary )
+            {
+                break;
+            }
+            StartBoundary = arg.walk_end;
+        }
+
+        InternalLeaveCriticalSection(pthrCurrent, &pInformation->regionLock);
+        pthread_rwlock_unlock(&virtual_index_lock);
+
+        if ( uRetVal == 0 )
+        {
+            *lpdwCount = nCount;
+            *lpdwGranularity = VIRTUAL_PAGE_SIZE;
+        }
+    }
+
+done:
+#else // HAVE_PAGEMAP_SCAN
+    if ( lpAddresses != NULL )
+    {
+        *lpAddresses = NULL;
+    }
+    if ( lpdwCount != NULL )
+    {
+        *lpdwCount = 0;
+    }
+    pthrCurrent->SetLastError( ERROR_NOT_SUPPORTED );
+#endif // HAVE_PAGEMAP_SCAN
+
+    LOGEXIT("GetWriteWatch returning %u\n", uRetVal);
+    PERF_EXIT(GetWriteWatch);
+    return uRetVal;
 }
 
 /*++
@@ -1897,9 +2733,58 @@ ResetWriteWatch(
   IN SIZE_T dwRegionSize
 )
 {
-    // TODO: implement this method
-    // Until it is implemented, return non-zero value as an indicator of failure
-    return 1;
+    UINT uRetVal = 1;
+    CPalThread *pthrCurrent;
+
+    PERF_ENTRY(ResetWriteWatch);
+    ENTRY("ResetWriteWatch(lpBaseAddress=%p, dwRegionSize=%u)\n", lpBaseAddress, dwRegionSize);
+
+    pthrCurrent = InternalGetCurrentThread();
+
+#if HAVE_PAGEMAP_SCAN
+    if ( VIRTUALIsWriteWatchSupported() )
+    {
+        UINT_PTR StartBoundary = (UINT_PTR)lpBaseAddress & ~VIRTUAL_PAGE_MASK;
+        SIZE_T MemSize = (((UINT_PTR)lpBaseAddress + dwRegionSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK) -
+                         StartBoundary;
+
+        PCMI pInformation;
+
+        pthread_rwlock_rdlock(&virtual_index_lock);
+
+        pInformation = VIRTUALFindWriteWatchRegion( StartBoundary, MemSize );
+        if ( pInformation == NULL )
+        {
+            ERROR( "The range was not reserved with MEM_WRITE_WATCH.\n" );
+            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        }
+        else
+        {
+            InternalEnterCriticalSection(pthrCurrent, &pInformation->regionLock);
+
+            if ( VIRTUALWriteProtectCommitted( pInformation, StartBoundary, MemSize ) )
+            {
+                uRetVal = 0;
+            }
+            else
+            {
+                pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+            }
+
+            InternalLeaveCriticalSection(pthrCurrent, &pInformation->regionLock);
+        }
+
+        pthread_rwlock_unlock(&virtual_index_lock);
+    }
+    else
+#endif // HAVE_PAGEMAP_SCAN
+    {
+        pthrCurrent->SetLastError( ERROR_NOT_SUPPORTED );
+    }
+
+    LOGEXIT("ResetWriteWatch returning %u\n", uRetVal);
+    PERF_EXIT(ResetWriteWatch);
+    return uRetVal;
 }
 
 /*++
@@ -0,0 +1,762 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*++
+
+
+
+Module Name:
+
+    cgroup.cpp
+
+Abstract:
+
+    Reads the CPU and memory limits that the cgroups of the process impose,
+    for both cgroup v1 and v2 hierarchies, so that GetSystemInfo and
+    GlobalMemoryStatusEx report the resources that a process running in a
+    container can actually use.
+
+
+
+--*/
+
+#include "pal/palinternal.h"
+#include "pal/dbgmsg.h"
+#include "pal/misc.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+SET_DEFAULT_DEBUG_CHANNEL(MISC);
+
+// Limits found by CGROUPInitialize; zero means that there is no limit
+static DWORD s_cgroupVersion = 0;
+static DWORD s_cgroupCpuLimit = 0;
+static DWORD s_cgroupCpuWeight = 0;
+static ULONGLONG s_cgroupMemoryLimit = 0;
+
+// Directory of the memory cgroup whose usage is charged against the memory
+// limit, empty if there is none. This is the cgroup of the process or the
+// ancestor that sets the limit.
+static DWORD s_memoryCGroupVersion = 0;
+static char s_memoryCGroupDirectory[PATH_MAX];
+
+#ifdef __linux__
+
+#define CGROUP_MAX_FIELDS 32
+
+/*++
+Function:
+    CGROUPSplitFields
+
+    Splits a line into fields separated by spaces, in place, and strips the
+    trailing new line. Returns the number of fields found, at most maxFields.
+--*/
+static int CGROUPSplitFields(char *line, char **fields, int maxFields)
+{
+    int count = 0;
+    char *current = line;
+
+    while (count < maxFields)
+    {
+        while (*current == ' ')
+        {
+            current++;
+        }
+        if (*current == '\0' || *current == '\n')
+        {
+            break;
+        }
+
+        fields[count++] = current;
+        while (*current != ' ' && *current != '\0' && *current != '\n')
+        {
+            current++;
+        }
+        if (*current == '\0')
+        {
+            break;
+        }
+        *current++ = '\0';
+    }
+
+    return count;
+}
+
+/*++
+Function:
+    CGROUPHasOption
+
+    Returns TRUE if the comma separated list contains the option.
+--*/
+static BOOL CGROUPHasOption(LPCSTR list, LPCSTR option)
+{
+    size_t optionLength = strlen(option);
+    LPCSTR current = list;
+
+    while (current != NULL)
+    {
+        if (strncmp(current, option, optionLength) == 0 &&
+            (current[optionLength] == ',' || current[optionLength] == '\0' || current[optionLength] == '\n'))
+        {
+            return TRUE;
+        }
+
+        current = strchr(current, ',');
+        if (current != NULL)
+        {
+            current++;
+        }
+    }
+
+    return FALSE;
+}
+
+/*++
+Function:
+    CGROUPFindMount
+
+    Finds where the cgroup hierarchy of the given controller is mounted by
+    scanning /proc/self/mountinfo. A cgroup v1 hierarchy lists its
+    controllers in its super options; when there is none for the controller,
+    the unified cgroup v2 hierarchy is used.
+
+    mountPoint receives the mount point and mountRoot the path within the
+    hierarchy of the cgroup that is mounted there; both are PATH_MAX long.
+    Returns the cgroup version of the hierarchy, or 0 if none was found.
+--*/
+static DWORD CGROUPFindMount(LPCSTR controller, LPSTR mountPoint, LPSTR mountRoot)
+{
+    FILE *mountInfoFile;
+    char *line = NULL;
+    size_t lineLen = 0;
+    DWORD version = 0;
+
+    mountInfoFile = fopen("/proc/self/mountinfo", "r");
+    if (mountInfoFile == NULL)
+    {
+        TRACE("Unable to open /proc/self/mountinfo (%d)\n", errno);
+        return 0;
+    }
+
+    while (getline(&line, &lineLen, mountInfoFile) != -1)
+    {
+        char *fields[CGROUP_MAX_FIELDS];
+        int fieldCount;
+        int separator;
+        DWORD lineVersion;
+
+        // <id> <parent id> <major:minor> <root> <mount point> <options>
+        // [<optional fields>...] - <fs type> <source> <super options>
+        fieldCount = CGROUPSplitFields(line, fields, CGROUP_MAX_FIELDS);
+        for (separator = 6; separator < fieldCount; separator++)
+        {
+            if (strcmp(fields[separator], "-") == 0)
+            {
+                break;
+            }
+        }
+        if (separator + 3 >= fieldCount)
+        {
+            continue;
+        }
+
+        if (strcmp(fields[separator + 1], "cgroup") == 0 &&
+            CGROUPHasOption(fields[separator + 3], controller))
+        {
+            lineVersion = 1;
+        }
+        else if (strcmp(fields[separator + 1], "cgroup2") == 0 && version == 0)
+        {
+            lineVersion = 2;
+        }
+        else
+        {
+            continue;
+        }
+
+        if (strlen(fields[3]) >= PATH_MAX || strlen(fields[4]) >= PATH_MAX)
+        {
+            continue;
+        }
+        strcpy_s(mountRoot, PATH_MAX, fields[3]);
+        strcpy_s(mountPoint, PATH_MAX, fields[4]);
+        version = lineVersion;
+
+        if (version == 1)
+        {
+            // A v1 hierarchy takes precedence over the unified one
+            break;
+        }
+    }
+
+    free(line); // We didn't allocate line, but as per contract of getline we should free it
+    fclose(mountInfoFile);
+
+    return version;
+}
+
+/*++
+Function:
+    CGROUPFindCGroupPath
+
+    Finds the path of the cgroup of the process within the hierarchy of the
+    given controller by scanning /proc/self/cgroup. cgroupPath is PATH_MAX
+    long.
+--*/
+static BOOL CGROUPFindCGroupPath(DWORD version, LPCSTR controller, LPSTR cgroupPath)
+{
+    FILE *cgroupFile;
+    char *line = NULL;
+    size_t lineLen = 0;
+    BOOL fFound = FALSE;
+
+    cgroupFile = fopen("/proc/self/cgroup", "r");
+    if (cgroupFile == NULL)
+    {
+        TRACE("Unable to open /proc/self/cgroup (%d)\n", errno);
+        return FALSE;
+    }
+
+    while (getline(&line, &lineLen, cgroupFile) != -1)
+    {
+        char *controllers;
+        char *path;
+        char *newLine;
+
+        // <hierarchy id>:<controllers>:<path>; the unified hierarchy has
+        // the id 0 and no controllers
+        controllers = strchr(line, ':');
+        if (controllers == NULL)
+        {
+            continue;
+        }
+        *controllers++ = '\0';
+
+        path = strchr(controllers, ':');
+        if (path == NULL)
+        {
+            continue;
+        }
+        *path++ = '\0';
+
+        newLine = strchr(path, '\n');
+        if (newLine != NULL)
+        {
+            *newLine = '\0';
+        }
+
+        if (version == 1 ?
+            CGROUPHasOption(controllers, controller) :
+            (strcmp(line, "0") == 0 && controllers[0] == '\0'))
+        {
+            if (strlen(path) < PATH_MAX)
+            {
+                strcpy_s(cgroupPath, PATH_MAX, path);
+                fFound = TRUE;
+            }
+            break;
+        }
+    }
+
+    free(line); // We didn't allocate line, but as per contract of getline we should free it
+    fclose(cgroupFile);
+
+    return fFound;
+}
+
+/*++
+Function:
+    CGROUPFindDirectory
+
+    Finds the directory of the cgroup of the process for the given
+    controller. directory is PATH_MAX long; pMountPointLength receives the
+    length of its prefix that is the mount point of the hierarchy.
+--*/
+static BOOL CGROUPFindDirectory(LPCSTR controller, DWORD *pVersion, LPSTR directory, size_t *pMountPointLength)
+{
+    char mountPoint[PATH_MAX];
+    char mountRoot[PATH_MAX];
+    char cgroupPath[PATH_MAX];
+    LPCSTR relativePath;
+    DWORD version;
+
+    version = CGROUPFindMount(controller, mountPoint, mountRoot);
+    if (version == 0)
+    {
+        return FALSE;
+    }
+
+    if (!CGROUPFindCGroupPath(version, controller, cgroupPath))
+    {
+        return FALSE;
+    }
+
+    // Only the part of the hierarchy below mountRoot is visible at the mount
+    // point, e.g. when a container without its own cgroup namespace has the
+    // cgroup of the container mounted
+    relativePath = cgroupPath;
+    if (strcmp(mountRoot, "/") != 0)
+    {
+        size_t rootLength = strlen(mountRoot);
+        if (strncmp(cgroupPath, mountRoot, rootLength) != 0)
+        {
+            TRACE("cgroup %s is not below the mounted %s\n", cgroupPath, mountRoot);
+            return FALSE;
+        }
+        relativePath += rootLength;
+    }
+
+    if (snprintf(directory, PATH_MAX, "%s%s", mountPoint, relativePath) >= PATH_MAX)
+    {
+        return FALSE;
+    }
+
+    TRACE("cgroup v%u %s controller directory is %s\n", version, controller, directory);
+    *pVersion = version;
+    *pMountPointLength = strlen(mountPoint);
+    return TRUE;
+}
+
+/*++
+Function:
+    CGROUPParentDirectory
+
+    Replaces a cgroup directory with the directory of its parent cgroup.
+    Returns FALSE, leaving the directory unchanged, when it is the mount
+    point, since the cgroups above it are not visible.
+--*/
+static BOOL CGROUPParentDirectory(LPSTR directory, size_t mountPointLength)
+{
+    char *lastSeparator;
+
+    if (strlen(directory) <= mountPointLength)
+    {
+        return FALSE;
+    }
+
+    lastSeparator = strrchr(directory, '/');
+    if (lastSeparator == NULL || (size_t)(lastSeparator - directory) < mountPointLength)
+    {
+        return FALSE;
+    }
+    *lastSeparator = '\0';
+
+    return TRUE;
+}
+
+/*++
+Function:
+    CGROUPReadFile
+
+    Reads the start of a file of a cgroup directory as a string.
+--*/
+static BOOL CGROUPReadFile(LPCSTR directory, LPCSTR fileName, LPSTR buffer, size_t bufferSize)
+{
+    char path[PATH_MAX];
+    ssize_t cbRead;
+    int fd;
+
+    if (snprintf(path, sizeof(path), "%s/%s", directory, fileName) >= (int)sizeof(path))
+    {
+        return FALSE;
+    }
+
+    fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        return FALSE;
+    }
+    cbRead = read(fd, buffer, bufferSize - 1);
+    close(fd);
+    if (cbRead <= 0)
+    {
+        return FALSE;
+    }
+    buffer[cbRead] = '\0';
+
+    return TRUE;
+}
+
+/*++
+Function:
+    CGROUPParseUInt64
+
+    Parses a number at the start of a string. Returns FALSE for "max" (no
+    limit in cgroup v2) and negative numbers (no limit in cgroup v1).
+--*/
+static BOOL CGROUPParseUInt64(LPCSTR string, LPCSTR *pEnd, ULONGLONG *pValue)
+{
+    ULONGLONG value;
+    char *end;
+
+    if (*string < '0' || *string > '9')
+    {
+        return FALSE;
+    }
+
+    errno = 0;
+    value = strtoull(string, &end, 10);
+    if (errno != 0)
+    {
+        return FALSE;
+    }
+
+    *pValue = value;
+    if (pEnd != NULL)
+    {
+        *pEnd = end;
+    }
+    return TRUE;
+}
+
+static BOOL CGROUPReadUInt64(LPCSTR directory, LPCSTR fileName, ULONGLONG *pValue)
+{
+    char buffer[64];
+
+    if (!CGROUPReadFile(directory, fileName, buffer, sizeof(buffer)))
+    {
+        return FALSE;
+    }
+
+    return CGROUPParseUInt64(buffer, NULL, pValue);
+}
+
+/*++
+Function:
+    CGROUPReadStat
+
+    Reads the value of a key of a "<key> <value>" per line stat file of a
+    cgroup directory, such as memory.stat.
+--*/
+static BOOL CGROUPReadStat(LPCSTR directory, LPCSTR fileName, LPCSTR key, ULONGLONG *pValue)
+{
+    char path[PATH_MAX];
+    FILE *statFile;
+    char *line = NULL;
+    size_t lineLen = 0;
+    size_t keyLength = strlen(key);
+    BOOL fFound = FALSE;
+
+    if (snprintf(path, sizeof(path), "%s/%s", directory, fileName) >= (int)sizeof(path))
+    {
+        return FALSE;
+    }
+
+    statFile = fopen(path, "r");
+    if (statFile == NULL)
+    {
+        return FALSE;
+    }
+
+    while (getline(&line, &lineLen, statFile) != -1)
+    {
+        if (strncmp(line, key, keyLength) == 0 && line[keyLength] == ' ')
+        {
+            fFound = CGROUPParseUInt64(line + keyLength + 1, NULL, pValue);
+            break;
+        }
+    }
+
+    free(line); // We didn't allocate line, but as per contract of getline we should free it
+    fclose(statFile);
+
+    return fFound;
+}
+
+/*++
+Function:
+    CGROUPReadCpuQuota
+
+    Reads the CPU quota of a cgroup directory. The quota allows the cgroup
+    to run quota microseconds every period microseconds.
+--*/
+static BOOL CGROUPReadCpuQuota(DWORD version, LPCSTR directory, ULONGLONG *pQuota, ULONGLONG *pPeriod)
+{
+    char buffer[64];
+    LPCSTR end;
+
+    if (version == 1)
+    {
+        return CGROUPReadUInt64(directory, "cpu.cfs_quota_us", pQuota) &&
+               CGROUPReadUInt64(directory, "cpu.cfs_period_us", pPeriod);
+    }
+
+    // cpu.max holds "<quota> <period>", where the quota is "max" when the
+    // cgroup is not limited
+    return CGROUPReadFile(directory, "cpu.max", buffer, sizeof(buffer)) &&
+           CGROUPParseUInt64(buffer, &end, pQuota) &&
+           *end == ' ' &&
+           CGROUPParseUInt64(end + 1, NULL, pPeriod);
+}
+
+/*++
+Function:
+    CGROUPInitializeCpu
+
+    Reads the CPU quota and weight of the cgroup of the process. The quota
+    of a cgroup also bounds all the cgroups below it, so the limit is the
+    smallest quota / period of the cgroup and its ancestors, rounded up to
+    whole CPUs.
+--*/
+static void CGROUPInitializeCpu(void)
+{
+    char directory[PATH_MAX];
+    size_t mountPointLength;
+    ULONGLONG cpuLimit = 0;
+    ULONGLONG weight;
+    DWORD version;
+
+    if (!CGROUPFindDirectory("cpu", &version, directory, &mountPointLength))
+    {
+        return;
+    }
+
+    if (CGROUPReadUInt64(directory, version == 1 ? "cpu.shares" : "cpu.weight", &weight))
+    {
+        s_cgroupCpuWeight = (DWORD)weight;
+    }
+
+    do
+    {
+        ULONGLONG quota;
+        ULONGLONG period;
+
+        if (CGROUPReadCpuQuota(version, directory, &quota, &period) && quota != 0 && period != 0)
+        {
+            ULONGLONG directoryLimit = (quota + period - 1) / period;
+            TRACE("cgroup %s CPU quota %llu per %llu us\n", directory, quota, period);
+            if (cpuLimit == 0 || directoryLimit < cpuLimit)
+            {
+                cpuLimit = directoryLimit;
+            }
+        }
+    }
+    while (CGROUPParentDirectory(directory, mountPointLength));
+
+    if (cpuLimit != 0)
+    {
+        s_cgroupCpuLimit = cpuLimit > MAXDWORD ? MAXDWORD : (DWORD)cpuLimit;
+        TRACE("cgroup CPU limit %u CPUs\n", s_cgroupCpuLimit);
+    }
+
+    s_cgroupVersion = version;
+}
+
+/*++
+Function:
+    CGROUPInitializeMemory
+
+    Reads the memory limit of the cgroup of the process, which is the
+    smallest limit of the cgroup and its ancestors, and remembers the
+    directory of the cgroup that sets it, whose usage counts against it.
+    cgroup v1 reports the limit of the ancestors as hierarchical_memory_limit
+    in memory.stat, while cgroup v2 requires reading memory.max of each of
+    them. When the v1 limit is set above the visible part of the hierarchy,
+    the usage comes from the highest visible cgroup.
+--*/
+static void CGROUPInitializeMemory(void)
+{
+    char directory[PATH_MAX];
+    size_t mountPointLength;
+    ULONGLONG limit;
+    ULONGLONG memoryLimit = 0;
+    ULONGLONG physicalMemory;
+    DWORD version;
+
+    if (!CGROUPFindDirectory("memory", &version, directory, &mountPointLength))
+    {
+        s_memoryCGroupDirectory[0] = '\0';
+        return;
+    }
+    s_memoryCGroupVersion = version;
+    strcpy_s(s_memoryCGroupDirectory, sizeof(s_memoryCGroupDirectory), directory);
+
+    // cgroup v1 reports a huge number rather than no limit, so only a limit
+    // below the physical memory counts
+    physicalMemory = (ULONGLONG)sysconf(_SC_PHYS_PAGES) * (ULONGLONG)sysconf(_SC_PAGE_SIZE);
+
+    if (version == 1)
+    {
+        if (CGROUPReadUInt64(directory, "memory.limit_in_bytes", &limit) &&
+            limit != 0 && limit < physicalMemory)
+        {
+            memoryLimit = limit;
+        }
+        if (CGROUPReadStat(directory, "memory.stat", "hierarchical_memory_limit", &limit) &&
+            limit != 0 && limit < physicalMemory && (memoryLimit == 0 || limit < memoryLimit))
+        {
+            memoryLimit = limit;
+        }
+
+        if (memoryLimit != 0)
+        {
+            // Find the cgroup that sets the limit, or the highest visible one
+            // when an ancestor above the mount point sets it
+            while (!(CGROUPReadUInt64(directory, "memory.limit_in_bytes", &limit) && limit == memoryLimit))
+            {
+                if (!CGROUPParentDirectory(directory, mountPointLength))
+                {
+                    break;
+                }
+            }
+            strcpy_s(s_memoryCGroupDirectory, sizeof(s_memoryCGroupDirectory), directory);
+        }
+    }
+    else
+    {
+        do
+        {
+            if (CGROUPReadUInt64(directory, "memory.max", &limit) && limit != 0)
+            {
+                TRACE("cgroup %s memory.max %llu bytes\n", directory, limit);
+                if (memoryLimit == 0 || limit < memoryLimit)
+                {
+                    memoryLimit = limit;
+                    strcpy_s(s_memoryCGroupDirectory, sizeof(s_memoryCGroupDirectory), directory);
+                }
+            }
+        }
+        while (CGROUPParentDirectory(directory, mountPointLength));
+    }
+    TRACE("cgroup memory usage directory is %s\n", s_memoryCGroupDirectory);
+
+    if (memoryLimit != 0 && memoryLimit < physicalMemory)
+    {
+        s_cgroupMemoryLimit = memoryLimit;
+        TRACE("cgroup memory limit %llu bytes\n", memoryLimit);
+    }
+
+    if (s_cgroupVersion == 0)
+    {
+        s_cgroupVersion = version;
+    }
+}
+
+#endif // __linux__
+
+/*++
+Function:
+    CGROUPInitialize
+
+See misc.h
+--*/
+void CGROUPInitialize(void)
+{
+#ifdef __linux__
+    CGROUPInitializeCpu();
+    CGROUPInitializeMemory();
+#endif // __linux__
+}
+
+/*++
+Function:
+    CGROUPGetCpuLimit
+
+See misc.h
+--*/
+DWORD CGROUPGetCpuLimit(void)
+{
+    return s_cgroupCpuLimit;
+}
+
+/*++
+Function:
+    CGROUPGetMemoryLimit
+
+See misc.h
+--*/
+ULONGLONG CGROUPGetMemoryLimit(void)
+{
+    return s_cgroupMemoryLimit;
+}
+
+/*++
+Function:
+    CGROUPGetMemoryUsage
+
+See misc.h
+--*/
+BOOL CGROUPGetMemoryUsage(ULONGLONG *pUsage)
+{
+#ifdef __linux__
+    ULONGLONG usage;
+    ULONGLONG inactiveFile;
+
+    if (s_memoryCGroupDirectory[0] == '\0')
+    {
+        return FALSE;
+    }
+
+    if (!CGROUPReadUInt64(s_memoryCGroupDirectory,
+                          s_memoryCGroupVersion == 1 ? "memory.usage_in_bytes" : "memory.current",
+                          &usage))
+    {
+        return FALSE;
+    }
+
+    // The usage includes the page cache. Its inactive file pages are
+    // reclaimed before the cgroup runs out of memory, so they do not count.
+    if (CGROUPReadStat(s_memoryCGroupDirectory, "memory.stat",
+                       s_memoryCGroupVersion == 1 ? "total_inactive_file" : "inactive_file",
+                       &inactiveFile) &&
+        inactiveFile < usage)
+    {
+        usage -= inactiveFile;
+    }
+
+    *pUsage = usage;
+    return TRUE;
+#else // __linux__
+    return FALSE;
+#endif // __linux__
+}
+
+/*++
+Function:
+  PAL_GetCGroupLimits
+
+Returns the cgroup limits that the PAL applies to the number of processors
+and the amount of physical memory it reports, and the memory currently
+charged to the memory cgroup of the process. Fields are zero when there is
+no limit or the value is not known.
+
+--*/
+BOOL
+PALAPI
+PAL_GetCGroupLimits(
+    OUT PAL_CGROUP_LIMITS *lpLimits)
+{
+    BOOL fRetVal = FALSE;
+
+    PERF_ENTRY(PAL_GetCGroupLimits);
+    ENTRY("PAL_GetCGroupLimits (lpLimits=%p)\n", lpLimits);
+
+    if (lpLimits == NULL)
+    {
+        ERROR("lpLimits is NULL\n");
+        SetLastError(ERROR_INVALID_PARAMETER);
+        goto done;
+    }
+
+    lpLimits->dwVersion = s_cgroupVersion;
+    lpLimits->dwCpuLimit = s_cgroupCpuLimit;
+    lpLimits->dwCpuWeight = s_cgroupCpuWeight;
+    lpLimits->ullMemoryLimit = s_cgroupMemoryLimit;
+    if (!CGROUPGetMemoryUsage(&lpLimits->ullMemoryUsage))
+    {
+        lpLimits->ullMemoryUsage = 0;
+    }
+    fRetVal = TRUE;
+
+done:
+    LOGEXIT("PAL_GetCGroupLimits returns %d\n", fRetVal);
+    PERF_EXIT(PAL_GetCGroupLimits);
+    return fRetVal;
+}
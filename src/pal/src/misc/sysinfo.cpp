@@ -72,6 +72,7 @@ Revision History:
 #endif
 
 #include "pal/dbgmsg.h"
+#include "pal/misc.h"
 
 
 SET_DEFAULT_DEBUG_CHANNEL(MISC);
@@ -122,6 +123,7 @@ GetSystemInfo(
           OUT LPSYSTEM_INFO lpSystemInfo)
 {
     int nrcpus = 0;
+    DWORD cpuLimit;
     long pagesize;
 
     PERF_ENTRY(GetSystemInfo);
@@ -166,6 +168,14 @@ GetSystemInfo(
     }
 #endif // HAVE_SYSCONF
 
+    // A CPU quota keeps the process from using more processors than it allows
+    cpuLimit = CGROUPGetCpuLimit();
+    if (cpuLimit != 0 && cpuLimit < (DWORD)nrcpus)
+    {
+        TRACE("Limiting the number of processors to the cgroup CPU quota (%u)\n", cpuLimit);
+        nrcpus = cpuLimit;
+    }
+
     TRACE("dwNumberOfProcessors=%d\n", nrcpus);
     lpSystemInfo->dwNumberOfProcessors = nrcpus;
 
@@ -232,6 +242,7 @@ GlobalMemoryStatusEx(
     lpBuffer->ullAvailExtendedVirtual = 0;
 
     BOOL fRetVal = FALSE;
+    ULONGLONG memoryLimit;
 
     // Get the physical memory size
 #if HAVE_SYSCONF && HAVE__SC_PHYS_PAGES
@@ -294,6 +305,25 @@ GlobalMemoryStatusEx(
 #endif // __APPLE__
     }
 
+    // Report the memory of the cgroup of the process when it is limited, so
+    // that the memory load reflects how close the process is to the limit
+    memoryLimit = CGROUPGetMemoryLimit();
+    if (memoryLimit != 0 && memoryLimit < lpBuffer->ullTotalPhys)
+    {
+        ULONGLONG memoryUsage;
+
+        lpBuffer->ullTotalPhys = memoryLimit;
+        if (CGROUPGetMemoryUsage(&memoryUsage))
+        {
+            lpBuffer->ullAvailPhys = memoryUsage < memoryLimit ? memoryLimit - memoryUsage : 0;
+            lpBuffer->dwMemoryLoad = memoryUsage < memoryLimit ? (DWORD)((memoryUsage * 100) / memoryLimit) : 100;
+        }
+        else if (lpBuffer->ullAvailPhys > memoryLimit)
+        {
+            lpBuffer->ullAvailPhys = memoryLimit;
+        }
+    }
+
     // There is no API to get the total virtual address space size on 
     // Unix, so we use a constant value representing 128TB, which is 
     // the approximate size of total user virtual address space on
@@ -337,6 +367,12 @@ PAL_GetLogicalCpuCountFromOS()
     numLogicalCores = sysconf(_SC_NPROCESSORS_ONLN);
 #endif
 
+    DWORD cpuLimit = CGROUPGetCpuLimit();
+    if (cpuLimit != 0 && cpuLimit < numLogicalCores)
+    {
+        numLogicalCores = cpuLimit;
+    }
+
     return numLogicalCores;
 }
 
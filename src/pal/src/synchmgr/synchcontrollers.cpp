@@ -30,6 +30,10 @@ SET_DEFAULT_DEBUG_CHANNEL(SYNC); // some headers have code with asserts, so do t
 #include <sched.h>
 #include <errno.h>
 #include <limits.h>
+#include <string.h>
+#if HAVE_EPOLL
+#include <sys/eventfd.h>
+#endif // HAVE_EPOLL
 
 namespace CorUnix
 {
@@ -737,6 +741,31 @@ namespace CorUnix
         return palErr;
     }
     
+    /*++
+    Method:
+      CSynchStateController::GetNotificationFd
+
+    Returns the descriptor that becomes readable whenever the target
+    object is left signaled
+    --*/
+    PAL_ERROR CSynchStateController::GetNotificationFd(int *piFd)
+    {
+        VALIDATEOBJECT(m_psdSynchData);
+
+        _ASSERTE(InternalGetCurrentThread() == m_pthrOwner);
+        _ASSERTE(NULL != piFd);
+
+        if (SharedObject == m_psdSynchData->GetObjectDomain())
+        {
+            // Other processes could not write to the descriptor
+            ERROR("Notification descriptors are not supported for shared "
+                  "objects\n");
+            return ERROR_NOT_SUPPORTED;
+        }
+
+        return m_psdSynchData->GetNotificationFd(piFd);
+    }
+
     /*++
     Method:
       CSynchStateController::ReleaseController
@@ -824,6 +853,12 @@ namespace CorUnix
                   lStatContentionCount);
 #endif // SYNCH_STATISTICS       
 
+            if (-1 != m_iNotificationFd)
+            {
+                close(m_iNotificationFd);
+                m_iNotificationFd = -1;
+            }
+
             if (fSharedObject)
             {
                 pSynchManager->CacheAddSharedSynchData(pthrCurrent, m_shridThis);
@@ -837,6 +872,81 @@ namespace CorUnix
         return lCount;
     }
 
+    /*++
+    Method:
+      CSynchData::GetNotificationFd
+
+    Returns the eventfd that is made readable whenever the object is left
+    signaled, creating it on first use. If the object is signaled at the
+    time of the call, the descriptor is made readable right away, so that
+    a wait set starting to watch the object does not miss its current
+    state.
+
+    Note: this method must be called while holding the local process
+          synch lock.
+    --*/
+    PAL_ERROR CSynchData::GetNotificationFd(int * piFd)
+    {
+        VALIDATEOBJECT(this);
+
+        _ASSERTE(ProcessLocalObject == m_odObjectDomain);
+
+#if HAVE_EPOLL
+        if (-1 == m_iNotificationFd)
+        {
+            m_iNotificationFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (-1 == m_iNotificationFd)
+            {
+                ERROR("eventfd failed with errno %d (%s)\n", errno, strerror(errno));
+                return (EMFILE == errno || ENFILE == errno) ?
+                    ERROR_TOO_MANY_OPEN_FILES : ERROR_NOT_ENOUGH_MEMORY;
+            }
+
+            TRACE("Created notification descriptor %d for SynchData @ %p\n",
+                  m_iNotificationFd, this);
+        }
+
+        if (m_lSignalCount > 0)
+        {
+            NotifySignaled();
+        }
+
+        *piFd = m_iNotificationFd;
+        return NO_ERROR;
+#else // HAVE_EPOLL
+        return ERROR_NOT_SUPPORTED;
+#endif // HAVE_EPOLL
+    }
+
+    /*++
+    Method:
+      CSynchData::NotifySignaled
+
+    Makes the notification descriptor of the object readable, waking up
+    the wait sets watching it.
+
+    Note: this method must be called while holding the local process
+          synch lock.
+    --*/
+    void CSynchData::NotifySignaled(void)
+    {
+        UINT64 ui64One = 1;
+        ssize_t sszWritten;
+
+        _ASSERTE(-1 != m_iNotificationFd);
+
+        do
+        {
+            sszWritten = write(m_iNotificationFd, &ui64One, sizeof(ui64One));
+        } while (-1 == sszWritten && EINTR == errno);
+
+        // EAGAIN means that the counter is saturated, i.e. the descriptor
+        // is readable already
+        _ASSERT_MSG(sizeof(ui64One) == sszWritten || EAGAIN == errno,
+                    "Failed to write notification descriptor %d [errno=%d]\n",
+                    m_iNotificationFd, errno);
+    }
+
     /*++
     Method:
       CSynchData::ReleaseWaiterWithoutBlocking
@@ -1042,6 +1152,13 @@ namespace CorUnix
                 m_lSignalCount = 0;
             }                    
         }
+
+        if (m_lSignalCount > 0 && -1 != m_iNotificationFd)
+        {
+            // Waiting threads could not take the whole signal count:
+            // let the wait sets watching the object know
+            NotifySignaled();
+        }
         
         _ASSERT_MSG(CObjectType::OwnershipTracked != 
                     GetObjectType()->GetOwnershipSemantics() || 
@@ -38,6 +38,10 @@ SET_DEFAULT_DEBUG_CHANNEL(SYNC); // some headers have code with asserts, so do t
 #else
 #include "pal/fakepoll.h"
 #endif // HAVE_POLL
+#if HAVE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif // HAVE_FUTEX
 
 // We use the synchronization manager's worker thread to handle
 // process termination requests. It does so by calling the
@@ -434,6 +438,73 @@ namespace CorUnix
         return palErr;
     }
 
+#if HAVE_FUTEX
+    PAL_ERROR CPalSynchronizationManager::ThreadNativeWait(
+        ThreadNativeWaitData * ptnwdNativeWaitData,
+        DWORD dwTimeout,
+        ThreadWakeupReason * ptwrWakeupReason,
+        DWORD * pdwSignaledObject)
+    {
+        PAL_ERROR palErr = NO_ERROR;
+        struct timespec tsAbsTmo;
+        long lRet;
+
+        TRACE("ThreadNativeWait(ptnwdNativeWaitData=%p, dwTimeout=%u, ...)\n",
+              ptnwdNativeWaitData, dwTimeout);
+
+        if (dwTimeout != INFINITE)
+        {
+            // Calculate absolute timeout
+            palErr = GetAbsoluteTimeout(dwTimeout, &tsAbsTmo);
+            if (NO_ERROR != palErr)
+            {
+                ERROR("Failed to convert timeout to absolute timeout\n");
+                goto TNW_exit;
+            }
+        }
+
+        // The predicate is the futex word: SignalThreadCondition sets it
+        // and wakes this thread, and the wait consumes it by resetting it.
+        // If the wait times out the predicate is left alone, since a
+        // signaling that raced with the timeout is meant for the 'second
+        // native wait' in BlockThread.
+        while (FALSE == InterlockedExchange((LONG *)&ptnwdNativeWaitData->iPred, FALSE))
+        {
+            lRet = syscall(SYS_futex,
+                           &ptnwdNativeWaitData->iPred,
+                           FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME,
+                           FALSE,
+                           (INFINITE == dwTimeout) ? NULL : &tsAbsTmo,
+                           NULL,
+                           FUTEX_BITSET_MATCH_ANY);
+            if (0 != lRet)
+            {
+                if (ETIMEDOUT == errno)
+                {
+                    _ASSERT_MSG(INFINITE != dwTimeout,
+                                "Got ETIMEDOUT despite timeout being INFINITE\n");
+                    *ptwrWakeupReason = WaitTimeout;
+                    goto TNW_exit;
+                }
+                else if (EAGAIN != errno && EINTR != errno)
+                {
+                    ERROR("futex wait failed [errno=%d (%s)]\n",
+                          errno, strerror(errno));
+                    palErr = ERROR_INTERNAL_ERROR;
+                    *ptwrWakeupReason = WaitFailed;
+                    goto TNW_exit;
+                }
+            }
+        }
+
+        *ptwrWakeupReason  = ptnwdNativeWaitData->twrWakeupReason;
+        *pdwSignaledObject = ptnwdNativeWaitData->dwObjectIndex;
+
+    TNW_exit:
+        TRACE("ThreadNativeWait: returning %u [WakeupReason=%u]\n", palErr, *ptwrWakeupReason);
+        return palErr;
+    }
+#else // HAVE_FUTEX
     PAL_ERROR CPalSynchronizationManager::ThreadNativeWait(
         ThreadNativeWaitData * ptnwdNativeWaitData,
         DWORD dwTimeout,
@@ -543,6 +614,7 @@ namespace CorUnix
         TRACE("ThreadNativeWait: returning %u [WakeupReason=%u]\n", palErr, *ptwrWakeupReason);
         return palErr;
     }
+#endif // HAVE_FUTEX
 
     /*++
     Method:
@@ -2445,6 +2517,30 @@ namespace CorUnix
         ThreadNativeWaitData * ptnwdNativeWaitData)
     {
         PAL_ERROR palErr = NO_ERROR;
+#if HAVE_FUTEX
+        long lRet;
+
+        // Set the predicate; the exchange orders the stores of the wakeup
+        // reason and object index done by WakeUpLocalThread before it
+        InterlockedExchange((LONG *)&ptnwdNativeWaitData->iPred, TRUE);
+
+        // Wake the target thread. No lock is held around the predicate, so
+        // the target may already have consumed it and returned: a wakeup
+        // that finds no waiter is harmless.
+        lRet = syscall(SYS_futex,
+                       &ptnwdNativeWaitData->iPred,
+                       FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+                       1,
+                       NULL,
+                       NULL,
+                       0);
+        if (0 > lRet)
+        {
+            ERROR("futex wake failed [errno=%d (%s)]\n",
+                  errno, strerror(errno));
+            palErr = ERROR_INTERNAL_ERROR;
+        }
+#else // HAVE_FUTEX
         int iRet;
 
         // Lock the mutex
@@ -2476,6 +2572,7 @@ namespace CorUnix
             ERROR("Cannot unlock mutex [err=%d]\n", iRet);
             return ERROR_INTERNAL_ERROR;
         }
+#endif // HAVE_FUTEX
 
         return palErr;
     }
@@ -165,6 +165,11 @@ namespace CorUnix
         OwnedObjectsListNode * m_poolnOwnedObjectListNode;
         bool m_fAbandoned;
 
+        // eventfd made readable whenever the object is left signaled, for
+        // the PAL wait sets watching it; -1 until one is requested. Valid
+        // only for process local objects.
+        int m_iNotificationFd;
+
 #ifdef SYNCH_STATISTICS
         ULONG m_lStatWaitCount;
         ULONG m_lStatContentionCount;
@@ -175,7 +180,8 @@ namespace CorUnix
             : m_ulcWaitingThreads(0), m_shridThis(NULLSharedID), m_lRefCount(1),
               m_lSignalCount(0), m_lOwnershipCount(0), m_dwOwnerPid(0),
               m_dwOwnerTid(0), m_pOwnerThread(NULL), 
-              m_poolnOwnedObjectListNode(NULL), m_fAbandoned(false)
+              m_poolnOwnedObjectListNode(NULL), m_fAbandoned(false),
+              m_iNotificationFd(-1)
         { 
             // m_ptrWTLHead, m_ptrWTLTail, m_odObjectDomain 
             // and m_otiObjectTypeId are initialized by
@@ -257,6 +263,9 @@ namespace CorUnix
             bool * pfDelegated,
             bool fWorkerThread);
 
+        PAL_ERROR GetNotificationFd(int * piFd);
+        void NotifySignaled(void);
+
         LONG ReleaseAllLocalWaiters(
             CPalThread * pthrCurrent);
 
@@ -490,6 +499,7 @@ namespace CorUnix
         virtual PAL_ERROR DecrementSignalCount(LONG lAmountToDecrement);
         virtual PAL_ERROR SetOwner(CPalThread *pNewOwningThread);
         virtual PAL_ERROR DecrementOwnershipCount(void);
+        virtual PAL_ERROR GetNotificationFd(int *piFd);
         virtual void ReleaseController(void);
     };    
     
@@ -0,0 +1,503 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*++
+
+
+
+Module Name:
+
+    waitset.cpp
+
+Abstract:
+
+    Implementation of the PAL wait sets.
+
+    A wait set is an epoll instance watching, for each object added to it,
+    a duplicate of the notification descriptor of that object (see
+    ISynchStateController::GetNotificationFd). The synchronization manager
+    makes the descriptor readable whenever a signal leaves the object
+    signaled, so a single thread can wait for any number of objects
+    without registering itself as a waiter on each of them. Since other
+    threads may acquire an object between the notification and the time
+    the set is serviced, readable descriptors are only hints: an object is
+    reported only once a zero timeout wait on it has succeeded.
+
+
+
+--*/
+
+#include "pal/dbgmsg.h"
+
+SET_DEFAULT_DEBUG_CHANNEL(SYNC); // some headers have code with asserts, so do this first
+
+#include "pal/thread.hpp"
+#include "pal/synchobjects.hpp"
+#include "pal/malloc.hpp"
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+#if HAVE_EPOLL
+#include <sys/epoll.h>
+#endif // HAVE_EPOLL
+
+using namespace CorUnix;
+
+struct _PAL_WAIT_SET
+{
+    int iEpollFd;
+};
+
+#if HAVE_EPOLL
+namespace
+{
+    struct WaitSetRegistration
+    {
+        IPalObject *pObject;
+        HANDLE hObject;
+        int iFd;            // duplicate of the notification descriptor of pObject
+        PVOID pvContext;
+    };
+}
+
+// Maximum number of descriptors collected by a single epoll_wait
+static const int WaitSetMaxEvents = 64;
+
+// Process objects are left out: their exit is only detected for processes
+// a thread is blocked on (see CSynchWaitController::RegisterWaitingThread),
+// and their signal count is set without going through CSynchData::Signal.
+static PalObjectTypeId sg_rgWaitSetObjectsIds[] =
+    {
+        otiAutoResetEvent,
+        otiManualResetEvent,
+        otiMutex,
+        otiSemaphore,
+        otiThread
+    };
+static CAllowedObjectTypes sg_aotWaitSetObject(sg_rgWaitSetObjectsIds,
+    sizeof(sg_rgWaitSetObjectsIds)/sizeof(sg_rgWaitSetObjectsIds[0]));
+
+/*++
+Function:
+  WaitSetGetNotificationFd
+
+Returns the notification descriptor of an object; if the object is
+signaled the descriptor is made readable.
+--*/
+static PAL_ERROR
+WaitSetGetNotificationFd(
+    CPalThread *pThread,
+    IPalObject *pObject,
+    int *piFd)
+{
+    ISynchStateController *pssc = NULL;
+    PAL_ERROR palError;
+
+    palError = pObject->GetSynchStateController(pThread, &pssc);
+    if (NO_ERROR != palError)
+    {
+        ERROR("Error %d obtaining synch state controller\n", palError);
+        return palError;
+    }
+
+    palError = pssc->GetNotificationFd(piFd);
+    pssc->ReleaseController();
+
+    return palError;
+}
+
+/*++
+Function:
+  WaitSetTryAcquire
+
+Consumes the notification of a registration and tries to acquire its
+object. Returns TRUE if the object was acquired.
+--*/
+static BOOL
+WaitSetTryAcquire(
+    CPalThread *pThread,
+    WaitSetRegistration *pRegistration)
+{
+    UINT64 ui64Count;
+    ssize_t sszRead;
+    DWORD dwRet;
+    int iFd;
+
+    // Other registrations of the object share the counter, so it may have
+    // been reset already
+    do
+    {
+        sszRead = read(pRegistration->iFd, &ui64Count, sizeof(ui64Count));
+    } while (-1 == sszRead && EINTR == errno);
+
+    dwRet = InternalWaitForMultipleObjectsEx(pThread, 1, &pRegistration->hObject,
+                                             FALSE, 0, FALSE);
+    if (WAIT_OBJECT_0 != dwRet && WAIT_ABANDONED_0 != dwRet)
+    {
+        // Another thread got the object first
+        TRACE("Object %p of registration %p could not be acquired [ret=%u]\n",
+              pRegistration->hObject, pRegistration, dwRet);
+        return FALSE;
+    }
+
+    // If the object is still signaled (e.g. a manual reset event), make
+    // the descriptor readable again so that the next wait reports it too.
+    // Nothing else would, since no further signal may come.
+    WaitSetGetNotificationFd(pThread, pRegistration->pObject, &iFd);
+
+    return TRUE;
+}
+#endif // HAVE_EPOLL
+
+/*++
+Function:
+  PAL_CreateWaitSet
+
+See declaration in pal.h
+--*/
+PAL_WAIT_SET
+PALAPI
+PAL_CreateWaitSet(
+    VOID)
+{
+    PAL_WAIT_SET hWaitSet = NULL;
+    PAL_ERROR palError = NO_ERROR;
+    CPalThread *pThread;
+
+    PERF_ENTRY(PAL_CreateWaitSet);
+    ENTRY("PAL_CreateWaitSet()\n");
+
+    pThread = InternalGetCurrentThread();
+
+#if HAVE_EPOLL
+    hWaitSet = InternalNew<_PAL_WAIT_SET>();
+    if (NULL == hWaitSet)
+    {
+        ERROR("Unable to allocate wait set\n");
+        palError = ERROR_NOT_ENOUGH_MEMORY;
+        goto done;
+    }
+
+    hWaitSet->iEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (-1 == hWaitSet->iEpollFd)
+    {
+        ERROR("epoll_create1 failed with errno %d (%s)\n", errno, strerror(errno));
+        palError = (EMFILE == errno || ENFILE == errno) ?
+            ERROR_TOO_MANY_OPEN_FILES : ERROR_NOT_ENOUGH_MEMORY;
+        InternalDelete(hWaitSet);
+        hWaitSet = NULL;
+        goto done;
+    }
+
+done:
+#else // HAVE_EPOLL
+    palError = ERROR_NOT_SUPPORTED;
+#endif // HAVE_EPOLL
+
+    if (NO_ERROR != palError)
+    {
+        pThread->SetLastError(palError);
+    }
+
+    LOGEXIT("PAL_CreateWaitSet returns PAL_WAIT_SET %p\n", hWaitSet);
+    PERF_EXIT(PAL_CreateWaitSet);
+    return hWaitSet;
+}
+
+/*++
+Function:
+  PAL_DeleteWaitSet
+
+See declaration in pal.h. The objects still in the set must have been
+removed from it.
+--*/
+VOID
+PALAPI
+PAL_DeleteWaitSet(
+    IN PAL_WAIT_SET hWaitSet)
+{
+    PERF_ENTRY(PAL_DeleteWaitSet);
+    ENTRY("PAL_DeleteWaitSet(hWaitSet=%p)\n", hWaitSet);
+
+    if (NULL != hWaitSet)
+    {
+        close(hWaitSet->iEpollFd);
+        InternalDelete(hWaitSet);
+    }
+
+    LOGEXIT("PAL_DeleteWaitSet returns\n");
+    PERF_EXIT(PAL_DeleteWaitSet);
+}
+
+/*++
+Function:
+  PAL_WaitSetAdd
+
+See declaration in pal.h
+--*/
+BOOL
+PALAPI
+PAL_WaitSetAdd(
+    IN PAL_WAIT_SET hWaitSet,
+    IN HANDLE hObject,
+    IN PVOID pvContext,
+    OUT PVOID *ppvRegistration)
+{
+    PAL_ERROR palError = NO_ERROR;
+    CPalThread *pThread;
+#if HAVE_EPOLL
+    WaitSetRegistration *pRegistration = NULL;
+    IPalObject *pObject = NULL;
+    struct epoll_event event;
+    int iFd;
+#endif // HAVE_EPOLL
+
+    PERF_ENTRY(PAL_WaitSetAdd);
+    ENTRY("PAL_WaitSetAdd(hWaitSet=%p, hObject=%p, pvContext=%p, ppvRegistration=%p)\n",
+          hWaitSet, hObject, pvContext, ppvRegistration);
+
+    pThread = InternalGetCurrentThread();
+
+#if HAVE_EPOLL
+    if (NULL == hWaitSet || NULL == ppvRegistration)
+    {
+        ERROR("Invalid parameter\n");
+        palError = ERROR_INVALID_PARAMETER;
+        goto done;
+    }
+
+    palError = g_pObjectManager->ReferenceObjectByHandle(
+        pThread,
+        hObject,
+        &sg_aotWaitSetObject,
+        0,
+        &pObject
+        );
+
+    if (NO_ERROR != palError)
+    {
+        ERROR("Unable to obtain object for handle %p (error %d)!\n", hObject, palError);
+        goto done;
+    }
+
+    pRegistration = InternalNew<WaitSetRegistration>();
+    if (NULL == pRegistration)
+    {
+        ERROR("Unable to allocate wait set registration\n");
+        palError = ERROR_NOT_ENOUGH_MEMORY;
+        goto done;
+    }
+
+    pRegistration->pObject = pObject;
+    pRegistration->hObject = hObject;
+    pRegistration->pvContext = pvContext;
+    pRegistration->iFd = -1;
+
+    palError = WaitSetGetNotificationFd(pThread, pObject, &iFd);
+    if (NO_ERROR != palError)
+    {
+        goto done;
+    }
+
+    // Each registration watches its own duplicate, so that the same object
+    // can be added more than once
+    pRegistration->iFd = dup(iFd);
+    if (-1 == pRegistration->iFd)
+    {
+        ERROR("dup failed with errno %d (%s)\n", errno, strerror(errno));
+        palError = ERROR_TOO_MANY_OPEN_FILES;
+        goto done;
+    }
+
+    event.events = EPOLLIN;
+    event.data.ptr = pRegistration;
+    if (-1 == epoll_ctl(hWaitSet->iEpollFd, EPOLL_CTL_ADD, pRegistration->iFd, &event))
+    {
+        ERROR("epoll_ctl failed with errno %d (%s)\n", errno, strerror(errno));
+        palError = ERROR_NOT_ENOUGH_MEMORY;
+        goto done;
+    }
+
+    TRACE("Object %p added to wait set %p as registration %p\n",
+          hObject, hWaitSet, pRegistration);
+
+    *ppvRegistration = pRegistration;
+    pRegistration = NULL;
+    pObject = NULL;
+
+done:
+    if (NULL != pRegistration)
+    {
+        if (-1 != pRegistration->iFd)
+        {
+            close(pRegistration->iFd);
+        }
+        InternalDelete(pRegistration);
+    }
+
+    if (NULL != pObject)
+    {
+        pObject->ReleaseReference(pThread);
+    }
+#else // HAVE_EPOLL
+    palError = ERROR_NOT_SUPPORTED;
+#endif // HAVE_EPOLL
+
+    if (NO_ERROR != palError)
+    {
+        pThread->SetLastError(palError);
+    }
+
+    LOGEXIT("PAL_WaitSetAdd returns BOOL %d\n", NO_ERROR == palError);
+    PERF_EXIT(PAL_WaitSetAdd);
+    return NO_ERROR == palError;
+}
+
+/*++
+Function:
+  PAL_WaitSetRemove
+
+See declaration in pal.h. While a thread waits on the set, only that
+thread may remove objects from it: the kernel may already have reported
+the registration to it.
+--*/
+VOID
+PALAPI
+PAL_WaitSetRemove(
+    IN PAL_WAIT_SET hWaitSet,
+    IN PVOID pvRegistration)
+{
+    PERF_ENTRY(PAL_WaitSetRemove);
+    ENTRY("PAL_WaitSetRemove(hWaitSet=%p, pvRegistration=%p)\n",
+          hWaitSet, pvRegistration);
+
+#if HAVE_EPOLL
+    WaitSetRegistration *pRegistration =
+        reinterpret_cast<WaitSetRegistration *>(pvRegistration);
+
+    if (NULL != hWaitSet && NULL != pRegistration)
+    {
+        epoll_ctl(hWaitSet->iEpollFd, EPOLL_CTL_DEL, pRegistration->iFd, NULL);
+        close(pRegistration->iFd);
+        pRegistration->pObject->ReleaseReference(InternalGetCurrentThread());
+        InternalDelete(pRegistration);
+    }
+#endif // HAVE_EPOLL
+
+    LOGEXIT("PAL_WaitSetRemove returns\n");
+    PERF_EXIT(PAL_WaitSetRemove);
+}
+
+/*++
+Function:
+  PAL_WaitSetWait
+
+See declaration in pal.h
+--*/
+DWORD
+PALAPI
+PAL_WaitSetWait(
+    IN PAL_WAIT_SET hWaitSet,
+    IN DWORD dwMilliseconds,
+    OUT PVOID *rgpvContexts,
+    IN DWORD nMaxContexts)
+{
+    DWORD dwRet = WAIT_FAILED;
+    PAL_ERROR palError = NO_ERROR;
+    CPalThread *pThread;
+
+    PERF_ENTRY(PAL_WaitSetWait);
+    ENTRY("PAL_WaitSetWait(hWaitSet=%p, dwMilliseconds=%u, rgpvContexts=%p, nMaxContexts=%u)\n",
+          hWaitSet, dwMilliseconds, rgpvContexts, nMaxContexts);
+
+    pThread = InternalGetCurrentThread();
+
+#if HAVE_EPOLL
+    struct epoll_event rgEvents[WaitSetMaxEvents];
+    ULONGLONG ullStart;
+    int iMaxEvents;
+    int iTimeout;
+    int iCount;
+
+    if (NULL == hWaitSet || NULL == rgpvContexts || 0 == nMaxContexts)
+    {
+        ERROR("Invalid parameter\n");
+        palError = ERROR_INVALID_PARAMETER;
+        goto done;
+    }
+
+    iMaxEvents = (nMaxContexts < (DWORD)WaitSetMaxEvents) ? (int)nMaxContexts : WaitSetMaxEvents;
+    ullStart = GetTickCount64();
+    dwRet = 0;
+
+    // Loop until an object is acquired or the timeout elapses: all the
+    // objects reported by epoll may have been acquired by other threads
+    for (;;)
+    {
+        if (INFINITE == dwMilliseconds)
+        {
+            iTimeout = -1;
+        }
+        else
+        {
+            ULONGLONG ullElapsed = GetTickCount64() - ullStart;
+
+            if (ullElapsed >= dwMilliseconds)
+            {
+                iTimeout = 0;
+            }
+            else
+            {
+                ULONGLONG ullRemaining = dwMilliseconds - ullElapsed;
+                iTimeout = (ullRemaining > INT_MAX) ? INT_MAX : (int)ullRemaining;
+            }
+        }
+
+        iCount = epoll_wait(hWaitSet->iEpollFd, rgEvents, iMaxEvents, iTimeout);
+        if (-1 == iCount)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            ERROR("epoll_wait failed with errno %d (%s)\n", errno, strerror(errno));
+            palError = ERROR_INTERNAL_ERROR;
+            dwRet = WAIT_FAILED;
+            goto done;
+        }
+
+        for (int i = 0; i < iCount; i++)
+        {
+            WaitSetRegistration *pRegistration =
+                reinterpret_cast<WaitSetRegistration *>(rgEvents[i].data.ptr);
+
+            if (WaitSetTryAcquire(pThread, pRegistration))
+            {
+                rgpvContexts[dwRet++] = pRegistration->pvContext;
+            }
+        }
+
+        if (0 != dwRet || 0 == iTimeout)
+        {
+            break;
+        }
+    }
+
+done:
+#else // HAVE_EPOLL
+    palError = ERROR_NOT_SUPPORTED;
+#endif // HAVE_EPOLL
+
+    if (NO_ERROR != palError)
+    {
+        pThread->SetLastError(palError);
+    }
+
+    LOGEXIT("PAL_WaitSetWait returns DWORD %u\n", dwRet);
+    PERF_EXIT(PAL_WaitSetWait);
+    return dwRet;
+}
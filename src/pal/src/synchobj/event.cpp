@@ -391,7 +391,6 @@ CorUnix::InternalSetEvent(
 {
     PAL_ERROR palError = NO_ERROR;
     IPalObject *pobjEvent = NULL;
-    ISynchStateController *pssc = NULL;
 
     _ASSERTE(NULL != pthr);
 
@@ -401,20 +400,89 @@ CorUnix::InternalSetEvent(
         fSetEvent
         );
 
+    palError = InternalReferenceEvent(pthr, hEvent, &pobjEvent);
+
+    if (NO_ERROR != palError)
+    {
+        goto InternalSetEventExit;
+    }
+
+    palError = InternalSetEventObject(pthr, pobjEvent, fSetEvent);
+
+InternalSetEventExit:
+
+    if (NULL != pobjEvent)
+    {
+        pobjEvent->ReleaseReference(pthr);
+    }
+
+    LOGEXIT("InternalSetEvent returns %d\n", palError);
+
+    return palError;
+}
+
+/*++
+Function:
+  InternalReferenceEvent
+
+Parameters:
+  pthr -- thread data for calling thread
+  hEvent -- handle to the event
+  ppobjEvent -- receives a reference to the event object, which the caller
+                releases; the object stays valid after the handle is closed
+--*/
+
+PAL_ERROR
+CorUnix::InternalReferenceEvent(
+    CPalThread *pthr,
+    HANDLE hEvent,
+    IPalObject **ppobjEvent
+    )
+{
+    PAL_ERROR palError = NO_ERROR;
+
+    _ASSERTE(NULL != pthr);
+    _ASSERTE(NULL != ppobjEvent);
+
     palError = g_pObjectManager->ReferenceObjectByHandle(
         pthr,
         hEvent,
         &aotEvent,
         0, // Should be EVENT_MODIFY_STATE; currently ignored (no Win32 security)
-        &pobjEvent
+        ppobjEvent
         );
 
     if (NO_ERROR != palError)
     {
         ERROR("Unable to obtain object for handle %p (error %d)!\n", hEvent, palError);
-        goto InternalSetEventExit;
     }
 
+    return palError;
+}
+
+/*++
+Function:
+  InternalSetEventObject
+
+Parameters:
+  pthr -- thread data for calling thread
+  pobjEvent -- event object to set, see InternalReferenceEvent
+  fSetEvent -- if TRUE, set the event; if FALSE, reset it
+--*/
+
+PAL_ERROR
+CorUnix::InternalSetEventObject(
+    CPalThread *pthr,
+    IPalObject *pobjEvent,
+    BOOL fSetEvent
+    )
+{
+    PAL_ERROR palError = NO_ERROR;
+    ISynchStateController *pssc = NULL;
+
+    _ASSERTE(NULL != pthr);
+    _ASSERTE(NULL != pobjEvent);
+
     palError = pobjEvent->GetSynchStateController(
         pthr,
         &pssc
@@ -423,7 +491,7 @@ CorUnix::InternalSetEvent(
     if (NO_ERROR != palError)
     {
         ASSERT("Error %d obtaining synch state controller\n", palError);
-        goto InternalSetEventExit;
+        goto InternalSetEventObjectExit;
     }
 
     palError = pssc->SetSignalCount(fSetEvent ? 1 : 0);
@@ -431,23 +499,16 @@ CorUnix::InternalSetEvent(
     if (NO_ERROR != palError)
     {
         ASSERT("Error %d setting event state\n", palError);
-        goto InternalSetEventExit;
+        goto InternalSetEventObjectExit;
     }
 
-InternalSetEventExit:
+InternalSetEventObjectExit:
 
     if (NULL != pssc)
     {
         pssc->ReleaseController();
     }
 
-    if (NULL != pobjEvent)
-    {
-        pobjEvent->ReleaseReference(pthr);
-    }
-
-    LOGEXIT("InternalSetEvent returns %d\n", palError);
-
     return palError;
 }
 
@@ -159,6 +159,11 @@ Volatile<PSHUTDOWN_CALLBACK> g_shutdownCallback = nullptr;
 //
 pthread_key_t CorUnix::thObjKey;
 
+//
+// Cache of the thObjKey value of the calling thread
+//
+__thread CPalThread *CorUnix::t_pCurrentPalThread PAL_TLS_INITIAL_EXEC = NULL;
+
 #define PROCESS_PELOADER_FILENAME  "clix"
 
 static WCHAR W16_WHITESPACE[]= {0x0020, 0x0009, 0x000D, 0};
@@ -169,7 +169,7 @@ static void InternalEndCurrentThreadWrapper(void *arg)
     // from TLS.  Since InternalEndCurrentThread calls functions that assert
     // that the current thread is known to this PAL, and that pThread
     // actually is the current PAL thread, put it back in TLS temporarily.
-    pthread_setspecific(thObjKey, pThread);
+    SetCurrentPalThread(pThread);
     (void)PAL_Enter(PAL_BoundaryTop);
     
     /* Call entry point functions of every attached modules to
@@ -181,7 +181,7 @@ static void InternalEndCurrentThreadWrapper(void *arg)
     // PAL_Leave will be called just before we release the thread reference
     // in InternalEndCurrentThread.
     InternalEndCurrentThread(pThread);
-    pthread_setspecific(thObjKey, NULL);
+    SetCurrentPalThread(NULL);
 }
 
 /*++
@@ -378,17 +378,26 @@ GetCurrentThreadId(
             VOID)
 {
     DWORD dwThreadId;
+    CPalThread *pThread;
 
     PERF_ENTRY(GetCurrentThreadId);
     ENTRY("GetCurrentThreadId()\n");
 
     //
-    // TODO: should do perf test to see how this compares
-    // with calling InternalGetCurrentThread (i.e., is our lookaside
-    // cache faster on average than pthread_self?)
+    // THREADSilentGetCurrentThreadId is a system call on Linux. Threads
+    // known to the PAL have their id cached in their CPalThread, which
+    // is a thread local read away.
     //
-    
-    dwThreadId = (DWORD)THREADSilentGetCurrentThreadId();
+
+    pThread = GetCurrentPalThread();
+    if (pThread != NULL)
+    {
+        dwThreadId = (DWORD)pThread->GetThreadId();
+    }
+    else
+    {
+        dwThreadId = (DWORD)THREADSilentGetCurrentThreadId();
+    }
     
     LOGEXIT("GetCurrentThreadId returns DWORD %#x\n", dwThreadId);    
     PERF_EXIT(GetCurrentThreadId);
@@ -215,7 +215,7 @@ CThreadTLSInfo::InitializePostCreate(
 {
     PAL_ERROR palError = NO_ERROR;
     
-    if (pthread_setspecific(thObjKey, reinterpret_cast<void*>(pThread)))
+    if (SetCurrentPalThread(pThread))
     {
         ASSERT("Unable to set the thread object key's value\n");
         palError = ERROR_INTERNAL_ERROR;
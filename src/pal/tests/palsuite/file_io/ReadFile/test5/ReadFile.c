@@ -0,0 +1,260 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=====================================================================
+**
+** Source:  ReadFile.c (test 5)
+**
+** Purpose: Tests the PAL implementation of overlapped ReadFile and
+**          WriteFile. Blocks are written and read back at explicit
+**          offsets on a handle opened with FILE_FLAG_OVERLAPPED, first
+**          waiting with GetOverlappedResult and then through a
+**          completion callback bound with PAL_BindIoCompletionCallback.
+**          Reads with auto-reset events must be complete once their
+**          event is signaled, whether the event is waited on directly or
+**          by GetOverlappedResult. A read past the end of the file must
+**          complete with ERROR_HANDLE_EOF.
+**
+**
+**===================================================================*/
+
+#include <palsuite.h>
+
+#define BLOCK_SIZE      4096
+#define BLOCK_COUNT     16
+
+const char szTextFile[] = "testfile.tmp";
+
+static BYTE g_writeBuffer[BLOCK_COUNT][BLOCK_SIZE];
+static BYTE g_readBuffer[BLOCK_COUNT][BLOCK_SIZE];
+static OVERLAPPED g_overlapped[BLOCK_COUNT];
+static HANDLE g_hCompletions = NULL;
+static volatile LONG g_completionErrors = 0;
+
+static VOID PALAPI CompletionCallback(DWORD dwErrorCode,
+                                      DWORD dwNumberOfBytesTransferred,
+                                      LPOVERLAPPED lpOverlapped,
+                                      PVOID pContext)
+{
+    if (pContext != (PVOID)&g_hCompletions ||
+        dwErrorCode != NO_ERROR ||
+        dwNumberOfBytesTransferred != BLOCK_SIZE)
+    {
+        InterlockedIncrement(&g_completionErrors);
+    }
+
+    ReleaseSemaphore(g_hCompletions, 1, NULL);
+}
+
+static void SetOffset(OVERLAPPED *pOverlapped, int block)
+{
+    memset(pOverlapped, 0, sizeof(*pOverlapped));
+    pOverlapped->Offset = block * BLOCK_SIZE;
+}
+
+static void CheckIssued(BOOL bRet, const char *szOperation, int block)
+{
+    if (!bRet && GetLastError() != ERROR_IO_PENDING)
+    {
+        Fail("ReadFile: ERROR -> overlapped %s of block %d failed, error %u\n",
+             szOperation, block, GetLastError());
+    }
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    HANDLE hFile;
+    DWORD dwBytes;
+    BOOL bRet;
+    int i;
+    int j;
+
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        for (j = 0; j < BLOCK_SIZE; j++)
+        {
+            g_writeBuffer[i][j] = (BYTE)(i * 31 + j);
+        }
+    }
+
+    hFile = CreateFile(szTextFile, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                       CREATE_ALWAYS, FILE_FLAG_OVERLAPPED, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        Fail("ReadFile: ERROR -> Unable to create file \"%s\", error %u\n",
+             szTextFile, GetLastError());
+    }
+
+    // Write the blocks in reverse order so that the offsets, not the file
+    // pointer, decide where the data lands
+    for (i = BLOCK_COUNT - 1; i >= 0; i--)
+    {
+        SetOffset(&g_overlapped[i], i);
+        g_overlapped[i].hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+        if (g_overlapped[i].hEvent == NULL)
+        {
+            Fail("ReadFile: ERROR -> CreateEvent failed, error %u\n", GetLastError());
+        }
+
+        bRet = WriteFile(hFile, g_writeBuffer[i], BLOCK_SIZE, NULL, &g_overlapped[i]);
+        CheckIssued(bRet, "write", i);
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        if (!GetOverlappedResult(hFile, &g_overlapped[i], &dwBytes, TRUE) ||
+            dwBytes != BLOCK_SIZE)
+        {
+            Fail("ReadFile: ERROR -> overlapped write of block %d did not complete, "
+                 "error %u, %u bytes\n", i, GetLastError(), dwBytes);
+        }
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        HANDLE hEvent = g_overlapped[i].hEvent;
+
+        SetOffset(&g_overlapped[i], i);
+        g_overlapped[i].hEvent = hEvent;
+
+        bRet = ReadFile(hFile, g_readBuffer[i], BLOCK_SIZE, NULL, &g_overlapped[i]);
+        CheckIssued(bRet, "read", i);
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        if (!GetOverlappedResult(hFile, &g_overlapped[i], &dwBytes, TRUE) ||
+            dwBytes != BLOCK_SIZE)
+        {
+            Fail("ReadFile: ERROR -> overlapped read of block %d did not complete, "
+                 "error %u, %u bytes\n", i, GetLastError(), dwBytes);
+        }
+        if (memcmp(g_readBuffer[i], g_writeBuffer[i], BLOCK_SIZE) != 0)
+        {
+            Fail("ReadFile: ERROR -> block %d read back different data\n", i);
+        }
+        CloseHandle(g_overlapped[i].hEvent);
+    }
+
+    // Auto-reset events: the status has to be final once the event is
+    // signaled, since waiting on the event consumes the signal
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        SetOffset(&g_overlapped[i], i);
+        g_overlapped[i].hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (g_overlapped[i].hEvent == NULL)
+        {
+            Fail("ReadFile: ERROR -> CreateEvent failed, error %u\n", GetLastError());
+        }
+
+        bRet = ReadFile(hFile, g_readBuffer[i], BLOCK_SIZE, NULL, &g_overlapped[i]);
+        CheckIssued(bRet, "read", i);
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        if (i % 2 == 0)
+        {
+            if (WaitForSingleObject(g_overlapped[i].hEvent, 10000) != WAIT_OBJECT_0)
+            {
+                Fail("ReadFile: ERROR -> event of overlapped read of block %d was not "
+                     "signaled\n", i);
+            }
+            if (!HasOverlappedIoCompleted(&g_overlapped[i]) ||
+                !GetOverlappedResult(hFile, &g_overlapped[i], &dwBytes, FALSE) ||
+                dwBytes != BLOCK_SIZE)
+            {
+                Fail("ReadFile: ERROR -> overlapped read of block %d was not complete "
+                     "after its event was signaled, error %u, %u bytes\n",
+                     i, GetLastError(), dwBytes);
+            }
+        }
+        else if (!GetOverlappedResult(hFile, &g_overlapped[i], &dwBytes, TRUE) ||
+                 dwBytes != BLOCK_SIZE)
+        {
+            Fail("ReadFile: ERROR -> overlapped read of block %d with an auto-reset "
+                 "event did not complete, error %u, %u bytes\n", i, GetLastError(), dwBytes);
+        }
+        CloseHandle(g_overlapped[i].hEvent);
+    }
+
+    // Past the end of the file
+    SetOffset(&g_overlapped[0], BLOCK_COUNT);
+    bRet = ReadFile(hFile, g_readBuffer[0], BLOCK_SIZE, NULL, &g_overlapped[0]);
+    if (!bRet && GetLastError() != ERROR_IO_PENDING && GetLastError() != ERROR_HANDLE_EOF)
+    {
+        Fail("ReadFile: ERROR -> overlapped read at end of file failed, error %u\n",
+             GetLastError());
+    }
+    if (GetOverlappedResult(hFile, &g_overlapped[0], &dwBytes, TRUE) ||
+        GetLastError() != ERROR_HANDLE_EOF || dwBytes != 0)
+    {
+        Fail("ReadFile: ERROR -> read at end of file did not report "
+             "ERROR_HANDLE_EOF, error %u, %u bytes\n", GetLastError(), dwBytes);
+    }
+
+    // Completion callbacks
+    g_hCompletions = CreateSemaphore(NULL, 0, BLOCK_COUNT, NULL);
+    if (g_hCompletions == NULL)
+    {
+        Fail("ReadFile: ERROR -> CreateSemaphore failed, error %u\n", GetLastError());
+    }
+
+    if (!PAL_BindIoCompletionCallback(hFile, CompletionCallback, (PVOID)&g_hCompletions))
+    {
+        Fail("ReadFile: ERROR -> PAL_BindIoCompletionCallback failed, error %u\n",
+             GetLastError());
+    }
+    if (PAL_BindIoCompletionCallback(hFile, CompletionCallback, NULL))
+    {
+        Fail("ReadFile: ERROR -> a handle was bound to a completion callback twice\n");
+    }
+
+    memset(g_readBuffer, 0, sizeof(g_readBuffer));
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        SetOffset(&g_overlapped[i], i);
+        bRet = ReadFile(hFile, g_readBuffer[i], BLOCK_SIZE, NULL, &g_overlapped[i]);
+        CheckIssued(bRet, "read", i);
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        if (WaitForSingleObject(g_hCompletions, 10000) != WAIT_OBJECT_0)
+        {
+            Fail("ReadFile: ERROR -> completion callback %d was not called\n", i);
+        }
+    }
+
+    if (g_completionErrors != 0)
+    {
+        Fail("ReadFile: ERROR -> %d completion callbacks reported an error\n",
+             g_completionErrors);
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        if (memcmp(g_readBuffer[i], g_writeBuffer[i], BLOCK_SIZE) != 0)
+        {
+            Fail("ReadFile: ERROR -> block %d read back different data\n", i);
+        }
+    }
+
+    CloseHandle(g_hCompletions);
+    CloseHandle(hFile);
+
+    if (!DeleteFileA(szTextFile))
+    {
+        Fail("ReadFile: ERROR -> Unable to delete file \"%s\", error %u\n",
+             szTextFile, GetLastError());
+    }
+
+    PAL_Terminate();
+    return PASS;
+}
@@ -0,0 +1,173 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source:  getwritewatch.c
+**
+** Purpose: Positive test the GetWriteWatch API.
+**          Reserve a region with MEM_WRITE_WATCH, commit the first
+**          half of it, write to some of its pages and check that
+**          exactly those pages are reported, that
+**          WRITE_WATCH_FLAG_RESET clears them and that decommitted
+**          pages are not reported.
+**
+**          Write watching depends on kernel support. If the region
+**          cannot be reserved, GetWriteWatch must fail cleanly.
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define REGION_SIZE     (64 * 64 * 1024)
+#define STRIDE          (64 * 1024)
+#define MAX_ADDRESSES   (REGION_SIZE / 4096)
+
+static PVOID addresses[MAX_ADDRESSES];
+
+/* Returns the number of written pages, failing if any page outside of
+   a written stride is reported */
+static ULONG_PTR GetWritten(LPBYTE region, DWORD flags, const BOOL *written)
+{
+    ULONG_PTR count = MAX_ADDRESSES;
+    ULONG granularity = 0;
+    ULONG_PTR i;
+
+    if (GetWriteWatch(flags, region, REGION_SIZE, addresses, &count, &granularity) != 0)
+    {
+        Fail("GetWriteWatch failed, error %u\n", GetLastError());
+    }
+    if (granularity == 0 || (STRIDE % granularity) != 0)
+    {
+        Fail("GetWriteWatch returned an unexpected granularity %u\n", granularity);
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        LPBYTE address = (LPBYTE)addresses[i];
+        if (address < region || address >= region + REGION_SIZE ||
+            ((SIZE_T)(address - region) % granularity) != 0)
+        {
+            Fail("GetWriteWatch reported an unexpected address %p\n", address);
+        }
+        if (!written[(address - region) / STRIDE])
+        {
+            Fail("GetWriteWatch reported the page at offset %#x, which was not written\n",
+                 (DWORD)(address - region));
+        }
+    }
+
+    return count;
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    LPBYTE region;
+    BOOL written[REGION_SIZE / STRIDE];
+    ULONG_PTR count;
+    ULONG granularity;
+    int i;
+
+    //Initialize the PAL environment
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        ExitProcess(FAIL);
+    }
+
+    region = (LPBYTE)VirtualAlloc(NULL, REGION_SIZE, MEM_RESERVE | MEM_WRITE_WATCH, PAGE_NOACCESS);
+    if (region == NULL)
+    {
+        count = MAX_ADDRESSES;
+        if (GetWriteWatch(0, addresses, sizeof(addresses), addresses, &count, &granularity) == 0)
+        {
+            Fail("GetWriteWatch succeeded for memory that is not watched\n");
+        }
+
+        Trace("Write watching is not supported on this system\n");
+        PAL_Terminate();
+        return PASS;
+    }
+
+    if (VirtualAlloc(region, REGION_SIZE / 2, MEM_COMMIT, PAGE_READWRITE) != region)
+    {
+        Fail("VirtualAlloc failed to commit, error %u\n", GetLastError());
+    }
+
+    memset(written, 0, sizeof(written));
+
+    /* Committing is not writing */
+    if (GetWritten(region, 0, written) != 0)
+    {
+        Fail("GetWriteWatch reported pages that were only committed\n");
+    }
+
+    /* Write to every third stride of the committed half */
+    for (i = 0; i < REGION_SIZE / 2 / STRIDE; i += 3)
+    {
+        region[i * STRIDE + 8] = 1;
+        written[i] = TRUE;
+    }
+
+    count = GetWritten(region, 0, written);
+    if (count == 0)
+    {
+        Fail("GetWriteWatch did not report the written pages\n");
+    }
+
+    /* Without the reset flag the pages are reported again */
+    if (GetWritten(region, WRITE_WATCH_FLAG_RESET, written) != count)
+    {
+        Fail("GetWriteWatch did not report the same pages twice\n");
+    }
+
+    /* The reset flag cleared them */
+    memset(written, 0, sizeof(written));
+    if (GetWritten(region, 0, written) != 0)
+    {
+        Fail("WRITE_WATCH_FLAG_RESET did not reset the written pages\n");
+    }
+
+    /* Writes after the reset are reported */
+    region[STRIDE + 8] = 2;
+    written[1] = TRUE;
+    if (GetWritten(region, 0, written) == 0)
+    {
+        Fail("GetWriteWatch did not report a page written after a reset\n");
+    }
+
+    /* Decommitted pages are not reported, and committing them again does not
+       make them written */
+    if (!VirtualFree(region, REGION_SIZE / 2, MEM_DECOMMIT))
+    {
+        Fail("VirtualFree failed to decommit, error %u\n", GetLastError());
+    }
+    memset(written, 0, sizeof(written));
+    if (GetWritten(region, 0, written) != 0)
+    {
+        Fail("GetWriteWatch reported decommitted pages\n");
+    }
+
+    if (VirtualAlloc(region, REGION_SIZE / 2, MEM_COMMIT, PAGE_READWRITE) != region)
+    {
+        Fail("VirtualAlloc failed to commit again, error %u\n", GetLastError());
+    }
+    if (GetWritten(region, 0, written) != 0)
+    {
+        Fail("GetWriteWatch reported pages that were only committed again\n");
+    }
+
+    region[5 * STRIDE] = 3;
+    written[5] = TRUE;
+    if (GetWritten(region, 0, written) == 0)
+    {
+        Fail("GetWriteWatch did not report a page written after committing it again\n");
+    }
+
+    if (!VirtualFree(region, 0, MEM_RELEASE))
+    {
+        Fail("VirtualFree failed to release, error %u\n", GetLastError());
+    }
+
+    PAL_Terminate();
+    return PASS;
+}
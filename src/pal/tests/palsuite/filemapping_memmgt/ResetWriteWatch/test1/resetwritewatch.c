@@ -0,0 +1,120 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source:  resetwritewatch.c
+**
+** Purpose: Positive test the ResetWriteWatch API.
+**          Reserve a region with MEM_WRITE_WATCH, commit pieces of
+**          it, write to every committed page and reset the first
+**          half only. The written pages of the second half must
+**          still be reported. ResetWriteWatch must fail for memory
+**          reserved without MEM_WRITE_WATCH.
+**
+**          Write watching depends on kernel support. If the region
+**          cannot be reserved, ResetWriteWatch must fail cleanly.
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define REGION_SIZE     (32 * 64 * 1024)
+#define STRIDE          (64 * 1024)
+#define MAX_ADDRESSES   (REGION_SIZE / 4096)
+
+static PVOID addresses[MAX_ADDRESSES];
+
+static ULONG_PTR CountWritten(LPBYTE address, SIZE_T size)
+{
+    ULONG_PTR count = MAX_ADDRESSES;
+    ULONG granularity = 0;
+
+    if (GetWriteWatch(0, address, size, addresses, &count, &granularity) != 0)
+    {
+        Fail("GetWriteWatch failed, error %u\n", GetLastError());
+    }
+
+    return count;
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    LPBYTE region;
+    LPBYTE unwatched;
+    int i;
+
+    //Initialize the PAL environment
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        ExitProcess(FAIL);
+    }
+
+    unwatched = (LPBYTE)VirtualAlloc(NULL, REGION_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (unwatched == NULL)
+    {
+        Fail("VirtualAlloc failed, error %u\n", GetLastError());
+    }
+    if (ResetWriteWatch(unwatched, REGION_SIZE) == 0)
+    {
+        Fail("ResetWriteWatch succeeded for memory that is not watched\n");
+    }
+
+    region = (LPBYTE)VirtualAlloc(NULL, REGION_SIZE, MEM_RESERVE | MEM_WRITE_WATCH, PAGE_NOACCESS);
+    if (region == NULL)
+    {
+        Trace("Write watching is not supported on this system\n");
+        VirtualFree(unwatched, 0, MEM_RELEASE);
+        PAL_Terminate();
+        return PASS;
+    }
+
+    /* Commit every other stride, so that the region has holes */
+    for (i = 0; i < REGION_SIZE / STRIDE; i += 2)
+    {
+        if (VirtualAlloc(region + i * STRIDE, STRIDE, MEM_COMMIT, PAGE_READWRITE) == NULL)
+        {
+            Fail("VirtualAlloc failed to commit, error %u\n", GetLastError());
+        }
+        region[i * STRIDE] = 1;
+    }
+
+    if (CountWritten(region, REGION_SIZE / 2) == 0 ||
+        CountWritten(region + REGION_SIZE / 2, REGION_SIZE / 2) == 0)
+    {
+        Fail("GetWriteWatch did not report the written pages\n");
+    }
+
+    /* Resetting the whole region, holes included, must succeed */
+    if (ResetWriteWatch(region, REGION_SIZE / 2) != 0)
+    {
+        Fail("ResetWriteWatch failed, error %u\n", GetLastError());
+    }
+
+    if (CountWritten(region, REGION_SIZE / 2) != 0)
+    {
+        Fail("ResetWriteWatch did not reset the written pages\n");
+    }
+    if (CountWritten(region + REGION_SIZE / 2, REGION_SIZE / 2) == 0)
+    {
+        Fail("ResetWriteWatch reset pages outside of its range\n");
+    }
+
+    /* A reset page is reported again once written */
+    region[2 * STRIDE + 16] = 2;
+    if (CountWritten(region, REGION_SIZE / 2) == 0)
+    {
+        Fail("GetWriteWatch did not report a page written after a reset\n");
+    }
+
+    if (ResetWriteWatch(region, REGION_SIZE) != 0 || CountWritten(region, REGION_SIZE) != 0)
+    {
+        Fail("ResetWriteWatch did not reset the whole region\n");
+    }
+
+    VirtualFree(region, 0, MEM_RELEASE);
+    VirtualFree(unwatched, 0, MEM_RELEASE);
+
+    PAL_Terminate();
+    return PASS;
+}
@@ -0,0 +1,176 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source:  virtualalloc.c
+**
+** Purpose: Positive test the VirtualAlloc API.
+**          Several threads reserve their own regions and commit,
+**          write, decommit and release pages in them at the same
+**          time, while also committing pages of a shared region.
+**          Ensure that every commit succeeds, is zeroed, and that
+**          decommitted pages are reported as reserved.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define THREAD_COUNT    8
+#define ITERATIONS      200
+#define PAGE_COUNT      16
+#define PAGE_SIZE_TEST  4096
+
+static LPBYTE g_sharedRegion = NULL;
+static volatile LONG g_failed = 0;
+
+static void CheckCommit(LPBYTE page)
+{
+    MEMORY_BASIC_INFORMATION mbi;
+
+    if (*page != 0)
+    {
+        Trace("VirtualAlloc did not zero committed page %p\n", page);
+        InterlockedExchange(&g_failed, 1);
+    }
+    *page = 0xcc;
+
+    if (VirtualQuery(page, &mbi, sizeof(mbi)) != sizeof(mbi) ||
+        mbi.State != MEM_COMMIT)
+    {
+        Trace("VirtualQuery did not report page %p as committed\n", page);
+        InterlockedExchange(&g_failed, 1);
+    }
+}
+
+static DWORD PALAPI StressThread(LPVOID lpParameter)
+{
+    int index = (int)(SIZE_T)lpParameter;
+    int i;
+    int j;
+
+    for (i = 0; i < ITERATIONS && g_failed == 0; i++)
+    {
+        LPBYTE region;
+        LPBYTE shared;
+        MEMORY_BASIC_INFORMATION mbi;
+
+        region = (LPBYTE)VirtualAlloc(NULL, PAGE_COUNT * PAGE_SIZE_TEST,
+                                      MEM_RESERVE, PAGE_NOACCESS);
+        if (region == NULL)
+        {
+            Trace("VirtualAlloc failed to reserve, error %u\n", GetLastError());
+            InterlockedExchange(&g_failed, 1);
+            break;
+        }
+
+        for (j = 0; j < PAGE_COUNT; j++)
+        {
+            LPBYTE page = region + j * PAGE_SIZE_TEST;
+
+            if (VirtualAlloc(page, PAGE_SIZE_TEST, MEM_COMMIT, PAGE_READWRITE) != page)
+            {
+                Trace("VirtualAlloc failed to commit, error %u\n", GetLastError());
+                InterlockedExchange(&g_failed, 1);
+                break;
+            }
+            CheckCommit(page);
+        }
+
+        for (j = 0; j < PAGE_COUNT; j += 2)
+        {
+            LPBYTE page = region + j * PAGE_SIZE_TEST;
+
+            if (!VirtualFree(page, PAGE_SIZE_TEST, MEM_DECOMMIT))
+            {
+                Trace("VirtualFree failed to decommit, error %u\n", GetLastError());
+                InterlockedExchange(&g_failed, 1);
+                break;
+            }
+            if (VirtualQuery(page, &mbi, sizeof(mbi)) != sizeof(mbi) ||
+                mbi.State != MEM_RESERVE)
+            {
+                Trace("VirtualQuery did not report page %p as reserved\n", page);
+                InterlockedExchange(&g_failed, 1);
+            }
+        }
+
+        // Each thread owns its own pages of the shared region, so the commit
+        // bitmap of that region is updated from all threads at once
+        shared = g_sharedRegion + ((i % 2) * THREAD_COUNT + index) * PAGE_SIZE_TEST;
+        if (VirtualAlloc(shared, PAGE_SIZE_TEST, MEM_COMMIT, PAGE_READWRITE) != shared)
+        {
+            Trace("VirtualAlloc failed to commit shared page, error %u\n", GetLastError());
+            InterlockedExchange(&g_failed, 1);
+            break;
+        }
+        CheckCommit(shared);
+        if (!VirtualFree(shared, PAGE_SIZE_TEST, MEM_DECOMMIT))
+        {
+            Trace("VirtualFree failed to decommit shared page, error %u\n", GetLastError());
+            InterlockedExchange(&g_failed, 1);
+            break;
+        }
+
+        if (!VirtualFree(region, 0, MEM_RELEASE))
+        {
+            Trace("VirtualFree failed to release, error %u\n", GetLastError());
+            InterlockedExchange(&g_failed, 1);
+            break;
+        }
+    }
+
+    return 0;
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    HANDLE threads[THREAD_COUNT];
+    DWORD threadId;
+    int i;
+
+    //Initialize the PAL environment
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        ExitProcess(FAIL);
+    }
+
+    g_sharedRegion = (LPBYTE)VirtualAlloc(NULL, 2 * THREAD_COUNT * PAGE_SIZE_TEST,
+                                          MEM_RESERVE, PAGE_NOACCESS);
+    if (g_sharedRegion == NULL)
+    {
+        Fail("VirtualAlloc failed to reserve the shared region!\n");
+    }
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        threads[i] = CreateThread(NULL, 0, StressThread, (LPVOID)(SIZE_T)i, 0, &threadId);
+        if (threads[i] == NULL)
+        {
+            Fail("CreateThread failed, error %u\n", GetLastError());
+        }
+    }
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        if (WaitForSingleObject(threads[i], INFINITE) != WAIT_OBJECT_0)
+        {
+            Fail("WaitForSingleObject failed, error %u\n", GetLastError());
+        }
+        CloseHandle(threads[i]);
+    }
+
+    if (g_failed != 0)
+    {
+        Fail("Concurrent VirtualAlloc/VirtualFree failed!\n");
+    }
+
+    if (!VirtualFree(g_sharedRegion, 0, MEM_RELEASE))
+    {
+        Fail("VirtualFree failed to release the shared region!\n");
+    }
+
+    PAL_Terminate();
+    return PASS;
+}
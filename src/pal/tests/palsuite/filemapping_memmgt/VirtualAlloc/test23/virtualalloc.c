@@ -0,0 +1,99 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source:  virtualalloc.c
+**
+** Purpose: Positive test the VirtualAlloc API.
+**          Reserve a region with MEM_LARGE_PAGES, commit all of it,
+**          write to it, decommit half of it and commit that half
+**          again. Whether the pages end up being huge depends on the
+**          system, so only the Windows semantics are checked.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define REGION_SIZE     (8 * 1024 * 1024)
+#define PAGE_SIZE_TEST  4096
+
+static void CheckState(LPBYTE address, SIZE_T size, DWORD state)
+{
+    MEMORY_BASIC_INFORMATION mbi;
+
+    if (VirtualQuery(address, &mbi, sizeof(mbi)) != sizeof(mbi))
+    {
+        Fail("VirtualQuery failed, error %u\n", GetLastError());
+    }
+    if (mbi.State != state || mbi.RegionSize < size)
+    {
+        Fail("VirtualQuery reported state %#x for %u bytes at %p, expected %#x for %u bytes\n",
+             mbi.State, (DWORD)mbi.RegionSize, address, state, (DWORD)size);
+    }
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    LPBYTE region;
+    SIZE_T i;
+
+    //Initialize the PAL environment
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        ExitProcess(FAIL);
+    }
+
+    region = (LPBYTE)VirtualAlloc(NULL, REGION_SIZE,
+                                  MEM_RESERVE | MEM_LARGE_PAGES, PAGE_NOACCESS);
+    if (region == NULL)
+    {
+        Fail("VirtualAlloc failed to reserve with MEM_LARGE_PAGES, error %u\n", GetLastError());
+    }
+    CheckState(region, REGION_SIZE, MEM_RESERVE);
+
+    if (VirtualAlloc(region, REGION_SIZE, MEM_COMMIT, PAGE_READWRITE) != region)
+    {
+        Fail("VirtualAlloc failed to commit, error %u\n", GetLastError());
+    }
+    CheckState(region, REGION_SIZE, MEM_COMMIT);
+
+    for (i = 0; i < REGION_SIZE; i += PAGE_SIZE_TEST)
+    {
+        if (region[i] != 0)
+        {
+            Fail("VirtualAlloc did not zero the page at offset %u\n", (DWORD)i);
+        }
+        region[i] = 0xcc;
+    }
+
+    if (!VirtualFree(region, REGION_SIZE / 2, MEM_DECOMMIT))
+    {
+        Fail("VirtualFree failed to decommit, error %u\n", GetLastError());
+    }
+    CheckState(region, REGION_SIZE / 2, MEM_RESERVE);
+    CheckState(region + REGION_SIZE / 2, REGION_SIZE / 2, MEM_COMMIT);
+
+    if (VirtualAlloc(region, REGION_SIZE / 2, MEM_COMMIT, PAGE_READWRITE) != region)
+    {
+        Fail("VirtualAlloc failed to commit again, error %u\n", GetLastError());
+    }
+    for (i = 0; i < REGION_SIZE; i += PAGE_SIZE_TEST)
+    {
+        BYTE expected = (i < REGION_SIZE / 2) ? 0 : 0xcc;
+
+        if (region[i] != expected)
+        {
+            Fail("Unexpected content %#x at offset %u\n", region[i], (DWORD)i);
+        }
+    }
+
+    if (!VirtualFree(region, 0, MEM_RELEASE))
+    {
+        Fail("VirtualFree failed to release, error %u\n", GetLastError());
+    }
+
+    PAL_Terminate();
+    return PASS;
+}
@@ -0,0 +1,84 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: PAL_GetCGroupLimits.c
+**
+** Purpose: Positive test the PAL_GetCGroupLimits API.
+**          Ensures that GetSystemInfo and GlobalMemoryStatusEx
+**          do not report more processors or physical memory than
+**          the cgroup limits of the process allow.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+int __cdecl main(int argc, char *argv[])
+{
+    PAL_CGROUP_LIMITS limits;
+    SYSTEM_INFO systemInfo;
+    MEMORYSTATUSEX memoryStatus;
+
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    if (!PAL_GetCGroupLimits(&limits))
+    {
+        Fail("PAL_GetCGroupLimits failed, error %u\n", GetLastError());
+    }
+
+    Trace("cgroup v%u: %u CPUs, weight %u, memory limit %llu, usage %llu\n",
+          limits.dwVersion, limits.dwCpuLimit, limits.dwCpuWeight,
+          limits.ullMemoryLimit, limits.ullMemoryUsage);
+
+    if (limits.dwVersion == 0 &&
+        (limits.dwCpuLimit != 0 || limits.ullMemoryLimit != 0))
+    {
+        Fail("PAL_GetCGroupLimits reported limits without a cgroup version\n");
+    }
+
+    GetSystemInfo(&systemInfo);
+    if (systemInfo.dwNumberOfProcessors < 1)
+    {
+        Fail("GetSystemInfo reported %u processors\n", systemInfo.dwNumberOfProcessors);
+    }
+    if (limits.dwCpuLimit != 0 &&
+        systemInfo.dwNumberOfProcessors > limits.dwCpuLimit)
+    {
+        Fail("GetSystemInfo reported %u processors with a CPU limit of %u\n",
+             systemInfo.dwNumberOfProcessors, limits.dwCpuLimit);
+    }
+    if (limits.dwCpuLimit != 0 &&
+        PAL_GetLogicalCpuCountFromOS() > limits.dwCpuLimit)
+    {
+        Fail("PAL_GetLogicalCpuCountFromOS reported %u processors with a CPU limit of %u\n",
+             PAL_GetLogicalCpuCountFromOS(), limits.dwCpuLimit);
+    }
+
+    memoryStatus.dwLength = sizeof(memoryStatus);
+    if (!GlobalMemoryStatusEx(&memoryStatus))
+    {
+        Fail("GlobalMemoryStatusEx failed, error %u\n", GetLastError());
+    }
+    if (limits.ullMemoryLimit != 0 &&
+        memoryStatus.ullTotalPhys > limits.ullMemoryLimit)
+    {
+        Fail("GlobalMemoryStatusEx reported %llu bytes of physical memory with "
+             "a memory limit of %llu\n",
+             memoryStatus.ullTotalPhys, limits.ullMemoryLimit);
+    }
+    if (memoryStatus.ullAvailPhys > memoryStatus.ullTotalPhys ||
+        memoryStatus.dwMemoryLoad > 100)
+    {
+        Fail("GlobalMemoryStatusEx reported %llu of %llu bytes available, "
+             "load %u\n", memoryStatus.ullAvailPhys, memoryStatus.ullTotalPhys,
+             memoryStatus.dwMemoryLoad);
+    }
+
+    PAL_Terminate();
+    return PASS;
+}
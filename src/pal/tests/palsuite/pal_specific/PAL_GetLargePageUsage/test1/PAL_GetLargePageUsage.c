@@ -0,0 +1,76 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: PAL_GetLargePageUsage.c
+**
+** Purpose: Positive test the PAL_GetLargePageUsage API.
+**          Commits and touches memory reserved with
+**          MEM_LARGE_PAGES and ensures that it is reported as
+**          resident, unless the system does not support
+**          transparent huge pages and nothing is reported.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define REGION_SIZE (8 * 1024 * 1024)
+
+int __cdecl main(int argc, char *argv[])
+{
+    PAL_LARGE_PAGE_USAGE usage;
+    char *region;
+    int i;
+
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    if (PAL_GetLargePageUsage(NULL))
+    {
+        Fail("PAL_GetLargePageUsage succeeded without a buffer\n");
+    }
+
+    region = (char *)VirtualAlloc(NULL, REGION_SIZE, MEM_RESERVE | MEM_LARGE_PAGES, PAGE_NOACCESS);
+    if (region == NULL)
+    {
+        Fail("VirtualAlloc failed to reserve, error %u\n", GetLastError());
+    }
+    if (VirtualAlloc(region, REGION_SIZE, MEM_COMMIT, PAGE_READWRITE) == NULL)
+    {
+        Fail("VirtualAlloc failed to commit, error %u\n", GetLastError());
+    }
+    for (i = 0; i < REGION_SIZE; i += 4096)
+    {
+        region[i] = 1;
+    }
+
+    if (!PAL_GetLargePageUsage(&usage))
+    {
+        Fail("PAL_GetLargePageUsage failed, error %u\n", GetLastError());
+    }
+
+    Trace("%llu resident bytes, %llu backed by huge pages\n",
+          usage.ullResidentSize, usage.ullHugePageSize);
+
+    if (usage.ullHugePageSize > usage.ullResidentSize)
+    {
+        Fail("PAL_GetLargePageUsage reported more huge page bytes than resident bytes\n");
+    }
+    if (usage.ullResidentSize != 0 && usage.ullResidentSize < REGION_SIZE)
+    {
+        Fail("PAL_GetLargePageUsage reported %llu resident bytes after touching %u\n",
+             usage.ullResidentSize, REGION_SIZE);
+    }
+
+    if (!VirtualFree(region, 0, MEM_RELEASE))
+    {
+        Fail("VirtualFree failed, error %u\n", GetLastError());
+    }
+
+    PAL_Terminate();
+    return PASS;
+}
@@ -0,0 +1,161 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: PAL_WaitSet.c
+**
+** Purpose: Positive test the PAL wait sets. An auto reset event
+**          (added twice), a manual reset event and a semaphore are
+**          added to a set; each signal must be reported once and
+**          acquire the object, a manual reset event must be reported
+**          for as long as it stays set, and a signal from another
+**          thread must wake up a thread blocked on the set.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define CONTEXT_AUTO        ((PVOID)1)
+#define CONTEXT_AUTO_AGAIN  ((PVOID)2)
+#define CONTEXT_MANUAL      ((PVOID)3)
+#define CONTEXT_SEMAPHORE   ((PVOID)4)
+
+static HANDLE g_hAutoEvent;
+
+static DWORD PALAPI SignalThread(LPVOID lpParameter)
+{
+    Sleep(100);
+    SetEvent(g_hAutoEvent);
+    return 0;
+}
+
+static void CheckWait(PAL_WAIT_SET hWaitSet, DWORD dwMilliseconds,
+                      PVOID pvExpected, PVOID pvAlternate)
+{
+    PVOID rgpvContexts[4];
+    DWORD dwCount;
+
+    dwCount = PAL_WaitSetWait(hWaitSet, dwMilliseconds, rgpvContexts, 4);
+    if (pvExpected == NULL)
+    {
+        if (dwCount != 0)
+        {
+            Fail("PAL_WaitSetWait returned %u contexts, expected none\n", dwCount);
+        }
+        return;
+    }
+
+    if (dwCount != 1)
+    {
+        Fail("PAL_WaitSetWait returned %u, expected 1 context, error %u\n",
+             dwCount, GetLastError());
+    }
+    if (rgpvContexts[0] != pvExpected && rgpvContexts[0] != pvAlternate)
+    {
+        Fail("PAL_WaitSetWait returned context %p, expected %p\n",
+             rgpvContexts[0], pvExpected);
+    }
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    PAL_WAIT_SET hWaitSet;
+    HANDLE hManualEvent;
+    HANDLE hSemaphore;
+    HANDLE hThread;
+    PVOID rgpvRegistrations[4];
+    DWORD dwThreadId;
+    int i;
+
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    hWaitSet = PAL_CreateWaitSet();
+    if (hWaitSet == NULL)
+    {
+        if (GetLastError() == ERROR_NOT_SUPPORTED)
+        {
+            Trace("Wait sets are not supported on this platform\n");
+            PAL_Terminate();
+            return PASS;
+        }
+        Fail("PAL_CreateWaitSet failed, error %u\n", GetLastError());
+    }
+
+    g_hAutoEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    hManualEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    hSemaphore = CreateSemaphore(NULL, 0, 10, NULL);
+    if (g_hAutoEvent == NULL || hManualEvent == NULL || hSemaphore == NULL)
+    {
+        Fail("Unable to create the objects, error %u\n", GetLastError());
+    }
+
+    if (!PAL_WaitSetAdd(hWaitSet, g_hAutoEvent, CONTEXT_AUTO, &rgpvRegistrations[0]) ||
+        !PAL_WaitSetAdd(hWaitSet, g_hAutoEvent, CONTEXT_AUTO_AGAIN, &rgpvRegistrations[1]) ||
+        !PAL_WaitSetAdd(hWaitSet, hManualEvent, CONTEXT_MANUAL, &rgpvRegistrations[2]) ||
+        !PAL_WaitSetAdd(hWaitSet, hSemaphore, CONTEXT_SEMAPHORE, &rgpvRegistrations[3]))
+    {
+        Fail("PAL_WaitSetAdd failed, error %u\n", GetLastError());
+    }
+
+    CheckWait(hWaitSet, 0, NULL, NULL);
+
+    // An auto reset event is reported once, through either registration,
+    // and is acquired by the wait
+    SetEvent(g_hAutoEvent);
+    CheckWait(hWaitSet, 1000, CONTEXT_AUTO, CONTEXT_AUTO_AGAIN);
+    CheckWait(hWaitSet, 0, NULL, NULL);
+    if (WaitForSingleObject(g_hAutoEvent, 0) != WAIT_TIMEOUT)
+    {
+        Fail("The auto reset event was not acquired by the wait set\n");
+    }
+
+    // A manual reset event is reported until it is reset
+    SetEvent(hManualEvent);
+    CheckWait(hWaitSet, 1000, CONTEXT_MANUAL, NULL);
+    CheckWait(hWaitSet, 1000, CONTEXT_MANUAL, NULL);
+    ResetEvent(hManualEvent);
+    CheckWait(hWaitSet, 0, NULL, NULL);
+
+    // Each unit of a semaphore is reported once
+    ReleaseSemaphore(hSemaphore, 3, NULL);
+    for (i = 0; i < 3; i++)
+    {
+        CheckWait(hWaitSet, 1000, CONTEXT_SEMAPHORE, NULL);
+    }
+    CheckWait(hWaitSet, 0, NULL, NULL);
+
+    // A signal from another thread wakes up the waiting thread
+    hThread = CreateThread(NULL, 0, SignalThread, NULL, 0, &dwThreadId);
+    if (hThread == NULL)
+    {
+        Fail("CreateThread failed, error %u\n", GetLastError());
+    }
+    CheckWait(hWaitSet, 10000, CONTEXT_AUTO, CONTEXT_AUTO_AGAIN);
+    WaitForSingleObject(hThread, INFINITE);
+    CloseHandle(hThread);
+
+    // Objects removed from the set are no longer reported
+    for (i = 0; i < 4; i++)
+    {
+        PAL_WaitSetRemove(hWaitSet, rgpvRegistrations[i]);
+    }
+    SetEvent(g_hAutoEvent);
+    CheckWait(hWaitSet, 0, NULL, NULL);
+    if (WaitForSingleObject(g_hAutoEvent, 0) != WAIT_OBJECT_0)
+    {
+        Fail("The auto reset event was acquired after its removal\n");
+    }
+
+    PAL_DeleteWaitSet(hWaitSet);
+    CloseHandle(g_hAutoEvent);
+    CloseHandle(hManualEvent);
+    CloseHandle(hSemaphore);
+
+    PAL_Terminate();
+    return PASS;
+}
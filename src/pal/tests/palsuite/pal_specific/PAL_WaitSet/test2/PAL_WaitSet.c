@@ -0,0 +1,138 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: PAL_WaitSet.c
+**
+** Purpose: Test the objects accepted by the PAL wait sets. A thread
+**          handle must be reported once the thread exits, and keep
+**          being reported since a thread stays signaled. A process
+**          handle must be rejected, since the exit of a process is
+**          only noticed for processes that a thread is blocked on.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define CONTEXT_THREAD  ((PVOID)1)
+#define CONTEXT_PROCESS ((PVOID)2)
+
+static HANDLE g_hExitEvent;
+
+static DWORD PALAPI ExitingThread(LPVOID lpParameter)
+{
+    WaitForSingleObject(g_hExitEvent, INFINITE);
+    return 0;
+}
+
+static DWORD CountContexts(PAL_WAIT_SET hWaitSet, DWORD dwMilliseconds)
+{
+    PVOID rgpvContexts[4];
+    DWORD dwCount;
+    DWORD i;
+
+    dwCount = PAL_WaitSetWait(hWaitSet, dwMilliseconds, rgpvContexts, 4);
+    if (dwCount == WAIT_FAILED)
+    {
+        Fail("PAL_WaitSetWait failed, error %u\n", GetLastError());
+    }
+
+    for (i = 0; i < dwCount; i++)
+    {
+        if (rgpvContexts[i] != CONTEXT_THREAD)
+        {
+            Fail("PAL_WaitSetWait returned context %p, expected %p\n",
+                 rgpvContexts[i], CONTEXT_THREAD);
+        }
+    }
+
+    return dwCount;
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    PAL_WAIT_SET hWaitSet;
+    HANDLE hThread;
+    HANDLE hProcess;
+    PVOID pvRegistration;
+    DWORD dwThreadId;
+
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    hWaitSet = PAL_CreateWaitSet();
+    if (hWaitSet == NULL)
+    {
+        if (GetLastError() == ERROR_NOT_SUPPORTED)
+        {
+            Trace("Wait sets are not supported on this platform\n");
+            PAL_Terminate();
+            return PASS;
+        }
+        Fail("PAL_CreateWaitSet failed, error %u\n", GetLastError());
+    }
+
+    // A thread is reported when it exits
+    g_hExitEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (g_hExitEvent == NULL)
+    {
+        Fail("CreateEvent failed, error %u\n", GetLastError());
+    }
+
+    hThread = CreateThread(NULL, 0, ExitingThread, NULL, 0, &dwThreadId);
+    if (hThread == NULL)
+    {
+        Fail("CreateThread failed, error %u\n", GetLastError());
+    }
+
+    if (!PAL_WaitSetAdd(hWaitSet, hThread, CONTEXT_THREAD, &pvRegistration))
+    {
+        Fail("PAL_WaitSetAdd failed for a thread, error %u\n", GetLastError());
+    }
+
+    if (CountContexts(hWaitSet, 100) != 0)
+    {
+        Fail("A running thread was reported by the wait set\n");
+    }
+
+    SetEvent(g_hExitEvent);
+
+    if (CountContexts(hWaitSet, 10000) != 1)
+    {
+        Fail("The exit of the thread was not reported by the wait set\n");
+    }
+    if (CountContexts(hWaitSet, 1000) != 1)
+    {
+        Fail("An exited thread was not reported again by the wait set\n");
+    }
+
+    PAL_WaitSetRemove(hWaitSet, pvRegistration);
+    if (CountContexts(hWaitSet, 0) != 0)
+    {
+        Fail("A removed thread was reported by the wait set\n");
+    }
+
+    // Process handles are rejected
+    hProcess = OpenProcess(PROCESS_ALL_ACCESS, FALSE, GetCurrentProcessId());
+    if (hProcess == NULL)
+    {
+        Fail("OpenProcess failed, error %u\n", GetLastError());
+    }
+
+    if (PAL_WaitSetAdd(hWaitSet, hProcess, CONTEXT_PROCESS, &pvRegistration))
+    {
+        Fail("PAL_WaitSetAdd accepted a process handle\n");
+    }
+
+    PAL_DeleteWaitSet(hWaitSet);
+    CloseHandle(hProcess);
+    CloseHandle(hThread);
+    CloseHandle(g_hExitEvent);
+
+    PAL_Terminate();
+    return PASS;
+}
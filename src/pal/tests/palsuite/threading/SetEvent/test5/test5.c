@@ -0,0 +1,144 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================================
+**
+** Source: test5.c
+**
+** Dependencies: PAL_Initialize
+**               PAL_Terminate
+**               CreateEvent
+**               CreateSemaphore
+**               ReleaseSemaphore
+**               CreateThread
+**               CloseHandle
+**               WaitForSingleObject
+**               GetTickCount
+**
+** Purpose:
+**
+** Test to ensure that no wakeup is lost when two threads repeatedly
+** signal and wait on each other. The main thread and a helper thread
+** play ping-pong first through a pair of auto-reset events and then
+** through a pair of semaphores; every wait has a timeout, so a lost
+** wakeup makes the test fail instead of hang. The round-trip rate is
+** traced so the test doubles as a wait/signal latency benchmark.
+**
+**
+**===========================================================================*/
+#include <palsuite.h>
+
+#define ROUND_TRIPS     100000
+#define WAIT_TIMEOUT_MS 10000
+
+static HANDLE hPing = NULL;
+static HANDLE hPong = NULL;
+static BOOL   bUseSemaphores = FALSE;
+
+static BOOL Signal(HANDLE hObject)
+{
+    if (bUseSemaphores)
+    {
+        return ReleaseSemaphore(hObject, 1, NULL);
+    }
+    return SetEvent(hObject);
+}
+
+static DWORD PALAPI PongThread(LPVOID lpParameter)
+{
+    int i;
+
+    for (i = 0; i < ROUND_TRIPS; i++)
+    {
+        if (WaitForSingleObject(hPing, WAIT_TIMEOUT_MS) != WAIT_OBJECT_0)
+        {
+            Trace("Pong thread did not see ping %d, error %u\n",
+                  i, GetLastError());
+            return FAIL;
+        }
+        if (!Signal(hPong))
+        {
+            Trace("Pong thread failed to signal, error %u\n", GetLastError());
+            return FAIL;
+        }
+    }
+
+    return PASS;
+}
+
+static void RunPingPong(const char *szKind)
+{
+    HANDLE hThread;
+    DWORD dwThreadId;
+    DWORD dwExitCode;
+    DWORD dwStart;
+    DWORD dwElapsed;
+    int i;
+
+    hThread = CreateThread(NULL, 0, PongThread, NULL, 0, &dwThreadId);
+    if (hThread == NULL)
+    {
+        Fail("CreateThread failed, error %u\n", GetLastError());
+    }
+
+    dwStart = GetTickCount();
+    for (i = 0; i < ROUND_TRIPS; i++)
+    {
+        if (!Signal(hPing))
+        {
+            Fail("Failed to signal %s %d, error %u\n", szKind, i, GetLastError());
+        }
+        if (WaitForSingleObject(hPong, WAIT_TIMEOUT_MS) != WAIT_OBJECT_0)
+        {
+            Fail("Lost wakeup: no pong for %s %d, error %u\n",
+                 szKind, i, GetLastError());
+        }
+    }
+    dwElapsed = GetTickCount() - dwStart;
+
+    if (WaitForSingleObject(hThread, WAIT_TIMEOUT_MS) != WAIT_OBJECT_0)
+    {
+        Fail("Pong thread did not exit, error %u\n", GetLastError());
+    }
+    if (!GetExitCodeThread(hThread, &dwExitCode) || dwExitCode != PASS)
+    {
+        Fail("Pong thread failed for %s\n", szKind);
+    }
+    CloseHandle(hThread);
+
+    Trace("%d %s round trips in %u ms\n", ROUND_TRIPS, szKind, dwElapsed);
+}
+
+int __cdecl main( int argc, char **argv )
+{
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    hPing = CreateEvent(NULL, FALSE, FALSE, NULL);
+    hPong = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (hPing == NULL || hPong == NULL)
+    {
+        Fail("CreateEvent failed, error %u\n", GetLastError());
+    }
+    bUseSemaphores = FALSE;
+    RunPingPong("event");
+    CloseHandle(hPing);
+    CloseHandle(hPong);
+
+    hPing = CreateSemaphore(NULL, 0, 1, NULL);
+    hPong = CreateSemaphore(NULL, 0, 1, NULL);
+    if (hPing == NULL || hPong == NULL)
+    {
+        Fail("CreateSemaphore failed, error %u\n", GetLastError());
+    }
+    bUseSemaphores = TRUE;
+    RunPingPong("semaphore");
+    CloseHandle(hPing);
+    CloseHandle(hPong);
+
+    PAL_Terminate();
+    return PASS;
+}
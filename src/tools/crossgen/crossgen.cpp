@@ -162,6 +162,9 @@ void PrintUsageHelper()
 #ifdef FEATURE_READYTORUN_COMPILER
        W("    /ReadyToRun          - Generate images resilient to the runtime and\n")
        W("                           dependency versions\n")
+       W("    /LargeVersionBubble  - Treat all input and reference assemblies as one\n")
+       W("                           version bubble, allowing cross-assembly inlining.\n")
+       W("                           The assemblies must be serviced together.\n")
 #endif
 #ifdef FEATURE_WINMD_RESILIENT
        W(" WinMD Parameters\n")
@@ -566,6 +569,10 @@ int _cdecl wmain(int argc, __in_ecount(argc) WCHAR **argv)
         {
             dwFlags &= ~NGENWORKER_FLAGS_READYTORUN;
         }
+        else if (MatchParameter(*argv, W("LargeVersionBubble")))
+        {
+            dwFlags |= NGENWORKER_FLAGS_LARGEVERSIONBUBBLE;
+        }
 #endif
 #ifdef FEATURE_CORECLR
         else if (MatchParameter(*argv, W("NoMetaData")))
@@ -870,6 +877,12 @@ int _cdecl wmain(int argc, __in_ecount(argc) WCHAR **argv)
         Output(W("The /Tuning switch cannot be used with /ReadyToRun switch.\n"));
         exit(FAILURE_RESULT);
     }
+
+    if (((dwFlags & NGENWORKER_FLAGS_LARGEVERSIONBUBBLE) != 0) && ((dwFlags & NGENWORKER_FLAGS_READYTORUN) == 0))
+    {
+        Output(W("The /LargeVersionBubble switch can only be used with /ReadyToRun switch.\n"));
+        exit(FAILURE_RESULT);
+    }
 #endif
     
     // All argument processing has happened by now. The only messages that should appear before here are errors
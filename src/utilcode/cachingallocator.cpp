@@ -0,0 +1,495 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+//*****************************************************************************
+// CachingAllocator.cpp
+//
+// Size class allocator with per-thread caches for small native allocations.
+// See cachingallocator.h for an overview.
+//*****************************************************************************
+
+#include "stdafx.h"
+#include "utilcode.h"
+#include "log.h"
+#include "cachingallocator.h"
+
+CachingAllocator CachingAllocator::s_singleton;
+bool CachingAllocator::s_fEnabled = false;
+
+namespace
+{
+    // Every chunk starts at an address that is a multiple of its size, see
+    // AllocateChunk
+    const size_t ChunkSize = 0x10000;
+    const unsigned ChunkShift = 16;
+
+    const USHORT s_blockSizes[CachingAllocator::SizeClassCount] =
+    {
+        16, 32, 48, 64, 80, 96, 112, 128,
+        160, 192, 224, 256,
+        320, 384, 448, 512,
+        640, 768, 896, 1024
+    };
+
+    // Maps a request size in [0, MaxBlockSize] to the smallest size class
+    // that can hold it. Classes are 16 bytes apart up to 128 bytes, after
+    // which each power of two range is split into four classes.
+    inline unsigned GetSizeClass(size_t sz)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        if (sz <= 128)
+            return sz == 0 ? 0 : (unsigned)((sz + 15) >> 4) - 1;
+        if (sz <= 256)
+            return 8 + (unsigned)((sz - 128 + 31) >> 5) - 1;
+        if (sz <= 512)
+            return 12 + (unsigned)((sz - 256 + 63) >> 6) - 1;
+        return 16 + (unsigned)((sz - 512 + 127) >> 7) - 1;
+    }
+
+    // Number of blocks moved between a thread cache and the shared list at
+    // a time. A thread caches at most twice that many blocks of a class.
+    inline DWORD GetBatchSize(unsigned sizeClass)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        DWORD count = (DWORD)(4096 / s_blockSizes[sizeClass]);
+        if (count < 4)
+            return 4;
+        if (count > 32)
+            return 32;
+        return count;
+    }
+
+    //-------------------------------------------------------------------------
+    // Chunk map
+    //
+    // Records which chunks belong to the allocator, so that Free can tell its
+    // own blocks from the ones of the process heap. The address space is split
+    // into 4GB ranges; each range that holds chunks has a leaf with one byte
+    // per chunk, holding the size class of the chunk plus one, or zero if the
+    // memory is not a chunk. Leaves are published once and never freed.
+    //-------------------------------------------------------------------------
+
+#ifdef _WIN64
+    // User mode addresses fit in 48 bits on all supported 64-bit platforms
+    const size_t ChunkMapRootCount = 0x10000;
+#else
+    const size_t ChunkMapRootCount = 1;
+#endif
+    const size_t ChunkMapLeafSize = 0x10000;
+
+    BYTE * volatile s_chunkMap[ChunkMapRootCount];
+
+    inline size_t GetChunkMapRoot(UINT_PTR addr)
+    {
+        LIMITED_METHOD_CONTRACT;
+#ifdef _WIN64
+        return (size_t)(addr >> 32);
+#else
+        return 0;
+#endif
+    }
+
+    inline size_t GetChunkMapIndex(UINT_PTR addr)
+    {
+        LIMITED_METHOD_CONTRACT;
+        return (size_t)((addr & 0xFFFFFFFF) >> ChunkShift);
+    }
+
+    // Returns the size class of the chunk that p belongs to, or -1 if p was
+    // not handed out by the allocator
+    inline int LookupSizeClass(void * p)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        UINT_PTR addr = (UINT_PTR)p;
+        size_t root = GetChunkMapRoot(addr);
+        if (root >= ChunkMapRootCount)
+            return -1;
+
+        BYTE * pLeaf = s_chunkMap[root];
+        if (pLeaf == NULL)
+            return -1;
+
+        return (int)pLeaf[GetChunkMapIndex(addr)] - 1;
+    }
+
+    bool RegisterChunk(void * pChunk, unsigned sizeClass)
+    {
+        WRAPPER_NO_CONTRACT;
+
+        UINT_PTR addr = (UINT_PTR)pChunk;
+        size_t root = GetChunkMapRoot(addr);
+        if (root >= ChunkMapRootCount)
+            return false;
+
+        BYTE * pLeaf = s_chunkMap[root];
+        if (pLeaf == NULL)
+        {
+            BYTE * pNewLeaf = (BYTE *)ClrVirtualAlloc(NULL, ChunkMapLeafSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+            if (pNewLeaf == NULL)
+                return false;
+
+            pLeaf = InterlockedCompareExchangeT(&s_chunkMap[root], pNewLeaf, (BYTE *)NULL);
+            if (pLeaf == NULL)
+            {
+                pLeaf = pNewLeaf;
+            }
+            else
+            {
+                // Another thread published a leaf for this range first
+                ClrVirtualFree(pNewLeaf, 0, MEM_RELEASE);
+            }
+        }
+
+        // The blocks of the chunk are only handed out through the lock of the
+        // size class, which orders this store before any Free of them
+        VolatileStore(&pLeaf[GetChunkMapIndex(addr)], (BYTE)(sizeClass + 1));
+        return true;
+    }
+
+    // The chunk map needs every chunk to start on a ChunkSize boundary
+    void * AllocateChunk(unsigned sizeClass)
+    {
+        WRAPPER_NO_CONTRACT;
+
+#ifndef FEATURE_PAL
+        // VirtualAlloc reserves at the 64KB allocation granularity
+        void * pReservation = ClrVirtualAlloc(NULL, ChunkSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (pReservation == NULL)
+            return NULL;
+
+        void * pChunk = pReservation;
+#else // !FEATURE_PAL
+        // The PAL only aligns reservations to the page size. Reserve twice the
+        // chunk size and commit the aligned chunk within it; the rest of the
+        // reservation is never committed.
+        void * pReservation = ClrVirtualAlloc(NULL, 2 * ChunkSize, MEM_RESERVE, PAGE_NOACCESS);
+        if (pReservation == NULL)
+            return NULL;
+
+        void * pChunk = ALIGN_UP(pReservation, ChunkSize);
+        if (ClrVirtualAlloc(pChunk, ChunkSize, MEM_COMMIT, PAGE_READWRITE) == NULL)
+        {
+            ClrVirtualFree(pReservation, 0, MEM_RELEASE);
+            return NULL;
+        }
+#endif // !FEATURE_PAL
+
+        _ASSERTE(((UINT_PTR)pChunk & (ChunkSize - 1)) == 0);
+
+        if (!RegisterChunk(pChunk, sizeClass))
+        {
+            ClrVirtualFree(pReservation, 0, MEM_RELEASE);
+            return NULL;
+        }
+
+        return pChunk;
+    }
+
+    //-------------------------------------------------------------------------
+    // Shared lists
+    //
+    // Free blocks of each size class that are not cached by any thread. The
+    // lock is only held for a few instructions per block moved, so waiters
+    // spin instead of blocking.
+    //-------------------------------------------------------------------------
+
+    struct DECLSPEC_ALIGN(64) SharedList
+    {
+        LONG volatile   m_lock;
+        DWORD           m_count;
+        void *          m_pHead;
+        UINT64          m_allocations;
+        UINT64          m_frees;
+        UINT64          m_chunks;
+    };
+
+    SharedList s_sharedLists[CachingAllocator::SizeClassCount];
+
+    void AcquireLock(LONG volatile * pLock)
+    {
+        WRAPPER_NO_CONTRACT;
+
+        DWORD spins = 0;
+        while (InterlockedCompareExchange(pLock, 1, 0) != 0)
+        {
+            if (++spins < 64)
+                YieldProcessor();
+            else
+                SwitchToThread();
+        }
+    }
+
+    void ReleaseLock(LONG volatile * pLock)
+    {
+        LIMITED_METHOD_CONTRACT;
+        InterlockedExchange(pLock, 0);
+    }
+
+    //-------------------------------------------------------------------------
+    // Thread caches
+    //-------------------------------------------------------------------------
+
+    struct ThreadCache
+    {
+        void *  m_pHead[CachingAllocator::SizeClassCount];
+        DWORD   m_count[CachingAllocator::SizeClassCount];
+        // Counts not yet added to the statistics of the shared list
+        DWORD   m_allocations[CachingAllocator::SizeClassCount];
+        DWORD   m_frees[CachingAllocator::SizeClassCount];
+        // Set once the cache has been flushed for thread exit
+        bool    m_fDetached;
+    };
+
+    __declspec(thread) ThreadCache t_threadCache;
+
+    // Must be called with the lock of the size class held
+    inline void PublishCounts(ThreadCache * pCache, SharedList * pList, unsigned sizeClass)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        pList->m_allocations += pCache->m_allocations[sizeClass];
+        pList->m_frees += pCache->m_frees[sizeClass];
+        pCache->m_allocations[sizeClass] = 0;
+        pCache->m_frees[sizeClass] = 0;
+    }
+
+    // Moves up to count blocks from the shared list to the thread cache,
+    // carving a new chunk if the shared list is empty. Returns the number of
+    // blocks moved, which is zero only if we ran out of memory.
+    DWORD TakeBlocks(ThreadCache * pCache, unsigned sizeClass, DWORD count)
+    {
+        WRAPPER_NO_CONTRACT;
+
+        SharedList * pList = &s_sharedLists[sizeClass];
+
+        AcquireLock(&pList->m_lock);
+        PublishCounts(pCache, pList, sizeClass);
+
+        if (pList->m_pHead == NULL)
+        {
+            // Don't hold the lock across the call into the OS
+            ReleaseLock(&pList->m_lock);
+            BYTE * pChunk = (BYTE *)AllocateChunk(sizeClass);
+            AcquireLock(&pList->m_lock);
+
+            if (pChunk != NULL)
+            {
+                size_t blockSize = s_blockSizes[sizeClass];
+                DWORD blockCount = (DWORD)(ChunkSize / blockSize);
+
+                // Link the blocks in address order
+                for (DWORD i = blockCount; i > 0; i--)
+                {
+                    void * pBlock = pChunk + (i - 1) * blockSize;
+                    *(void **)pBlock = pList->m_pHead;
+                    pList->m_pHead = pBlock;
+                }
+                pList->m_count += blockCount;
+                pList->m_chunks++;
+            }
+        }
+
+        void * pHead = pCache->m_pHead[sizeClass];
+        DWORD taken = 0;
+        while (taken < count && pList->m_pHead != NULL)
+        {
+            void * pBlock = pList->m_pHead;
+            pList->m_pHead = *(void **)pBlock;
+            *(void **)pBlock = pHead;
+            pHead = pBlock;
+            taken++;
+        }
+        pList->m_count -= taken;
+
+        ReleaseLock(&pList->m_lock);
+
+        pCache->m_pHead[sizeClass] = pHead;
+        pCache->m_count[sizeClass] += taken;
+        return taken;
+    }
+
+    // Moves the first count blocks of the thread cache to the shared list
+    void GiveBlocks(ThreadCache * pCache, unsigned sizeClass, DWORD count)
+    {
+        WRAPPER_NO_CONTRACT;
+
+        _ASSERTE(count <= pCache->m_count[sizeClass]);
+
+        SharedList * pList = &s_sharedLists[sizeClass];
+        void * pFirst = NULL;
+        void * pLast = NULL;
+
+        if (count != 0)
+        {
+            pFirst = pCache->m_pHead[sizeClass];
+            pLast = pFirst;
+            for (DWORD i = 1; i < count; i++)
+            {
+                pLast = *(void **)pLast;
+            }
+            pCache->m_pHead[sizeClass] = *(void **)pLast;
+            pCache->m_count[sizeClass] -= count;
+        }
+
+        AcquireLock(&pList->m_lock);
+        PublishCounts(pCache, pList, sizeClass);
+        if (count != 0)
+        {
+            *(void **)pLast = pList->m_pHead;
+            pList->m_pHead = pFirst;
+            pList->m_count += count;
+        }
+        ReleaseLock(&pList->m_lock);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Returns NULL if we are out of memory. Requests larger than MaxBlockSize are
+// passed on to the process heap.
+//-----------------------------------------------------------------------------
+void* CachingAllocator::Alloc(size_t sz)
+{
+    WRAPPER_NO_CONTRACT;
+
+    if (sz > MaxBlockSize)
+    {
+        return ClrAllocInProcessHeap(0, S_SIZE_T(sz));
+    }
+
+    unsigned sizeClass = GetSizeClass(sz);
+    ThreadCache * pCache = &t_threadCache;
+
+    if (pCache->m_pHead[sizeClass] == NULL)
+    {
+        DWORD count = pCache->m_fDetached ? 1 : GetBatchSize(sizeClass);
+        if (TakeBlocks(pCache, sizeClass, count) == 0)
+        {
+            return NULL;
+        }
+    }
+
+    void * pBlock = pCache->m_pHead[sizeClass];
+    pCache->m_pHead[sizeClass] = *(void **)pBlock;
+    pCache->m_count[sizeClass]--;
+    pCache->m_allocations[sizeClass]++;
+
+    return pBlock;
+}
+
+void* CachingAllocator::ArrayAlloc(size_t elemSize, size_t numElems)
+{
+    WRAPPER_NO_CONTRACT;
+
+    ClrSafeInt<size_t> safeElemSize(elemSize);
+    ClrSafeInt<size_t> safeNumElems(numElems);
+    ClrSafeInt<size_t> sz = safeElemSize * safeNumElems;
+    if (sz.IsOverflow())
+    {
+        return NULL;
+    }
+    else
+    {
+        return Alloc(sz.Value());
+    }
+}
+
+void CachingAllocator::Free(void * p)
+{
+    WRAPPER_NO_CONTRACT;
+
+    if (p == NULL)
+    {
+        return;
+    }
+
+    int sizeClass = LookupSizeClass(p);
+    if (sizeClass < 0)
+    {
+        ClrFreeInProcessHeap(0, p);
+        return;
+    }
+
+#ifdef _DEBUG
+    // Make uses after free easier to spot
+    memset(p, 0xdd, s_blockSizes[sizeClass]);
+#endif
+
+    ThreadCache * pCache = &t_threadCache;
+
+    *(void **)p = pCache->m_pHead[sizeClass];
+    pCache->m_pHead[sizeClass] = p;
+    pCache->m_count[sizeClass]++;
+    pCache->m_frees[sizeClass]++;
+
+    if (pCache->m_fDetached)
+    {
+        GiveBlocks(pCache, sizeClass, pCache->m_count[sizeClass]);
+    }
+    else if (pCache->m_count[sizeClass] > 2 * GetBatchSize(sizeClass))
+    {
+        GiveBlocks(pCache, sizeClass, GetBatchSize(sizeClass));
+    }
+}
+
+bool CachingAllocator::Owns(void * p)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    return LookupSizeClass(p) >= 0;
+}
+
+void CachingAllocator::FlushThreadCache()
+{
+    WRAPPER_NO_CONTRACT;
+
+    ThreadCache * pCache = &t_threadCache;
+
+    // Later allocations of the thread, e.g. from other thread exit
+    // callbacks, go straight to the shared lists
+    pCache->m_fDetached = true;
+
+    for (unsigned sizeClass = 0; sizeClass < SizeClassCount; sizeClass++)
+    {
+        if (pCache->m_count[sizeClass] != 0 ||
+            pCache->m_allocations[sizeClass] != 0 ||
+            pCache->m_frees[sizeClass] != 0)
+        {
+            GiveBlocks(pCache, sizeClass, pCache->m_count[sizeClass]);
+        }
+    }
+}
+
+void CachingAllocator::GetStatistics(unsigned sizeClass, SizeClassStatistics * pStats)
+{
+    WRAPPER_NO_CONTRACT;
+
+    _ASSERTE(sizeClass < SizeClassCount);
+
+    SharedList * pList = &s_sharedLists[sizeClass];
+
+    AcquireLock(&pList->m_lock);
+    pStats->BlockSize = s_blockSizes[sizeClass];
+    pStats->Allocations = pList->m_allocations;
+    pStats->Frees = pList->m_frees;
+    pStats->Chunks = pList->m_chunks;
+    ReleaseLock(&pList->m_lock);
+}
+
+#ifdef LOGGING
+void CachingAllocator::LogStatistics()
+{
+    WRAPPER_NO_CONTRACT;
+
+    for (unsigned sizeClass = 0; sizeClass < SizeClassCount; sizeClass++)
+    {
+        SizeClassStatistics stats;
+        GetStatistics(sizeClass, &stats);
+
+        LOG((LF_EEMEM, LL_INFO10, "CachingAllocator: %4u byte blocks: %I64u allocations, %I64u frees, %I64u chunks\n",
+             (unsigned)stats.BlockSize, stats.Allocations, stats.Frees, stats.Chunks));
+    }
+}
+#endif // LOGGING
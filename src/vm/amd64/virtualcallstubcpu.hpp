@@ -420,7 +420,7 @@ struct ResolveHolder
 
     void  Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget, 
                      size_t dispatchToken, UINT32 hashedToken,
-                     void * cacheAddr, INT32* counterAddr);
+                     void * cacheAddr, size_t cacheMask, INT32* counterAddr);
 
     ResolveStub* stub()      { LIMITED_METHOD_CONTRACT;  return &_stub; }
 
@@ -683,12 +683,13 @@ void ResolveHolder::InitializeStatic()
 
 void  ResolveHolder::Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget, 
                                 size_t dispatchToken, UINT32 hashedToken,
-                                void * cacheAddr, INT32* counterAddr)
+                                void * cacheAddr, size_t cacheMask, INT32* counterAddr)
 {
     _stub = resolveInit;
 
     //fill in the stub specific fields
     _stub._cacheAddress       = (size_t) cacheAddr;
+    _stub.mask                = (UINT32) (cacheMask * sizeof(void *));
     _stub._hashedToken        = hashedToken << LOG2_PTRSIZE;
     _stub._token              = dispatchToken;
     _stub._tokenSlow          = dispatchToken;
@@ -1082,7 +1082,7 @@ void ResolveHolder::InitializeStatic()
 
 void ResolveHolder::Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget,
                                 size_t dispatchToken, UINT32 hashedToken,
-                                void * cacheAddr, INT32 * counterAddr)
+                                void * cacheAddr, size_t cacheMask, INT32 * counterAddr)
 {
     // Called directly by JITTED code
     // ResolveStub._resolveEntryPoint(r0:Object*, r1, r2, r3, r4:IndirectionCellAndFlags)
@@ -1326,7 +1326,7 @@ void ResolveHolder::Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget,
     _stub._token               = dispatchToken;
     _stub._tokenSlow           = dispatchToken;
     _stub._resolveWorkerTarget = resolveWorkerTarget;
-    _stub._cacheMask           = CALL_STUB_CACHE_MASK * sizeof(void*);
+    _stub._cacheMask           = (UINT32) (cacheMask * sizeof(void*));
 
     _ASSERTE(resolveWorkerTarget == (PCODE)ResolveWorkerChainLookupAsmStub);
     _ASSERTE(patcherTarget == NULL);
@@ -166,7 +166,7 @@ struct ResolveHolder
 
     void Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget, 
                     size_t dispatchToken, UINT32 hashedToken,
-                    void * cacheAddr, INT32 * counterAddr)
+                    void * cacheAddr, size_t cacheMask, INT32 * counterAddr)
     {
          int n=0;
          DWORD offset;
@@ -224,6 +224,7 @@ struct ResolveHolder
          _stub._resolveEntryPoint[n++] = 0xCA0D0129;
 
          _ASSERTE(CALL_STUB_CACHE_MASK * sizeof(void*) == 0x7FF8);
+         _ASSERTE(cacheMask == CALL_STUB_CACHE_MASK);
          //x9-i
          //and x9,x9,#cachemask
          _stub._resolveEntryPoint[n++] = 0x927D2D29;
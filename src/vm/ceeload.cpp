@@ -1616,6 +1616,11 @@ void Module::Destruct()
         delete m_pILStubCache;
     }
 
+    if (m_pMethodSigComparisonCache != NULL)
+    {
+        delete m_pMethodSigComparisonCache;
+    }
+
 #ifdef FEATURE_MIXEDMODE // IJW
     delete m_pMUThunkHash;
     delete m_pThunkHeap;
@@ -4032,7 +4037,17 @@ BOOL Module::IsInCurrentVersionBubble()
         return TRUE;
 
     if (IsReadyToRunCompilation())
-        return FALSE;
+    {
+        if (!IsLargeVersionBubbleEnabled())
+            return FALSE;
+
+#ifdef FEATURE_COMINTEROP
+        // WinMDs are always versioned independently
+        if (GetAssembly()->IsWinMD())
+            return FALSE;
+#endif
+        return TRUE;
+    }
 
 #ifdef FEATURE_COMINTEROP
     if (g_fNGenWinMDResilient)
@@ -4585,6 +4600,31 @@ ILStubCache* Module::GetILStubCache()
     return m_pILStubCache;
 }
 
+MethodSigComparisonCache* Module::GetMethodSigComparisonCache()
+{
+    CONTRACTL
+    {
+        THROWS;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        INJECT_FAULT(COMPlusThrowOM(););
+    }
+    CONTRACTL_END;
+
+    if (m_pMethodSigComparisonCache == NULL)
+    {
+        MethodSigComparisonCache *pCache = new MethodSigComparisonCache();
+
+        if (FastInterlockCompareExchangePointer(&m_pMethodSigComparisonCache, pCache, NULL) != NULL)
+        {
+            // some thread swooped in and set the field
+            delete pCache;
+        }
+    }
+    _ASSERTE(m_pMethodSigComparisonCache != NULL);
+    return m_pMethodSigComparisonCache;
+}
+
 // Called to finish the process of adding a new class with Reflection.Emit
 void Module::AddClass(mdTypeDef classdef)
 {
@@ -11094,6 +11134,7 @@ void Module::Fixup(DataImage *image)
     m_MethodDefToPropertyInfoMap.Fixup(image, FALSE);
 
     image->ZeroPointerField(this, offsetof(Module, m_pILStubCache));
+    image->ZeroPointerField(this, offsetof(Module, m_pMethodSigComparisonCache));
 
     if (m_pAvailableClasses != NULL) {
         image->FixupPointerField(this, offsetof(Module, m_pAvailableClasses));
@@ -11446,6 +11487,14 @@ Module *Module::GetModuleFromIndex(DWORD ix)
         CORCOMPILE_IMPORT_TABLE_ENTRY *p = GetNativeImage()->GetNativeImportFromIndex(ix);
         RETURN ZapSig::DecodeModuleFromIndexes(this, p->wAssemblyRid, p->wModuleRid);
     }
+#ifdef FEATURE_READYTORUN
+    else if (IsReadyToRun() && GetReadyToRunInfo()->IsLargeVersionBubble())
+    {
+        // The index is an assembly index, which may refer to the manifest metadata
+        // (see code:ZapImportTable::GetIndexOfModule)
+        RETURN ZapSig::DecodeModuleFromIndexes(this, ix, 0);
+    }
+#endif
     else
     {
         mdAssemblyRef mdAssemblyRefToken = TokenFromRid(ix, mdtAssemblyRef);
@@ -11475,13 +11524,21 @@ Module *Module::GetModuleFromIndexIfLoaded(DWORD ix)
         NOTHROW;
         GC_NOTRIGGER;
         MODE_ANY;
-        PRECONDITION(HasNativeImage());
-        PRECONDITION(GetNativeImage()->CheckNativeImportFromIndex(ix));
+        PRECONDITION(HasNativeImage() || IsReadyToRun());
         POSTCONDITION(CheckPointer(RETVAL, NULL_OK));
     }
     CONTRACT_END;
 
 #ifndef DACCESS_COMPILE 
+#ifdef FEATURE_READYTORUN
+    if (!HasNativeImage())
+    {
+        _ASSERTE(GetReadyToRunInfo()->IsLargeVersionBubble());
+        RETURN ZapSig::DecodeModuleFromIndexesIfLoaded(this, ix, 0);
+    }
+#endif
+
+    _ASSERTE(GetNativeImage()->CheckNativeImportFromIndex(ix));
     CORCOMPILE_IMPORT_TABLE_ENTRY *p = GetNativeImage()->GetNativeImportFromIndex(ix);
 
     RETURN ZapSig::DecodeModuleFromIndexesIfLoaded(this, p->wAssemblyRid, p->wModuleRid);
@@ -11518,11 +11575,16 @@ IMDInternalImport *Module::GetNativeAssemblyImport(BOOL loadAllowed)
         if (loadAllowed) THROWS;                         else NOTHROW;
         if (loadAllowed) INJECT_FAULT(COMPlusThrowOM()); else FORBID_FAULT;
         MODE_ANY;
-        PRECONDITION(HasNativeImage());
-        POSTCONDITION(CheckPointer(RETVAL));
+        PRECONDITION(HasNativeImage() || IsReadyToRun());
+        POSTCONDITION(CheckPointer(RETVAL, loadAllowed ? NULL_NOT_OK : NULL_OK));
     }
     CONTRACT_END;
 
+#ifdef FEATURE_READYTORUN
+    if (IsReadyToRun())
+        RETURN GetReadyToRunInfo()->GetNativeManifestMetadata();
+#endif
+
     RETURN GetFile()->GetPersistentNativeImage()->GetNativeMDImport(loadAllowed);
 }
 
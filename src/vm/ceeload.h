@@ -85,6 +85,7 @@ class ProfileEmitter;
 class ReJitManager;
 class TrackingMap;
 class PersistentInlineTrackingMap;
+class MethodSigComparisonCache;
 
 // Hash table parameter of available classes (name -> module/class) hash
 #define AVAILABLE_CLASSES_HASH_BUCKETS 1024
@@ -1599,6 +1600,10 @@ private:
     // IL stub cache with fabricated MethodTable parented by this module.
     ILStubCache                *m_pILStubCache;
 
+    // Outcomes of comparing method signatures of this module with those of other modules.
+    // Created on first use, see GetMethodSigComparisonCache.
+    MethodSigComparisonCache   *m_pMethodSigComparisonCache;
+
     ULONG m_DefaultDllImportSearchPathsAttributeValue;
 
      LPCUTF8 m_pszCultureName;
@@ -2180,6 +2185,9 @@ protected:
     // IL stub cache
     ILStubCache* GetILStubCache();
 
+    // Cache of cross module method signature comparisons
+    MethodSigComparisonCache* GetMethodSigComparisonCache();
+
     // Classes
     void AddClass(mdTypeDef classdef);
     void BuildClassForModule();
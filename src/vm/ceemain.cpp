@@ -203,6 +203,7 @@
 #include "stringarraylist.h"
 #include "stubhelpers.h"
 #include "perfdefaults.h"
+#include "cachingallocator.h"
 
 #ifdef FEATURE_STACK_SAMPLING
 #include "stacksampler.h"
@@ -245,6 +246,7 @@
 
 #ifndef FEATURE_FUSION
 #include "../binder/inc/coreclrbindercommon.h"
+#include "../binder/inc/clrprivbindercoreclr.h"
 #endif // !FEATURE_FUSION
 
 #ifdef FEATURE_UEF_CHAINMANAGER
@@ -851,6 +853,13 @@ void EEStartupHelper(COINITIEE fFlags)
 #endif // !FEATURE_CORECLR && !CROSSGEN_COMPILE
         }
 
+        // Route the small native allocations of the runtime through per-thread
+        // caches. A host that provides its own memory manager keeps them all.
+        if (CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_UseCachingAllocator) && !CLRMemoryHosted())
+        {
+            CachingAllocator::Enable();
+        }
+
 #ifndef CROSSGEN_COMPILE
         // Initialize Numa and CPU group information
         // Need to do this as early as possible. Used by creating object handle
@@ -871,6 +880,20 @@ void EEStartupHelper(COINITIEE fFlags)
         InitThreadManager();
         STRESS_LOG0(LF_STARTUP, LL_ALWAYS, "Returned successfully from InitThreadManager");
 
+#ifdef FEATURE_PAL
+        {
+            // The processor count and memory status that the GC heaps and the
+            // thread pool are sized from honor these limits
+            PAL_CGROUP_LIMITS cgroupLimits;
+            if (PAL_GetCGroupLimits(&cgroupLimits) && cgroupLimits.dwVersion != 0)
+            {
+                STRESS_LOG4(LF_STARTUP, LL_ALWAYS, "cgroup v%d limits: %d CPUs (weight %d), %p bytes of memory",
+                    cgroupLimits.dwVersion, cgroupLimits.dwCpuLimit, cgroupLimits.dwCpuWeight,
+                    (size_t)cgroupLimits.ullMemoryLimit);
+            }
+        }
+#endif // FEATURE_PAL
+
 #ifdef FEATURE_EVENT_TRACE        
         // Initialize event tracing early so we can trace CLR startup time events.
         InitializeEventTracing();
@@ -1211,6 +1234,7 @@ void EEStartupHelper(COINITIEE fFlags)
         SyncBlockCache::Start();
 
         StackwalkCache::Init();
+        StackwalkCodeInfoCache::Init();
 
         // Start up security
         Security::Start();
@@ -1931,6 +1955,19 @@ void STDMETHODCALLTYPE EEShutDownHelper(BOOL fIsDllUnloading)
         PerfMap::Destroy();
 #endif
 
+#if !defined(FEATURE_FUSION) && !defined(CROSSGEN_COMPILE)
+        // Persist the identities the binder learned about the TPA assemblies so that the next
+        // run can skip opening mismatched candidates. Failing to do so only costs startup time.
+        {
+            AppDomain *pDefaultDomain = SystemDomain::System()->DefaultDomain();
+            CLRPrivBinderCoreCLR *pTPABinder = (pDefaultDomain != NULL) ? pDefaultDomain->GetTPABinderContext() : NULL;
+            if (pTPABinder != NULL)
+            {
+                pTPABinder->GetAppContext()->SaveProbingIndex();
+            }
+        }
+#endif // !FEATURE_FUSION && !CROSSGEN_COMPILE
+
 #ifdef FEATURE_PREJIT
         // If we're doing basic block profiling, we need to write the log files to disk.
 
@@ -2178,6 +2215,11 @@ part2:
                     FcallTimeHist[4], FcallTimeHist[5], FcallTimeHist[6], FcallTimeHist[7],
                     FcallTimeHist[8], FcallTimeHist[9], FcallTimeHist[10]));
 
+#ifdef LOGGING
+                if (CachingAllocator::IsEnabled())
+                    CachingAllocator::LogStatistics();
+#endif
+
                 WriteJitHelperCountToSTRESSLOG();
 
                 STRESS_LOG0(LF_STARTUP, LL_INFO10, "EEShutdown shutting down logging");
@@ -3921,6 +3963,12 @@ BOOL STDMETHODCALLTYPE EEDllMain( // TRUE on success, FALSE on error.
             CExecutionEngine::ThreadDetaching(param.pTlsData);
         }
     }
+
+    if (dwReason == DLL_THREAD_DETACH)
+    {
+        // Hand the blocks cached by the exiting thread back to other threads
+        CachingAllocator::FlushThreadCache();
+    }
     return TRUE;
 }
 
@@ -2581,7 +2581,10 @@ ClassLoader::~ClassLoader()
 
     FreeModules();
 
-    m_UnresolvedClassLock.Destroy();
+    for (DWORD i = 0; i < UNRESOLVED_CLASS_LOCK_STRIPES; i++)
+    {
+        m_UnresolvedClassLocks[i].Destroy();
+    }
     m_AvailableClassLock.Destroy();
     m_AvailableTypesLock.Destroy();
 }
@@ -2641,7 +2644,12 @@ VOID ClassLoader::Init(AllocMemTracker *pamTracker)
                                                           UNRESOLVED_CLASS_HASH_BUCKETS, 
                                                           pamTracker);
 
-    m_UnresolvedClassLock.Init(CrstUnresolvedClassLock);
+    // A bucket of the unresolved class hash must always be covered by the same lock
+    static_assert_no_msg((UNRESOLVED_CLASS_HASH_BUCKETS % UNRESOLVED_CLASS_LOCK_STRIPES) == 0);
+    for (DWORD i = 0; i < UNRESOLVED_CLASS_LOCK_STRIPES; i++)
+    {
+        m_UnresolvedClassLocks[i].Init(CrstUnresolvedClassLock);
+    }
 
     // This lock is taken within the classloader whenever we have to enter a
     // type in one of the modules governed by the loader.
@@ -3941,6 +3949,19 @@ void ClassLoader::Notify(TypeHandle typeHnd)
         GetPerfCounters().m_Loading.cClassesLoaded ++;
 #endif
     }
+
+#if defined(FEATURE_MULTICOREJIT) && !defined(CROSSGEN_COMPILE)
+    {
+        // Let multicore JIT remember the order in which types are loaded so that the
+        // player can load them ahead of the application on later runs
+        MulticoreJitManager & mcJitManager = GetAppDomain()->GetMulticoreJitManager();
+
+        if (mcJitManager.IsRecorderActive())
+        {
+            mcJitManager.RecordTypeLoad(pMT);
+        }
+    }
+#endif // FEATURE_MULTICOREJIT && !CROSSGEN_COMPILE
 }
 
 
@@ -4032,8 +4053,8 @@ TypeHandle ClassLoader::LoadTypeHandleForTypeKey(TypeKey *pTypeKey,
         SString name;
         TypeString::AppendTypeKeyDebug(name, pTypeKey);
         LOG((LF_CLASSLOADER, LL_INFO10000, "PHASEDLOAD: LoadTypeHandleForTypeKey for type %S to level %s\n", name.GetUnicode(), classLoadLevelName[targetLevel]));
-        CrstHolder unresolvedClassLockHolder(&m_UnresolvedClassLock);
-        m_pUnresolvedClassHash->Dump();
+        CrstHolder unresolvedClassLockHolder(GetUnresolvedClassLock(pTypeKey));
+        m_pUnresolvedClassHash->Dump(pTypeKey->ComputeHash() % UNRESOLVED_CLASS_LOCK_STRIPES, UNRESOLVED_CLASS_LOCK_STRIPES);
     }
 #endif
 
@@ -4189,7 +4210,7 @@ ClassLoader::LoadTypeHandleForTypeKey_Body(
 retry:
     ReleaseHolder<PendingTypeLoadEntry> pLoadingEntry;
 
-    CrstHolderWithState unresolvedClassLockHolder(&m_UnresolvedClassLock);
+    CrstHolderWithState unresolvedClassLockHolder(GetUnresolvedClassLock(pTypeKey));
 
     // Is it in the hash of classes currently being loaded?
     pLoadingEntry = m_pUnresolvedClassHash->GetValue(pTypeKey);
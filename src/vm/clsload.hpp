@@ -41,7 +41,11 @@ class DynamicResolver;
 class SigPointer;
 
 // Hash table parameter for unresolved class hash
-#define UNRESOLVED_CLASS_HASH_BUCKETS 8
+#define UNRESOLVED_CLASS_HASH_BUCKETS 64
+
+// Number of locks protecting the unresolved class hash. Each lock covers a fixed subset of
+// the buckets, so this must divide UNRESOLVED_CLASS_HASH_BUCKETS.
+#define UNRESOLVED_CLASS_LOCK_STRIPES 16
 
 // This is information required to look up a type in the loader. Besides the
 // basic name there is the meta data information for the type, whether the
@@ -574,7 +578,10 @@ class ClassLoader
 private:
     // Classes for which load is in progress
     PendingTypeLoadTable  * m_pUnresolvedClassHash;
-    CrstExplicitInit        m_UnresolvedClassLock;
+
+    // Protects m_pUnresolvedClassHash. Loads of types whose keys hash to different
+    // stripes do not contend with each other.
+    CrstExplicitInit        m_UnresolvedClassLocks[UNRESOLVED_CLASS_LOCK_STRIPES];
 
     // Protects addition of elements to module's m_pAvailableClasses.
     // (indeed thus protects addition of elements to any m_pAvailableClasses in any
@@ -1141,6 +1148,13 @@ private:
     TypeHandle LoadTypeHandleForTypeKey_Body(TypeKey *pTypeKey,
                                              TypeHandle typeHnd,
                                              ClassLoadLevel targetLevel);
+
+    // Returns the lock that protects the bucket of m_pUnresolvedClassHash the key hashes to
+    CrstBase *GetUnresolvedClassLock(TypeKey *pTypeKey)
+    {
+        LIMITED_METHOD_CONTRACT;
+        return &m_UnresolvedClassLocks[pTypeKey->ComputeHash() % UNRESOLVED_CLASS_LOCK_STRIPES];
+    }
 #endif //!DACCESS_COMPILE
 
 };  // class ClassLoader
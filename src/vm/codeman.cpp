@@ -2120,7 +2120,16 @@ HeapList* LoaderCodeHeap::CreateCodeHeap(CodeHeapRequestInfo *pInfo, LoaderHeap
         }
         else
         {
-            pBaseAddr = ClrVirtualAllocExecutable(reserveSize, MEM_RESERVE, PAGE_NOACCESS);
+            DWORD flAllocationType = MEM_RESERVE;
+#ifdef FEATURE_PAL
+            // Have the PAL back the code with transparent huge pages
+            if (CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_CodeHeapLargePages) != 0)
+            {
+                flAllocationType |= MEM_LARGE_PAGES;
+            }
+#endif // FEATURE_PAL
+
+            pBaseAddr = ClrVirtualAllocExecutable(reserveSize, flAllocationType, PAGE_NOACCESS);
             if (!pBaseAddr)
                 ThrowOutOfMemory();
         }
@@ -4772,6 +4781,11 @@ void ExecutionManager::DeleteRange(TADDR pStartRange)
     //
     if (pCurr != NULL)
     {
+#ifndef CROSSGEN_COMPILE
+        // Cached code infos may point at the range section and at the code that lived in it
+        StackwalkCodeInfoCache::Invalidate();
+#endif // !CROSSGEN_COMPILE
+
 #if defined(_TARGET_AMD64_)
         if (pCurr->pUnwindInfoTable != 0)
             delete pCurr->pUnwindInfoTable;
@@ -4869,6 +4883,7 @@ void ExecutionManager::Unload(LoaderAllocator *pLoaderAllocator)
     StackwalkCacheEntry corresponds to it. So flush the cache.
     */
     StackwalkCache::Invalidate(pLoaderAllocator);
+    StackwalkCodeInfoCache::Invalidate();
 
     JumpStubCache * pJumpStubCache = (JumpStubCache *)pLoaderAllocator->m_pJumpStubCache;
     if (pJumpStubCache != NULL)
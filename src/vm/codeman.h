@@ -1702,6 +1702,9 @@ class EECodeInfo
 #ifdef FEATURE_READYTORUN
     friend BOOL ReadyToRunJitManager::JitCodeToMethodInfo(RangeSection * pRangeSection, PCODE currentPC, MethodDesc** ppMethodDesc, EECodeInfo * pCodeInfo);
 #endif
+#ifndef DACCESS_COMPILE
+    friend class StackwalkCodeInfoCache;
+#endif
 
 public:
     EECodeInfo();
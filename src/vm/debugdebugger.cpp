@@ -818,6 +818,14 @@ FCIMPL4(void, DebugStackTrace::GetStackFramesInternal,
                     COUNT_T peSize;
                     PTR_CVOID peAddress = pPEFile->GetLoadedImageContents(&peSize);
 
+                    // The portable pdb reader expects a loaded layout. IL only images that are used
+                    // straight from their flat file view are read from their path instead.
+                    if (peAddress != NULL && !pPEFile->GetLoaded()->IsMapped())
+                    {
+                        peAddress = NULL;
+                        peSize = 0;
+                    }
+
                     // Save the PE address and size
                     PTR_CVOID *pLoadedPeAddress = (PTR_CVOID *)pStackFrameHelper->rgLoadedPeAddress->GetDataPtr();
                     pLoadedPeAddress[iNumValidFrames] = peAddress;
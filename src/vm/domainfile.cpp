@@ -1499,6 +1499,12 @@ void DomainFile::Activate()
             m_bDisableActivationCheck=TRUE;
             pMT->CheckRunClassInitThrowing();
         }
+#ifdef FEATURE_READYTORUN
+        if (m_pModule->IsReadyToRun())
+        {
+            m_pModule->GetReadyToRunInfo()->QueueBackgroundFixups(this->GetAppDomain());
+        }
+#endif // FEATURE_READYTORUN
 #ifdef FEATURE_CORECLR
         if (g_pConfig->VerifyModulesOnLoad())
         {
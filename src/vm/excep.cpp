@@ -5208,6 +5208,19 @@ LONG InternalUnhandledExceptionFilter_Worker(
         g_fForbidEnterEE = true;
     }
 
+#ifdef WIN64EXCEPTIONS
+    // The first pass may not have published the stack trace of the exception yet. Do it
+    // before anything reports the unhandled exception.
+    if ((pThread != NULL) && !g_fForbidEnterEE && pThread->IsExceptionInProgress())
+    {
+        PTR_ExceptionTracker pTracker = pThread->GetExceptionState()->GetCurrentExceptionTracker();
+        if (pTracker != NULL)
+        {
+            pTracker->FlushPendingStackTrace();
+        }
+    }
+#endif // WIN64EXCEPTIONS
+
 #ifdef DEBUGGING_SUPPORTED
 
     // Mark that this exception has gone unhandled. At the moment only the debugger will
@@ -5339,8 +5352,8 @@ LONG InternalUnhandledExceptionFilter_Worker(
             //
             // 1) The flag is specified on the AD when it is created by the host and all managed threads created
             //    in such an AD will inherit the flag. For non-finalizer and non-threadpool threads, we check the flag against the thread.
-            // 2) The finalizer thread always switches to the AD of the object that is going to be finalized. Thus,
-            //    while it wont have the flag specified, the AD it switches to will.
+            // 2) The finalizer thread and its helpers always switch to the AD of the object that is going to be
+            //    finalized. Thus, while they wont have the flag specified, the AD they switch to will.
             // 3) The threadpool thread also switches to the correct AD before executing the request. The thread wont have the
             //    flag specified, but the AD it switches to will.
 
@@ -5350,7 +5363,7 @@ LONG InternalUnhandledExceptionFilter_Worker(
             // Fortunately, we should never get into this case, since the thread flag about
             // ignoring unhandled exceptions cannot be set on the default domain.
 
-            if (IsFinalizerThread() || (pParam->pThread->IsThreadPoolThread()))
+            if (IsFinalizerThread() || IsFinalizerHelperThread() || (pParam->pThread->IsThreadPoolThread()))
                 fIsProcessTerminating = !(pParam->pThread->GetDomain()->IgnoreUnhandledExceptions());
             else
                 fIsProcessTerminating = !(pParam->pThread->HasThreadStateNC(Thread::TSNC_IgnoreUnhandledExceptions));
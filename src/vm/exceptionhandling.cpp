@@ -1576,6 +1576,77 @@ void ExceptionTracker::FirstPassIsComplete()
 {
     m_ExceptionFlags.ResetUnwindingToFindResumeFrame();
     m_pSkipToParentFunctionMD = NULL;
+
+    // Publish the frames seen during the first pass before any handler runs.
+    FlushPendingStackTrace();
+}
+
+//---------------------------------------------------------------------------------------
+//
+// Records a frame seen during the first pass in the stack trace of the exception.
+//
+// Saving the stack trace to the throwable requires fetching and growing the managed
+// stack trace array and walking the dynamic method array, which used to be done for
+// every frame. The frames are now accumulated in m_StackTraceInfo and saved in one
+// batch by FlushPendingStackTrace before anything can observe the throwable: when a
+// filter or first chance handler is about to run, when the first pass is complete,
+// or when the exception goes unhandled. With a debugger attached the stack trace is
+// still saved for every frame since the debugger inspects it on each notification.
+//
+void ExceptionTracker::AppendStackTraceElement(UINT_PTR uControlPC, StackFrame sf, MethodDesc* pMD, CrawlFrame* pcfThisFrame,
+                                               BOOL bReplaceStack, BOOL bSkipLastElement)
+{
+    CONTRACTL
+    {
+        MODE_COOPERATIVE;
+        GC_TRIGGERS;
+        NOTHROW;
+    }
+    CONTRACTL_END;
+
+    // The first frame of a new or rethrown exception determines how the accumulated
+    // frames are merged into the stack trace already saved in the throwable.
+    if (bReplaceStack || bSkipLastElement)
+    {
+        FlushPendingStackTrace();
+        m_fPendingReplaceStack      = bReplaceStack;
+        m_fPendingSkipLastElement   = bSkipLastElement;
+    }
+    else if (!m_fStackTraceSavePending)
+    {
+        m_fPendingReplaceStack      = FALSE;
+        m_fPendingSkipLastElement   = FALSE;
+    }
+
+    m_StackTraceInfo.AppendElement(CanAllocateMemory(), uControlPC, sf.SP, pMD, pcfThisFrame);
+    m_fStackTraceSavePending = TRUE;
+
+    if (CORDebuggerAttached())
+    {
+        FlushPendingStackTrace();
+    }
+}
+
+void ExceptionTracker::FlushPendingStackTrace()
+{
+    CONTRACTL
+    {
+        MODE_ANY;
+        GC_TRIGGERS;
+        NOTHROW;
+    }
+    CONTRACTL_END;
+
+    if (!m_fStackTraceSavePending)
+    {
+        return;
+    }
+
+    EH_LOG((LL_INFO100, "  saving pending stack trace, replace = %d, skiplast = %d\n", m_fPendingReplaceStack, m_fPendingSkipLastElement));
+
+    GCX_COOP();
+    m_StackTraceInfo.SaveStackTrace(CanAllocateMemory(), m_hThrowable, m_fPendingReplaceStack, m_fPendingSkipLastElement);
+    m_fStackTraceSavePending = FALSE;
 }
 
 void ExceptionTracker::SecondPassIsComplete(MethodDesc* pMD, StackFrame sfResumeStackFrame)
@@ -2201,8 +2272,7 @@ CLRUnwindStatus ExceptionTracker::ProcessExplicitFrame(
                 //
                 // Update stack trace
                 //
-                m_StackTraceInfo.AppendElement(CanAllocateMemory(), NULL, sf.SP, pMD, pcfThisFrame);
-                m_StackTraceInfo.SaveStackTrace(CanAllocateMemory(), m_hThrowable, bReplaceStack, bSkipLastElement);
+                AppendStackTraceElement(NULL, sf, pMD, pcfThisFrame, bReplaceStack, bSkipLastElement);
 
                 //
                 // make callback to debugger and/or profiler
@@ -2214,6 +2284,8 @@ CLRUnwindStatus ExceptionTracker::ProcessExplicitFrame(
                     // Deliver the FirstChanceNotification after the debugger, if not already delivered.
                     if (!this->DeliveredFirstChanceNotification())
                     {
+                        // First chance handlers are managed code and may look at the stack trace.
+                        FlushPendingStackTrace();
                         ExceptionNotifications::DeliverFirstChanceNotification();
                     }
 #endif // FEATURE_EXCEPTION_NOTIFICATIONS
@@ -2513,8 +2585,7 @@ CLRUnwindStatus ExceptionTracker::ProcessManagedCallFrame(
             {
                 GCX_COOP();
 
-                m_StackTraceInfo.AppendElement(CanAllocateMemory(), uControlPC, sf.SP, pMD, pcfThisFrame);
-                m_StackTraceInfo.SaveStackTrace(CanAllocateMemory(), m_hThrowable, bReplaceStack, bSkipLastElement);
+                AppendStackTraceElement(uControlPC, sf, pMD, pcfThisFrame, bReplaceStack, bSkipLastElement);
             }
 
             //
@@ -2555,6 +2626,8 @@ CLRUnwindStatus ExceptionTracker::ProcessManagedCallFrame(
                     // has done that, provided we have not already delivered it.
                     if (!this->DeliveredFirstChanceNotification())
                     {
+                        // First chance handlers are managed code and may look at the stack trace.
+                        FlushPendingStackTrace();
                         ExceptionNotifications::DeliverFirstChanceNotification();
                     }
 #endif // FEATURE_EXCEPTION_NOTIFICATIONS
@@ -3291,6 +3364,9 @@ DWORD_PTR ExceptionTracker::CallHandler(
     EH_LOG((LL_INFO100, "    calling handler at 0x%p, sp = 0x%p\n", uHandlerStartPC, sf.SP));
 
     Thread* pThread = GetThread();
+
+    // Filters run in the first pass and can look at the stack trace of the exception.
+    FlushPendingStackTrace();
     
     // The first parameter specifies whether we want to make callbacks before (true) or after (false)
     // calling the handler.
@@ -4627,6 +4703,13 @@ VOID DECLSPEC_NORETURN UnwindManagedExceptionPass1(PAL_SEHException& ex, CONTEXT
             NativeExceptionHolderBase* holder = nullptr;
             while ((holder = NativeExceptionHolderBase::FindNextHolder(holder, (void*)sp, (void*)parentSp)) != nullptr)
             {
+                // Native filters may report the exception, so publish its stack trace first.
+                ExceptionTracker* pTracker = GetThread()->GetExceptionState()->GetCurrentExceptionTracker();
+                if (pTracker != NULL)
+                {
+                    pTracker->FlushPendingStackTrace();
+                }
+
                 EXCEPTION_DISPOSITION disposition =  holder->InvokeFilter(ex);
                 if (disposition == EXCEPTION_EXECUTE_HANDLER)
                 {
@@ -76,6 +76,9 @@ public:
 #ifndef DACCESS_COMPILE
         m_StackTraceInfo.Init();
 #endif //  DACCESS_COMPILE
+        m_fStackTraceSavePending = FALSE;
+        m_fPendingReplaceStack = FALSE;
+        m_fPendingSkipLastElement = FALSE;
 
 #ifndef FEATURE_PAL        
         // Init the WatsonBucketTracker
@@ -140,6 +143,9 @@ public:
         }
 
         m_StackTraceInfo.Init();
+        m_fStackTraceSavePending = FALSE;
+        m_fPendingReplaceStack = FALSE;
+        m_fPendingSkipLastElement = FALSE;
 
 #ifndef FEATURE_PAL        
         // Init the WatsonBucketTracker
@@ -235,6 +241,10 @@ public:
     void FirstPassIsComplete();
     void SecondPassIsComplete(MethodDesc* pMD, StackFrame sfResumeStackFrame);
 
+    void AppendStackTraceElement(UINT_PTR uControlPC, StackFrame sf, MethodDesc* pMD, CrawlFrame* pcfThisFrame,
+                                 BOOL bReplaceStack, BOOL bSkipLastElement);
+    void FlushPendingStackTrace();
+
     CLRUnwindStatus HandleFunclets(bool* pfProcessThisFrame, bool fIsFirstPass, 
         MethodDesc * pMD, bool fFunclet, StackFrame sf);
 
@@ -723,6 +733,11 @@ private: ;
 #endif
     OBJECTHANDLE            m_hThrowable;
     StackTraceInfo          m_StackTraceInfo;
+    // Set when m_StackTraceInfo holds first pass frames not yet saved to the throwable,
+    // see code:ExceptionTracker::AppendStackTraceElement
+    BOOL                    m_fStackTraceSavePending;
+    BOOL                    m_fPendingReplaceStack;
+    BOOL                    m_fPendingSkipLastElement;
     UINT_PTR                m_uCatchToCallPC;
     BOOL           m_fResetEnclosingClauseSPForCatchFunclet;
     
@@ -41,6 +41,11 @@ CLREvent * FinalizerThread::hEventFinalizerToShutDown = NULL;
 
 HANDLE FinalizerThread::MHandles[kHandleCount];
 
+CLRSemaphore * FinalizerThread::hSemaphoreFinalizerHelpers = NULL;
+LONG FinalizerThread::cFinalizerHelpers = 0;
+LONG FinalizerThread::cBusyFinalizerHelpers = 0;
+LONG64 FinalizerThread::cFinalizersRun = 0;
+
 BOOL FinalizerThread::IsCurrentThreadFinalizer()
 {
     LIMITED_METHOD_CONTRACT;
@@ -55,6 +60,13 @@ void FinalizerThread::EnableFinalization()
     hEventFinalizer->Set();
 }
 
+size_t FinalizerThread::GetFinalizationQueueLength()
+{
+    WRAPPER_NO_CONTRACT;
+
+    return GCHeap::GetGCHeap()->GetNumberOfFinalizable();
+}
+
 BOOL FinalizerThread::HaveExtraWorkForFinalizer()
 {
     WRAPPER_NO_CONTRACT;
@@ -155,6 +167,7 @@ void CallFinalizer(Object* obj)
 struct FinalizeAllObjects_Args {
     OBJECTREF fobj;
     int bitToCheck;
+    BOOL fNonCriticalOnly;
 };
 
 void FinalizerThread::FinalizeAllObjects_Wrapper(void *ptr)
@@ -167,16 +180,14 @@ void FinalizerThread::FinalizeAllObjects_Wrapper(void *ptr)
     _ASSERTE(args->fobj);
     Object *fobj = OBJECTREFToObject(args->fobj);
     args->fobj = NULL;      // don't want to do this guy again, if we take an exception here:
-    args->fobj = ObjectToOBJECTREF(FinalizeAllObjects(fobj, args->bitToCheck));
+    args->fobj = ObjectToOBJECTREF(FinalizeAllObjects(fobj, args->bitToCheck, args->fNonCriticalOnly));
 }
 
-// The following is inadequate when we have multiple Finalizer threads in some future release.
-// Instead, we will have to store this in TLS or pass it through the call tree of finalization.
 // It is used to tie together the base exception handling and the AppDomain transition exception
-// handling for this thread.
-static struct ManagedThreadCallState *pThreadTurnAround;
+// handling for this thread. It lives in TLS since finalizer helper threads have their own base.
+static __declspec(thread) struct ManagedThreadCallState *pThreadTurnAround;
 
-Object * FinalizerThread::DoOneFinalization(Object* fobj, Thread* pThread,int bitToCheck,bool *pbTerminate)
+Object * FinalizerThread::DoOneFinalization(Object* fobj, Thread* pThread,int bitToCheck,BOOL fNonCriticalOnly,bool *pbTerminate)
 {
     STATIC_CONTRACT_THROWS;
     STATIC_CONTRACT_GC_TRIGGERS;
@@ -257,6 +268,7 @@ Object * FinalizerThread::DoOneFinalization(Object* fobj, Thread* pThread,int bi
             FinalizeAllObjects_Args args;
             args.fobj = ObjectToOBJECTREF(fobj);
             args.bitToCheck = bitToCheck;
+            args.fNonCriticalOnly = fNonCriticalOnly;
             GCPROTECT_BEGIN(args.fobj);
             {
                 ThreadLocaleHolder localeHolder;
@@ -278,7 +290,74 @@ Object * FinalizerThread::DoOneFinalization(Object* fobj, Thread* pThread,int bi
     return pReturnObject;
 }
 
-Object * FinalizerThread::FinalizeAllObjects(Object* fobj, int bitToCheck)
+//
+// Dequeues the next object to finalize. When helper threads are running, the finalizer thread
+// must not start on a critical finalizer while a helper may still be running a normal one,
+// so it waits for the helpers to go idle first. It also waits for them before reporting
+// the queue as drained, so that waiters in FinalizerThreadWait see every finalizer completed.
+//
+Object * FinalizerThread::GetNextFinalizableObject(BOOL fNonCriticalOnly)
+{
+    STATIC_CONTRACT_THROWS;
+    STATIC_CONTRACT_GC_TRIGGERS;
+    STATIC_CONTRACT_MODE_COOPERATIVE;
+
+    if (fNonCriticalOnly)
+        return GCHeap::GetGCHeap()->GetNextNonCriticalFinalizable();
+
+    if (cFinalizerHelpers == 0)
+        return GCHeap::GetGCHeap()->GetNextFinalizable();
+
+    Object *fobj = GCHeap::GetGCHeap()->GetNextNonCriticalFinalizable();
+    if (fobj != NULL)
+        return fobj;
+
+    fobj = GCHeap::GetGCHeap()->GetNextFinalizable();
+    if (fobj == NULL || fobj->GetMethodTable()->HasCriticalFinalizer())
+    {
+        OBJECTREF objref = ObjectToOBJECTREF(fobj);
+        GCPROTECT_BEGIN(objref);
+        WaitForFinalizerHelpersIdle();
+        fobj = OBJECTREFToObject(objref);
+        GCPROTECT_END();
+    }
+
+    return fobj;
+}
+
+void FinalizerThread::WaitForFinalizerHelpersIdle()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_COOPERATIVE;
+    }
+    CONTRACTL_END;
+
+    // Helpers may need a GC to make progress, so don't spin in cooperative mode
+    GCX_PREEMP();
+
+    DWORD dwSwitchCount = 0;
+    while (VolatileLoad(&cBusyFinalizerHelpers) != 0)
+    {
+        __SwitchToThread(0, ++dwSwitchCount);
+    }
+}
+
+void FinalizerThread::ReleaseFinalizerHelpers()
+{
+    WRAPPER_NO_CONTRACT;
+
+    // Release one at a time: a helper that has not consumed its previous release yet would
+    // make a single Release(cFinalizerHelpers) fail for all of them.
+    for (LONG i = 0; i < cFinalizerHelpers; i++)
+    {
+        hSemaphoreFinalizerHelpers->Release(1, NULL);
+    }
+}
+
+Object * FinalizerThread::FinalizeAllObjects(Object* fobj, int bitToCheck, BOOL fNonCriticalOnly)
 {
     STATIC_CONTRACT_THROWS;
     STATIC_CONTRACT_GC_TRIGGERS;
@@ -295,7 +374,7 @@ Object * FinalizerThread::FinalizeAllObjects(Object* fobj, int bitToCheck)
         {
             return NULL;
         }
-        fobj = GCHeap::GetGCHeap()->GetNextFinalizable();
+        fobj = GetNextFinalizableObject(fNonCriticalOnly);
     }
 
     Thread *pThread = GetThread();
@@ -311,7 +390,9 @@ Object * FinalizerThread::FinalizeAllObjects(Object* fobj, int bitToCheck)
         // Don't let an overloaded finalizer queue starve out
         // an attaching profiler.  In between running finalizers,
         // check the profiler attach event without blocking.
-        ProcessProfilerAttachIfNecessary(&ui64TimestampLastCheckedProfAttachEventMs);
+        // Only the finalizer thread itself (never a helper) handles it.
+        if (!fNonCriticalOnly)
+            ProcessProfilerAttachIfNecessary(&ui64TimestampLastCheckedProfAttachEventMs);
 #endif // FEATURE_PROFAPI_ATTACH_DETACH
 
         if (fobj->GetHeader()->GetBits() & bitToCheck)
@@ -320,12 +401,12 @@ Object * FinalizerThread::FinalizeAllObjects(Object* fobj, int bitToCheck)
             {
                 return NULL;
             }
-            fobj = GCHeap::GetGCHeap()->GetNextFinalizable();
+            fobj = GetNextFinalizableObject(fNonCriticalOnly);
         }
         else
         {
             fcount++;
-            fobj = DoOneFinalization(fobj, pThread, bitToCheck,&fTerminate);
+            fobj = DoOneFinalization(fobj, pThread, bitToCheck, fNonCriticalOnly, &fTerminate);
             if (fTerminate)
             {
                 break;
@@ -337,11 +418,14 @@ Object * FinalizerThread::FinalizeAllObjects(Object* fobj, int bitToCheck)
                 {
                     return NULL;
                 }
-                fobj = GCHeap::GetGCHeap()->GetNextFinalizable();
+                fobj = GetNextFinalizableObject(fNonCriticalOnly);
             }
         }
     }
     FireEtwGCFinalizersEnd_V1(fcount, GetClrInstanceId());
+
+    LONG64 cRun = FastInterlockExchangeAddLong(&cFinalizersRun, fcount) + fcount;
+    COUNTER_ONLY(GetPerfCounters().m_GC.cFinalizersRun = (size_t)cRun);
     
     return fobj;
 }
@@ -736,6 +820,11 @@ VOID FinalizerThread::FinalizerThreadWorker(void *args)
         FastInterlockExchange ((LONG*)&g_FinalizerIsRunning, TRUE);
         AppDomain::EnableADUnloadWorkerForFinalizer();
 
+        if (cFinalizerHelpers != 0)
+        {
+            ReleaseFinalizerHelpers();
+        }
+
         do
         {
             FinalizeAllObjects(NULL, 0);
@@ -793,6 +882,117 @@ VOID FinalizerThread::FinalizerThreadWorker(void *args)
 }
 
 
+//
+// Helper threads only run non-critical finalizers; the finalizer thread keeps running the
+// critical ones (after the helpers go idle, see GetNextFinalizableObject), along with all the
+// other work it does such as AppDomain unload processing.
+//
+VOID FinalizerThread::FinalizerHelperThreadWorker(void *args)
+{
+    SCAN_IGNORE_THROW;
+    SCAN_IGNORE_TRIGGER;
+
+    _ASSERTE(args != NULL);
+    pThreadTurnAround = (ManagedThreadCallState *) args;
+
+    class BusyHelperHolder
+    {
+    public:
+        BusyHelperHolder() { FastInterlockIncrement(&cBusyFinalizerHelpers); }
+        ~BusyHelperHolder() { FastInterlockDecrement(&cBusyFinalizerHelpers); }
+    };
+
+    Thread *pThread = GetThread();
+
+    while (!fQuitFinalizer)
+    {
+        _ASSERTE(pThread->PreemptiveGCDisabled());
+        pThread->EnablePreemptiveGC();
+        hSemaphoreFinalizerHelpers->Wait(INFINITE, FALSE);
+        pThread->DisablePreemptiveGC();
+
+        if (fQuitFinalizer)
+            break;
+
+        {
+            BusyHelperHolder busy;
+            FinalizeAllObjects(NULL, 0, TRUE);
+        }
+
+        _ASSERTE(pThread->GetDomain()->IsDefaultDomain());
+
+        if (pThread->IsAbortRequested())
+        {
+            pThread->EEResetAbort(Thread::TAR_ALL);
+        }
+    }
+}
+
+DWORD __stdcall FinalizerThread::FinalizerHelperThreadStart(void *args)
+{
+    // Not ThreadType_Finalizer: helpers only run normal finalizers, and must not get the
+    // finalizer thread's exemptions, such as running on after the EE is suspended for shutdown
+    ClrFlsSetThreadType (ThreadType_FinalizerHelper);
+
+    SCAN_IGNORE_THROW;
+    SCAN_IGNORE_TRIGGER;
+
+    Thread *pThread = (Thread *) args;
+
+    if (pThread->HasStarted())
+    {
+        INSTALL_UNHANDLED_MANAGED_EXCEPTION_TRAP;
+
+        pThread->SetBackground(TRUE);
+        _ASSERTE(pThread->GetDomain()->IsDefaultDomain());
+
+        while (!fQuitFinalizer)
+        {
+            // Same exception swallowing policy as the finalizer thread
+            ManagedThreadBase::FinalizerBase(FinalizerHelperThreadWorker);
+        }
+
+        UNINSTALL_UNHANDLED_MANAGED_EXCEPTION_TRAP;
+
+        pThread->EnablePreemptiveGC();
+    }
+
+    return 0;
+}
+
+void FinalizerThread::FinalizerHelperThreadsCreate()
+{
+    CONTRACTL{
+        THROWS;
+        GC_TRIGGERS;
+        MODE_ANY;
+    } CONTRACTL_END;
+
+    DWORD cThreads = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_FinalizerThreadCount);
+    cThreads = min(cThreads, (DWORD)GetCurrentProcessCpuCount());
+    if (cThreads <= 1)
+        return;
+
+    hSemaphoreFinalizerHelpers = new CLRSemaphore();
+    hSemaphoreFinalizerHelpers->Create(0, cThreads - 1);
+
+    for (DWORD i = 0; i < cThreads - 1; i++)
+    {
+        Thread *pThread = SetupUnstartedThread();
+        if (!pThread->CreateNewThread(0, &FinalizerHelperThreadStart, pThread))
+        {
+            // Finalization still works with fewer helpers, or none at all
+            pThread->DecExternalCount(FALSE);
+            break;
+        }
+
+        pThread->StartThread();
+        FastInterlockIncrement(&cFinalizerHelpers);
+    }
+
+    LOG((LF_GC, LL_INFO10, "Started %d finalizer helper threads\n", cFinalizerHelpers));
+}
+
 // During shutdown, finalize all objects that haven't been run yet... whether reachable or not.
 void FinalizerThread::FinalizeObjectsOnShutdown(LPVOID args)
 {
@@ -1053,6 +1253,8 @@ void FinalizerThread::FinalizerThreadCreate()
                 ThrowOutOfMemory();
             }
         }
+
+        FinalizerHelperThreadsCreate();
     }
 }
 
@@ -1074,8 +1276,8 @@ void FinalizerThread::FinalizerThreadWait(DWORD timeout)
     ASSERT(hEventFinalizer->IsValid());
     ASSERT(GetFinalizerThread());
 
-    // Can't call this from within a finalized method.
-    if (!IsCurrentThreadFinalizer())
+    // Can't call this from within a finalized method, be it on the finalizer thread or on one of its helpers.
+    if (!IsCurrentThreadFinalizer() && !IsFinalizerThread() && !IsFinalizerHelperThread())
     {
 #ifdef FEATURE_COMINTEROP
         // To help combat finalizer thread starvation, we check to see if there are any wrappers
@@ -21,6 +21,16 @@ class FinalizerThread
     static CLREvent *hEventShutDownToFinalizer;
     static CLREvent *hEventFinalizerToShutDown;
 
+    // Helper threads that run non-critical finalizers in parallel with the finalizer
+    // thread (see FinalizerThreadCount). They are woken through the semaphore each
+    // time the finalizer thread starts draining the queue.
+    static CLRSemaphore *hSemaphoreFinalizerHelpers;
+    static LONG cFinalizerHelpers;
+    static LONG cBusyFinalizerHelpers;
+
+    // Number of finalizers run so far by the finalizer thread and its helpers
+    static LONG64 cFinalizersRun;
+
     // Note: This enum makes it easier to read much of the code that deals with the
     // array of events that the finalizer thread waits on.  However, the ordering
     // is important.
@@ -47,10 +57,18 @@ class FinalizerThread
     static void ProcessProfilerAttachIfNecessary(ULONGLONG * pui64TimestampLastCheckedEventMs);
 #endif // FEATURE_PROFAPI_ATTACH_DETACH
 
-    static Object * DoOneFinalization(Object* fobj, Thread* pThread, int bitToCheck, bool *pbTerminate);
+    static Object * DoOneFinalization(Object* fobj, Thread* pThread, int bitToCheck, BOOL fNonCriticalOnly, bool *pbTerminate);
 
     static void FinalizeAllObjects_Wrapper(void *ptr);
-    static Object * FinalizeAllObjects(Object* fobj, int bitToCheck);
+    static Object * FinalizeAllObjects(Object* fobj, int bitToCheck, BOOL fNonCriticalOnly = FALSE);
+
+    static Object * GetNextFinalizableObject(BOOL fNonCriticalOnly);
+    static void WaitForFinalizerHelpersIdle();
+    static void ReleaseFinalizerHelpers();
+
+    static VOID FinalizerHelperThreadWorker(void *args);
+    static DWORD __stdcall FinalizerHelperThreadStart(void *args);
+    static void FinalizerHelperThreadsCreate();
 
 public:
     static Thread* GetFinalizerThread() 
@@ -76,6 +94,16 @@ public:
 
     static BOOL IsCurrentThreadFinalizer();
 
+    // Number of objects whose finalizer has been run, for computing the drain rate
+    static LONG64 GetFinalizersRunCount()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return VolatileLoad(&cFinalizersRun);
+    }
+
+    // Number of objects currently waiting in the finalization queue
+    static size_t GetFinalizationQueueLength();
+
     static void EnableFinalization();
 
     static BOOL HaveExtraWorkForFinalizer();
@@ -165,6 +165,16 @@ void* GCToOSInterface::VirtualReserve(void* address, size_t size, size_t alignme
     LIMITED_METHOD_CONTRACT;
 
     DWORD memFlags = (flags & VirtualReserveFlags::WriteWatch) ? (MEM_RESERVE | MEM_WRITE_WATCH) : MEM_RESERVE;
+#ifdef FEATURE_PAL
+    // Windows only supports large pages for memory that is reserved and
+    // committed at once, by a process that holds SeLockMemoryPrivilege.
+    // The PAL backs the pages with transparent huge pages as they are
+    // committed instead.
+    if (flags & VirtualReserveFlags::LargePages)
+    {
+        memFlags |= MEM_LARGE_PAGES;
+    }
+#endif // FEATURE_PAL
     if (alignment == 0)
     {
         return ::ClrVirtualAlloc(0, size, memFlags, PAGE_READWRITE);
@@ -246,6 +256,12 @@ bool GCToOSInterface::SupportsWriteWatch()
 
     bool writeWatchSupported = false;
 
+#ifdef FEATURE_PAL
+    // The write watch of the PAL relies on recent kernel features, so it is opt-in
+    if (CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_GCPalWriteWatch) == 0)
+        return false;
+#endif // FEATURE_PAL
+
     // check if the OS supports write-watch. 
     // Drawbridge does not support write-watch so we still need to do the runtime detection for them.
     // Otherwise, all currently supported OSes do support write-watch.
@@ -293,6 +309,31 @@ bool GCToOSInterface::GetWriteWatch(bool resetState, void* address, size_t size,
     return success;
 }
 
+// Get how much of the memory reserved with VirtualReserveFlags::LargePages is backed by large pages
+// Parameters:
+//  residentSize  - receives the resident size of the memory reserved with large pages
+//  largePageSize - receives the part of the resident size that is backed by large pages
+// Return:
+//  true if it has succeeded, false if the OS does not report it
+bool GCToOSInterface::GetLargePageUsage(uint64_t* residentSize, uint64_t* largePageSize)
+{
+    LIMITED_METHOD_CONTRACT;
+
+#ifdef FEATURE_PAL
+    PAL_LARGE_PAGE_USAGE usage;
+    if (PAL_GetLargePageUsage(&usage))
+    {
+        *residentSize = usage.ullResidentSize;
+        *largePageSize = usage.ullHugePageSize;
+        return true;
+    }
+#endif // FEATURE_PAL
+
+    *residentSize = 0;
+    *largePageSize = 0;
+    return false;
+}
+
 // Get size of the largest cache on the processor die
 // Parameters:
 //  trueSize - true to return true cache size, false to return scaled up size based on
@@ -13,6 +13,7 @@
 #include "mscoreepriv.h"
 #include "corhost.h"
 #include "threads.h"
+#include "cachingallocator.h"
 
 #if defined(FEATURE_CLICKONCE)
 #include "isolationpriv.h"
@@ -628,6 +629,14 @@ LPVOID EEHeapAllocInProcessHeap(DWORD dwFlags, SIZE_T dwBytes)
     // only fail if we call directly in from outside the EE, such as the JIT.
     MINIMAL_STACK_PROBE_CHECK_THREAD(GetThread());
 
+    if (CachingAllocator::IsEnabled() && dwBytes <= CachingAllocator::MaxBlockSize)
+    {
+        LPVOID p = CachingAllocator::Singleton()->Alloc(dwBytes);
+        if (p != NULL && (dwFlags & HEAP_ZERO_MEMORY))
+            memset(p, 0, dwBytes);
+        return p;
+    }
+
     if (ProcessHeap == NULL)
         ProcessHeap = EEGetProcessHeap();
 
@@ -709,6 +718,13 @@ BOOL EEHeapFreeInProcessHeap(DWORD dwFlags, LPVOID lpMem)
 
     static HANDLE ProcessHeap = NULL;
 
+    // Blocks allocated before the caching allocator was enabled came from the process heap
+    if (CachingAllocator::Owns(lpMem))
+    {
+        CachingAllocator::Singleton()->Free(lpMem);
+        return TRUE;
+    }
+
     if (ProcessHeap == NULL)
         ProcessHeap = EEGetProcessHeap();
 
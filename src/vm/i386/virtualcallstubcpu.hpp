@@ -338,7 +338,7 @@ struct ResolveHolder
 
     void  Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget, 
                      size_t dispatchToken, UINT32 hashedToken,
-                     void * cacheAddr, INT32 * counterAddr);
+                     void * cacheAddr, size_t cacheMask, INT32 * counterAddr);
 
     ResolveStub* stub()      { LIMITED_METHOD_CONTRACT;  return &_stub; }
 
@@ -981,7 +981,7 @@ void ResolveHolder::InitializeStatic()
 
 void  ResolveHolder::Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget, 
                                 size_t dispatchToken, UINT32 hashedToken,
-                                void * cacheAddr, INT32 * counterAddr)
+                                void * cacheAddr, size_t cacheMask, INT32 * counterAddr)
 {
     _stub = resolveInit;
 
@@ -989,6 +989,7 @@ void  ResolveHolder::Initialize(PCODE resolveWorkerTarget, PCODE patcherTarget,
     _stub._pCounter           = counterAddr;
     _stub._hashedToken        = hashedToken << LOG2_PTRSIZE;
     _stub._cacheAddress       = (size_t) cacheAddr;
+    _stub.mask                = (cacheMask << LOG2_PTRSIZE);
     _stub._token              = dispatchToken;
 //    _stub._hashedTokenMov     = hashedToken;
     _stub._tokenPush          = dispatchToken;
@@ -734,8 +734,9 @@ BOOL CEEInfo::shouldEnforceCallvirtRestriction(
 #ifdef FEATURE_READYTORUN_COMPILER
 
 // Returns true if assemblies are in the same version bubble
-// Right now each assembly is in its own version bubble.
-// If the need arises (i.e. performance issues) we will define sets of assemblies (e.g. all app assemblies)
+// By default each assembly is in its own version bubble. With /LargeVersionBubble, all assemblies
+// visible to the compilation form a single version bubble (except WinMDs, which are always versioned
+// independently).
 // The main point is that all this logic is concentrated in one place.
 
 bool IsInSameVersionBubble(Assembly * current, Assembly * target)
@@ -746,6 +747,15 @@ bool IsInSameVersionBubble(Assembly * current, Assembly * target)
     if (current == target)
         return true;
 
+    if (IsLargeVersionBubbleEnabled())
+    {
+#ifdef FEATURE_COMINTEROP
+        if (current->IsWinMD() || target->IsWinMD())
+            return false;
+#endif
+        return true;
+    }
+
     return false;
 }
 
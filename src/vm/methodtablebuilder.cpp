@@ -3720,8 +3720,8 @@ VOID MethodTableBuilder::AllocateFieldDescs()
     // Allocate fields
     if (NumDeclaredFields() > 0)
     {
-        GetHalfBakedClass()->SetFieldDescList((FieldDesc *)
-            AllocateFromHighFrequencyHeap(S_SIZE_T(NumDeclaredFields()) * S_SIZE_T(sizeof(FieldDesc))));
+        GetHalfBakedClass()->SetFieldDescList((FieldDesc *)GetMemTracker()->Track(
+            GetColdTypeDataHeap()->AllocMem(S_SIZE_T(NumDeclaredFields()) * S_SIZE_T(sizeof(FieldDesc)))));
         INDEBUG(GetClassLoader()->m_dwDebugFieldDescs += NumDeclaredFields();)
         INDEBUG(GetClassLoader()->m_dwFieldDescData += (NumDeclaredFields() * sizeof(FieldDesc));)
     }
@@ -7076,7 +7076,7 @@ VOID MethodTableBuilder::AllocAndInitMethodDescChunk(COUNT_T startIndex, COUNT_T
     } CONTRACTL_END;
 
     void * pMem = GetMemTracker()->Track(
-        GetLoaderAllocator()->GetHighFrequencyHeap()->AllocMem(S_SIZE_T(sizeof(TADDR) + sizeof(MethodDescChunk) + sizeOfMethodDescs)));
+        GetColdTypeDataHeap()->AllocMem(S_SIZE_T(sizeof(TADDR) + sizeof(MethodDescChunk) + sizeOfMethodDescs)));
 
     // Skip pointer to temporary entrypoints
     MethodDescChunk * pChunk = (MethodDescChunk *)((BYTE*)pMem + sizeof(TADDR));
@@ -12854,6 +12854,32 @@ MethodTableBuilder::AllocateFromLowFrequencyHeap(S_SIZE_T cbMem)
         GetLoaderAllocator()->GetLowFrequencyHeap()->AllocMem(cbMem));
 }
 
+//*******************************************************************************
+// Returns the heap for per-type data that casting and interface dispatch never look at
+// (FieldDescs and MethodDescs). By default this data lives on the high frequency heap next
+// to the MethodTables. With SplitHotColdTypeData it moves to the low frequency heap, so that
+// the high frequency heap packs the MethodTables of dynamically loaded types densely.
+// NGen images have their own layout, so the compilation process keeps the default.
+LoaderHeap *
+MethodTableBuilder::GetColdTypeDataHeap()
+{
+    CONTRACTL
+    {
+        THROWS;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    static ConfigDWORD splitHotColdTypeData;
+    if (!IsCompilationProcess() && splitHotColdTypeData.val(CLRConfig::UNSUPPORTED_SplitHotColdTypeData) != 0)
+    {
+        return GetLoaderAllocator()->GetLowFrequencyHeap();
+    }
+
+    return GetLoaderAllocator()->GetHighFrequencyHeap();
+}
+
 //-------------------------------------------------------------------------------
 // Make best-case effort to obtain an image name for use in an error message.
 //
@@ -2243,6 +2243,9 @@ private:
     BYTE *
     AllocateFromLowFrequencyHeap(S_SIZE_T cbMem);
 
+    LoaderHeap *
+    GetColdTypeDataHeap();
+
     // --------------------------------------------------------------------------------------------
     // The following structs, defined as private members of MethodTableBuilder, contain the necessary local
     // parameters needed for BuildMethodTable
@@ -492,10 +492,14 @@ HRESULT MulticoreJitRecorder::WriteOutput(IStream * pStream)
         header.shortCounters[ 8] = m_stats.m_nDelayCount;
         header.shortCounters[ 9] = m_stats.m_nWalkBack;
         header.shortCounters[10] = m_fAppxMode;
+        header.shortCounters[11] = m_stats.m_nHelperCompiled;
+        header.shortCounters[12] = m_stats.m_nHelpersCompiling;
+        header.shortCounters[13] = m_stats.m_nTypesLoaded;
 
         _ASSERTE(HEADER_W_COUNTER >= 14);
 
         header.longCounters[0] = m_stats.m_hr;
+        header.longCounters[1] = m_stats.m_nFixupsResolved;
         
         _ASSERTE(HEADER_D_COUNTER >= 3);
         
@@ -590,7 +594,13 @@ void MulticoreJitRecorder::RecordJitInfo(unsigned module, unsigned method)
 {
     LIMITED_METHOD_CONTRACT;
     
-    if (m_JitInfoCount < (LONG) MAX_METHOD_ARRAY)
+    bool fTypeLoad = ((method & (MODULE_DEPENDENCY | TYPE_LOAD)) == TYPE_LOAD);
+
+    // Type loads have their own budget, so that they can't crowd out methods
+    bool fHasRoom = fTypeLoad ? (m_TypeLoadCount < (LONG) MAX_TYPE_ARRAY)
+                              : ((m_JitInfoCount - m_TypeLoadCount) < (LONG) MAX_METHOD_ARRAY);
+
+    if (fHasRoom)
     {
         unsigned info1 = Pack8_24(module, method & 0xFFFFFF);
 
@@ -621,6 +631,11 @@ void MulticoreJitRecorder::RecordJitInfo(unsigned module, unsigned method)
             m_ModuleList[module].methodCount ++;
         }
 
+        if (fTypeLoad)
+        {
+            m_TypeLoadCount ++;
+        }
+
         m_JitInfoArray[m_JitInfoCount] = info1;
         m_JitInfoCount ++;
     }
@@ -884,17 +899,11 @@ void MulticoreJitRecorder::PreRecordFirstMethod()
 }
 
 
-void MulticoreJitRecorder::RecordMethodJit(MethodDesc * pMethod, bool application)
+// Find or add the module a method or type record refers to, making sure its current load level
+// is recorded before the record itself. Return UINT_MAX when the module can't be recorded.
+unsigned MulticoreJitRecorder::GetModuleIndexForRecord(Module * pModule)
 {
     STANDARD_VM_CONTRACT;
-    
-    Module * pModule = pMethod->GetModule_NoLogging();
-
-    // Skip methods from non-supported modules
-    if (! MulticoreJitManager::IsSupportedModule(pModule, true, m_fAppxMode))
-    {
-        return;
-    }
 
     // pModule could be unknown at this point (modules not enumerated, no event received yet)
     unsigned moduleIndex = GetModuleIndex(pModule);
@@ -919,7 +928,28 @@ void MulticoreJitRecorder::RecordMethodJit(MethodDesc * pMethod, bool applicatio
                 RecordJitInfo(0, ((unsigned) needLevel << 8) | moduleIndex | MODULE_DEPENDENCY);
             }
         }
+    }
+
+    return moduleIndex;
+}
 
+
+void MulticoreJitRecorder::RecordMethodJit(MethodDesc * pMethod, bool application)
+{
+    STANDARD_VM_CONTRACT;
+    
+    Module * pModule = pMethod->GetModule_NoLogging();
+
+    // Skip methods from non-supported modules
+    if (! MulticoreJitManager::IsSupportedModule(pModule, true, m_fAppxMode))
+    {
+        return;
+    }
+
+    unsigned moduleIndex = GetModuleIndexForRecord(pModule);
+
+    if (moduleIndex < UINT_MAX)
+    {
         unsigned methodIndex = pMethod->GetMemberDef_NoLogging() & 0xFFFFFF;
 
         if (methodIndex <= METHODINDEX_MASK)
@@ -935,6 +965,84 @@ void MulticoreJitRecorder::RecordMethodJit(MethodDesc * pMethod, bool applicatio
 }
 
 
+void MulticoreJitRecorder::RecordTypeLoad(MethodTable * pMT)
+{
+    STANDARD_VM_CONTRACT;
+
+    Module * pModule = pMT->GetModule();
+
+    // Skip types from non-supported modules
+    if (! MulticoreJitManager::IsSupportedModule(pModule, true, m_fAppxMode))
+    {
+        return;
+    }
+
+    unsigned typeIndex = RidFromToken(pMT->GetCl());
+
+    if ((typeIndex == 0) || (typeIndex > METHODINDEX_MASK))
+    {
+        return;
+    }
+
+    unsigned moduleIndex = GetModuleIndexForRecord(pModule);
+
+    if (moduleIndex < UINT_MAX)
+    {
+        // ClassLoader::Notify can fire more than once for the same type, record it only the first time
+        unsigned info = Pack8_24(moduleIndex, typeIndex | TYPE_LOAD);
+
+        if (m_RecordedTypes.Contains(info))
+        {
+            return;
+        }
+
+        bool fAdded = false;
+
+        EX_TRY
+        {
+            m_RecordedTypes.Add(info);
+            fAdded = true;
+        }
+        EX_CATCH
+        {
+        }
+        EX_END_CATCH(SwallowAllExceptions);
+
+        // Out of memory: drop the record rather than fail the type load
+        if (fAdded)
+        {
+            RecordJitInfo(moduleIndex, typeIndex | TYPE_LOAD);
+        }
+    }
+}
+
+
+void MulticoreJitRecorder::RecordReadyToRunMethod(MethodDesc * pMethod)
+{
+    STANDARD_VM_CONTRACT;
+
+    Module * pModule = pMethod->GetModule_NoLogging();
+
+    // Skip methods from non-supported modules
+    if (! MulticoreJitManager::IsSupportedModule(pModule, true, m_fAppxMode))
+    {
+        return;
+    }
+
+    unsigned moduleIndex = GetModuleIndexForRecord(pModule);
+
+    if (moduleIndex < UINT_MAX)
+    {
+        unsigned methodIndex = pMethod->GetMemberDef_NoLogging() & 0xFFFFFF;
+
+        if (methodIndex <= METHODINDEX_MASK)
+        {
+            RecordJitInfo(moduleIndex, methodIndex | READYTORUN_METHOD);
+        }
+    }
+}
+
+
 // Called from AppDomain::RaiseAssemblyResolveEvent, make it simple
 
 void MulticoreJitRecorder::AbortProfile()
@@ -1549,6 +1657,60 @@ void MulticoreJitManager::RecordMethodJit(MethodDesc * pMethod)
 }
 
 
+// Call back from ClassLoader::Notify when a type is loaded
+// Threading: protected by m_playerLock
+
+void MulticoreJitManager::RecordTypeLoad(MethodTable * pMT)
+{
+    STANDARD_VM_CONTRACT;
+
+    // Generic instantiations and arrays can't be described by a TypeDef token
+    if (pMT->HasInstantiation() || pMT->IsArray())
+    {
+        return;
+    }
+
+    CrstHolder hold(& m_playerLock);
+
+    if (m_pMulticoreJitRecorder != NULL)
+    {
+        m_pMulticoreJitRecorder->RecordTypeLoad(pMT);
+
+        if (m_pMulticoreJitRecorder->IsAtFullCapacity())
+        {
+            m_fRecorderActive = false;
+        }
+    }
+}
+
+
+// Call back from MethodDesc::DoPrestub when the fixups of a ReadyToRun method are resolved
+// Threading: protected by m_playerLock
+
+void MulticoreJitManager::RecordReadyToRunMethod(MethodDesc * pMethod)
+{
+    STANDARD_VM_CONTRACT;
+
+    // Entry points of instantiations are not found by MethodDef token
+    if (pMethod->HasClassOrMethodInstantiation())
+    {
+        return;
+    }
+
+    CrstHolder hold(& m_playerLock);
+
+    if (m_pMulticoreJitRecorder != NULL)
+    {
+        m_pMulticoreJitRecorder->RecordReadyToRunMethod(pMethod);
+
+        if (m_pMulticoreJitRecorder->IsAtFullCapacity())
+        {
+            m_fRecorderActive = false;
+        }
+    }
+}
+
+
 // static 
 bool MulticoreJitManager::IsMethodSupported(MethodDesc * pMethod)
 {
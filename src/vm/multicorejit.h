@@ -62,6 +62,10 @@ struct MulticoreJitPlayerStat
     unsigned short    m_nTotalDelay;
     unsigned short    m_nDelayCount;
     unsigned short    m_nWalkBack;
+    unsigned short    m_nHelperCompiled;    // Methods compiled by player helper threads
+    unsigned short    m_nHelpersCompiling;  // Player helper threads which compiled at least one method
+    unsigned short    m_nTypesLoaded;       // Recorded types loaded by the player before the application
+    unsigned short    m_nFixupsResolved;    // ReadyToRun methods whose fixups the player resolved
     
     HRESULT           m_hr;
 
@@ -233,6 +237,12 @@ public:
 
     void RecordMethodJit(MethodDesc * pMethod);
 
+    // Track the order in which the types of the application are loaded
+    void RecordTypeLoad(MethodTable * pMT);
+
+    // Track the ReadyToRun methods whose fixups the application resolved
+    void RecordReadyToRunMethod(MethodDesc * pMethod);
+
     MulticoreJitPlayerStat & GetStats()
     {
         LIMITED_METHOD_CONTRACT;
@@ -31,6 +31,7 @@ const int      HEADER_D_COUNTER  = 3;               // Extra 32-bit counters in
 const unsigned MAX_MODULES       = 512;             // Maximum number of modules
 
 const unsigned MAX_METHOD_ARRAY  = 16384;           // Maximum number of methods
+const unsigned MAX_TYPE_ARRAY    = 4096;            // Maximum number of type loads, on top of the methods
 
 const int      MULTICOREJITLIFE  = 60 * 1000;       // 60 seconds
 
@@ -41,6 +42,8 @@ const int      MULTICOREJITBLOCKLIMIT = 10 * 1000;  // 10 seconds
                                                     // Method JIT information: 8-bit module 4-bit flag 20-bit method index
 const unsigned MODULE_DEPENDENCY = 0x800000;        //  1-bit module dependency mask
 const unsigned JIT_BY_APP_THREAD = 0x400000;        //  1-bit application thread
+const unsigned TYPE_LOAD         = 0x200000;        //  1-bit type load, index is a TypeDef RID
+const unsigned READYTORUN_METHOD = 0x100000;        //  1-bit precompiled method, its fixups are resolved instead of jitting it
 
 const unsigned METHODINDEX_MASK  = 0x0FFFFF;        // 20-bit method index
 
@@ -51,9 +54,11 @@ const unsigned MODULE_MASK       = 0xFF;            //  8-bit dependent module i
 
 const int      MAX_WALKBACK      = 128;
 
+const unsigned MAX_PLAYER_THREADS = 8;              // Player thread plus helper threads compiling queued methods
+
 enum
 {
-    MULTICOREJIT_PROFILE_VERSION   = 101,
+    MULTICOREJIT_PROFILE_VERSION   = 102,
 
     MULTICOREJIT_HEADER_RECORD_ID  = 1,
     MULTICOREJIT_MODULE_RECORD_ID  = 2,
@@ -79,10 +84,13 @@ inline unsigned Pack8_24(unsigned up, unsigned low)
 //  5  Simple module name stored
 //  6  Maximum method index: 20-bit, could extend to 22 bits
 //  7  JIT_BY_APP_THREAD is for diagnosis only
+//  8  Type loads are interleaved with methods in the order they happened, module jitMethodCount and header
+//     methodCount include them. Each type is recorded once, with its own budget of MAX_TYPE_ARRAY records
+//  9  ReadyToRun methods are recorded when the application resolves their fixups, player resolves them ahead
 
 // <HeaderRecord>::= <recordID> <version> <timeStamp> <moduleCount> <methodCount> <DependencyCount> <unsigned short counter>*14 <unsigned counter>*3
 // <ModuleRecord>::= <recordID> <ModuleVersion> <JitMethodCount> <loadLevel> <lenModuleName> char*lenModuleName <padding>
-// <JifInfRecord>::= <recordID> { <moduleDependency> | <methodJitInfo> }
+// <JifInfRecord>::= <recordID> { <moduleDependency> | <methodJitInfo> | <typeLoadInfo> | <readyToRunInfo> }
 
 // <moduleDependency>:: 
 //    8-bit source module index,  current always 0 until we track per module dependency
@@ -95,6 +103,16 @@ inline unsigned Pack8_24(unsigned up, unsigned low)
 //    4-bit flag                  MODULE_DEPENDENCY is 0, JIT_BY_APP_THREAD could be 1
 //   20-bit method index
 
+// <typeLoadInfo>::
+//    8-bit module index
+//    4-bit flag                  MODULE_DEPENDENCY is 0, TYPE_LOAD is 1
+//   20-bit TypeDef index
+
+// <readyToRunInfo>::
+//    8-bit module index
+//    4-bit flag                  MODULE_DEPENDENCY is 0, READYTORUN_METHOD is 1
+//   20-bit method index
+
 
 struct HeaderRecord
 {
@@ -242,7 +260,59 @@ public:
 
 class PlayerModuleInfo;
 
+class MulticoreJitProfilePlayer;
+
+// Lifetime of the helper threads. The player may be deleted as soon as the last helper has signaled m_helpersDone,
+// so from then on that helper only touches the group. The player and every helper hold a reference on the group,
+// the last one to release it deletes it.
+struct PlayerHelperGroup
+{
+    LONG                               m_nRefCount;
+    LONG                               m_nActiveHelpers;    // Helpers still running, plus one for the player thread
+    CLREvent                           m_helpersDone;
+
+    PlayerHelperGroup()
+        : m_nRefCount(1), m_nActiveHelpers(1)
+    {
+        LIMITED_METHOD_CONTRACT;
+    }
+
+    void AddRef()
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        FastInterlockIncrement(& m_nRefCount);
+    }
+
+    void Release()
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        if (FastInterlockDecrement(& m_nRefCount) == 0)
+        {
+            delete this;
+        }
+    }
+};
+
+// Per helper thread state. Statistics are kept per thread so that helpers do not share counters, they are
+// merged into the player statistics once all helpers have finished. m_busyWith is the method the helper is
+// compiling, for debugging.
+struct PlayerHelperInfo
+{
+    MulticoreJitProfilePlayer        * m_pPlayer;
+    PlayerHelperGroup                * m_pGroup;
+    Thread                           * m_pThread;
+    unsigned                           m_index;
+    unsigned                           m_busyWith;
+    MulticoreJitPlayerStat             m_stats;
+};
+
 // MulticoreJitProfilePlayer manages background thread, playing back profile, storing result into code stoage, and gather statistics information
+// 
+// The player thread walks the profile in order: module records, module dependencies and type loads are handled there.
+// Groups of methods between two such records do not depend on each other, so on machines with idle processors they
+// are put on a work queue and compiled by helper threads as well as by the player thread.
 
 class MulticoreJitProfilePlayer
 {
@@ -269,18 +339,48 @@ private:
 
     int                                m_nLoadedModuleCount;
     
-    unsigned                           m_busyWith;
+    unsigned                           m_busyWith;          // Player thread only, helpers have their own
 
     unsigned                           m_headerModuleCount;
     unsigned                           m_moduleCount;
     PlayerModuleInfo                 * m_pModules;
+
+    // Work queue of methods shared with helper threads, only the player thread adds to it
+    unsigned                         * m_pWorkQueue;
+    unsigned                           m_nWorkQueueSize;
+    LONG                               m_nQueued;
+    LONG                               m_nDequeued;
+    bool                               m_fQueueClosed;
+
+    unsigned                           m_nHelperCount;
+    PlayerHelperInfo                 * m_pHelpers;
+    PlayerHelperGroup                * m_pHelperGroup;
+    CLRSemaphore                       m_workAvailable;
     
-    void JITMethod(Module * pModule, unsigned methodIndex);
+    void JITMethod(Module * pModule, unsigned methodIndex, MulticoreJitPlayerStat & stats, unsigned & busyWith);
+
+    void LoadType(Module * pModule, unsigned typeIndex);
+
+    void ResolveReadyToRunFixups(Module * pModule, unsigned methodIndex);
 
     HRESULT HandleModuleRecord(const ModuleRecord * pModule);
     HRESULT HandleMethodRecord(unsigned * buffer, int count);
 
-    bool CompileMethodDesc(Module * pModule, MethodDesc * pMD);
+    bool CompileMethodDesc(Module * pModule, MethodDesc * pMD, MulticoreJitPlayerStat & stats);
+
+    unsigned GetPlayerThreadCount();
+
+    void StartHelperThreads();
+
+    void StopHelperThreads();
+
+    void QueueMethods(unsigned * buffer, int start, int run);
+
+    bool ProcessQueuedMethod(MulticoreJitPlayerStat & stats, unsigned & busyWith);
+
+    void HelperThreadProc(PlayerHelperInfo * pHelper);
+
+    static DWORD WINAPI StaticHelperThreadProc(void *args);
 
     HRESULT PlayProfile();
 
@@ -354,8 +454,10 @@ private:
     unsigned                  m_ModuleCount;
     unsigned                  m_ModuleDepCount;
 
-    unsigned                  m_JitInfoArray[MAX_METHOD_ARRAY];
+    unsigned                  m_JitInfoArray[MAX_METHOD_ARRAY + MAX_TYPE_ARRAY];
     LONG                      m_JitInfoCount;
+    LONG                      m_TypeLoadCount;      // Type load records in m_JitInfoArray
+    SetSHash<unsigned>        m_RecordedTypes;      // Type load records already made, type loads can be notified more than once
     
     bool                      m_fFirstMethod;
     bool                      m_fAborted;
@@ -368,6 +470,7 @@ private:
 
     unsigned FindModule(Module * pModule);
     unsigned GetModuleIndex(Module * pModule);
+    unsigned GetModuleIndexForRecord(Module * pModule);
 
     HRESULT WriteModuleRecord(IStream * pStream,  const RecorderModuleInfo & module);
     
@@ -397,6 +500,7 @@ public:
         m_pBinderContext    = pBinderContext;
 #endif
         m_JitInfoCount      = 0;
+        m_TypeLoadCount     = 0;
         m_ModuleCount       = 0;
         m_ModuleDepCount    = 0;
 
@@ -441,12 +545,17 @@ public:
     {
         LIMITED_METHOD_CONTRACT;
 
-        return (m_JitInfoCount >= (LONG) MAX_METHOD_ARRAY) ||
+        // Running out of room for type loads does not stop recording methods
+        return ((m_JitInfoCount - m_TypeLoadCount) >= (LONG) MAX_METHOD_ARRAY) ||
                (m_ModuleCount  >= MAX_MODULES);
     }
 
     void RecordMethodJit(MethodDesc * pMethod, bool application);
 
+    void RecordTypeLoad(MethodTable * pMT);
+
+    void RecordReadyToRunMethod(MethodDesc * pMethod);
+
     PCODE RequestMethodCode(MethodDesc * pMethod, MulticoreJitManager * pManager);
     
     HRESULT StartProfile(const wchar_t * pRoot, const wchar_t * pFileName, int suffix, LONG nSession);
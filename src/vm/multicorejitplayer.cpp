@@ -392,6 +392,15 @@ MulticoreJitProfilePlayer::MulticoreJitProfilePlayer(AppDomain * pDomain, ICLRPr
     
     m_busyWith           = EmptyToken;
 
+    m_pWorkQueue         = NULL;
+    m_nWorkQueueSize     = 0;
+    m_nQueued            = 0;
+    m_nDequeued          = 0;
+    m_fQueueClosed       = false;
+    m_nHelperCount       = 0;
+    m_pHelpers           = NULL;
+    m_pHelperGroup       = NULL;
+
     m_nStartTime         = GetTickCount();
 }
 
@@ -410,6 +419,13 @@ MulticoreJitProfilePlayer::~MulticoreJitProfilePlayer()
     {
         delete [] m_pFileBuffer;
     }
+
+    _ASSERTE((m_pHelpers == NULL) && (m_pHelperGroup == NULL));
+
+    if (m_pWorkQueue != NULL)
+    {
+        delete [] m_pWorkQueue;
+    }
 }
 
 
@@ -533,7 +549,7 @@ HRESULT MulticoreJitProfilePlayer::HandleModuleRecord(const ModuleRecord * pMod)
 
 // Call JIT to compile a method
 
-bool MulticoreJitProfilePlayer::CompileMethodDesc(Module * pModule, MethodDesc * pMD)
+bool MulticoreJitProfilePlayer::CompileMethodDesc(Module * pModule, MethodDesc * pMD, MulticoreJitPlayerStat & stats)
 {
     STANDARD_VM_CONTRACT;
     
@@ -543,12 +559,12 @@ bool MulticoreJitProfilePlayer::CompileMethodDesc(Module * pModule, MethodDesc *
         
     if (status == COR_ILMETHOD_DECODER::SUCCESS)
     {
-        if (m_stats.m_nTryCompiling == 0)
+        if (stats.m_nTryCompiling == 0)
         {
             MulticoreJitTrace(("First call to MakeJitWorker"));
         }
 
-        m_stats.m_nTryCompiling ++;
+        stats.m_nTryCompiling ++;
 
 #if defined(FEATURE_CORECLR)
         // Reset the flag to allow managed code to be called in multicore JIT background thread from this routine
@@ -565,8 +581,8 @@ bool MulticoreJitProfilePlayer::CompileMethodDesc(Module * pModule, MethodDesc *
 }
 
 
-// Conditional JIT of a method
-void MulticoreJitProfilePlayer::JITMethod(Module * pModule, unsigned methodIndex)
+// Conditional JIT of a method, statistics and the method being compiled go to the calling thread's state
+void MulticoreJitProfilePlayer::JITMethod(Module * pModule, unsigned methodIndex, MulticoreJitPlayerStat & stats, unsigned & busyWith)
 {
     STANDARD_VM_CONTRACT;
     
@@ -605,17 +621,17 @@ void MulticoreJitProfilePlayer::JITMethod(Module * pModule, unsigned methodIndex
 
         if (pMethod->GetNativeCode() != NULL) // last check before
         {
-            m_stats.m_nHasNativeCode ++;
+            stats.m_nHasNativeCode ++;
 
             return;
         }
         else
         {                    
-            m_busyWith = methodIndex;
+            busyWith = methodIndex;
 
-            bool rslt = CompileMethodDesc(pModule, pMethod);
+            bool rslt = CompileMethodDesc(pModule, pMethod, stats);
 
-            m_busyWith = EmptyToken;
+            busyWith = EmptyToken;
 
             if (rslt)
             {
@@ -626,7 +642,7 @@ void MulticoreJitProfilePlayer::JITMethod(Module * pModule, unsigned methodIndex
     
 BadMethod:
 
-    m_stats.m_nFilteredMethods ++;
+    stats.m_nFilteredMethods ++;
         
     MulticoreJitTrace(("Filtered out methods: pModule:[%s] token:[%x]", pModule->GetSimpleName(), token));
 
@@ -637,6 +653,97 @@ BadMethod:
 }
 
 
+// Load a type recorded in the profile, so that the application finds it loaded
+void MulticoreJitProfilePlayer::LoadType(Module * pModule, unsigned typeIndex)
+{
+    STANDARD_VM_CONTRACT;
+
+    if (pModule == NULL)
+    {
+        return;
+    }
+
+    mdTypeDef token = TokenFromRid(typeIndex & METHODINDEX_MASK, mdtTypeDef);
+
+    if (! pModule->GetMDImport()->IsValidToken(token))
+    {
+        return;
+    }
+
+    TypeHandle th = pModule->LookupTypeDef(token);
+
+    if (! th.IsNull() && th.IsFullyLoaded())
+    {
+        return;
+    }
+
+    // A type that fails to load here will fail the same way on the application thread, just skip it
+    EX_TRY
+    {
+        m_busyWith = typeIndex & METHODINDEX_MASK;
+
+        th = ClassLoader::LoadTypeDefThrowing(pModule, token, ClassLoader::ReturnNullIfNotFound, ClassLoader::PermitUninstDefOrRef);
+
+        if (! th.IsNull())
+        {
+            m_stats.m_nTypesLoaded ++;
+        }
+    }
+    EX_CATCH
+    {
+        MulticoreJitTrace(("Failed to load type: pModule:[%s] token:[%x]", pModule->GetSimpleName(), token));
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    m_busyWith = EmptyToken;
+}
+
+
+// Resolve the fixups of a precompiled method recorded in the profile, so that the application
+// only has to publish its code on the first call
+void MulticoreJitProfilePlayer::ResolveReadyToRunFixups(Module * pModule, unsigned methodIndex)
+{
+    STANDARD_VM_CONTRACT;
+
+#ifdef FEATURE_READYTORUN
+    if ((pModule == NULL) || ! pModule->IsReadyToRun())
+    {
+        return;
+    }
+
+    mdMethodDef token = TokenFromRid(methodIndex & METHODINDEX_MASK, mdtMethodDef);
+
+    if (! pModule->GetMDImport()->IsValidToken(token))
+    {
+        return;
+    }
+
+    // A method whose fixups fail here will fail the same way on the application thread, just skip it
+    EX_TRY
+    {
+        m_busyWith = methodIndex & METHODINDEX_MASK;
+
+        MethodDesc * pMethod = MemberLoader::GetMethodDescFromMethodDef(pModule, token, FALSE);
+
+        if ((pMethod != NULL) && ! pMethod->HasClassOrMethodInstantiation() && (pMethod->GetNativeCode() == NULL))
+        {
+            if (pModule->GetReadyToRunInfo()->ResolveMethodFixups(pMethod))
+            {
+                m_stats.m_nFixupsResolved ++;
+            }
+        }
+    }
+    EX_CATCH
+    {
+        MulticoreJitTrace(("Failed to resolve fixups: pModule:[%s] token:[%x]", pModule->GetSimpleName(), token));
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    m_busyWith = EmptyToken;
+#endif // FEATURE_READYTORUN
+}
+
+
 class MulticoreJitPlayerModuleEnumerator : public MulticoreJitModuleEnumerator
 {
     MulticoreJitProfilePlayer * m_pPlayer;
@@ -999,7 +1106,7 @@ inline bool MethodJifInfo(unsigned inst)
 {
     LIMITED_METHOD_CONTRACT;
 
-    return ((inst & MODULE_DEPENDENCY) == 0);
+    return ((inst & (MODULE_DEPENDENCY | TYPE_LOAD | READYTORUN_METHOD)) == 0);
 }
 
 
@@ -1039,6 +1146,24 @@ HRESULT MulticoreJitProfilePlayer::HandleMethodRecord(unsigned * buffer, int cou
                     goto Abort;
                 }
             }
+            else if (jitInfo & TYPE_LOAD) // Type load, in the order the application did it
+            {
+                PlayerModuleInfo & info = m_pModules[moduleIndex];
+
+                if (info.m_enableJit)
+                {
+                    LoadType(info.m_pModule, jitInfo);
+                }
+            }
+            else if (jitInfo & READYTORUN_METHOD) // Precompiled method, resolve its fixups instead of jitting it
+            {
+                PlayerModuleInfo & info = m_pModules[moduleIndex];
+
+                if (info.m_enableJit)
+                {
+                    ResolveReadyToRunFixups(info.m_pModule, jitInfo);
+                }
+            }
             else
             {
                 PlayerModuleInfo & info = m_pModules[moduleIndex];
@@ -1084,28 +1209,36 @@ HRESULT MulticoreJitProfilePlayer::HandleMethodRecord(unsigned * buffer, int cou
                             MulticoreJitTrace(("Jit backwards %d methods",  run));
                         }
 
-                        // Walk backwards within the same group, may be from different modules
-                        for (int p = pos + run - 1; p >= pos; p --)
+                        if (m_nHelperCount != 0)
                         {
-                            unsigned inst = buffer[p];
+                            // Let the helper threads compile the group while this thread moves on to the next records
+                            QueueMethods(buffer, pos, run);
+                        }
+                        else
+                        {
+                            // Walk backwards within the same group, may be from different modules
+                            for (int p = pos + run - 1; p >= pos; p --)
+                            {
+                                unsigned inst = buffer[p];
 
-                            _ASSERTE(MethodJifInfo(inst));
+                                _ASSERTE(MethodJifInfo(inst));
 
-                            PlayerModuleInfo & mod = m_pModules[inst >> 24];
+                                PlayerModuleInfo & mod = m_pModules[inst >> 24];
 
 #if defined(FEATURE_CORECLR)
-                            _ASSERTE(mod.IsModuleLoaded());
+                                _ASSERTE(mod.IsModuleLoaded());
 #else
-                            _ASSERTE(mod.IsModuleLoaded() && ! mod.IsLowerLevel());
+                                _ASSERTE(mod.IsModuleLoaded() && ! mod.IsLowerLevel());
 #endif
 
-                            if (mod.m_enableJit)
-                            {
-                                JITMethod(mod.m_pModule, inst);
-                            }
-                            else
-                            {
-                                m_stats.m_nFilteredMethods ++;
+                                if (mod.m_enableJit)
+                                {
+                                    JITMethod(mod.m_pModule, inst, m_stats, m_busyWith);
+                                }
+                                else
+                                {
+                                    m_stats.m_nFilteredMethods ++;
+                                }
                             }
                         }
 
@@ -1144,6 +1277,359 @@ Abort:
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////
+//
+//               Helper threads
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+// Number of threads playing back the profile, including the player thread
+unsigned MulticoreJitProfilePlayer::GetPlayerThreadCount()
+{
+    STANDARD_VM_CONTRACT;
+
+    unsigned count = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_MultiCoreJitThreads);
+
+    if (count == 0)
+    {
+        // Leave one processor for the application thread the player is racing against
+        int cpuCount = GetCurrentProcessCpuCount();
+
+        count = (cpuCount > 2) ? (unsigned) (cpuCount - 1) : 1;
+    }
+
+    return min(count, MAX_PLAYER_THREADS);
+}
+
+
+void MulticoreJitProfilePlayer::StartHelperThreads()
+{
+    STANDARD_VM_CONTRACT;
+
+    _ASSERTE((m_pHelpers == NULL) && (m_nHelperCount == 0));
+
+    unsigned count = GetPlayerThreadCount();
+
+    if (count <= 1)
+    {
+        return;
+    }
+
+    // Upper bound on the number of methods in the profile
+    m_nWorkQueueSize = m_nFileSize / sizeof(unsigned);
+
+    m_pWorkQueue   = new (nothrow) unsigned[m_nWorkQueueSize];
+    m_pHelpers     = new (nothrow) PlayerHelperInfo[count - 1];
+    m_pHelperGroup = new (nothrow) PlayerHelperGroup();
+
+    if ((m_pWorkQueue == NULL) || (m_pHelpers == NULL) || (m_pHelperGroup == NULL) ||
+        ! m_pHelperGroup->m_helpersDone.CreateManualEventNoThrow(FALSE))
+    {
+        // Play back on the player thread only
+        return;
+    }
+
+    bool created = false;
+
+    EX_TRY
+    {
+        m_workAvailable.Create(0, m_nWorkQueueSize + MAX_PLAYER_THREADS);
+
+        created = true;
+    }
+    EX_CATCH
+    {
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    if (! created)
+    {
+        return;
+    }
+
+    for (unsigned i = 0; i < count - 1; i ++)
+    {
+        PlayerHelperInfo & helper = m_pHelpers[m_nHelperCount];
+
+        helper.m_pPlayer = this;
+        helper.m_pGroup  = m_pHelperGroup;
+        helper.m_pThread = NULL;
+        helper.m_index   = m_nHelperCount + 1; // 0 is the player thread
+        helper.m_busyWith = EmptyToken;
+        helper.m_stats.Clear();
+
+        EX_TRY
+        {
+            helper.m_pThread = SetupUnstartedThread();
+        }
+        EX_CATCH
+        {
+        }
+        EX_END_CATCH(SwallowAllExceptions);
+
+        if (helper.m_pThread == NULL)
+        {
+            break;
+        }
+
+        m_pHelperGroup->AddRef();
+        FastInterlockIncrement(& m_pHelperGroup->m_nActiveHelpers);
+
+        if (! helper.m_pThread->CreateNewThread(0, StaticHelperThreadProc, & helper))
+        {
+            FastInterlockDecrement(& m_pHelperGroup->m_nActiveHelpers);
+            m_pHelperGroup->Release();
+
+            helper.m_pThread->DecExternalCount(FALSE);
+            break;
+        }
+
+        m_nHelperCount ++;
+
+        helper.m_pThread->StartThread();
+    }
+
+    MulticoreJitTrace(("Started %d helper threads", m_nHelperCount));
+
+    _FireEtwMulticoreJit(W("PLAYER"), W("HelperThreads"), m_nHelperCount, count, 0);
+}
+
+
+// Wait for helper threads to drain the queue and exit, merge their statistics into the player's
+void MulticoreJitProfilePlayer::StopHelperThreads()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if ((m_pHelpers == NULL) && (m_pHelperGroup == NULL))
+    {
+        return;
+    }
+
+    if (m_nHelperCount != 0)
+    {
+        VolatileStore(& m_fQueueClosed, true);
+
+        m_workAvailable.Release((LONG) m_nHelperCount, NULL);
+
+        // Drop the player thread's count, the last helper to exit sets the event
+        if (FastInterlockDecrement(& m_pHelperGroup->m_nActiveHelpers) != 0)
+        {
+            GCX_PREEMP();
+
+            m_pHelperGroup->m_helpersDone.Wait(INFINITE, FALSE);
+        }
+
+        MulticoreJitTrace(("PlayerThread 0: %d compiled, %d had code, %d filtered", 
+            m_stats.m_nTryCompiling, m_stats.m_nHasNativeCode, m_stats.m_nFilteredMethods));
+
+        _FireEtwMulticoreJit(W("PLAYERTHREAD"), W(""), 0, m_stats.m_nTryCompiling, m_stats.m_nHasNativeCode);
+
+        for (unsigned i = 0; i < m_nHelperCount; i ++)
+        {
+            MulticoreJitPlayerStat & stats = m_pHelpers[i].m_stats;
+
+            // Compiled methods are hits the application thread did not have to JIT, methods which already had code are misses
+            MulticoreJitTrace(("PlayerThread %d: %d compiled, %d had code, %d filtered", 
+                m_pHelpers[i].m_index, stats.m_nTryCompiling, stats.m_nHasNativeCode, stats.m_nFilteredMethods));
+
+            _FireEtwMulticoreJit(W("PLAYERTHREAD"), W(""), m_pHelpers[i].m_index, stats.m_nTryCompiling, stats.m_nHasNativeCode);
+
+            m_stats.m_nTryCompiling    += stats.m_nTryCompiling;
+            m_stats.m_nHasNativeCode   += stats.m_nHasNativeCode;
+            m_stats.m_nFilteredMethods += stats.m_nFilteredMethods;
+            m_stats.m_nHelperCompiled  += stats.m_nTryCompiling;
+
+            if (stats.m_nTryCompiling != 0)
+            {
+                m_stats.m_nHelpersCompiling ++;
+            }
+        }
+    }
+
+    delete [] m_pHelpers;
+
+    if (m_pHelperGroup != NULL)
+    {
+        m_pHelperGroup->Release();
+    }
+
+    m_pHelpers     = NULL;
+    m_pHelperGroup = NULL;
+    m_nHelperCount = 0;
+}
+
+
+// Queue a group of methods for the helper threads, walking backwards as the player thread would
+void MulticoreJitProfilePlayer::QueueMethods(unsigned * buffer, int start, int run)
+{
+    STANDARD_VM_CONTRACT;
+
+    LONG queued = m_nQueued;
+
+    for (int p = start + run - 1; p >= start; p --)
+    {
+        unsigned inst = buffer[p];
+
+        _ASSERTE(MethodJifInfo(inst));
+
+        PlayerModuleInfo & mod = m_pModules[inst >> 24];
+
+        if (! mod.m_enableJit)
+        {
+            m_stats.m_nFilteredMethods ++;
+        }
+        else if ((unsigned) queued < m_nWorkQueueSize)
+        {
+            m_pWorkQueue[queued ++] = inst;
+        }
+        else
+        {
+            JITMethod(mod.m_pModule, inst, m_stats, m_busyWith);
+        }
+    }
+
+    LONG added = queued - m_nQueued;
+
+    if (added != 0)
+    {
+        // Publish the methods after they are written
+        VolatileStore(& m_nQueued, queued);
+
+        m_workAvailable.Release((LONG) min((unsigned) added, m_nHelperCount), NULL);
+    }
+}
+
+
+// Take one method off the queue and compile it, return false if the queue is empty
+bool MulticoreJitProfilePlayer::ProcessQueuedMethod(MulticoreJitPlayerStat & stats, unsigned & busyWith)
+{
+    STANDARD_VM_CONTRACT;
+
+    for (;;)
+    {
+        LONG index = VolatileLoad(& m_nDequeued);
+
+        if (index >= VolatileLoad(& m_nQueued))
+        {
+            return false;
+        }
+
+        if (FastInterlockCompareExchange(& m_nDequeued, index + 1, index) == index)
+        {
+            unsigned inst = m_pWorkQueue[index];
+
+            JITMethod(m_pModules[inst >> 24].m_pModule, inst, stats, busyWith);
+
+            return true;
+        }
+    }
+}
+
+
+void MulticoreJitProfilePlayer::HelperThreadProc(PlayerHelperInfo * pHelper)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_COOPERATIVE;
+        INJECT_FAULT(COMPlusThrowOM(););
+    }
+    CONTRACTL_END;
+
+    EX_TRY
+    {
+        ENTER_DOMAIN_ID(m_DomainID);
+        {
+            // Go into preemptive mode
+            GCX_PREEMP();
+
+            while (! ShouldAbort(false))
+            {
+                if (ProcessQueuedMethod(pHelper->m_stats, pHelper->m_busyWith))
+                {
+                    continue;
+                }
+
+                if (VolatileLoad(& m_fQueueClosed))
+                {
+                    break;
+                }
+
+                // Wake up now and then to check for session and time out
+                m_workAvailable.Wait(MULTICOREJITBLOCKLIMIT, FALSE);
+            }
+        }
+        END_DOMAIN_TRANSITION;
+    }
+    EX_CATCH
+    {
+        // The remaining methods are left to the other threads
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+}
+
+
+DWORD WINAPI MulticoreJitProfilePlayer::StaticHelperThreadProc(void *args)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_ANY;
+        ENTRY_POINT;
+        INJECT_FAULT(COMPlusThrowOM(););
+    }
+    CONTRACTL_END;
+
+    BEGIN_ENTRYPOINT_NOTHROW;
+
+    PlayerHelperInfo * pHelper = (PlayerHelperInfo *) args;
+
+    MulticoreJitProfilePlayer * pPlayer = pHelper->m_pPlayer;
+
+    PlayerHelperGroup * pGroup = pHelper->m_pGroup;
+
+    Thread * pThread = pHelper->m_pThread;
+
+    MulticoreJitTrace(("StaticHelperThreadProc(%d) starting", pHelper->m_index));
+
+    if ((pThread != NULL) && pThread->HasStarted())
+    {
+        // Disable calling managed code in background thread
+        ThreadStateNCStackHolder holder(TRUE, Thread::TSNC_CallingManagedCodeDisabled);
+
+        // Run as background thread, so ThreadStore::WaitForOtherThreads will not wait for it
+        pThread->SetBackground(TRUE);
+
+        pPlayer->HelperThreadProc(pHelper);
+    }
+
+    if (pThread != NULL)
+    {
+        DestroyThread(pThread);
+    }
+
+    // The player and pHelper may be deleted as soon as the last helper signals, only the group is used from here on
+    if (FastInterlockDecrement(& pGroup->m_nActiveHelpers) == 0)
+    {
+        pGroup->m_helpersDone.Set();
+    }
+
+    pGroup->Release();
+
+    END_ENTRYPOINT_NOTHROW;
+
+    return 0;
+}
+
+
 void MulticoreJitProfilePlayer::TraceSummary()
 {
     LIMITED_METHOD_CONTRACT;
@@ -1214,7 +1700,7 @@ HRESULT MulticoreJitProfilePlayer::ReadCheckFile(const wchar_t * pFileName)
 
             MulticoreJitTrace(("HeaderRecord(version=%d, module=%d, method=%d)", header.version, m_headerModuleCount, header.methodCount));
 
-            if ((header.version != MULTICOREJIT_PROFILE_VERSION) || (header.moduleCount > MAX_MODULES) || (header.methodCount > MAX_METHOD_ARRAY) ||
+            if ((header.version != MULTICOREJIT_PROFILE_VERSION) || (header.moduleCount > MAX_MODULES) || (header.methodCount > MAX_METHOD_ARRAY + MAX_TYPE_ARRAY) ||
                 (header.recordID != Pack8_24(MULTICOREJIT_HEADER_RECORD_ID, sizeof(HeaderRecord))))
             {
                 hr = COR_E_BADIMAGEFORMAT;
@@ -1296,6 +1782,8 @@ HRESULT MulticoreJitProfilePlayer::PlayProfile()
         GetAppDomain()->GetId().m_dwId, 
         GetAppDomain()->GetFriendlyNameForLogging()));
 
+    StartHelperThreads();
+
     while ((SUCCEEDED(hr)) && (nSize > sizeof(unsigned)))
     {
         unsigned data   = * (const unsigned *) pBuffer;
@@ -1347,6 +1835,16 @@ HRESULT MulticoreJitProfilePlayer::PlayProfile()
         }
     }
 
+    // Help the helper threads finish the queue, then wait for them
+    if (SUCCEEDED(hr))
+    {
+        while (! ShouldAbort(true) && ProcessQueuedMethod(m_stats, m_busyWith))
+        {
+        }
+    }
+
+    StopHelperThreads();
+
     start = GetTickCount() - start;
 
     {
@@ -1394,6 +1892,9 @@ HRESULT MulticoreJitProfilePlayer::JITThreadProc(Thread * pThread)
     }
     EX_END_CATCH(SwallowAllExceptions);
 
+    // Helper threads still reference the player if PlayProfile did not get to stop them
+    StopHelperThreads();
+
     return (DWORD) m_stats.m_hr;
 }
 
@@ -1522,6 +1522,17 @@ PTR_PEImageLayout PEImage::GetLayoutInternal(DWORD imageLayoutMask,DWORD flags)
     {
         _ASSERTE(HasID());
 
+#ifdef FEATURE_PAL
+        // An IL only image that is loaded straight from the flat view of its file has no mapped
+        // layout. Callers that need one get a copy laid out at the RVAs of its sections.
+        if ((imageLayoutMask&PEImageLayout::LAYOUT_MAPPED) &&
+            m_pLayouts[IMAGE_LOADED]!=NULL && !m_pLayouts[IMAGE_LOADED]->IsMapped())
+        {
+            pRetVal=PEImageLayout::LoadFromFlat(m_pLayouts[IMAGE_LOADED]);
+            SetLayout(IMAGE_MAPPED,pRetVal);
+        }
+        else
+#endif // FEATURE_PAL
         if (imageLayoutMask&PEImageLayout::LAYOUT_MAPPED)
         {
             PEImageLayout * pLoadLayout = NULL;
@@ -1557,8 +1568,23 @@ PTR_PEImageLayout PEImage::GetLayoutInternal(DWORD imageLayoutMask,DWORD flags)
 
             if (pLoadLayout != NULL)
             {
-                SetLayout(IMAGE_MAPPED,pLoadLayout);
-                pLoadLayout->AddRef();
+#ifdef FEATURE_PAL
+                // IL only images may be loaded straight from the flat view of the file. Such a layout
+                // is not mapped, so it fills the flat slot rather than the mapped one.
+                if (!pLoadLayout->IsMapped())
+                {
+                    if (m_pLayouts[IMAGE_FLAT]==NULL)
+                    {
+                        pLoadLayout->AddRef();
+                        SetLayout(IMAGE_FLAT,pLoadLayout);
+                    }
+                }
+                else
+#endif // FEATURE_PAL
+                {
+                    SetLayout(IMAGE_MAPPED,pLoadLayout);
+                    pLoadLayout->AddRef();
+                }
                 SetLayout(IMAGE_LOADED,pLoadLayout);
                 pRetVal=pLoadLayout;
             }
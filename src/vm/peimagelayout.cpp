@@ -84,6 +84,18 @@ PEImageLayout* PEImageLayout::Map(HANDLE hFile, PEImage* pOwner)
         if (!pFlat->CheckFormat())
             ThrowHR(COR_E_BADIMAGEFORMAT);
 
+#if defined(FEATURE_PAL) && !defined(CROSSGEN_COMPILE)
+        // The file alignment of most IL images is too small for the PAL to map their sections
+        // directly. Rather than copying such an image into private memory, use the read-only view
+        // of the file when nothing in the image needs the sections laid out at their RVAs. The
+        // pages are then backed by the page cache and shared between processes.
+        if (pFlat->CanUseFlatLayoutAsLoaded())
+        {
+            LOG((LF_LOADER, LL_INFO100, "PEImage: Using flat layout of IL only image %S\n", (LPCWSTR) pFlat->GetPath()));
+            RETURN pFlat.Extract();
+        }
+#endif // FEATURE_PAL && !CROSSGEN_COMPILE
+
         pAlloc=new ConvertedImageLayout(pFlat);
     }
     else
@@ -92,6 +104,50 @@ PEImageLayout* PEImageLayout::Map(HANDLE hFile, PEImage* pOwner)
     RETURN pAlloc.Extract();    
 }
 
+#ifdef FEATURE_PAL
+BOOL PEImageLayout::CanUseFlatLayoutAsLoaded()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        PRECONDITION(!IsMapped());
+    }
+    CONTRACTL_END;
+
+    static ConfigDWORD useFlatLayout;
+    if (useFlatLayout.val(CLRConfig::UNSUPPORTED_UseFlatLayoutForILOnlyImages) == 0)
+        return FALSE;
+
+    // Native code and its fixups need the image laid out at its RVAs
+    if (!HasCorHeader() || !IsILOnly() || HasNativeHeader() || HasReadyToRunHeader())
+        return FALSE;
+
+    if (HasTls())
+        return FALSE;
+
+    // Executables are loaded through PEImage::LoadFromMapped, which needs a mapped layout
+    if (!IsDll())
+        return FALSE;
+
+    // RVA fields are handed out as pointers into the image, so they have to be backed by
+    // the file and must not be written through the read-only view.
+    IMAGE_SECTION_HEADER * pSection = FindFirstSection();
+    IMAGE_SECTION_HEADER * pSectionEnd = pSection + GetNumberOfSections();
+    for (; pSection < pSectionEnd; pSection++)
+    {
+        if ((pSection->Characteristics & VAL32(IMAGE_SCN_MEM_WRITE)) != 0)
+            return FALSE;
+
+        if (VAL32(pSection->Misc.VirtualSize) > VAL32(pSection->SizeOfRawData))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+#endif // FEATURE_PAL
+
 #ifdef FEATURE_PREJIT
 
 #ifdef FEATURE_PAL
@@ -75,6 +75,11 @@ public:
     void ApplyBaseRelocations();
 #endif
 
+#if defined(FEATURE_PAL) && !defined(DACCESS_COMPILE)
+    // Returns TRUE if this flat layout of an IL only image can be used as its loaded layout
+    BOOL CanUseFlatLayoutAsLoaded();
+#endif
+
 public:
 #ifdef DACCESS_COMPILE
     void EnumMemoryRegions(CLRDataEnumMemoryFlags flags);
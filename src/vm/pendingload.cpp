@@ -45,7 +45,7 @@
     pThis = (PendingTypeLoadTable *) pMem;
 
 #ifdef _DEBUG
-    pThis->m_dwDebugMemory = (DWORD)(size + dwNumBuckets*sizeof(PendingTypeLoadTable::TableEntry*));
+    pThis->m_dwDebugMemory = (LONG)(size + dwNumBuckets*sizeof(PendingTypeLoadTable::TableEntry*));
 #endif
 
     pThis->m_dwNumBuckets = dwNumBuckets;
@@ -71,7 +71,8 @@ PendingTypeLoadTable::TableEntry *PendingTypeLoadTable::AllocNewEntry()
     CONTRACTL_END
 
 #ifdef _DEBUG
-    m_dwDebugMemory += (DWORD) (sizeof(PendingTypeLoadTable::TableEntry));
+    // Entries in different lock stripes are allocated concurrently
+    InterlockedExchangeAdd(&m_dwDebugMemory, (LONG) sizeof(PendingTypeLoadTable::TableEntry));
 #endif
 
     return (PendingTypeLoadTable::TableEntry *) new (nothrow) BYTE[sizeof(PendingTypeLoadTable::TableEntry)];
@@ -92,7 +93,7 @@ void PendingTypeLoadTable::FreeEntry(PendingTypeLoadTable::TableEntry * pEntry)
     delete[] ((BYTE*)pEntry);
 
 #ifdef _DEBUG
-    m_dwDebugMemory -= (DWORD) (sizeof(PendingTypeLoadTable::TableEntry));
+    InterlockedExchangeAdd(&m_dwDebugMemory, -(LONG) sizeof(PendingTypeLoadTable::TableEntry));
 #endif
 }
 
@@ -201,7 +202,7 @@ PendingTypeLoadTable::TableEntry *PendingTypeLoadTable::FindItem(TypeKey *pKey)
 
 
 #ifdef _DEBUG
-void PendingTypeLoadTable::Dump()
+void PendingTypeLoadTable::Dump(DWORD dwStripe, DWORD dwNumStripes)
 {
     CONTRACTL
     {
@@ -212,7 +213,7 @@ void PendingTypeLoadTable::Dump()
     CONTRACTL_END
 
     LOG((LF_CLASSLOADER, LL_INFO10000, "PHASEDLOAD: table contains:\n"));
-    for (DWORD i = 0; i < m_dwNumBuckets; i++)
+    for (DWORD i = dwStripe; i < m_dwNumBuckets; i += dwNumStripes)
     {
         for (TableEntry *pSearch = m_pBuckets[i]; pSearch; pSearch = pSearch->pNext)
         {
@@ -211,6 +211,10 @@ public:
 
 // Hash table used to hold pending type loads
 // @todo : use shash.h when Rotor build problems are fixed and it supports LoaderHeap/Alloc\MemTracker
+//
+// The table does no locking of its own. The owner partitions the buckets across a set of
+// locks (see ClassLoader::GetUnresolvedClassLock), so operations on keys that fall into
+// different partitions may run concurrently.
 class PendingTypeLoadTable
 {
 protected:
@@ -227,7 +231,7 @@ protected:
 public:
 
 #ifdef _DEBUG
-    DWORD           m_dwDebugMemory;
+    LONG            m_dwDebugMemory;
 #endif
 
     static PendingTypeLoadTable *Create(LoaderHeap *pHeap, DWORD dwNumBuckets, AllocMemTracker *pamTracker);
@@ -247,7 +251,8 @@ public:
     TableEntry* AllocNewEntry();
     void FreeEntry(TableEntry* pEntry);
 #ifdef _DEBUG
-    void            Dump();
+    // Dumps the buckets that are covered by the given lock stripe
+    void            Dump(DWORD dwStripe, DWORD dwNumStripes);
 #endif
 
 private:
@@ -1374,7 +1374,19 @@ PCODE MethodDesc::DoPrestub(MethodTable *pDispatchingMT)
             {
                 pCode = pModule->GetReadyToRunInfo()->GetEntryPoint(this);
                 if (pCode != NULL)
+                {
                     fReportCompilationFinished = TRUE;
+
+#ifdef FEATURE_MULTICOREJIT
+                    // Tell multi-core JIT manager to record the method, so that its fixups are resolved ahead of time on later runs
+                    MulticoreJitManager & mcJitManager = GetAppDomain()->GetMulticoreJitManager();
+
+                    if (mcJitManager.IsRecorderActive() && MulticoreJitManager::IsMethodSupported(this))
+                    {
+                        mcJitManager.RecordReadyToRunMethod(this);
+                    }
+#endif
+                }
             }
         }
 #endif // FEATURE_READYTORUN
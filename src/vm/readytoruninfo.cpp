@@ -15,6 +15,9 @@
 #include "compile.h"
 #include "versionresilienthashcode.h"
 #include "typehashingalgorithms.h"
+#ifndef CROSSGEN_COMPILE
+#include "win32threadpool.h"
+#endif
 
 using namespace NativeFormat;
 
@@ -487,7 +490,7 @@ PTR_ReadyToRunInfo ReadyToRunInfo::Initialize(Module * pModule, AllocMemTracker
 }
 
 ReadyToRunInfo::ReadyToRunInfo(Module * pModule, PEImageLayout * pLayout, READYTORUN_HEADER * pHeader)
-    : m_pModule(pModule), m_pLayout(pLayout), m_pHeader(pHeader), m_Crst(CrstLeafLock)
+    : m_pModule(pModule), m_pLayout(pLayout), m_pHeader(pHeader), m_pNativeManifestMetadata(NULL), m_Crst(CrstLeafLock)
 {
     STANDARD_VM_CONTRACT;
 
@@ -535,6 +538,16 @@ ReadyToRunInfo::ReadyToRunInfo(Module * pModule, PEImageLayout * pLayout, READYT
         m_availableTypesHashtable = NativeHashtable(parser);
     }
 
+    IMAGE_DATA_DIRECTORY * pManifestMetadataDir = FindSection(READYTORUN_SECTION_MANIFEST_METADATA);
+    if (pManifestMetadataDir != NULL)
+    {
+        IfFailThrow(GetMetaDataInternalInterface((void *) pLayout->GetDirectoryData(pManifestMetadataDir),
+                                                 pManifestMetadataDir->Size,
+                                                 ofRead,
+                                                 IID_IMDInternalImport,
+                                                 (void **) &m_pNativeManifestMetadata));
+    }
+
     {
         LockOwner lock = {&m_Crst, IsOwnerOfCrst};
         m_entryPointToMethodDescMap.Init(TRUE, &lock);
@@ -679,6 +692,37 @@ PCODE ReadyToRunInfo::GetEntryPoint(MethodDesc * pMD, BOOL fFixups /*=TRUE*/)
     return pEntryPoint;
 }
 
+BOOL ReadyToRunInfo::ResolveMethodFixups(MethodDesc * pMD)
+{
+    STANDARD_VM_CONTRACT;
+
+    _ASSERTE(!pMD->HasClassOrMethodInstantiation());
+
+    int rid = RidFromToken(pMD->GetMemberDef());
+    if (rid == 0)
+        return FALSE;
+
+    uint offset;
+    if (!m_methodDefEntryPoints.TryGetAt(rid - 1, &offset))
+        return FALSE;
+
+    uint id;
+    offset = m_nativeReader.DecodeUnsigned(offset, &id);
+
+    // Methods without fixups have nothing to resolve ahead of time
+    if ((id & 1) == 0)
+        return FALSE;
+
+    if (id & 2)
+    {
+        uint val;
+        m_nativeReader.DecodeUnsigned(offset, &val);
+        offset -= val;
+    }
+
+    return m_pModule->FixupDelayList(dac_cast<TADDR>(m_pLayout->GetBase()) + offset);
+}
+
 BOOL ReadyToRunInfo::MethodIterator::Next()
 {
     CONTRACTL
@@ -755,6 +799,156 @@ PCODE ReadyToRunInfo::MethodIterator::GetMethodStartAddress()
     return ret;
 }
 
+#ifndef CROSSGEN_COMPILE
+
+// Number of methods whose fixup lists are resolved before the background thread yields
+#define READYTORUN_BACKGROUND_FIXUPS_BATCH_SIZE 64
+
+struct ReadyToRunBackgroundFixupsArgs
+{
+    ReadyToRunInfo * m_pInfo;
+    ADID             m_DomainID;
+};
+
+//
+// Resolves the fixup lists of all methods in the image on a threadpool thread, so that the
+// first call of each method finds its cells already bound. Fixups are resolved in batches
+// of READYTORUN_BACKGROUND_FIXUPS_BATCH_SIZE methods, yielding between batches. Any fixup
+// that fails is simply left unresolved; the thread that calls the method will resolve it
+// again and observe the failure as it would without this optimization.
+//
+void ReadyToRunInfo::QueueBackgroundFixups(AppDomain * pDomain)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_ANY;
+        PRECONDITION(CheckPointer(pDomain));
+    }
+    CONTRACTL_END;
+
+    static ConfigDWORD backgroundFixups;
+    if (backgroundFixups.val(CLRConfig::UNSUPPORTED_ReadyToRun_BackgroundFixups) == 0)
+        return;
+
+    // The image of a collectible assembly may go away while the work item is pending
+    if (m_pModule->GetLoaderAllocator()->IsCollectible())
+        return;
+
+    if (m_methodDefEntryPoints.GetCount() == 0)
+        return;
+
+    ReadyToRunBackgroundFixupsArgs * pArgs = NULL;
+
+    EX_TRY
+    {
+        pArgs = new ReadyToRunBackgroundFixupsArgs();
+        pArgs->m_pInfo = this;
+        pArgs->m_DomainID = pDomain->GetId();
+
+        if (ThreadpoolMgr::QueueUserWorkItem(BackgroundFixupsThreadProc, pArgs, WT_EXECUTELONGFUNCTION))
+            pArgs = NULL;
+    }
+    EX_CATCH
+    {
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    if (pArgs != NULL)
+        delete pArgs;
+}
+
+DWORD WINAPI ReadyToRunInfo::BackgroundFixupsThreadProc(LPVOID lpParameter)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_PREEMPTIVE;
+    }
+    CONTRACTL_END;
+
+    NewHolder<ReadyToRunBackgroundFixupsArgs> pArgs = (ReadyToRunBackgroundFixupsArgs *)lpParameter;
+
+    Thread * pThread = SetupThreadNoThrow();
+    if (pThread == NULL)
+        return 0;
+
+    EX_TRY
+    {
+        GCX_COOP();
+
+        ENTER_DOMAIN_ID(pArgs->m_DomainID);
+        {
+            GCX_PREEMP();
+
+            pArgs->m_pInfo->ResolveBackgroundFixups();
+        }
+        END_DOMAIN_TRANSITION;
+    }
+    EX_CATCH
+    {
+        // The domain may have been unloaded before the work item got to run
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    return 0;
+}
+
+void ReadyToRunInfo::ResolveBackgroundFixups()
+{
+    STANDARD_VM_CONTRACT;
+
+    TADDR pImageBase = dac_cast<TADDR>(m_pLayout->GetBase());
+    DWORD dwSwitchCount = 0;
+    DWORD nResolved = 0;
+
+    for (DWORD methodDefIndex = 0; methodDefIndex < m_methodDefEntryPoints.GetCount(); methodDefIndex++)
+    {
+        if (g_fEEShutDown)
+            break;
+
+        uint offset;
+        if (!m_methodDefEntryPoints.TryGetAt(methodDefIndex, &offset))
+            continue;
+
+        uint id;
+        offset = m_nativeReader.DecodeUnsigned(offset, &id);
+
+        // Methods without fixups have nothing to resolve ahead of time
+        if ((id & 1) == 0)
+            continue;
+
+        if (id & 2)
+        {
+            uint val;
+            m_nativeReader.DecodeUnsigned(offset, &val);
+            offset -= val;
+        }
+
+        EX_TRY
+        {
+            m_pModule->FixupDelayList(pImageBase + offset);
+        }
+        EX_CATCH
+        {
+            // Leave the fixups unresolved; the first caller of the method will retry them
+        }
+        EX_END_CATCH(SwallowAllExceptions);
+
+        if (++nResolved % READYTORUN_BACKGROUND_FIXUPS_BATCH_SIZE == 0)
+        {
+            // Give the threads that are doing the actual startup work a chance to run
+            __SwitchToThread(0, ++dwSwitchCount);
+        }
+    }
+
+    STRESS_LOG2(LF_LOADER, LL_INFO100, "ReadyToRun: resolved fixups of %d methods in background for module %p\n", nResolved, m_pModule);
+}
+
+#endif // CROSSGEN_COMPILE
+
 DWORD ReadyToRunInfo::GetFieldBaseOffset(MethodTable * pMT)
 {
     STANDARD_VM_CONTRACT;
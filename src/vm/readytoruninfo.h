@@ -37,6 +37,9 @@ class ReadyToRunInfo
     NativeFormat::NativeHashtable   m_instMethodEntryPoints;
     NativeFormat::NativeHashtable   m_availableTypesHashtable;
 
+    // Assembly references used by cross-module references within a large version bubble
+    IMDInternalImport *             m_pNativeManifestMetadata;
+
     Crst                            m_Crst;
     PtrHashMap                      m_entryPointToMethodDescMap;
 
@@ -49,6 +52,9 @@ public:
 
     PCODE GetEntryPoint(MethodDesc * pMD, BOOL fFixups = TRUE);
 
+    // Resolve the fixups of the code of a non-generic method ahead of its first call
+    BOOL ResolveMethodFixups(MethodDesc * pMD);
+
     MethodDesc * GetMethodDescForEntryPoint(PCODE entryPoint);
 
     BOOL HasHashtableOfTypes();
@@ -60,6 +66,18 @@ public:
         return m_pHeader->Flags & READYTORUN_FLAG_SKIP_TYPE_VALIDATION;
     }
 
+    BOOL IsLargeVersionBubble()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return m_pHeader->Flags & READYTORUN_FLAG_LARGE_VERSION_BUBBLE;
+    }
+
+    IMDInternalImport * GetNativeManifestMetadata()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return m_pNativeManifestMetadata;
+    }
+
     PTR_PEImageLayout GetImage()
     {
         LIMITED_METHOD_CONTRACT;
@@ -98,6 +116,10 @@ public:
 
     PTR_BYTE GetDebugInfo(PTR_RUNTIME_FUNCTION pRuntimeFunction);
 
+#ifndef CROSSGEN_COMPILE
+    void QueueBackgroundFixups(AppDomain * pDomain);
+#endif
+
     class MethodIterator
     {
         ReadyToRunInfo * m_pInfo;
@@ -122,6 +144,11 @@ private:
     BOOL GetTypeNameFromToken(IMDInternalImport * pImport, mdToken mdType, LPCUTF8 * ppszName, LPCUTF8 * ppszNameSpace);
     BOOL GetEnclosingToken(IMDInternalImport * pImport, mdToken mdType, mdToken * pEnclosingToken);
     BOOL CompareTypeNameOfTokens(mdToken mdToken1, IMDInternalImport * pImport1, mdToken mdToken2, IMDInternalImport * pImport2);
+
+#ifndef CROSSGEN_COMPILE
+    static DWORD WINAPI BackgroundFixupsThreadProc(LPVOID lpParameter);
+    void ResolveBackgroundFixups();
+#endif
 };
 
 class DynamicHelpers
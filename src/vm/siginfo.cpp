@@ -4297,6 +4297,119 @@ MetaSig::CompareMethodSigs(
     return TRUE;
 }
 
+#ifndef DACCESS_COMPILE
+
+//---------------------------------------------------------------------------------------
+// 
+// Returns TRUE if the signature lies in the IL or native image of the module. Such signatures
+// live as long as the module. Signatures built on the fly (SigBuilder, stored sig MethodDescs,
+// reflection) may be freed and their memory reused for a different signature.
+//static
+BOOL 
+MethodSigComparisonCache::IsSigInModuleImage(
+    Module *        pModule, 
+    PCCOR_SIGNATURE pSig, 
+    DWORD           cSig)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END
+
+    if (pModule->IsSigInIL(pSig) && pModule->IsSigInIL(pSig + cSig - 1))
+        return TRUE;
+
+    if (pModule->HasNativeImage())
+    {
+        PEImageLayout *pNativeImage = pModule->GetNativeImage();
+        if (pNativeImage->PointerInPE(pSig) && pNativeImage->PointerInPE(pSig + cSig - 1))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+//---------------------------------------------------------------------------------------
+// 
+MethodSigComparisonCache::MethodSigComparisonCache()
+    : m_crst(CrstLeafLock, CRST_UNSAFE_ANYMODE)
+{
+    WRAPPER_NO_CONTRACT;
+}
+
+//---------------------------------------------------------------------------------------
+// 
+BOOL 
+MethodSigComparisonCache::Lookup(
+    PCCOR_SIGNATURE pSig1, 
+    DWORD           cSig1, 
+    Module *        pModule2, 
+    PCCOR_SIGNATURE pSig2, 
+    DWORD           cSig2, 
+    BOOL *          pfEqual)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END
+
+    Entry key = { pSig1, pSig2, pModule2, cSig1, cSig2, FALSE };
+
+    CrstHolder ch(&m_crst);
+
+    const Entry *pEntry = m_hash.LookupPtr(key);
+    if (pEntry == NULL)
+        return FALSE;
+
+    *pfEqual = pEntry->m_fEqual;
+    return TRUE;
+}
+
+//---------------------------------------------------------------------------------------
+// 
+void 
+MethodSigComparisonCache::Add(
+    PCCOR_SIGNATURE pSig1, 
+    DWORD           cSig1, 
+    Module *        pModule2, 
+    PCCOR_SIGNATURE pSig2, 
+    DWORD           cSig2, 
+    BOOL            fEqual)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END
+
+    Entry entry = { pSig1, pSig2, pModule2, cSig1, cSig2, fEqual };
+
+    CrstHolder ch(&m_crst);
+
+    if (m_hash.GetCount() >= MaxEntries || m_hash.LookupPtr(entry) != NULL)
+        return;
+
+    // The cache is only an optimization, so failing to grow it is not an error
+    EX_TRY
+    {
+        m_hash.Add(entry);
+    }
+    EX_CATCH
+    {
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+}
+
+#endif // !DACCESS_COMPILE
+
 //---------------------------------------------------------------------------------------
 // 
 //static
@@ -4353,14 +4466,6 @@ MetaSig::CompareMethodSigs(
     }
     CONTRACTL_END
 
-    PCCOR_SIGNATURE pSig1 = pSignature1;
-    PCCOR_SIGNATURE pSig2 = pSignature2;
-    PCCOR_SIGNATURE pEndSig1 = pSignature1 + cSig1;
-    PCCOR_SIGNATURE pEndSig2 = pSignature2 + cSig2;
-    DWORD           ArgCount1;
-    DWORD           ArgCount2;
-    DWORD           i;
-
     // If scopes are the same, and sigs are same, can return.
     // If the sigs aren't the same, but same scope, can't return yet, in
     // case there are two AssemblyRefs pointing to the same assembly or such.
@@ -4368,11 +4473,78 @@ MetaSig::CompareMethodSigs(
         (cSig1 == cSig2) && 
         (pSubst1 == NULL) && 
         (pSubst2 == NULL) && 
-        (memcmp(pSig1, pSig2, cSig1) == 0))
+        (memcmp(pSignature1, pSignature2, cSig1) == 0))
     {
         return TRUE;
     }
 
+#ifndef DACCESS_COMPILE
+    // Remember the outcome of plain comparisons across modules. Substitutions and visited lists
+    // live on the caller's stack, so comparisons that use them cannot be cached. The cache lives
+    // in the first module, so the second one must not be unloaded before it. Signatures of
+    // dynamic modules may move as their metadata grows. The key is the address of the signatures,
+    // so both have to live in the images of their modules rather than in temporary memory.
+    if ((pSubst1 == NULL) && 
+        (pSubst2 == NULL) && 
+        (pVisited == NULL) && 
+        (pModule1 != pModule2) && 
+        (cSig1 != 0) && 
+        (cSig2 != 0) && 
+        !pModule1->IsReflection() && 
+        !pModule2->IsReflection() && 
+        (!pModule2->IsCollectible() || (pModule2->GetLoaderAllocator() == pModule1->GetLoaderAllocator())) && 
+        MethodSigComparisonCache::IsSigInModuleImage(pModule1, pSignature1, cSig1) && 
+        MethodSigComparisonCache::IsSigInModuleImage(pModule2, pSignature2, cSig2))
+    {
+        MethodSigComparisonCache *pCache = pModule1->GetMethodSigComparisonCache();
+
+        BOOL fEqual;
+        if (pCache->Lookup(pSignature1, cSig1, pModule2, pSignature2, cSig2, &fEqual))
+        {
+            return fEqual;
+        }
+
+        fEqual = CompareMethodSigsWorker(pSignature1, cSig1, pModule1, NULL, pSignature2, cSig2, pModule2, NULL, NULL);
+        pCache->Add(pSignature1, cSig1, pModule2, pSignature2, cSig2, fEqual);
+        return fEqual;
+    }
+#endif // !DACCESS_COMPILE
+
+    return CompareMethodSigsWorker(pSignature1, cSig1, pModule1, pSubst1, pSignature2, cSig2, pModule2, pSubst2, pVisited);
+}
+
+//---------------------------------------------------------------------------------------
+// 
+//static
+BOOL 
+MetaSig::CompareMethodSigsWorker(
+    PCCOR_SIGNATURE      pSignature1, 
+    DWORD                cSig1, 
+    Module *             pModule1, 
+    const Substitution * pSubst1, 
+    PCCOR_SIGNATURE      pSignature2, 
+    DWORD                cSig2, 
+    Module *             pModule2, 
+    const Substitution * pSubst2, 
+    TokenPairList *      pVisited)
+{
+    CONTRACTL
+    {
+        THROWS;
+        GC_TRIGGERS;
+        INJECT_FAULT(COMPlusThrowOM());
+        MODE_ANY;
+    }
+    CONTRACTL_END
+
+    PCCOR_SIGNATURE pSig1 = pSignature1;
+    PCCOR_SIGNATURE pSig2 = pSignature2;
+    PCCOR_SIGNATURE pEndSig1 = pSignature1 + cSig1;
+    PCCOR_SIGNATURE pEndSig2 = pSignature2 + cSig2;
+    DWORD           ArgCount1;
+    DWORD           ArgCount2;
+    DWORD           i;
+
     if ((*pSig1 & ~CORINFO_CALLCONV_PARAMTYPE) != (*pSig2 & ~CORINFO_CALLCONV_PARAMTYPE))
     {   // Calling convention or hasThis mismatch
         return FALSE;
@@ -4478,7 +4650,7 @@ MetaSig::CompareMethodSigs(
     }
 
     return TRUE;
-} // MetaSig::CompareMethodSigs
+} // MetaSig::CompareMethodSigsWorker
 
 //---------------------------------------------------------------------------------------
 // 
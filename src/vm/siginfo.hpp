@@ -33,6 +33,73 @@
 #define STACK_GROWS_UP_ON_ARGS_WALK
 #endif
 
+#ifndef DACCESS_COMPILE
+
+//------------------------------------------------------------------------
+// Remembers whether method signatures of a module matched method signatures of
+// other modules. Comparing signatures across modules has to resolve every TypeRef
+// they contain, and the same pairs are compared repeatedly while overrides are
+// matched and MemberRefs are resolved. Only comparisons without substitutions are
+// cached; see MetaSig::CompareMethodSigs.
+//------------------------------------------------------------------------
+class MethodSigComparisonCache
+{
+public:
+    MethodSigComparisonCache();
+
+    // Returns TRUE if the signature is part of the IL or native image of the module, so that
+    // its address identifies it for as long as the module is loaded
+    static BOOL IsSigInModuleImage(Module *pModule, PCCOR_SIGNATURE pSig, DWORD cSig);
+
+    // Returns TRUE and the outcome of the comparison if it is known
+    BOOL Lookup(PCCOR_SIGNATURE pSig1, DWORD cSig1,
+                Module *pModule2, PCCOR_SIGNATURE pSig2, DWORD cSig2,
+                BOOL *pfEqual);
+
+    void Add(PCCOR_SIGNATURE pSig1, DWORD cSig1,
+             Module *pModule2, PCCOR_SIGNATURE pSig2, DWORD cSig2,
+             BOOL fEqual);
+
+private:
+    struct Entry
+    {
+        PCCOR_SIGNATURE m_pSig1;
+        PCCOR_SIGNATURE m_pSig2;
+        Module *        m_pModule2;
+        DWORD           m_cSig1;
+        DWORD           m_cSig2;
+        BOOL            m_fEqual;
+    };
+
+    class Traits : public NoRemoveSHashTraits< DefaultSHashTraits<Entry> >
+    {
+    public:
+        typedef const Entry & key_t;
+        static key_t GetKey(const Entry & e) { LIMITED_METHOD_CONTRACT; return e; }
+        static BOOL Equals(key_t k1, key_t k2)
+        {
+            LIMITED_METHOD_CONTRACT;
+            return (k1.m_pSig1 == k2.m_pSig1) && (k1.m_pSig2 == k2.m_pSig2) && (k1.m_pModule2 == k2.m_pModule2) &&
+                   (k1.m_cSig1 == k2.m_cSig1) && (k1.m_cSig2 == k2.m_cSig2);
+        }
+        static count_t Hash(key_t k)
+        {
+            LIMITED_METHOD_CONTRACT;
+            return (count_t)((size_t)k.m_pSig1 ^ ((size_t)k.m_pSig2 >> 2) ^ ((size_t)k.m_pModule2 >> 4) ^ (k.m_cSig1 << 16) ^ k.m_cSig2);
+        }
+        static const Entry Null() { LIMITED_METHOD_CONTRACT; Entry e = { 0 }; return e; }
+        static bool IsNull(const Entry & e) { LIMITED_METHOD_CONTRACT; return e.m_pSig1 == NULL; }
+    };
+
+    // Bounds the memory used by a module that is compared against many others
+    static const COUNT_T MaxEntries = 8192;
+
+    SHash<Traits>   m_hash;
+    Crst            m_crst;
+};
+
+#endif // !DACCESS_COMPILE
+
 BOOL IsTypeRefOrDef(LPCSTR szClassName, Module *pModule, mdToken token);
 
 struct ElementTypeInfo {
@@ -1116,6 +1183,19 @@ public:
             m_flags |= TREAT_AS_VARARG;
         }
 
+    private:
+        // CompareMethodSigs without the shortcuts for identical and previously compared signatures
+        static BOOL CompareMethodSigsWorker(
+            PCCOR_SIGNATURE pSig1, 
+            DWORD       cSig1, 
+            Module*     pModule1, 
+            const Substitution* pSubst1,
+            PCCOR_SIGNATURE pSig2, 
+            DWORD       cSig2, 
+            Module*     pModule2,
+            const Substitution* pSubst2,
+            TokenPairList *pVisited
+        );
 
     // These are protected because Reflection subclasses Metasig
     protected:
@@ -2786,8 +2786,25 @@ void StackFrameIterator::ProcessIp(PCODE Ip)
         SUPPORTS_DAC;
     } CONTRACTL_END;
 
-    // Re-initialize codeInfo with new IP
-    m_crawl.codeInfo.Init(Ip, m_scanFlag);
+#ifndef DACCESS_COMPILE
+    if (StackwalkCodeInfoCache::Enabled())
+    {
+        if (!StackwalkCodeInfoCache::Lookup(Ip, &m_crawl.codeInfo))
+        {
+            DWORD dwEpoch = StackwalkCodeInfoCache::GetEpoch();
+
+            m_crawl.codeInfo.Init(Ip, m_scanFlag);
+
+            if (m_crawl.codeInfo.IsValid())
+                StackwalkCodeInfoCache::Insert(&m_crawl.codeInfo, dwEpoch);
+        }
+    }
+    else
+#endif // !DACCESS_COMPILE
+    {
+        // Re-initialize codeInfo with new IP
+        m_crawl.codeInfo.Init(Ip, m_scanFlag);
+    }
  
     m_crawl.isFrameless = !!m_crawl.codeInfo.IsValid();
 } // StackFrameIterator::ProcessIp()
@@ -3451,6 +3468,214 @@ void StackwalkCache::Invalidate(LoaderAllocator * pLoaderAllocator)
     ZeroMemory(PVOID(&g_StackwalkCache), sizeof(g_StackwalkCache));
 }
 
+#ifndef DACCESS_COMPILE
+
+/*
+============================================================
+StackwalkCodeInfoCache: a shared, direct-mapped cache of EECodeInfo lookups keyed
+by control PC. Unlike StackwalkCache above it does not depend on the unwind scheme
+of the target, so it is used by every StackFrameIterator on every platform,
+including GC stack crawls.
+
+Entry protocol:
+  - writers claim an entry by swapping its IP with LOCKED_IP, make its sequence
+    number odd, fill it in, publish the real IP and make the sequence number even
+    again;
+  - readers load the sequence number and the IP, copy the payload and load both
+    again; the copy is only used if the sequence number was even and unchanged
+    and both loads of the IP returned the IP being looked up.
+Checking the IP alone is not enough: after an invalidation the same IP can be
+reinserted with a different payload (e.g. new code at a reused address) while a
+reader is in the middle of its copy.
+============================================================
+*/
+
+#define LOG_NUM_OF_CODEINFO_CACHE_ENTRIES 10
+#define NUM_OF_CODEINFO_CACHE_ENTRIES (1 << LOG_NUM_OF_CODEINFO_CACHE_ENTRIES)
+
+StackwalkCodeInfoCache::Entry StackwalkCodeInfoCache::s_rgEntries[NUM_OF_CODEINFO_CACHE_ENTRIES] = {};
+BOOL  StackwalkCodeInfoCache::s_fEnabled = FALSE;
+DWORD StackwalkCodeInfoCache::s_dwEpoch = 0;
+
+// static
+void StackwalkCodeInfoCache::Init()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    s_fEnabled = (CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_StackwalkCodeInfoCache) != 0);
+}
+
+// static
+inline unsigned StackwalkCodeInfoCache::GetKey(PCODE ip)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    // Return addresses are not aligned, but the low bits alone are a poor hash since
+    // call sites to the same callee tend to share them.
+    return (unsigned)(((ip >> LOG_NUM_OF_CODEINFO_CACHE_ENTRIES) ^ ip) & (NUM_OF_CODEINFO_CACHE_ENTRIES - 1));
+}
+
+/*
+    Fills in pCodeInfo from the cache if ip is cached. Returns FALSE on a miss, in
+    which case pCodeInfo is left untouched.
+*/
+// static
+BOOL StackwalkCodeInfoCache::Lookup(PCODE ip, EECodeInfo * pCodeInfo)
+{
+    CONTRACTL {
+        NOTHROW;
+        GC_NOTRIGGER;
+        SO_TOLERANT;
+    } CONTRACTL_END;
+
+    _ASSERTE(Enabled());
+
+    // Neither value can be code, and both would match unrelated entries
+    if (ip == NULL || ip == LOCKED_IP)
+        return FALSE;
+
+    Entry * pEntry = &s_rgEntries[GetKey(ip)];
+
+    DWORD dwSequence = VolatileLoad(&pEntry->dwSequence);
+    if ((dwSequence & 1) != 0)
+        return FALSE;
+
+    if (VolatileLoad(&pEntry->IP) != ip)
+        return FALSE;
+
+    // Every payload load is an acquire so that none of them can be reordered past the second load of IP
+    RangeSection *          pRangeSection   = VolatileLoad(&pEntry->pRangeSection);
+    TADDR                   pCodeHeader     = VolatileLoad(&pEntry->pCodeHeader);
+    MethodDesc *            pMD             = VolatileLoad(&pEntry->pMD);
+    IJitManager *           pJM             = VolatileLoad(&pEntry->pJM);
+    DWORD                   relOffset       = VolatileLoad(&pEntry->relOffset);
+#ifdef WIN64EXCEPTIONS
+    PTR_RUNTIME_FUNCTION    pFunctionEntry  = VolatileLoad(&pEntry->pFunctionEntry);
+#endif // WIN64EXCEPTIONS
+
+    if (VolatileLoad(&pEntry->IP) != ip)
+        return FALSE;
+
+    if (VolatileLoad(&pEntry->dwSequence) != dwSequence)
+        return FALSE;
+
+    pCodeInfo->m_codeAddress = ip;
+    pCodeInfo->m_methodToken = METHODTOKEN(pRangeSection, pCodeHeader);
+    pCodeInfo->m_pMD         = pMD;
+    pCodeInfo->m_pJM         = pJM;
+    pCodeInfo->m_relOffset   = relOffset;
+#ifdef WIN64EXCEPTIONS
+    pCodeInfo->m_pFunctionEntry = pFunctionEntry;
+#endif // WIN64EXCEPTIONS
+
+    return TRUE;
+}
+
+/*
+    Caches a valid EECodeInfo. dwEpoch must have been obtained from GetEpoch() before
+    pCodeInfo was initialized; the insert is dropped if an invalidation happened since.
+*/
+// static
+void StackwalkCodeInfoCache::Insert(EECodeInfo * pCodeInfo, DWORD dwEpoch)
+{
+    CONTRACTL {
+        NOTHROW;
+        GC_NOTRIGGER;
+        SO_TOLERANT;
+    } CONTRACTL_END;
+
+    _ASSERTE(Enabled());
+    _ASSERTE(pCodeInfo->IsValid());
+
+    PCODE ip = pCodeInfo->m_codeAddress;
+    _ASSERTE(ip != NULL && ip != LOCKED_IP);
+
+    // The code of LCG methods is freed as soon as the method is collected, without
+    // going through the range section teardown that flushes this cache.
+    if (pCodeInfo->m_pMD == NULL || pCodeInfo->m_pMD->IsLCGMethod())
+        return;
+
+    Entry * pEntry = &s_rgEntries[GetKey(ip)];
+
+    PCODE oldIP = VolatileLoad(&pEntry->IP);
+    if (oldIP == ip || oldIP == LOCKED_IP)
+        return;
+
+    if (InterlockedCompareExchangeT(&pEntry->IP, LOCKED_IP, oldIP) != oldIP)
+        return;
+
+    // The code may have been unloaded between the time pCodeInfo was computed and the time we
+    // claimed the entry. Invalidate() bumps the epoch before it sweeps the table, so checking it
+    // with the entry held is enough to never publish a stale entry.
+    if (VolatileLoad(&s_dwEpoch) != dwEpoch)
+    {
+        VolatileStore(&pEntry->IP, (PCODE)NULL);
+        return;
+    }
+
+    // Only the holder of the entry writes the sequence number
+    DWORD dwSequence = pEntry->dwSequence;
+    _ASSERTE((dwSequence & 1) == 0);
+    VolatileStore(&pEntry->dwSequence, dwSequence + 1);
+    MemoryBarrier();
+
+    VolatileStore(&pEntry->pRangeSection, pCodeInfo->m_methodToken.m_pRangeSection);
+    VolatileStore(&pEntry->pCodeHeader, pCodeInfo->m_methodToken.m_pCodeHeader);
+    VolatileStore(&pEntry->pMD, pCodeInfo->m_pMD);
+    VolatileStore(&pEntry->pJM, pCodeInfo->m_pJM);
+    VolatileStore(&pEntry->relOffset, pCodeInfo->m_relOffset);
+#ifdef WIN64EXCEPTIONS
+    VolatileStore(&pEntry->pFunctionEntry, pCodeInfo->m_pFunctionEntry);
+#endif // WIN64EXCEPTIONS
+
+    VolatileStore(&pEntry->IP, ip);
+    VolatileStore(&pEntry->dwSequence, dwSequence + 2);
+}
+
+/*
+    Flushes the whole cache. Called whenever a code range is removed, since the same
+    addresses may be reused for other code afterwards.
+*/
+// static
+void StackwalkCodeInfoCache::Invalidate()
+{
+    CONTRACTL {
+        NOTHROW;
+        GC_NOTRIGGER;
+    } CONTRACTL_END;
+
+    if (!s_fEnabled)
+        return;
+
+    FastInterlockIncrement((LONG *)&s_dwEpoch);
+
+    for (unsigned i = 0; i < NUM_OF_CODEINFO_CACHE_ENTRIES; i++)
+    {
+        Entry * pEntry = &s_rgEntries[i];
+
+        DWORD dwSwitchCount = 0;
+        for (;;)
+        {
+            PCODE ip = VolatileLoad(&pEntry->IP);
+            if (ip == NULL)
+                break;
+
+            // Wait for an in-flight insert to finish; it will notice the new epoch and back off
+            // or it will have published before we got here and we clear it below.
+            if (ip == LOCKED_IP)
+            {
+                __SwitchToThread(0, ++dwSwitchCount);
+                continue;
+            }
+
+            if (InterlockedCompareExchangeT(&pEntry->IP, (PCODE)NULL, ip) == ip)
+                break;
+        }
+    }
+}
+
+#endif // !DACCESS_COMPILE
+
 //----------------------------------------------------------------------------
 // 
 // SetUpRegdisplayForStackWalk - set up Regdisplay for a stack walk
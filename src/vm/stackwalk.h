@@ -542,6 +542,62 @@ private:
 #endif // ELIMINATE_FEF
 
 
+#ifndef DACCESS_COMPILE
+//---------------------------------------------------------------------------------------
+//
+// StackwalkCodeInfoCache remembers the result of EECodeInfo::Init() for the control PCs seen by
+// StackFrameIterator, so that deep and stable stacks do not pay for the range section lookup and
+// the nibble map / runtime function search on every GC stack crawl or stack trace capture.
+//
+// The cache is a fixed-size, direct-mapped table shared by all threads. Writers claim an entry through
+// its IP field; readers validate their copy with the sequence number of the entry
+// (see code:StackwalkCodeInfoCache::Lookup).
+// The whole table is flushed whenever a code range goes away (see code:ExecutionManager::Unload and
+// code:ExecutionManager::DeleteRange). Code of LCG methods can be freed individually and is
+// never cached.
+//
+
+class StackwalkCodeInfoCache
+{
+public:
+    static void Init();
+
+    static BOOL Enabled() { LIMITED_METHOD_CONTRACT; return s_fEnabled; }
+
+    // Snapshot of the invalidation epoch; must be taken before the EECodeInfo to be inserted is computed.
+    static DWORD GetEpoch() { LIMITED_METHOD_CONTRACT; return VolatileLoad(&s_dwEpoch); }
+
+    static BOOL Lookup(PCODE ip, EECodeInfo * pCodeInfo);
+    static void Insert(EECodeInfo * pCodeInfo, DWORD dwEpoch);
+
+    static void Invalidate();
+
+private:
+    struct Entry
+    {
+        PCODE                   IP;             // 0 when empty, LOCKED_IP while being written
+        DWORD                   dwSequence;     // Odd while the payload is being written
+        RangeSection *          pRangeSection;
+        TADDR                   pCodeHeader;
+        MethodDesc *            pMD;
+        IJitManager *           pJM;
+        DWORD                   relOffset;
+#ifdef WIN64EXCEPTIONS
+        PTR_RUNTIME_FUNCTION    pFunctionEntry;
+#endif // WIN64EXCEPTIONS
+    };
+
+    static const PCODE LOCKED_IP = 1;
+
+    static unsigned GetKey(PCODE ip);
+
+    static Entry        s_rgEntries[];
+    static BOOL         s_fEnabled;
+    static DWORD        s_dwEpoch;
+};
+#endif // !DACCESS_COMPILE
+
+
 //---------------------------------------------------------------------------------------
 //
 // This iterator class walks the stack of a managed thread.  Where the iterator stops depends on the 
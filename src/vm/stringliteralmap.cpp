@@ -49,6 +49,14 @@
 // assumes that memory pools's per block data is same as sizeof (StringLiteralEntry) 
 #define EEHASH_MEMORY_POOL_GROW_COUNT 128
 
+#ifdef FEATURE_BASICFREEZE
+// Each frozen segment reserves this much address space and commits it on demand.
+#define FROZEN_STRING_SEGMENT_RESERVE_SIZE (4*1024*1024)
+#define FROZEN_STRING_SEGMENT_COMMIT_SIZE (64*1024)
+// Larger literals are rare and would waste the tail of a segment, so they stay on the GC heap.
+#define FROZEN_STRING_MAX_OBJECT_SIZE (FROZEN_STRING_SEGMENT_RESERVE_SIZE/8)
+#endif // FEATURE_BASICFREEZE
+
 StringLiteralEntryArray *StringLiteralEntry::s_EntryList = NULL;
 DWORD StringLiteralEntry::s_UsedEntries = NULL;
 StringLiteralEntry *StringLiteralEntry::s_FreeEntryList = NULL;
@@ -176,7 +184,7 @@ STRINGREF *StringLiteralMap::GetStringLiteral(EEStringData *pStringData, BOOL bA
         // someone beat us to inserting it. (m_StringToEntryHashTable->GetValue(pStringData, &Data))
         // (Rather than waiting until after we look the string up in the global map) 
         
-        StringLiteralEntryHolder pEntry(SystemDomain::GetGlobalStringLiteralMap()->GetStringLiteral(pStringData, dwHash, bAddIfNotFound));
+        StringLiteralEntryHolder pEntry(SystemDomain::GetGlobalStringLiteralMap()->GetStringLiteral(pStringData, dwHash, bAddIfNotFound, bAppDomainWontUnload));
 
         _ASSERTE(pEntry || !bAddIfNotFound);
 
@@ -315,6 +323,120 @@ GlobalStringLiteralMap::GlobalStringLiteralMap()
 #endif
 }
 
+#ifdef FEATURE_BASICFREEZE
+FrozenStringLiteralHeap::FrozenStringLiteralHeap()
+: m_pCurrent(NULL)
+, m_pCommitLimit(NULL)
+, m_pReserveLimit(NULL)
+, m_SegmentHandle(NULL)
+{
+    LIMITED_METHOD_CONTRACT;
+}
+
+BOOL FrozenStringLiteralHeap::ReserveSegment()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_ANY;
+        PRECONDITION(SystemDomain::GetGlobalStringLiteralMap()->GetHashTableCrstGlobal()->OwnedByCurrentThread());
+    }
+    CONTRACTL_END;
+
+    BYTE *pStart = (BYTE *)ClrVirtualAlloc(NULL, FROZEN_STRING_SEGMENT_RESERVE_SIZE, MEM_RESERVE, PAGE_NOACCESS);
+    if (pStart == NULL)
+        return FALSE;
+
+    if (ClrVirtualAlloc(pStart, FROZEN_STRING_SEGMENT_COMMIT_SIZE, MEM_COMMIT, PAGE_READWRITE) == NULL)
+    {
+        ClrVirtualFree(pStart, 0, MEM_RELEASE);
+        return FALSE;
+    }
+
+    // The first object starts after the room for its header; the memory is already zeroed.
+    segment_info si;
+    si.pvMem = pStart;
+    si.ibFirstObject = sizeof(ObjHeader);
+    si.ibAllocated = si.ibFirstObject;
+    si.ibCommit = FROZEN_STRING_SEGMENT_COMMIT_SIZE;
+    si.ibReserved = FROZEN_STRING_SEGMENT_RESERVE_SIZE;
+
+    segment_handle hSegment = GCHeap::GetGCHeap()->RegisterFrozenSegment(&si);
+    if (hSegment == NULL)
+    {
+        ClrVirtualFree(pStart, 0, MEM_RELEASE);
+        return FALSE;
+    }
+
+    // The previous segment, if any, stays registered with whatever it already holds.
+    m_pCurrent = pStart + si.ibFirstObject;
+    m_pCommitLimit = pStart + si.ibCommit;
+    m_pReserveLimit = pStart + si.ibReserved;
+    m_SegmentHandle = hSegment;
+
+    return TRUE;
+}
+
+STRINGREF *FrozenStringLiteralHeap::AllocateStringLiteral(EEStringData *pStringData)
+{
+    CONTRACTL
+    {
+        THROWS;
+        GC_TRIGGERS;
+        MODE_COOPERATIVE;
+        PRECONDITION(CheckPointer(pStringData));
+        PRECONDITION(SystemDomain::GetGlobalStringLiteralMap()->GetHashTableCrstGlobal()->OwnedByCurrentThread());
+    }
+    CONTRACTL_END;
+
+    static ConfigDWORD fFrozenStringLiterals;
+    if (!fFrozenStringLiterals.val(CLRConfig::UNSUPPORTED_GCFrozenStringLiterals))
+        return NULL;
+
+    DWORD cCount = pStringData->GetCharCount();
+    SIZE_T ObjectSize = PtrAlign(StringObject::GetSize(cCount));
+    if (ObjectSize >= FROZEN_STRING_MAX_OBJECT_SIZE)
+        return NULL;
+
+    // Objects are laid out back to back, so the header of each object is the tail of the previous one.
+    if (m_pCurrent == NULL || ObjectSize > (SIZE_T)(m_pReserveLimit - m_pCurrent))
+    {
+        if (!ReserveSegment())
+            return NULL;
+    }
+
+    if (ObjectSize > (SIZE_T)(m_pCommitLimit - m_pCurrent))
+    {
+        SIZE_T cbCommit = ALIGN_UP(ObjectSize - (m_pCommitLimit - m_pCurrent), FROZEN_STRING_SEGMENT_COMMIT_SIZE);
+        cbCommit = min(cbCommit, (SIZE_T)(m_pReserveLimit - m_pCommitLimit));
+        if (ClrVirtualAlloc(m_pCommitLimit, cbCommit, MEM_COMMIT, PAGE_READWRITE) == NULL)
+            return NULL;
+        m_pCommitLimit += cbCommit;
+    }
+
+    // The cell referencing the string lives outside the GC heap for good, like the string itself.
+    STRINGREF *pStrObj = (STRINGREF *)(void *)SystemDomain::GetGlobalLoaderAllocator()->GetLowFrequencyHeap()->AllocMem(S_SIZE_T(sizeof(STRINGREF)));
+
+    StringObject *orObject = (StringObject *)m_pCurrent;
+    _ASSERTE(orObject->HasEmptySyncBlockInfo());
+    orObject->SetMethodTable(g_pStringClass);
+    orObject->SetStringLength(cCount);
+
+    // Copy the string constant into the frozen string object. As for the GC heap copy, there is an
+    // extra null at the end, which the committed memory already provides.
+    memcpyNoGCRefs(orObject->GetBuffer(), pStringData->GetStringBuffer(), cCount*sizeof(WCHAR));
+
+    m_pCurrent += ObjectSize;
+
+    // Only publish the object to the GC once it is complete.
+    GCHeap::GetGCHeap()->UpdateFrozenSegment(m_SegmentHandle, m_pCurrent, m_pCommitLimit);
+
+    *pStrObj = ObjectToSTRINGREF(orObject);
+    return pStrObj;
+}
+#endif // FEATURE_BASICFREEZE
+
 GlobalStringLiteralMap::~GlobalStringLiteralMap()
 {
     CONTRACTL
@@ -373,7 +495,7 @@ void GlobalStringLiteralMap::Init()
         ThrowOutOfMemory();
 }
 
-StringLiteralEntry *GlobalStringLiteralMap::GetStringLiteral(EEStringData *pStringData, DWORD dwHash, BOOL bAddIfNotFound)
+StringLiteralEntry *GlobalStringLiteralMap::GetStringLiteral(EEStringData *pStringData, DWORD dwHash, BOOL bAddIfNotFound, BOOL bAppDomainWontUnload)
 {
     CONTRACTL
     {
@@ -399,7 +521,7 @@ StringLiteralEntry *GlobalStringLiteralMap::GetStringLiteral(EEStringData *pStri
     else
     {
         if (bAddIfNotFound)
-            pEntry = AddStringLiteral(pStringData);
+            pEntry = AddStringLiteral(pStringData, bAppDomainWontUnload);
     }
 
     return pEntry;
@@ -484,7 +606,7 @@ STRINGREF AllocateStringObject(EEStringData *pStringData)
 
     return strObj;
 }
-StringLiteralEntry *GlobalStringLiteralMap::AddStringLiteral(EEStringData *pStringData)
+StringLiteralEntry *GlobalStringLiteralMap::AddStringLiteral(EEStringData *pStringData, BOOL bAppDomainWontUnload)
 {
     CONTRACTL
     {
@@ -498,6 +620,29 @@ StringLiteralEntry *GlobalStringLiteralMap::AddStringLiteral(EEStringData *pStri
 
     StringLiteralEntry *pRet;
 
+#ifdef FEATURE_BASICFREEZE
+    // Literals of domains that never unload are never released either, so they can live in a
+    // frozen segment instead of taking a GC heap allocation and a pinned handle slot.
+    if (bAppDomainWontUnload)
+    {
+        STRINGREF *pFrozenStrObj = m_FrozenStringLiteralHeap.AllocateStringLiteral(pStringData);
+        if (pFrozenStrObj != NULL)
+        {
+            StringLiteralEntryHolder pEntry(StringLiteralEntry::AllocateEntry(pStringData, pFrozenStrObj));
+            // There is no handle behind the entry, so it must never reach RemoveStringLiteralEntry.
+            pEntry->MakeImmortal();
+            m_StringToEntryHashTable->InsertValue(pStringData, (LPVOID)pEntry, FALSE);
+            pEntry.SuppressRelease();
+            pRet = pEntry;
+
+#ifdef LOGGING
+            LogStringLiteral("added frozen", pStringData);
+#endif
+            return pRet;
+        }
+    }
+#endif // FEATURE_BASICFREEZE
+
     {
     LargeHeapHandleBlockHolder pStrObj(&m_LargeHeapHandleTable,1);
     // Create the COM+ string object.
@@ -56,6 +56,28 @@ private:
     MemoryPool                  *m_MemoryPool;
 };
 
+#ifdef FEATURE_BASICFREEZE
+// Bump allocator for string literals that are never collected. The strings are laid out in
+// segments registered with the GC as frozen, so they need neither a GC allocation nor a handle;
+// the references to them are kept in cells allocated from the global loader heap.
+class FrozenStringLiteralHeap
+{
+public:
+    FrozenStringLiteralHeap();
+
+    // Returns NULL if the string cannot be frozen, in which case the caller falls back to the GC heap.
+    STRINGREF *AllocateStringLiteral(EEStringData *pStringData);
+
+private:
+    BOOL ReserveSegment();
+
+    BYTE*                       m_pCurrent;
+    BYTE*                       m_pCommitLimit;
+    BYTE*                       m_pReserveLimit;
+    segment_handle              m_SegmentHandle;
+};
+#endif // FEATURE_BASICFREEZE
+
 // Global string literal map.
 class GlobalStringLiteralMap
 {
@@ -72,7 +94,7 @@ public:
     void Init();
 
     // Method to retrieve a string from the map. Takes a precomputed hash (for perf).
-    StringLiteralEntry *GetStringLiteral(EEStringData *pStringData, DWORD dwHash, BOOL bAddIfNotFound);
+    StringLiteralEntry *GetStringLiteral(EEStringData *pStringData, DWORD dwHash, BOOL bAddIfNotFound, BOOL bAppDomainWontUnload);
 
     // Method to explicitly intern a string object. Takes a precomputed hash (for perf).
     StringLiteralEntry *GetInternedString(STRINGREF *pString, DWORD dwHash, BOOL bAddIfNotFound);
@@ -93,7 +115,7 @@ public:
 
 private:    
     // Helper method to add a string to the global string literal map.
-    StringLiteralEntry *AddStringLiteral(EEStringData *pStringData);
+    StringLiteralEntry *AddStringLiteral(EEStringData *pStringData, BOOL bAppDomainWontUnload);
 
     // Helper method to add an interned string.
     StringLiteralEntry *AddInternedString(STRINGREF *pString);
@@ -117,6 +139,10 @@ private:
     // The large heap handle table.
     LargeHeapHandleTable        m_LargeHeapHandleTable;
 
+#ifdef FEATURE_BASICFREEZE
+    // The frozen segments for string literals of domains that never unload.
+    FrozenStringLiteralHeap     m_FrozenStringLiteralHeap;
+#endif // FEATURE_BASICFREEZE
 };
 
 class StringLiteralEntryArray;
@@ -153,7 +179,7 @@ public:
             NOTHROW;
             GC_NOTRIGGER;
             PRECONDITION(CheckPointer<void>(this));
-            PRECONDITION((LONG)VolatileLoad(&m_dwRefCount) > 0);            
+            PRECONDITION(VolatileLoad(&m_dwRefCount) > 0);
             PRECONDITION(SystemDomain::GetGlobalStringLiteralMapNoCreate()->m_HashTableCrstGlobal.OwnedByCurrentThread());            
         }
         CONTRACTL_END;
@@ -166,6 +192,23 @@ public:
 
         VolatileStore(&m_dwRefCount, VolatileLoad(&m_dwRefCount) + 1);
     }
+    // Keeps the entry alive forever, e.g. because its string object is frozen and has no handle to release.
+    void MakeImmortal()
+    {
+        CONTRACTL
+        {
+            NOTHROW;
+            GC_NOTRIGGER;
+            PRECONDITION(CheckPointer<void>(this));
+            PRECONDITION(SystemDomain::GetGlobalStringLiteralMapNoCreate()->m_HashTableCrstGlobal.OwnedByCurrentThread());
+        }
+        CONTRACTL_END;
+
+        _ASSERTE (!m_bDeleted);
+
+        VolatileStore(&m_dwRefCount, (DWORD)0x80000000);
+    }
+
 #ifndef DACCESS_COMPILE
     FORCEINLINE static void StaticRelease(StringLiteralEntry* pEntry)
     {        
@@ -1869,7 +1869,7 @@ void CheckADValidity(AppDomain* pDomain, DWORD ADValidityKind)
         pDomain->IsCompilationDomain())
        return;
     if ((ADValidityKind &  ADV_FINALIZER) &&
-        IsFinalizerThread())
+        (IsFinalizerThread() || IsFinalizerHelperThread()))
        return;
     if ((ADValidityKind &  ADV_ADUTHREAD) &&
         IsADUnloadHelperThread())
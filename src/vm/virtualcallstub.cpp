@@ -54,6 +54,7 @@ UINT32 g_insert_cache_hit = 0;          //# of times Insert found an empty cache
 UINT32 g_insert_cache_miss = 0;         //# of times Insert already had a matching cache entry
 UINT32 g_insert_cache_collide = 0;      //# of times Insert found a used cache entry
 UINT32 g_insert_cache_write = 0;        //# of times Insert wrote a cache entry
+UINT32 g_insert_cache_max_chain = 0;    //longest chain seen by Insert
 
 UINT32 g_cache_entry_counter = 0;       //# of cache structs
 UINT32 g_cache_entry_space = 0;         //# of bytes used by cache lookup structs
@@ -355,6 +356,8 @@ void VirtualCallStubManager::LoggingDump()
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT_PCT, "insert_cache_write", g_insert_cache_write,
                 100.0 * double(g_insert_cache_write)/double(total_inserts));
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
+        sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "insert_cache_max_chain", g_insert_cache_max_chain);
+        WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
 
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), "\r\ncache data\r\n");
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
@@ -385,7 +388,7 @@ void VirtualCallStubManager::LoggingDump()
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), "\r\ncache entry write counts\r\n");
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
         DispatchCache::CacheEntryData *rgCacheData = g_resolveCache->cacheData;
-        for (UINT16 i = 0; i < CALL_STUB_CACHE_SIZE; i++)
+        for (size_t i = 0; i < g_resolveCache->GetCacheCount(); i++)
         {
             sprintf_s(szPrintStr, COUNTOF(szPrintStr), " %4d", rgCacheData[i]);
             WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
@@ -462,6 +465,7 @@ void VirtualCallStubManager::ResetCache()
     g_insert_cache_miss = 0;
     g_insert_cache_collide = 0;
     g_insert_cache_write = 0;
+    g_insert_cache_max_chain = 0;
 
     // Go through each cache entry and if the cache element there is in
     // the cache entry heap of the manager being deleted, then we just
@@ -877,7 +881,16 @@ void VirtualCallStubManager::InitStatic()
 #endif // !STUB_DISPATCH_PORTABLE
     LookupHolder::InitializeStatic();
 
-    g_resolveCache = new DispatchCache();
+    // Applications with a large number of interface call targets see long collision
+    // chains in the resolve cache, so its size can be raised at startup. The size
+    // cannot change later since the cache address and mask are inlined in the stubs.
+    DWORD cacheBits = CLRConfig::GetConfigValue(CLRConfig::EXTERNAL_VirtualCallStubCacheBits);
+    if (cacheBits < CALL_STUB_CACHE_NUM_BITS)
+        cacheBits = CALL_STUB_CACHE_NUM_BITS;
+    if (cacheBits > CALL_STUB_CACHE_MAX_NUM_BITS)
+        cacheBits = CALL_STUB_CACHE_MAX_NUM_BITS;
+
+    g_resolveCache = new DispatchCache(cacheBits);
 
     if(CLRConfig::GetConfigValue(CLRConfig::EXTERNAL_VirtualCallStubLogging))
         StartupLogging();
@@ -3011,7 +3024,8 @@ ResolveHolder *VirtualCallStubManager::GenerateResolveStub(PCODE            addr
 
     holder->Initialize(addrOfResolver, addrOfPatcher,
                        dispatchToken, DispatchCache::HashToken(dispatchToken),
-                       g_resolveCache->GetCacheBaseAddr(), counterAddr);
+                       g_resolveCache->GetCacheBaseAddr(), g_resolveCache->GetCacheMask(),
+                       counterAddr);
     ClrFlushInstructionCache(holder->stub(), holder->stub()->size());
 
     AddToCollectibleVSDRangeList(holder);
@@ -3055,6 +3069,19 @@ LookupHolder *VirtualCallStubManager::GenerateLookupStub(PCODE addrOfResolver, s
     RETURN (holder);
 }
 
+//----------------------------------------------------------------------------
+// Returns the alignment used for resolve cache entries: the smallest power of 2
+// that holds an entry, capped at the cache line size.
+static size_t GetResolveCacheElemAlignment()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    size_t alignment = CODE_SIZE_ALIGN;
+    while (alignment < sizeof(ResolveCacheElem) && alignment < CALL_STUB_CACHE_LINE_SIZE)
+        alignment <<= 1;
+    return alignment;
+}
+
 //----------------------------------------------------------------------------
 /* Generate a cache entry
 */
@@ -3073,8 +3100,9 @@ ResolveCacheElem *VirtualCallStubManager::GenerateResolveCacheElem(void *addrOfC
     CONSISTENCY_CHECK(CheckPointer(pMTExpected));
 
     //allocate from the requisite heap and set the appropriate fields
+    //entries are aligned to their (power of 2) size so that an entry never straddles a cache line
     ResolveCacheElem *e = (ResolveCacheElem*) (void*)
-        cache_entry_heap->AllocAlignedMem(sizeof(ResolveCacheElem), CODE_SIZE_ALIGN);
+        cache_entry_heap->AllocAlignedMem(sizeof(ResolveCacheElem), GetResolveCacheElemAlignment());
 
     e->pMT    = pMTExpected;
     e->token  = token;
@@ -3646,7 +3674,7 @@ void BucketTable::LogStats()
     stats.bucket_space_dead = 0;
 }
 
-DispatchCache::DispatchCache()
+DispatchCache::DispatchCache(UINT32 numBits)
 #ifdef CHAIN_LOOKUP 
     : m_writeLock(CrstStubDispatchCache, CRST_UNSAFE_ANYMODE)
 #endif
@@ -3656,22 +3684,34 @@ DispatchCache::DispatchCache()
         THROWS;
         GC_TRIGGERS;
         INJECT_FAULT(COMPlusThrowOM());
+        PRECONDITION(numBits <= CALL_STUB_CACHE_MAX_NUM_BITS);
     }
     CONTRACTL_END
 
+    m_cacheMask = ((size_t)1 << numBits) - 1;
+
+    // The bucket array is allocated once and never freed, since its address is
+    // inlined into every resolve stub. Align it to a cache line so that a probe
+    // of one bucket never touches two lines.
+    size_t cbCache = GetCacheCount() * sizeof(ResolveCacheElem*);
+    BYTE *pCacheMem = new BYTE[cbCache + CALL_STUB_CACHE_LINE_SIZE - 1];
+    cache = (ResolveCacheElem**) ALIGN_UP(pCacheMem, CALL_STUB_CACHE_LINE_SIZE);
+
     //initialize the cache to be empty, i.e. all slots point to the empty entry
     ResolveCacheElem* e = new ResolveCacheElem();
     e->pMT = (void *) (-1); //force all method tables to be misses
     e->pNext = NULL; // null terminate the chain for the empty entry
     empty = e;
-    for (int i = 0;i<CALL_STUB_CACHE_SIZE;i++)
-        ClearCacheEntry(i);
 
     // Initialize statistics
     memset(&stats, 0, sizeof(stats));
 #ifdef STUB_LOGGING 
-    memset(&cacheData, 0, sizeof(cacheData));
+    cacheData = new CacheEntryData[GetCacheCount()];
+    memset(cacheData, 0, GetCacheCount() * sizeof(CacheEntryData));
 #endif
+
+    for (size_t i = 0; i < GetCacheCount(); i++)
+        ClearCacheEntry(i);
 }
 
 ResolveCacheElem* DispatchCache::Lookup(size_t token, UINT16 tokenHash, void* mt)
@@ -3797,6 +3837,15 @@ BOOL DispatchCache::Insert(ResolveCacheElem* elem, InsertKind insertKind)
 #ifdef CHAIN_LOOKUP 
         // We create a list with the last pNext pointing at empty
         elem->pNext = cell;
+
+        if (collide)
+        {
+            UINT32 chainLength = 1;
+            for (ResolveCacheElem *pCur = cell; pCur != empty; pCur = pCur->Next())
+                chainLength++;
+            if (chainLength > stats.insert_cache_max_chain)
+                stats.insert_cache_max_chain = chainLength;
+        }
 #else // !CHAIN_LOOKUP
         elem->pNext = empty;
 #endif // !CHAIN_LOOKUP
@@ -3887,6 +3936,8 @@ void DispatchCache::LogStats()
     g_insert_cache_miss     += stats.insert_cache_miss;
     g_insert_cache_collide  += stats.insert_cache_collide;
     g_insert_cache_write    += stats.insert_cache_write;
+    if (stats.insert_cache_max_chain > g_insert_cache_max_chain)
+        g_insert_cache_max_chain = stats.insert_cache_max_chain;
 
     stats.insert_cache_external = 0;
     stats.insert_cache_shared = 0;
@@ -3896,6 +3947,7 @@ void DispatchCache::LogStats()
     stats.insert_cache_miss = 0;
     stats.insert_cache_collide = 0;
     stats.insert_cache_write = 0;
+    stats.insert_cache_max_chain = 0;
 }
 
 /* The following tablse have bits that have the following properties:
@@ -3940,6 +3992,8 @@ static const UINT16 tokenHashBits[32] =
     // Note if you change the number of bits in CALL_STUB_CACHE_NUM_BITS
     // then we have to recompute the hash function
     // Though making the number of bits smaller should still be OK
+    // Caches larger than 2^CALL_STUB_CACHE_NUM_BITS get their upper index bits
+    // from the MethodTable part of the hash only.
     static_assert_no_msg(CALL_STUB_CACHE_NUM_BITS <= 12);
 
     while (token)
@@ -958,11 +958,23 @@ extern UINT32 STUB_COLLIDE_MONO_PCT;
 #define STUB_COLLIDE_MONO_PCT     0
 #endif // !STUB_LOGGING
 
-//size and mask of the cache used by resolve stubs
+//default size and mask of the cache used by resolve stubs
 // CALL_STUB_CACHE_SIZE must be equal to 2^CALL_STUB_CACHE_NUM_BITS
+// CALL_STUB_CACHE_NUM_BITS is also the shift used to fold the upper bits of the MethodTable
+// into the hash, which is inlined in the resolve stubs and does not change with the cache size.
 #define CALL_STUB_CACHE_NUM_BITS 12 //10
 #define CALL_STUB_CACHE_SIZE 4096 //1024
 #define CALL_STUB_CACHE_MASK (CALL_STUB_CACHE_SIZE-1)
+// The actual cache size is picked at startup (VirtualCallStubCacheBits). Cache indices are
+// UINT16, so the cache can grow to at most 2^16 entries. The arm64 resolve stub encodes the
+// cache mask as an instruction immediate, so it stays at the default size there.
+#if defined(_TARGET_ARM64_)
+#define CALL_STUB_CACHE_MAX_NUM_BITS CALL_STUB_CACHE_NUM_BITS
+#else
+#define CALL_STUB_CACHE_MAX_NUM_BITS 16
+#endif
+// Resolve cache entries are laid out so that a single entry never straddles a cache line.
+#define CALL_STUB_CACHE_LINE_SIZE 64
 #define CALL_STUB_CACHE_PROBES 5
 //min sizes for BucketTable and buckets and the growth and hashing constants
 #define CALL_STUB_MIN_BUCKETS 32
@@ -1211,7 +1223,7 @@ class DispatchCache
 public:
     static const UINT16 INVALID_HASH = (UINT16)(-1);
 
-    DispatchCache();
+    DispatchCache(UINT32 numBits);
 
     //read and write the cache keyed by (method table,token) pair.
     inline ResolveCacheElem* Lookup(size_t token, void* mt)
@@ -1233,9 +1245,9 @@ public:
     {
         LIMITED_METHOD_CONTRACT;
 
-        *total = CALL_STUB_CACHE_SIZE;
+        *total = GetCacheCount();
         size_t count = 0;
-        for (size_t i = 0; i < CALL_STUB_CACHE_SIZE; i++)
+        for (size_t i = 0; i < GetCacheCount(); i++)
             if (cache[i] != empty)
                 count++;
         *used = count;
@@ -1244,7 +1256,9 @@ public:
     inline void *GetCacheBaseAddr()
         { LIMITED_METHOD_CONTRACT; return &cache[0]; }
     inline size_t GetCacheCount()
-        { LIMITED_METHOD_CONTRACT; return CALL_STUB_CACHE_SIZE; }
+        { LIMITED_METHOD_CONTRACT; return m_cacheMask + 1; }
+    inline size_t GetCacheMask()
+        { LIMITED_METHOD_CONTRACT; return m_cacheMask; }
     inline ResolveCacheElem *GetCacheEntry(size_t idx)
         { LIMITED_METHOD_CONTRACT; return VolatileLoad(&cache[idx]); }
     inline BOOL IsCacheEntryEmpty(size_t idx)
@@ -1259,8 +1273,10 @@ public:
 #ifdef CHAIN_LOOKUP 
         CONSISTENCY_CHECK(m_writeLock.OwnedByCurrentThread());
 #endif
-          cache[idx] = elem;
-        }
+        // Resolve stubs read the cache without taking any lock, so the entry (including
+        // its pNext link) must be fully visible before it is published in the bucket.
+        VolatileStore(&cache[idx], elem);
+    }
 
     inline void ClearCacheEntry(size_t idx)
     {
@@ -1268,8 +1284,8 @@ public:
 #ifdef STUB_LOGGING 
           cacheData[idx].numClears++;
 #endif
-          cache[idx] = empty;
-        }
+        VolatileStore(&cache[idx], empty);
+    }
 
     struct
     {
@@ -1281,6 +1297,7 @@ public:
         UINT32 insert_cache_miss;         //# of times Insert already had a matching cache entry
         UINT32 insert_cache_collide;      //# of times Insert found a used cache entry
         UINT32 insert_cache_write;        //# of times Insert wrote a cache entry
+        UINT32 insert_cache_max_chain;    //longest chain seen by Insert
     } stats;
 
     void LogStats();
@@ -1319,30 +1336,31 @@ private:
 #endif
 
     //the following hash computation is also inlined in the resolve stub in asm (SO NO TOUCHIE)
-    inline static UINT16 HashMT(UINT16 tokenHash, void* mt)
+    inline UINT16 HashMT(UINT16 tokenHash, void* mt)
     {
         LIMITED_METHOD_CONTRACT;
 
         UINT16 hash;
 
         size_t mtHash = (size_t) mt;
-        mtHash = (((mtHash >> CALL_STUB_CACHE_NUM_BITS) + mtHash) >> LOG2_PTRSIZE) & CALL_STUB_CACHE_MASK;
+        mtHash = (((mtHash >> CALL_STUB_CACHE_NUM_BITS) + mtHash) >> LOG2_PTRSIZE) & m_cacheMask;
         hash  = (UINT16) mtHash;
 
-        hash ^= (tokenHash & CALL_STUB_CACHE_MASK);
+        hash ^= (tokenHash & m_cacheMask);
 
         return hash;
     }
 
-    ResolveCacheElem* cache[CALL_STUB_CACHE_SIZE]; //must be first
+    ResolveCacheElem** cache;                   //cache line aligned array of GetCacheCount() buckets
     ResolveCacheElem* empty;                    //empty entry, initialized to fail all comparisons
+    size_t m_cacheMask;                         //GetCacheCount() - 1, also inlined in the resolve stubs
 #ifdef STUB_LOGGING 
 public:
     struct CacheEntryData {
         UINT32 numWrites;
         UINT16 numClears;
     };
-    CacheEntryData cacheData[CALL_STUB_CACHE_SIZE];
+    CacheEntryData *cacheData;
 #endif // STUB_LOGGING
 };
 
@@ -117,7 +117,7 @@ int ThreadpoolMgr::offset_counter = 0;
 SPTR_IMPL(WorkRequest,ThreadpoolMgr,WorkRequestHead);        // Head of work request queue
 SPTR_IMPL(WorkRequest,ThreadpoolMgr,WorkRequestTail);        // Head of work request queue
 
-SVAL_IMPL(ThreadpoolMgr::LIST_ENTRY,ThreadpoolMgr,TimerQueue);  // queue of timers
+SVAL_IMPL(LONG,ThreadpoolMgr,NumTimers);                     // number of active timers
 
 //unsigned int ThreadpoolMgr::LastCpuSamplingTime=0;      //  last time cpu utilization was sampled by gate thread
 unsigned int ThreadpoolMgr::LastCPThreadCreation=0;     //  last time a completion port thread was created
@@ -129,6 +129,17 @@ CLREvent * ThreadpoolMgr::RetiredCPWakeupEvent;       // wakeup event for comple
 CrstStatic ThreadpoolMgr::WaitThreadsCriticalSection;
 ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::WaitThreadsHead;
 
+#ifdef FEATURE_PAL
+LONG ThreadpoolMgr::WaitSetStatus = WaitSetUninitialized;
+PAL_WAIT_SET ThreadpoolMgr::WaitSet = NULL;
+DWORD ThreadpoolMgr::WaitSetThreadId = 0;
+CLREvent * ThreadpoolMgr::WaitSetWakeupEvent = NULL;
+ThreadpoolMgr::WaitSetRequest * volatile ThreadpoolMgr::WaitSetRequests = NULL;
+ThreadpoolMgr::WaitInfo ** ThreadpoolMgr::WaitSetTimers = NULL;
+int ThreadpoolMgr::WaitSetTimerCount = 0;
+int ThreadpoolMgr::WaitSetTimerCapacity = 0;
+#endif // FEATURE_PAL
+
 ThreadpoolMgr::UnfairSemaphore* ThreadpoolMgr::WorkerSemaphore;
 CLRSemaphore* ThreadpoolMgr::RetiredWorkerSemaphore;
 
@@ -136,6 +147,9 @@ CrstStatic ThreadpoolMgr::TimerQueueCriticalSection;
 HANDLE ThreadpoolMgr::TimerThread=NULL;
 Thread *ThreadpoolMgr::pTimerThread=NULL;
 DWORD ThreadpoolMgr::LastTickCount;
+ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::TimerWheel[TIMER_WHEEL_SLOTS];
+DWORD ThreadpoolMgr::TimerWheelOccupied[TIMER_WHEEL_SLOTS / 32];
+ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::ExpiredTimers;
 
 #ifdef _DEBUG
 DWORD ThreadpoolMgr::TickCountAdjustment=0;
@@ -352,8 +366,12 @@ BOOL ThreadpoolMgr::Initialize()
         // initialize WaitThreadsHead
         InitializeListHead(&WaitThreadsHead);
 
-        // initialize TimerQueue
-        InitializeListHead(&TimerQueue);
+        // initialize the timer wheel
+        for (int i = 0; i < TIMER_WHEEL_SLOTS; i++)
+        {
+            InitializeListHead(&TimerWheel[i]);
+        }
+        InitializeListHead(&ExpiredTimers);
 
         RetiredCPWakeupEvent = new CLREvent();
         RetiredCPWakeupEvent->CreateAutoEvent(FALSE);
@@ -1416,8 +1434,25 @@ BOOL ThreadpoolMgr::PostQueuedCompletionStatus(LPOVERLAPPED lpOverlapped,
                                         (ULONG_PTR) Function,
                                         lpOverlapped);
 #else  
-    SetLastError(ERROR_CALL_NOT_IMPLEMENTED);
-    return FALSE;
+    EnsureInitialized();
+
+    // There is no completion port in the PAL, so completions are dispatched
+    // to worker threads the same way they are when hosted
+    PostRequestHolder postRequest = MakePostRequest(Function, lpOverlapped);
+    if (postRequest)
+    {
+        if (FALSE == QueueUserWorkItem(QUWIPostCompletion, postRequest, QUEUE_ONLY))
+        {
+            return FALSE;
+        }
+        else
+        {
+            postRequest.SuppressRelease();
+            return TRUE;
+        }
+    }
+    else
+        return FALSE;
 #endif // !FEATURE_PAL
 }
 
@@ -1662,6 +1697,7 @@ DWORD __stdcall ThreadpoolMgr::QUWIPostCompletion(PVOID pArgs)
     EX_TRY
     {
         (postRequest->Function)(postRequest->errorCode, postRequest->numBytesTransferred, postRequest->lpOverlapped);
+        RecycleMemory( postRequest, MEMTYPE_PostRequest );
     }
     EX_CATCH
     {
@@ -1674,6 +1710,63 @@ DWORD __stdcall ThreadpoolMgr::QUWIPostCompletion(PVOID pArgs)
 
 }
 
+#ifdef FEATURE_PAL
+// Called by the PAL, on its own I/O completion thread, when an overlapped read
+// or write on a handle bound through BindIoCompletionCallback completes. The
+// completion routine is run on a worker thread, or inline when it cannot be
+// queued: the completion must not be lost, its caller may be blocked on it.
+VOID PALAPI ThreadpoolMgr::PalIoCompletionCallback(DWORD dwErrorCode,
+                                                   DWORD dwNumberOfBytesTransferred,
+                                                   LPOVERLAPPED lpOverlapped,
+                                                   PVOID pContext)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    BOOL fQueued = FALSE;
+
+    EX_TRY
+    {
+        PostRequestHolder postRequest = MakePostRequest((LPOVERLAPPED_COMPLETION_ROUTINE)pContext, lpOverlapped);
+        if (postRequest)
+        {
+            postRequest->errorCode = dwErrorCode;
+            postRequest->numBytesTransferred = dwNumberOfBytesTransferred;
+
+            if (QueueUserWorkItem(QUWIPostCompletion, postRequest, QUEUE_ONLY))
+            {
+                postRequest.SuppressRelease();
+                fQueued = TRUE;
+            }
+        }
+    }
+    EX_CATCH
+    {
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    if (!fQueued)
+    {
+        STRESS_LOG1(LF_THREADPOOL, LL_WARNING, "Running I/O completion %p inline, it could not be queued\n", lpOverlapped);
+
+        // BindIoCompletionCallbackStubEx sets up the thread
+        EX_TRY
+        {
+            ((LPOVERLAPPED_COMPLETION_ROUTINE)pContext)(dwErrorCode, dwNumberOfBytesTransferred, lpOverlapped);
+        }
+        EX_CATCH
+        {
+        }
+        EX_END_CATCH(SwallowAllExceptions);
+    }
+}
+#endif // FEATURE_PAL
+
 
 // This is either made by a worker thread or a CP thread
 // indicated by threadTypeStatus
@@ -2633,16 +2726,23 @@ BOOL ThreadpoolMgr::RegisterWaitForSingleObject(PHANDLE phNewWaitObject,
     CONTRACTL_END;
     EnsureInitialized();
 
-    ThreadCB* threadCB;
+    ThreadCB* threadCB = NULL;
+    BOOL useWaitSet = FALSE;
     {
         CrstHolder csh(&WaitThreadsCriticalSection);
 
-        threadCB = FindWaitThread();
+#ifdef FEATURE_PAL
+        useWaitSet = EnsureWaitSetThreadRunning();
+        if (!useWaitSet)
+#endif // FEATURE_PAL
+        {
+            threadCB = FindWaitThread();
+        }
     }
 
     *phNewWaitObject = NULL;
 
-    if (threadCB)
+    if (threadCB || useWaitSet)
     {
         WaitInfo* waitInfo = new (nothrow) WaitInfo;
 
@@ -2654,7 +2754,7 @@ BOOL ThreadpoolMgr::RegisterWaitForSingleObject(PHANDLE phNewWaitObject,
         waitInfo->Context = Context;
         waitInfo->timeout = timeout;
         waitInfo->flag = dwFlag;
-        waitInfo->threadCB = threadCB;
+        waitInfo->threadCB = threadCB;     // NULL for the wait set thread
         waitInfo->state = 0;
         waitInfo->refCount = 1;     // safe to do this since no wait has yet been queued, so no other thread could be modifying this
         waitInfo->ExternalCompletionEvent = INVALID_HANDLE;
@@ -2663,6 +2763,11 @@ BOOL ThreadpoolMgr::RegisterWaitForSingleObject(PHANDLE phNewWaitObject,
 
         waitInfo->timer.startTime = GetTickCount();
         waitInfo->timer.remainingTime = timeout;
+#ifdef FEATURE_PAL
+        waitInfo->waitSetRegistration = NULL;
+        waitInfo->dueTime = 0;
+        waitInfo->timerIndex = -1;
+#endif // FEATURE_PAL
 
         *phNewWaitObject = waitInfo;
 
@@ -2672,7 +2777,7 @@ BOOL ThreadpoolMgr::RegisterWaitForSingleObject(PHANDLE phNewWaitObject,
         if (ETW_EVENT_ENABLED(MICROSOFT_WINDOWS_DOTNETRUNTIME_PROVIDER_Context, ThreadPoolIOEnqueue))
             FireEtwThreadPoolIOEnqueue((LPOVERLAPPED)waitInfo, reinterpret_cast<void*>(Callback), (dwFlag & WAIT_SINGLE_EXECUTION) == 0, GetClrInstanceId());
     
-        BOOL status = QueueUserAPC((PAPCFUNC)InsertNewWaitForSelf, threadCB->threadHandle, (size_t) waitInfo);
+        BOOL status = QueueWaitRequest((PAPCFUNC)InsertNewWaitForSelf, waitInfo);
 
         if (status == FALSE)
         {
@@ -2820,6 +2925,14 @@ void ThreadpoolMgr::InsertNewWaitForSelf(WaitInfo* pArgs)
 
     WaitInfo* waitInfo = pArgs;
 
+#ifdef FEATURE_PAL
+    if (waitInfo->threadCB == NULL)
+    {
+        InsertNewWaitForWaitSet(waitInfo);
+        return;
+    }
+#endif // FEATURE_PAL
+
     // the following is safe since only this thread is allowed to change the state
     if (!(waitInfo->state & WAIT_DELETE))
     {
@@ -3135,6 +3248,497 @@ DWORD __stdcall ThreadpoolMgr::WaitThreadStart(LPVOID lpArgs)
 #endif
 #endif
 
+#ifdef FEATURE_PAL
+
+// Maximum number of waits dispatched by the wait set thread per PAL_WaitSetWait
+#define WAIT_SET_BATCH_SIZE 64
+
+// On the PAL, registered waits are serviced by a single thread blocked in
+// PAL_WaitSetWait, which has no limit on the number of handles it waits for
+// (it is backed by epoll on Linux). Each wait is added to the set on its own,
+// so waits on the same handle are independent, and waits that time out are
+// kept in a heap ordered by due time. As there is no alertable wait on a
+// wait set, registrations and deregistrations are queued as WaitSetRequests
+// and the wait set thread is woken up by an event in the set. Waits on
+// handles the PAL cannot add to a set are handed over to the wait threads.
+
+// Starts the wait set thread on first use. Returns FALSE if registered waits
+// are serviced by the wait threads instead. The caller holds
+// WaitThreadsCriticalSection.
+BOOL ThreadpoolMgr::EnsureWaitSetThreadRunning()
+{
+    CONTRACTL
+    {
+        THROWS;     // CLREvent::CreateAutoEvent can throw
+        GC_TRIGGERS;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (WaitSetStatus != WaitSetUninitialized)
+        return (WaitSetStatus == WaitSetRunning);
+
+    if (g_fEEShutDown & ShutDown_Finalize2)
+    {
+        // The process is shutting down; CreateWaitThread fails as well
+        return FALSE;
+    }
+
+    WaitSetStatus = WaitSetUnavailable;
+
+    if (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_UseWaitSet) == 0)
+        return FALSE;
+
+    NewHolder<CLREvent> wakeupEvent(new CLREvent());
+    wakeupEvent->CreateAutoEvent(FALSE);
+
+    NewHolder<CLREvent> startEvent(new CLREvent());
+    startEvent->CreateAutoEvent(FALSE);
+
+    WaitSet = PAL_CreateWaitSet();
+    if (WaitSet == NULL)
+    {
+        STRESS_LOG1(LF_THREADPOOL, LL_INFO10, "Wait sets are not available (error %d), using wait threads\n", GetLastError());
+        return FALSE;
+    }
+
+    // The wakeup event has a NULL context. Being an auto reset event, it is
+    // reset by PAL_WaitSetWait when it wakes up the thread.
+    PVOID wakeupRegistration;
+    if (!PAL_WaitSetAdd(WaitSet, wakeupEvent->GetHandleUNHOSTED(), NULL, &wakeupRegistration))
+    {
+        STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "Could not add the wakeup event to the wait set (error %d)\n", GetLastError());
+        PAL_DeleteWaitSet(WaitSet);
+        WaitSet = NULL;
+        return FALSE;
+    }
+
+    DWORD threadId;
+    HANDLE threadHandle = Thread::CreateUtilityThread(Thread::StackSize_Small, WaitSetThreadStart, (LPVOID)(CLREvent*)startEvent, CREATE_SUSPENDED, &threadId);
+
+    if (threadHandle == NULL)
+    {
+        PAL_WaitSetRemove(WaitSet, wakeupRegistration);
+        PAL_DeleteWaitSet(WaitSet);
+        WaitSet = NULL;
+        return FALSE;
+    }
+
+    ResumeThread(threadHandle);
+    CloseHandle(threadHandle);      // requests are not queued as APCs, so the handle is not needed
+
+    {
+        GCX_PREEMP();
+        while (startEvent->Wait(500, FALSE) != WAIT_OBJECT_0)
+        {
+            if (g_fEEShutDown & ShutDown_Finalize2)
+            {
+                // The process is shutting down. Shutdown thread has ThreadStore lock,
+                // the new thread is blocked on the lock and may still set the event.
+                startEvent.SuppressRelease();
+                wakeupEvent.SuppressRelease();
+                return FALSE;
+            }
+        }
+    }
+
+    // check to see if setup succeeded
+    if (WaitSetThreadId == 0)
+    {
+        PAL_WaitSetRemove(WaitSet, wakeupRegistration);
+        PAL_DeleteWaitSet(WaitSet);
+        WaitSet = NULL;
+        return FALSE;
+    }
+
+    WaitSetWakeupEvent = wakeupEvent.Extract();
+    WaitSetStatus = WaitSetRunning;
+    return TRUE;
+}
+
+DWORD __stdcall ThreadpoolMgr::WaitSetThreadStart(LPVOID lpArgs)
+{
+    CONTRACTL
+    {
+        THROWS;
+        GC_TRIGGERS;
+        MODE_PREEMPTIVE;
+        SO_TOLERANT;
+    }
+    CONTRACTL_END;
+
+    ClrFlsSetThreadType (ThreadType_Wait);
+
+    CLREvent* startEvent = (CLREvent*) lpArgs;
+    Thread* pThread = SetupThreadNoThrow();
+
+    if (pThread != NULL)
+    {
+        WaitSetThreadId = GetCurrentThreadId();
+    }
+
+    startEvent->Set();
+
+    if (pThread == NULL)
+    {
+        return 0;
+    }
+
+    BEGIN_SO_INTOLERANT_CODE(pThread);  // we probe at the top of the thread so we can safely call anything below here.
+    {
+        PVOID contexts[WAIT_SET_BATCH_SIZE];
+
+        // like the wait threads, the wait set thread never dies
+        for (;;)
+        {
+            // Requests are only processed here, so that no wait returned by
+            // PAL_WaitSetWait can be deactivated or deleted before it is dispatched
+            ProcessWaitSetRequests();
+
+            DWORD count = PAL_WaitSetWait(WaitSet, WaitSetTimeout(), contexts, WAIT_SET_BATCH_SIZE);
+
+            if (count == WAIT_FAILED)
+            {
+                STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "PAL_WaitSetWait failed %d", GetLastError());
+                _ASSERTE(!"PAL_WaitSetWait failed");
+                __SwitchToThread(0, CALLER_LIMITS_SPINNING);
+                continue;
+            }
+
+            for (DWORD i = 0; i < count; i++)
+            {
+                WaitInfo* waitInfo = (WaitInfo*) contexts[i];
+
+                // the wakeup event: the requests are processed at the top of the loop
+                if (waitInfo == NULL)
+                    continue;
+
+                _ASSERTE(waitInfo->state & WAIT_ACTIVE);
+
+                ProcessWaitCompletion(waitInfo, 0, FALSE);
+
+                // the timeout of a recurring wait starts over
+                if (waitInfo->state & WAIT_ACTIVE)
+                    ResetWaitSetTimer(waitInfo);
+            }
+
+            FireWaitSetTimers();
+        }
+    }
+    END_SO_INTOLERANT_CODE;
+
+    //This is unreachable...so no return required.
+}
+
+// Queues function to run with waitInfo on the wait set thread
+BOOL ThreadpoolMgr::QueueWaitSetRequest(PAPCFUNC function, WaitInfo* waitInfo)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        MODE_ANY;
+        GC_NOTRIGGER;
+    }
+    CONTRACTL_END;
+
+    _ASSERTE(WaitSetStatus == WaitSetRunning);
+
+    WaitSetRequest* request = new (nothrow) WaitSetRequest;
+    if (request == NULL)
+        return FALSE;
+
+    request->function = function;
+    request->waitInfo = waitInfo;
+
+    WaitSetRequest* head;
+    do
+    {
+        head = WaitSetRequests;
+        request->next = head;
+    } while (InterlockedCompareExchangeT(&WaitSetRequests, request, head) != head);
+
+    WaitSetWakeupEvent->Set();
+    return TRUE;
+}
+
+// Runs the queued requests, in the order they were queued
+void ThreadpoolMgr::ProcessWaitSetRequests()
+{
+    WRAPPER_NO_CONTRACT;
+
+    WaitSetRequest* pending = InterlockedExchangeT(&WaitSetRequests, NULL);
+    WaitSetRequest* ordered = NULL;
+
+    while (pending != NULL)
+    {
+        WaitSetRequest* next = pending->next;
+        pending->next = ordered;
+        ordered = pending;
+        pending = next;
+    }
+
+    while (ordered != NULL)
+    {
+        WaitSetRequest* request = ordered;
+        ordered = request->next;
+
+        PAPCFUNC function = request->function;
+        WaitInfo* waitInfo = request->waitInfo;
+        delete request;
+
+        if (waitInfo->threadCB != NULL)
+        {
+            // the wait was handed over to a wait thread after the request was queued
+            if (QueueUserAPC(function, waitInfo->threadCB->threadHandle, reinterpret_cast<ULONG_PTR>(waitInfo)))
+                SetWaitThreadAPCPending();
+            else
+                STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "Queue APC failed in ProcessWaitSetRequests %p", waitInfo);
+            continue;
+        }
+
+        function(reinterpret_cast<ULONG_PTR>(waitInfo));
+    }
+}
+
+// Executed as a request on the wait set thread. Adds the wait to the wait set
+void ThreadpoolMgr::InsertNewWaitForWaitSet(WaitInfo* waitInfo)
+{
+    WRAPPER_NO_CONTRACT;
+
+    // the following is safe since only this thread is allowed to change the state
+    if (waitInfo->state & WAIT_DELETE)
+    {
+        // some thread unregistered the wait
+        DeleteWait(waitInfo);
+        return;
+    }
+
+    if (!InsertWaitSetTimer(waitInfo))
+    {
+        HandOffWaitToWaitThread(waitInfo);
+        return;
+    }
+
+    if (!PAL_WaitSetAdd(WaitSet, waitInfo->waitHandle, waitInfo, &waitInfo->waitSetRegistration))
+    {
+        // e.g. an object shared with other processes, or an invalid handle
+        STRESS_LOG2(LF_THREADPOOL, LL_INFO100, "Could not add handle %p to the wait set (error %d)\n", waitInfo->waitHandle, GetLastError());
+        RemoveWaitSetTimer(waitInfo);
+        HandOffWaitToWaitThread(waitInfo);
+        return;
+    }
+
+    waitInfo->state = (WAIT_REGISTERED | WAIT_ACTIVE);
+}
+
+// Registers a wait that cannot be serviced by the wait set thread with a wait
+// thread, as RegisterWaitForSingleObject does. Requests for the wait already
+// queued to the wait set thread are forwarded by ProcessWaitSetRequests.
+// Runs on the wait set thread, which must survive a failure to create a wait
+// thread.
+void ThreadpoolMgr::HandOffWaitToWaitThread(WaitInfo* waitInfo)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_PREEMPTIVE;
+    }
+    CONTRACTL_END;
+
+    _ASSERTE(waitInfo->state == 0);
+
+    ThreadCB* threadCB = NULL;
+    EX_TRY
+    {
+        CrstHolder csh(&WaitThreadsCriticalSection);
+
+        threadCB = FindWaitThread();
+    }
+    EX_CATCH
+    {
+        threadCB = NULL;
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    if (threadCB == NULL)
+    {
+        // As for a handle a wait thread fails to wait for, the wait is left
+        // inactive until it is unregistered
+        STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "No wait thread for handle %p", waitInfo->waitHandle);
+        waitInfo->state = WAIT_REGISTERED;
+        return;
+    }
+
+    // from now on, requests for the wait are queued to the wait thread
+    VolatileStore(&waitInfo->threadCB, threadCB);
+
+    if (!QueueUserAPC((PAPCFUNC)InsertNewWaitForSelf, threadCB->threadHandle, reinterpret_cast<ULONG_PTR>(waitInfo)))
+    {
+        STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "Queue APC failed in HandOffWaitToWaitThread %p", waitInfo);
+        InterlockedDecrement(&threadCB->NumWaitHandles);
+    }
+}
+
+void ThreadpoolMgr::DeactivateWaitSetWait(WaitInfo* waitInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    PAL_WaitSetRemove(WaitSet, waitInfo->waitSetRegistration);
+    waitInfo->waitSetRegistration = NULL;
+
+    RemoveWaitSetTimer(waitInfo);
+
+    waitInfo->state &= ~WAIT_ACTIVE;
+}
+
+// Adds the wait to the timer heap if it has a timeout. Returns FALSE if out of memory
+BOOL ThreadpoolMgr::InsertWaitSetTimer(WaitInfo* waitInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    waitInfo->timerIndex = -1;
+
+    if (waitInfo->timeout == INFINITE)
+        return TRUE;
+
+    if (WaitSetTimerCount == WaitSetTimerCapacity)
+    {
+        int newCapacity = max(2 * WaitSetTimerCapacity, 64);
+        WaitInfo** newTimers = new (nothrow) WaitInfo*[newCapacity];
+
+        if (newTimers == NULL)
+            return FALSE;
+
+        if (WaitSetTimers != NULL)
+        {
+            memcpy(newTimers, WaitSetTimers, WaitSetTimerCount * sizeof(WaitInfo*));
+            delete [] WaitSetTimers;
+        }
+
+        WaitSetTimers = newTimers;
+        WaitSetTimerCapacity = newCapacity;
+    }
+
+    waitInfo->dueTime = CLRGetTickCount64() + waitInfo->timeout;
+    waitInfo->timerIndex = WaitSetTimerCount;
+    WaitSetTimers[WaitSetTimerCount++] = waitInfo;
+    SiftWaitSetTimer(waitInfo->timerIndex);
+
+    return TRUE;
+}
+
+void ThreadpoolMgr::RemoveWaitSetTimer(WaitInfo* waitInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    int index = waitInfo->timerIndex;
+    if (index < 0)
+        return;
+
+    waitInfo->timerIndex = -1;
+    WaitSetTimerCount--;
+
+    if (index < WaitSetTimerCount)
+    {
+        // move the last timer into the hole
+        WaitSetTimers[index] = WaitSetTimers[WaitSetTimerCount];
+        WaitSetTimers[index]->timerIndex = index;
+        SiftWaitSetTimer(index);
+    }
+}
+
+// Restarts the timeout of an active recurring wait
+void ThreadpoolMgr::ResetWaitSetTimer(WaitInfo* waitInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (waitInfo->timerIndex < 0)
+        return;
+
+    // a zero timeout would have the wait time out again right away, so that
+    // FireWaitSetTimers would never return; such waits time out once per tick
+    waitInfo->dueTime = CLRGetTickCount64() + (waitInfo->timeout != 0 ? waitInfo->timeout : 1);
+    SiftWaitSetTimer(waitInfo->timerIndex);
+}
+
+// Moves the timer at index up or down the heap after its due time was set
+void ThreadpoolMgr::SiftWaitSetTimer(int index)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    WaitInfo* waitInfo = WaitSetTimers[index];
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (WaitSetTimers[parent]->dueTime <= waitInfo->dueTime)
+            break;
+
+        WaitSetTimers[index] = WaitSetTimers[parent];
+        WaitSetTimers[index]->timerIndex = index;
+        index = parent;
+    }
+
+    for (;;)
+    {
+        int child = 2 * index + 1;
+        if (child >= WaitSetTimerCount)
+            break;
+
+        if (child + 1 < WaitSetTimerCount && WaitSetTimers[child + 1]->dueTime < WaitSetTimers[child]->dueTime)
+            child++;
+
+        if (waitInfo->dueTime <= WaitSetTimers[child]->dueTime)
+            break;
+
+        WaitSetTimers[index] = WaitSetTimers[child];
+        WaitSetTimers[index]->timerIndex = index;
+        index = child;
+    }
+
+    WaitSetTimers[index] = waitInfo;
+    waitInfo->timerIndex = index;
+}
+
+// Returns the time until the first wait times out
+DWORD ThreadpoolMgr::WaitSetTimeout()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (WaitSetTimerCount == 0)
+        return INFINITE;
+
+    ULONGLONG currentTime = CLRGetTickCount64();
+    ULONGLONG dueTime = WaitSetTimers[0]->dueTime;
+
+    if (dueTime <= currentTime)
+        return 0;
+
+    // the timeouts of the waits are below INFINITE
+    return (DWORD) (dueTime - currentTime);
+}
+
+void ThreadpoolMgr::FireWaitSetTimers()
+{
+    WRAPPER_NO_CONTRACT;
+
+    ULONGLONG currentTime = CLRGetTickCount64();
+
+    while (WaitSetTimerCount > 0 && WaitSetTimers[0]->dueTime <= currentTime)
+    {
+        WaitInfo* waitInfo = WaitSetTimers[0];
+
+        // deactivates a single execution wait, removing it from the heap
+        ProcessWaitCompletion(waitInfo, 0, TRUE);
+
+        if (waitInfo->state & WAIT_ACTIVE)
+            ResetWaitSetTimer(waitInfo);
+    }
+}
+
+#endif // FEATURE_PAL
+
 void ThreadpoolMgr::ProcessWaitCompletion(WaitInfo* waitInfo,
                                           unsigned index,
                                           BOOL waitTimedOut
@@ -3252,6 +3856,14 @@ void ThreadpoolMgr::DeactivateWait(WaitInfo* waitInfo)
 {
     LIMITED_METHOD_CONTRACT;
 
+#ifdef FEATURE_PAL
+    if (waitInfo->threadCB == NULL)
+    {
+        DeactivateWaitSetWait(waitInfo);
+        return;
+    }
+#endif // FEATURE_PAL
+
     ThreadCB* threadCB = waitInfo->threadCB;
     DWORD endIndex = threadCB->NumActiveWaits-1;
     DWORD index;
@@ -3280,6 +3892,14 @@ void ThreadpoolMgr::DeactivateNthWait(WaitInfo* waitInfo, DWORD index)
 {
     LIMITED_METHOD_CONTRACT;
 
+#ifdef FEATURE_PAL
+    if (waitInfo->threadCB == NULL)
+    {
+        DeactivateWaitSetWait(waitInfo);
+        return;
+    }
+#endif // FEATURE_PAL
+
     ThreadCB* threadCB = waitInfo->threadCB;
 
     if (waitInfo->link.Flink != waitInfo->link.Blink)
@@ -3381,7 +4001,11 @@ BOOL ThreadpoolMgr::UnregisterWaitEx(HANDLE hWaitObject,HANDLE Event)
     }
 
     // we do not allow callbacks to run in the wait thread, hence the assert
+#ifdef FEATURE_PAL
+    _ASSERTE(GetCurrentThreadId() != (waitInfo->threadCB ? waitInfo->threadCB->threadId : WaitSetThreadId));
+#else
     _ASSERTE(GetCurrentThreadId() != waitInfo->threadCB->threadId);
+#endif // FEATURE_PAL
 
 
     if (Blocking)
@@ -3398,7 +4022,7 @@ BOOL ThreadpoolMgr::UnregisterWaitEx(HANDLE hWaitObject,HANDLE Event)
         waitInfo->PartialCompletionEvent.CreateAutoEvent(FALSE);
     }
 
-    BOOL status = QueueDeregisterWait(waitInfo->threadCB->threadHandle, waitInfo);
+    BOOL status = QueueDeregisterWait(waitInfo);
 
 
     if (status == 0)
@@ -3498,7 +4122,7 @@ void ThreadpoolMgr::WaitHandleCleanup(HANDLE hWaitObject)
     WaitInfo* waitInfo = (WaitInfo*) hWaitObject;
     _ASSERTE(waitInfo->refCount > 0);
 
-    DWORD result = QueueDeregisterWait(waitInfo->threadCB->threadHandle, waitInfo);
+    DWORD result = QueueDeregisterWait(waitInfo);
 
     if (result == 0)
         STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "Queue APC failed in WaitHandleCleanup %x", result);
@@ -3586,8 +4210,17 @@ BOOL ThreadpoolMgr::BindIoCompletionCallback(HANDLE FileHandle,
 
     return TRUE;
 #else // FEATURE_PAL
-    SetLastError(ERROR_CALL_NOT_IMPLEMENTED);
-    return FALSE;
+    errCode = S_OK;
+
+    EnsureInitialized();
+
+    if (!PAL_BindIoCompletionCallback(FileHandle, PalIoCompletionCallback, (PVOID)Function))
+    {
+        errCode = GetLastError();
+        return FALSE;
+    }
+
+    return TRUE;
 #endif // !FEATURE_PAL
 }
 
@@ -5071,22 +5704,187 @@ void ThreadpoolMgr::InsertNewTimer(TimerInfo* pArg)
     }
     else
     {
-        timerInfo->FiringTime += currentTime;
-
         timerInfo->state = (TIMER_REGISTERED | TIMER_ACTIVE);
         timerInfo->refCount = 1;
+        SyncEmptyTimerWheel(currentTime);
+        NumTimers++;
 
-        // insert the timer in the queue
-        InsertTailList(&TimerQueue,(&timerInfo->link));
+        // insert the timer in the wheel
+        InsertTimerInWheel(timerInfo, currentTime, timerInfo->FiringTime);
     }
 
     return;
 }
 
+#define TimerWheelLevelShift(level)     ((level) == 0 ? 0 : TIMER_WHEEL_ROOT_BITS + ((level) - 1) * TIMER_WHEEL_LEVEL_BITS)
+#define TimerWheelLevelSize(level)      ((level) == 0 ? (1 << TIMER_WHEEL_ROOT_BITS) : (1 << TIMER_WHEEL_LEVEL_BITS))
+#define TimerWheelLevelFirstSlot(level) ((level) == 0 ? 0 : (1 << TIMER_WHEEL_ROOT_BITS) + ((level) - 1) * (1 << TIMER_WHEEL_LEVEL_BITS))
+
+// Moves an empty wheel to the current time. Otherwise, after the timer thread
+// slept without timers, FireTimers would have to advance the wheel through all
+// the ticks of the sleep before it gets to the timers inserted since.
+void ThreadpoolMgr::SyncEmptyTimerWheel(DWORD currentTime)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (NumTimers == 0 && IsListEmpty(&ExpiredTimers))
+    {
+        LastTickCount = currentTime;
+    }
+}
+
+// Sets the firing time of the timer to dueTime ticks after currentTime and
+// inserts it in the timer wheel
+void ThreadpoolMgr::InsertTimerInWheel(TimerInfo* timerInfo, DWORD currentTime, DWORD dueTime)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    // ticks after the last tick the wheel was advanced to, which is never
+    // ahead of currentTime
+    ULONGLONG delta = (ULONGLONG) (currentTime - LastTickCount) + dueTime;
+
+    if (delta == 0)
+    {
+        // due at a tick already processed, fire on the next call to FireTimers()
+        timerInfo->FiringTime = currentTime;
+        InsertTailList(&ExpiredTimers, (&timerInfo->link));
+        return;
+    }
+
+    // the wheel spans the 32 bits of the tick count, a timer due later than
+    // that fires early by the time the timer thread took to get to the request
+    if (delta > ((ULONGLONG) 1 << 32))
+        delta = ((ULONGLONG) 1 << 32);
+
+    timerInfo->FiringTime = LastTickCount + (DWORD) delta;
+    LinkTimerInWheel(timerInfo);
+}
+
+// Inserts the timer in the slot of its firing time, which is not before the
+// next tick the wheel is advanced to. The level of the slot is the lowest one
+// that does not wrap around before the firing time.
+void ThreadpoolMgr::LinkTimerInWheel(TimerInfo* timerInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DWORD delta = timerInfo->FiringTime - (LastTickCount + 1);
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= ((DWORD) 1 << TimerWheelLevelShift(level + 1)))
+    {
+        level++;
+    }
+
+    DWORD slot = TimerWheelLevelFirstSlot(level) +
+                 ((timerInfo->FiringTime >> TimerWheelLevelShift(level)) & (TimerWheelLevelSize(level) - 1));
+
+    InsertTailList(&TimerWheel[slot], (&timerInfo->link));
+    TimerWheelOccupied[slot / 32] |= ((DWORD) 1 << (slot % 32));
+}
+
+// Called when the wheel is advanced to a tick where level 0 wraps around. The
+// timers in the slot of the tick in level 1 move down to level 0, and so on
+// for the levels above as long as the level below wraps around as well.
+void ThreadpoolMgr::CascadeTimerWheel(DWORD tick)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    _ASSERTE((tick & (TimerWheelLevelSize(0) - 1)) == 0);
+    _ASSERTE(tick == LastTickCount + 1);
+
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        DWORD index = (tick >> TimerWheelLevelShift(level)) & (TimerWheelLevelSize(level) - 1);
+        LIST_ENTRY* head = &TimerWheel[TimerWheelLevelFirstSlot(level) + index];
+
+        while (!IsListEmpty(head))
+        {
+            LIST_ENTRY* entry;
+            RemoveHeadList(head, entry);
+            LinkTimerInWheel((TimerInfo*) entry);
+        }
+
+        if (index != 0)
+            break;
+    }
+}
+
+// Returns the first slot of the level, in circular order from start, that holds
+// timers, or -1 if the level is empty
+int ThreadpoolMgr::FindTimerWheelSlot(int level, DWORD start)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DWORD firstSlot = TimerWheelLevelFirstSlot(level);
+    DWORD size = TimerWheelLevelSize(level);
+
+    // the levels are made of whole words of TimerWheelOccupied
+    for (DWORD i = 0; i < size; )
+    {
+        DWORD slot = firstSlot + ((start + i) & (size - 1));
+        DWORD bits = TimerWheelOccupied[slot / 32] >> (slot % 32);
+
+        if (bits == 0)
+        {
+            // skip to the next word
+            i += 32 - (slot % 32);
+            continue;
+        }
+
+        DWORD skip;
+        BitScanForward(&skip, bits);
+        i += skip;
+        if (i >= size)
+            break;
+
+        slot += skip;
+        if (!IsListEmpty(&TimerWheel[slot]))
+            return (int) (slot - firstSlot);
+
+        // the timers in the slot were deactivated or moved
+        TimerWheelOccupied[slot / 32] &= ~((DWORD) 1 << (slot % 32));
+        i++;
+    }
+
+    return -1;
+}
+
+// Returns the number of ticks from tick to the first tick, tick included, at
+// which a slot of level 0 holding timers expires or a slot of the other levels
+// holding timers is cascaded, or TIMER_WHEEL_NO_EVENT if the wheel is empty.
+// Nothing needs to be done for the ticks in between.
+ULONGLONG ThreadpoolMgr::NextTimerWheelEvent(DWORD tick)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    ULONGLONG nextEvent = TIMER_WHEEL_NO_EVENT;
+
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        DWORD shift = TimerWheelLevelShift(level);
+        DWORD sizeMask = TimerWheelLevelSize(level) - 1;
+        DWORD tickMask = ((DWORD) 1 << shift) - 1;
+
+        // the first tick from tick where the levels below wrap around
+        DWORD baseTick = (tick + tickMask) & ~tickMask;
+        DWORD baseIndex = (baseTick >> shift) & sizeMask;
+
+        int slot = FindTimerWheelSlot(level, baseIndex);
+        if (slot < 0)
+            continue;
+
+        ULONGLONG ticks = (ULONGLONG) (DWORD) (baseTick - tick) + ((ULONGLONG) (((DWORD) slot - baseIndex) & sizeMask) << shift);
+        if (ticks < nextEvent)
+            nextEvent = ticks;
+    }
+
+    return nextEvent;
+}
+
 
 // executed by the Timer thread
-// sweeps through the list of timers, readjusting the firing times, queueing APCs for
-// those that have expired, and returns the next firing time interval
+// advances the timer wheel to the current time, queueing the callbacks of the
+// timers that expired, and returns the next firing time interval
 DWORD ThreadpoolMgr::FireTimers()
 {
     CONTRACTL
@@ -5098,24 +5896,26 @@ DWORD ThreadpoolMgr::FireTimers()
     CONTRACTL_END;
 
     DWORD currentTime = GetTickCount();
-    DWORD nextFiringInterval = (DWORD) -1;
     TimerInfo* timerInfo = NULL;
-    
-    EX_TRY 
+
+    SyncEmptyTimerWheel(currentTime);
+
+    EX_TRY
     {
-        for (LIST_ENTRY* node = (LIST_ENTRY*) TimerQueue.Flink;
-             node != &TimerQueue;
-            )
+        for (;;)
         {
-            timerInfo = (TimerInfo*) node;
-            node = (LIST_ENTRY*) node->Flink;
-
-            if (TimeExpired(LastTickCount, currentTime, timerInfo->FiringTime))
+            while (!IsListEmpty(&ExpiredTimers))
             {
+                timerInfo = (TimerInfo*) ExpiredTimers.Flink;
+
                 if (timerInfo->Period == 0 || timerInfo->Period == (ULONG) -1)
                 {
                     DeactivateTimer(timerInfo);
                 }
+                else
+                {
+                    RemoveEntryList(&timerInfo->link);
+                }
 
                 InterlockedIncrement(&timerInfo->refCount);
 
@@ -5123,29 +5923,64 @@ DWORD ThreadpoolMgr::FireTimers()
                                   timerInfo,
                                   QUEUE_ONLY /* TimerInfo take care of deleting*/);
 
-                timerInfo->FiringTime = currentTime+timerInfo->Period;
+                if (timerInfo->state & TIMER_ACTIVE)
+                {
+                    InsertTimerInWheel(timerInfo, currentTime, timerInfo->Period);
+                }
 
-                if ((timerInfo->Period != 0) && (timerInfo->Period != (ULONG) -1) && (nextFiringInterval > timerInfo->Period))
-                    nextFiringInterval = timerInfo->Period;
+                timerInfo = NULL;
             }
 
-            else
+            if (LastTickCount == currentTime)
+                break;
+
+            DWORD tick = LastTickCount + 1;
+
+            // skip the ticks at which no timer expires and no slot holding
+            // timers is cascaded, whole rotations of the lower levels included
+            ULONGLONG idleTicks = NextTimerWheelEvent(tick);
+
+            if (idleTicks != 0)
+            {
+                LastTickCount += (DWORD) min(idleTicks, (ULONGLONG) (currentTime - LastTickCount));
+                continue;
+            }
+
+            DWORD index = tick & (TimerWheelLevelSize(0) - 1);
+
+            if (index == 0)
             {
-                DWORD firingInterval = TimeInterval(timerInfo->FiringTime,currentTime);
-                if (firingInterval < nextFiringInterval)
-                    nextFiringInterval = firingInterval;
+                CascadeTimerWheel(tick);
+            }
+
+            // the timers in the slot expire at this tick
+            LastTickCount = tick;
+
+            LIST_ENTRY* head = &TimerWheel[index];
+            while (!IsListEmpty(head))
+            {
+                LIST_ENTRY* entry;
+                RemoveHeadList(head, entry);
+                InsertTailList(&ExpiredTimers, entry);
             }
         }
-    } 
-    EX_CATCH 
+    }
+    EX_CATCH
     {
         // If QueueUserWorkItem throws OOM, swallow the exception and retry on
         // the next call to FireTimers(), otherwise retrhow.
         Exception *ex = GET_EXCEPTION();
-        // undo the call to DeactivateTimer()
-        InterlockedDecrement(&timerInfo->refCount);
-        timerInfo->state = timerInfo->state & TIMER_ACTIVE;
-        InsertTailList(&TimerQueue, (&timerInfo->link));
+        if (timerInfo != NULL)
+        {
+            // undo the call to DeactivateTimer()
+            InterlockedDecrement(&timerInfo->refCount);
+            if (!(timerInfo->state & TIMER_ACTIVE))
+            {
+                timerInfo->state |= TIMER_ACTIVE;
+                NumTimers++;
+            }
+            InsertHeadList(&ExpiredTimers, (&timerInfo->link));
+        }
         if (ex->GetHR() != E_OUTOFMEMORY)
         {
            EX_RETHROW;
@@ -5153,9 +5988,23 @@ DWORD ThreadpoolMgr::FireTimers()
     }
     EX_END_CATCH(RethrowTerminalExceptions);
 
-    LastTickCount = currentTime;
+    if (!IsListEmpty(&ExpiredTimers))
+    {
+        // QueueUserWorkItem failed, retry at the next tick
+        return 1;
+    }
+
+    // Wake up at the next tick at which a timer expires or timers are cascaded
+    ULONGLONG nextFiringInterval = NextTimerWheelEvent(currentTime + 1);
+
+    if (nextFiringInterval != TIMER_WHEEL_NO_EVENT)
+        nextFiringInterval++;
 
-    return nextFiringInterval;
+    // INFINITE is only returned when there are no timers
+    if (nextFiringInterval >= (DWORD) -1 && NumTimers != 0)
+        nextFiringInterval = (DWORD) -2;
+
+    return (DWORD) nextFiringInterval;
 }
 
 DWORD __stdcall ThreadpoolMgr::AsyncTimerCallbackCompletion(PVOID pArgs)
@@ -5212,6 +6061,7 @@ void ThreadpoolMgr::DeactivateTimer(TimerInfo* timerInfo)
     // waiting to be released. Reinitialize the list pointers
     InitializeListHead(&timerInfo->link);
     timerInfo->state = timerInfo->state & ~TIMER_ACTIVE;
+    NumTimers--;
 }
 
 DWORD __stdcall ThreadpoolMgr::AsyncDeleteTimer(PVOID pArgs)
@@ -5488,20 +6338,27 @@ void ThreadpoolMgr::UpdateTimer(TimerUpdateInfo* pArgs)
     }
 
     DWORD currentTime = GetTickCount();
-    timerInfo->FiringTime = currentTime + updateInfo->DueTime;
+    DWORD dueTime = updateInfo->DueTime;
 
     delete updateInfo;
 
-    if (! (timerInfo->state & TIMER_ACTIVE))
+    if (timerInfo->state & TIMER_ACTIVE)
+    {
+        // take the timer out of the slot of its previous firing time
+        RemoveEntryList(&timerInfo->link);
+    }
+    else
     {
         // timer not active (probably a one shot timer that has expired), so activate it
         timerInfo->state |= TIMER_ACTIVE;
         _ASSERTE(timerInfo->refCount >= 1);
-        // insert the timer in the queue
-        InsertTailList(&TimerQueue,(&timerInfo->link));
-
+        SyncEmptyTimerWheel(currentTime);
+        NumTimers++;
     }
 
+    // insert the timer in the wheel
+    InsertTimerInWheel(timerInfo, currentTime, dueTime);
+
     return;
 }
 
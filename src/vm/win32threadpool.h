@@ -38,6 +38,15 @@ Revision History:
 #define TIMER_ACTIVE        0x02
 #define TIMER_DELETE        0x04
 
+// The timer wheel has a slot per tick for the next 256 ticks (level 0), followed
+// by levels of 64 slots, each slot spanning a rotation of the level below.
+// Five levels cover the 32 bits of the tick count.
+#define TIMER_WHEEL_ROOT_BITS       8
+#define TIMER_WHEEL_LEVEL_BITS      6
+#define TIMER_WHEEL_LEVELS          5
+#define TIMER_WHEEL_SLOTS           ((1 << TIMER_WHEEL_ROOT_BITS) + (TIMER_WHEEL_LEVELS - 1) * (1 << TIMER_WHEEL_LEVEL_BITS))
+#define TIMER_WHEEL_NO_EVENT        ((ULONGLONG) -1)
+
 #define WAIT_SINGLE_EXECUTION      0x00000001
 #define WAIT_FREE_CONTEXT          0x00000002
 #define WAIT_INTERNAL_COMPLETION   0x00000004
@@ -701,6 +710,12 @@ private:
         HANDLE              ExternalCompletionEvent; // they are signalled when all callbacks have completed (refCount=0)
         ADID                handleOwningAD;
         OBJECTHANDLE        ExternalEventSafeHandle;
+#ifdef FEATURE_PAL
+        // Used when the wait is serviced by the wait set thread, in which case threadCB is NULL
+        PVOID               waitSetRegistration;    // registration of waitHandle in WaitSet
+        ULONGLONG           dueTime;                // tick count at which the wait times out
+        int                 timerIndex;             // position in WaitSetTimers, -1 if the wait does not time out
+#endif // FEATURE_PAL
 
     } ;
 
@@ -716,6 +731,17 @@ private:
         BOOL        waitTimedOut;
     } ;
 
+#ifdef FEATURE_PAL
+    // Registration or deregistration of a wait, queued to the wait set thread
+    // in place of an APC. Pushed with an interlocked compare exchange and
+    // taken all at once by the wait set thread.
+    struct WaitSetRequest {
+        WaitSetRequest* next;
+        PAPCFUNC        function;           // InsertNewWaitForSelf or DeregisterWait
+        WaitInfo*       waitInfo;
+    } ;
+#endif // FEATURE_PAL
+
 #ifndef DACCESS_COMPILE
 
     static VOID
@@ -840,7 +866,7 @@ private:
 
     // Timer 
     typedef struct {
-        LIST_ENTRY  link;           // doubly linked list of timers
+        LIST_ENTRY  link;           // doubly linked list of the timers in a slot of the timer wheel
         ULONG FiringTime;           // TickCount of when to fire next
         WAITORTIMERCALLBACK Function;             // Function to call when timer fires
         PVOID Context;              // Context to pass to function when timer fires
@@ -1179,6 +1205,13 @@ public:
 
     static DWORD __stdcall QUWIPostCompletion(PVOID pArgs);
 
+#ifdef FEATURE_PAL
+    static VOID PALAPI PalIoCompletionCallback(DWORD dwErrorCode,
+                                               DWORD dwNumberOfBytesTransferred,
+                                               LPOVERLAPPED lpOverlapped,
+                                               PVOID pContext);
+#endif // FEATURE_PAL
+
     static void DeactivateWait(WaitInfo* waitInfo);
     static void DeactivateNthWait(WaitInfo* waitInfo, DWORD index);
 
@@ -1201,6 +1234,44 @@ public:
 
     static void __stdcall DeregisterWait(WaitInfo* pArgs);
 
+#ifdef FEATURE_PAL
+    static BOOL EnsureWaitSetThreadRunning();
+    static DWORD __stdcall WaitSetThreadStart(LPVOID lpArgs);
+    static BOOL QueueWaitSetRequest(PAPCFUNC function, WaitInfo* waitInfo);
+    static void ProcessWaitSetRequests();
+    static void InsertNewWaitForWaitSet(WaitInfo* waitInfo);
+    static void HandOffWaitToWaitThread(WaitInfo* waitInfo);
+    static void DeactivateWaitSetWait(WaitInfo* waitInfo);
+    static BOOL InsertWaitSetTimer(WaitInfo* waitInfo);
+    static void RemoveWaitSetTimer(WaitInfo* waitInfo);
+    static void ResetWaitSetTimer(WaitInfo* waitInfo);
+    static void SiftWaitSetTimer(int index);
+    static DWORD WaitSetTimeout();
+    static void FireWaitSetTimers();
+#endif // FEATURE_PAL
+
+    // Queues pfn to run with waitInfo on the thread servicing the wait
+    inline static BOOL QueueWaitRequest(PAPCFUNC function, WaitInfo* waitInfo)
+    {
+        CONTRACTL
+        {
+            NOTHROW;
+            MODE_ANY;
+            GC_NOTRIGGER;
+        }
+        CONTRACTL_END;
+
+        // threadCB is set once by the wait set thread if it hands the wait over to a wait thread
+        ThreadCB* threadCB = VolatileLoad(&waitInfo->threadCB);
+
+#ifdef FEATURE_PAL
+        if (threadCB == NULL)
+            return QueueWaitSetRequest(function, waitInfo);
+#endif // FEATURE_PAL
+
+        return QueueUserAPC(function, threadCB->threadHandle, reinterpret_cast<ULONG_PTR>(waitInfo));
+    }
+
 #ifndef FEATURE_PAL
     // holds the aggregate of system cpu usage of all processors
     typedef struct _PROCESS_CPU_INFORMATION
@@ -1250,6 +1321,12 @@ private:
     static void TimerThreadFire(); // helper method used by TimerThreadStart
     static void __stdcall InsertNewTimer(TimerInfo* pArg);
     static DWORD FireTimers();
+    static void InsertTimerInWheel(TimerInfo* timerInfo, DWORD currentTime, DWORD dueTime);
+    static void LinkTimerInWheel(TimerInfo* timerInfo);
+    static void CascadeTimerWheel(DWORD tick);
+    static int FindTimerWheelSlot(int level, DWORD start);
+    static ULONGLONG NextTimerWheelEvent(DWORD tick);
+    static void SyncEmptyTimerWheel(DWORD currentTime);
     static DWORD __stdcall AsyncTimerCallbackCompletion(PVOID pArgs);
     static void DeactivateTimer(TimerInfo* timerInfo);
     static DWORD __stdcall AsyncDeleteTimer(PVOID pArgs);
@@ -1258,7 +1335,7 @@ private:
 
     static void __stdcall DeregisterTimer(TimerInfo* pArgs);
 
-    inline static DWORD QueueDeregisterWait(HANDLE waitThread, WaitInfo* waitInfo)
+    inline static DWORD QueueDeregisterWait(WaitInfo* waitInfo)
     {
         CONTRACTL
         {
@@ -1268,7 +1345,7 @@ private:
         }
         CONTRACTL_END;
 
-        DWORD result = QueueUserAPC(reinterpret_cast<PAPCFUNC>(DeregisterWait), waitThread, reinterpret_cast<ULONG_PTR>(waitInfo));
+        DWORD result = QueueWaitRequest(reinterpret_cast<PAPCFUNC>(DeregisterWait), waitInfo);
         SetWaitThreadAPCPending();
         return result;
     }
@@ -1348,12 +1425,33 @@ private:
     static CrstStatic WaitThreadsCriticalSection;
     static LIST_ENTRY WaitThreadsHead;                  // queue of wait threads, each thread can handle upto 64 waits
 
+#ifdef FEATURE_PAL
+    enum WaitSetStatusValues
+    {
+        WaitSetUninitialized,
+        WaitSetRunning,
+        WaitSetUnavailable                              // the wait threads are used instead
+    };
+
+    static LONG WaitSetStatus;                          // protected by WaitThreadsCriticalSection
+    static PAL_WAIT_SET WaitSet;                        // all the waits serviced by the wait set thread
+    static DWORD WaitSetThreadId;
+    static CLREvent * WaitSetWakeupEvent;               // in WaitSet, set when requests are queued
+    static WaitSetRequest * volatile WaitSetRequests;   // pending requests, most recent first
+    static WaitInfo ** WaitSetTimers;                   // min-heap on dueTime of the waits that can time out
+    static int WaitSetTimerCount;
+    static int WaitSetTimerCapacity;
+#endif // FEATURE_PAL
+
     static TimerInfo *TimerInfosToBeRecycled;           // list of delegate infos associated with deleted timers
     static CrstStatic TimerQueueCriticalSection;        // critical section to synchronize timer queue access
-    SVAL_DECL(LIST_ENTRY,TimerQueue);                   // queue of timers
+    static LIST_ENTRY TimerWheel[TIMER_WHEEL_SLOTS];    // timers by firing time, only accessed by the timer thread
+    static DWORD TimerWheelOccupied[TIMER_WHEEL_SLOTS / 32]; // bit set for the slots of TimerWheel that may hold timers
+    static LIST_ENTRY ExpiredTimers;                    // timers to fire, taken out of TimerWheel
+    SVAL_DECL(LONG,NumTimers);                          // number of active timers
     static HANDLE TimerThread;                          // Currently we only have one timer thread
     static Thread*  pTimerThread;
-    static DWORD LastTickCount;                         // the count just before timer thread goes to sleep
+    static DWORD LastTickCount;                         // the last tick the timer wheel was advanced to
 
     static BOOL InitCompletionPortThreadpool;           // flag indicating whether completion port threadpool has been initialized
     static HANDLE GlobalCompletionPort;                 // used for binding io completions on file handles
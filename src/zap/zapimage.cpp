@@ -1156,7 +1156,7 @@ static void CompressFile(WCHAR volumeLetter, HANDLE hFile)
 
 HANDLE ZapImage::SaveImage(LPCWSTR wszOutputFileName, CORCOMPILE_NGEN_SIGNATURE * pNativeImageSig)
 {
-    if (!IsReadyToRunCompilation())
+    if (!IsReadyToRunCompilation() || IsLargeVersionBubbleEnabled())
     {
         OutputManifestMetadata();
     }
@@ -1619,6 +1619,13 @@ void ZapImage::OutputManifestMetadata()
         m_pAssemblyMetaData->SetMetaData(m_pAssemblyEmit);
 
         m_pMetaDataSection->Place(m_pAssemblyMetaData);
+
+#ifdef FEATURE_READYTORUN_COMPILER
+        // Cross-module references within a large version bubble may refer to assemblies
+        // that the IL metadata of the module does not reference.
+        if (IsReadyToRunCompilation())
+            GetReadyToRunHeader()->RegisterSection(READYTORUN_SECTION_MANIFEST_METADATA, m_pAssemblyMetaData);
+#endif
     }
 }
 
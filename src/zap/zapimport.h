@@ -363,10 +363,21 @@ public:
     }
 
     // Returns index of module in the import table for encoding module fixups in EE datastructures.
+    // ReadyToRun images have no import table: the index is the assembly index that
+    // Module::GetModuleFromIndex decodes with ZapSig::DecodeModuleFromIndexes, i.e. the RID of
+    // an AssemblyRef of the IL metadata, or of the manifest metadata past GetAssemblyRefMax().
     DWORD GetIndexOfModule(CORINFO_MODULE_HANDLE handle)
     {
         ZapImportTable::ModuleReferenceEntry * pModuleReference = GetModuleReference(handle);
         _ASSERTE(pModuleReference != NULL);
+#ifdef FEATURE_READYTORUN_COMPILER
+        if (IsReadyToRunCompilation())
+        {
+            // ReadyToRun does not support multi-module assemblies
+            _ASSERTE(pModuleReference->m_wModuleRid == 0);
+            return pModuleReference->m_wAssemblyRid;
+        }
+#endif
         return pModuleReference->m_index;
     }
 
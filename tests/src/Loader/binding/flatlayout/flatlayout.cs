@@ -0,0 +1,78 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Uses an IL only library that, on Unix, the runtime loads straight from the
+// flat view of its file rather than from a copy of its sections: field RVA
+// data, user strings, manifest resources, generic instantiations and stack
+// traces through it all have to come out right.
+
+using System;
+using System.Linq;
+using FlatLayoutLib;
+
+public class FlatLayout
+{
+    static int Main()
+    {
+        try
+        {
+            int sum = Data.Primes.Sum();
+            if (sum != 197)
+            {
+                Console.WriteLine("FAIL: field RVA data sums to {0}", sum);
+                return 101;
+            }
+
+            if (Data.Powers[3] != 1L << 48)
+            {
+                Console.WriteLine("FAIL: field RVA data holds {0}", Data.Powers[3]);
+                return 102;
+            }
+
+            string literal = Data.GetLiteral();
+            if (literal != "flat layout literal")
+            {
+                Console.WriteLine("FAIL: string literal is \"{0}\"", literal);
+                return 103;
+            }
+
+            string resource = Data.ReadResource();
+            if (resource != "resource from the flat layout library")
+            {
+                Console.WriteLine("FAIL: resource is \"{0}\"", resource);
+                return 104;
+            }
+
+            string box = new Box<Guid>(Guid.Empty).ToString() + new Box<int>(42).ToString();
+            if (box != "Box<Guid>(00000000-0000-0000-0000-000000000000)Box<Int32>(42)")
+            {
+                Console.WriteLine("FAIL: generic instantiations returned \"{0}\"", box);
+                return 105;
+            }
+
+            try
+            {
+                Thrower.Throw();
+                Console.WriteLine("FAIL: nothing was thrown");
+                return 106;
+            }
+            catch (InvalidOperationException e)
+            {
+                if (e.StackTrace == null || !e.StackTrace.Contains("FlatLayoutLib.Thrower.Throw"))
+                {
+                    Console.WriteLine("FAIL: stack trace is {0}", e.StackTrace);
+                    return 107;
+                }
+            }
+        }
+        catch (Exception e)
+        {
+            Console.WriteLine("FAIL: {0}", e);
+            return 108;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,68 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// An IL only library with no writable sections. On Unix its file alignment
+// is too small for the PAL to map its sections, so the runtime loads it
+// straight from the flat view of the file.
+
+using System;
+using System.IO;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+
+namespace FlatLayoutLib
+{
+    public static class Data
+    {
+        // Initialized from field RVA data in the image
+        public static readonly int[] Primes = new int[] { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+
+        public static readonly long[] Powers = new long[] { 1L, 1L << 16, 1L << 32, 1L << 48 };
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static string GetLiteral()
+        {
+            return "flat layout literal";
+        }
+
+        public static string ReadResource()
+        {
+            Assembly assembly = typeof(Data).GetTypeInfo().Assembly;
+            using (Stream stream = assembly.GetManifestResourceStream("FlatLayoutLib.flatlayoutlib.txt"))
+            {
+                if (stream == null)
+                    return null;
+
+                using (StreamReader reader = new StreamReader(stream))
+                {
+                    return reader.ReadToEnd().Trim();
+                }
+            }
+        }
+    }
+
+    public class Box<T>
+    {
+        public T Value;
+
+        public Box(T value)
+        {
+            Value = value;
+        }
+
+        public override string ToString()
+        {
+            return "Box<" + typeof(T).Name + ">(" + Value + ")";
+        }
+    }
+
+    public static class Thrower
+    {
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static void Throw()
+        {
+            throw new InvalidOperationException("thrown from the flat layout library");
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Runs with TpaProbingIndex pointing at an index file that is corrupt: it
+// starts with a well formed entry and then ends in the middle of the next one.
+// The binder must discard the whole index, including the entry it could read,
+// and bind TPA assemblies exactly as it does without an index.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Xml;
+
+public class CorruptIndex
+{
+    static int Main()
+    {
+        try
+        {
+            // Each of these binds a different assembly from the TPA list
+            int sum = Enumerable.Range(1, 10).Sum();
+            if (sum != 55)
+            {
+                Console.WriteLine("FAIL: System.Linq returned {0}", sum);
+                return 101;
+            }
+
+            var stack = new Stack<string>();
+            stack.Push("probing");
+            if (stack.Pop() != "probing")
+            {
+                Console.WriteLine("FAIL: System.Collections");
+                return 102;
+            }
+
+            var document = new XmlDocument();
+            document.LoadXml("<index entries=\"2\"/>");
+            if (document.DocumentElement.GetAttribute("entries") != "2")
+            {
+                Console.WriteLine("FAIL: System.Xml.XmlDocument");
+                return 103;
+            }
+
+            // The index must not make up assemblies either
+            try
+            {
+                Assembly.Load(new AssemblyName("ProbingIndexDoesNotExist"));
+                Console.WriteLine("FAIL: loaded an assembly that does not exist");
+                return 104;
+            }
+            catch (FileNotFoundException)
+            {
+            }
+        }
+        catch (Exception e)
+        {
+            Console.WriteLine("FAIL: {0}", e);
+            return 105;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
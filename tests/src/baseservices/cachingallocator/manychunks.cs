@@ -0,0 +1,94 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Runs type loads and type name parsing, which make many small native
+// allocations, on several threads at once with the caching allocator enabled.
+// Each thread exits while the others are still allocating, so blocks of many
+// chunks end up freed by, and flushed from, threads other than the first one
+// that used them.
+
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Threading;
+
+public class G1<T> { public T Value; }
+public class G2<T, U> : G1<T> { public U Other; }
+public struct S1<T> { public T Value; }
+
+public class ManyChunks
+{
+    const int ThreadCount = 8;
+    const int Rounds = 4;
+
+    static readonly Type[] s_args = new Type[]
+    {
+        typeof(int), typeof(long), typeof(string), typeof(object), typeof(byte),
+        typeof(char), typeof(double), typeof(short), typeof(DateTime), typeof(Guid),
+    };
+
+    static volatile bool s_failed;
+
+    static void Work(object state)
+    {
+        int seed = (int)state;
+        try
+        {
+            var names = new List<string>();
+            for (int i = 0; i < s_args.Length; i++)
+            {
+                Type a = s_args[(i + seed) % s_args.Length];
+                for (int j = 0; j < s_args.Length; j++)
+                {
+                    Type b = s_args[j];
+                    Type t = typeof(G2<,>).MakeGenericType(a, b);
+                    Type s = typeof(S1<>).MakeGenericType(t);
+                    Type l = typeof(List<>).MakeGenericType(s);
+
+                    if (t.GetTypeInfo().BaseType != typeof(G1<>).MakeGenericType(a))
+                        throw new Exception("Unexpected base type of " + t);
+
+                    names.Add(l.AssemblyQualifiedName);
+                }
+            }
+
+            foreach (string name in names)
+            {
+                Type t = Type.GetType(name, true);
+                if (t.AssemblyQualifiedName != name)
+                    throw new Exception("Type name did not round trip: " + name);
+            }
+        }
+        catch (Exception e)
+        {
+            Console.WriteLine("Thread {0} failed: {1}", seed, e);
+            s_failed = true;
+        }
+    }
+
+    public static int Main()
+    {
+        for (int round = 0; round < Rounds; round++)
+        {
+            var threads = new Thread[ThreadCount];
+            for (int i = 0; i < ThreadCount; i++)
+            {
+                threads[i] = new Thread(Work);
+                threads[i].Start(round * ThreadCount + i);
+            }
+
+            foreach (Thread t in threads)
+                t.Join();
+        }
+
+        if (s_failed)
+        {
+            Console.WriteLine("FAILED");
+            return 101;
+        }
+
+        Console.WriteLine("PASSED");
+        return 100;
+    }
+}
@@ -0,0 +1,210 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Plays back a multicore JIT profile on helper threads. The pre commands run
+// this test with "record" to write the profile of the stages below, then with
+// "play" and MultiCoreJitThreads=4: the player thread queues the methods of
+// the stages and the helper threads compile them while the main thread calls
+// them. Every method has to end up with code that computes the right result,
+// whichever thread compiled it. Playing back records the profile again, with
+// the playback statistics in its header, and the test run itself checks that
+// the helper threads compiled methods of the profile. Multicore JIT is off on
+// a single processor, where the test only runs the stages.
+
+using System;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Runtime.Loader;
+using System.Threading;
+
+namespace MulticoreJitPlayer
+{
+    static class Stage0
+    {
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step0(long value) { return value * 2 + 0; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step1(long value) { return value * 2 + 1; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step2(long value) { return value * 2 + 2; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step3(long value) { return value * 2 + 3; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step4(long value) { return value * 2 + 4; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step5(long value) { return value * 2 + 5; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step6(long value) { return value * 2 + 6; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step7(long value) { return value * 2 + 7; }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static long Run(long value)
+        {
+            return Step0(value) + Step1(value) + Step2(value) + Step3(value) +
+                   Step4(value) + Step5(value) + Step6(value) + Step7(value);
+        }
+    }
+
+    static class Stage1
+    {
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step0(long value) { return value * 3 + 0; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step1(long value) { return value * 3 + 1; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step2(long value) { return value * 3 + 2; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step3(long value) { return value * 3 + 3; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step4(long value) { return value * 3 + 4; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step5(long value) { return value * 3 + 5; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step6(long value) { return value * 3 + 6; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step7(long value) { return value * 3 + 7; }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static long Run(long value)
+        {
+            return Step0(value) + Step1(value) + Step2(value) + Step3(value) +
+                   Step4(value) + Step5(value) + Step6(value) + Step7(value);
+        }
+    }
+
+    static class Stage2
+    {
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step0(long value) { return value * 4 + 0; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step1(long value) { return value * 4 + 1; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step2(long value) { return value * 4 + 2; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step3(long value) { return value * 4 + 3; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step4(long value) { return value * 4 + 4; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step5(long value) { return value * 4 + 5; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step6(long value) { return value * 4 + 6; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step7(long value) { return value * 4 + 7; }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static long Run(long value)
+        {
+            return Step0(value) + Step1(value) + Step2(value) + Step3(value) +
+                   Step4(value) + Step5(value) + Step6(value) + Step7(value);
+        }
+    }
+
+    static class Stage3
+    {
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step0(long value) { return value * 5 + 0; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step1(long value) { return value * 5 + 1; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step2(long value) { return value * 5 + 2; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step3(long value) { return value * 5 + 3; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step4(long value) { return value * 5 + 4; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step5(long value) { return value * 5 + 5; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step6(long value) { return value * 5 + 6; }
+        [MethodImpl(MethodImplOptions.NoInlining)] static long Step7(long value) { return value * 5 + 7; }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        public static long Run(long value)
+        {
+            return Step0(value) + Step1(value) + Step2(value) + Step3(value) +
+                   Step4(value) + Step5(value) + Step6(value) + Step7(value);
+        }
+    }
+
+    public class PlayerHelpers
+    {
+        const string ProfileName = "playerhelpers.profile";
+
+        // Offset of the header counters of the methods compiled by helper
+        // threads and of the helper threads which compiled any, see
+        // HeaderRecord in src/vm/multicorejitimpl.h: six 32-bit fields, then
+        // 16-bit counters 11 and 12
+        const int HelperCompiledOffset = 6 * 4 + 11 * 2;
+        const int HelpersCompilingOffset = 6 * 4 + 12 * 2;
+
+        static long RunStages(long value)
+        {
+            return Stage0.Run(value) + Stage1.Run(value) + Stage2.Run(value) + Stage3.Run(value);
+        }
+
+        // Each stage k returns 8 * (k + 2) * value + 28
+        static long ExpectedStages(long value)
+        {
+            long total = 0;
+            for (int k = 0; k < 4; k++)
+            {
+                total += 8 * (k + 2) * value + 28;
+            }
+            return total;
+        }
+
+        static int RunProfile(bool play)
+        {
+            AssemblyLoadContext.Default.SetProfileOptimizationRoot(Directory.GetCurrentDirectory());
+            AssemblyLoadContext.Default.StartProfileOptimization(ProfileName);
+
+            if (play)
+            {
+                // Give the helper threads a head start on the methods of the profile
+                Thread.Sleep(200);
+            }
+
+            for (long value = 1; value <= 16; value++)
+            {
+                long total = RunStages(value);
+                if (total != ExpectedStages(value))
+                {
+                    Console.WriteLine("FAIL: stages of {0} returned {1}, expected {2}", value, total, ExpectedStages(value));
+                    return 101;
+                }
+            }
+
+            if (play)
+            {
+                // Let the player thread finish, its statistics are written
+                // to the profile when the process exits
+                Thread.Sleep(1000);
+            }
+
+            return 100;
+        }
+
+        // Reads the statistics that the "play" run wrote to the profile
+        static int CheckHelpers()
+        {
+            if (Environment.ProcessorCount < 2)
+            {
+                Console.WriteLine("Single processor, multicore JIT is off");
+                return 100;
+            }
+
+            byte[] profile = File.ReadAllBytes(ProfileName);
+            int helperCompiled = BitConverter.ToUInt16(profile, HelperCompiledOffset);
+            int helpersCompiling = BitConverter.ToUInt16(profile, HelpersCompilingOffset);
+
+            Console.WriteLine("{0} methods compiled by {1} helper threads", helperCompiled, helpersCompiling);
+
+            if (helperCompiled == 0 || helpersCompiling == 0)
+            {
+                Console.WriteLine("FAIL: helper threads compiled no methods of the profile");
+                return 103;
+            }
+
+            return 100;
+        }
+
+        static int Main(string[] args)
+        {
+            string mode = args.Length > 0 ? args[0] : "check";
+            int result;
+
+            try
+            {
+                if (mode == "record" || mode == "play")
+                {
+                    result = RunProfile(mode == "play");
+                }
+                else
+                {
+                    result = CheckHelpers();
+                }
+            }
+            catch (Exception e)
+            {
+                Console.WriteLine("FAIL: {0}", e);
+                return 102;
+            }
+
+            if (result == 100)
+            {
+                Console.WriteLine("PASS");
+            }
+            return result;
+        }
+    }
+}
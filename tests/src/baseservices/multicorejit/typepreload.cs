@@ -0,0 +1,209 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Round trip of the type loads in a multicore JIT profile. The pre commands
+// run this test with "record" to write a profile while the shapes below are
+// loaded, then with "play": before starting the profile again it checks that
+// the recorded profile has a type load record for each shape, and it waits
+// before touching the shapes so that the player can load them first. Playing
+// back records the profile again, with the playback statistics in its header,
+// and the test run itself checks that the player loaded recorded types ahead
+// of the application. Multicore JIT is off on a single processor, where the
+// test only creates the shapes.
+
+using System;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Runtime.Loader;
+using System.Threading;
+
+namespace MulticoreJitTypePreload
+{
+    abstract class Shape
+    {
+        public abstract int Sides();
+    }
+
+    class Shape0 : Shape { public override int Sides() { return 3; } }
+    class Shape1 : Shape { public override int Sides() { return 4; } }
+    class Shape2 : Shape { public override int Sides() { return 5; } }
+    class Shape3 : Shape { public override int Sides() { return 6; } }
+    class Shape4 : Shape { public override int Sides() { return 7; } }
+    class Shape5 : Shape { public override int Sides() { return 8; } }
+    class Shape6 : Shape { public override int Sides() { return 9; } }
+    class Shape7 : Shape { public override int Sides() { return 10; } }
+    class Shape8 : Shape { public override int Sides() { return 11; } }
+    class Shape9 : Shape { public override int Sides() { return 12; } }
+    class Shape10 : Shape { public override int Sides() { return 13; } }
+    class Shape11 : Shape { public override int Sides() { return 14; } }
+    class Shape12 : Shape { public override int Sides() { return 15; } }
+    class Shape13 : Shape { public override int Sides() { return 16; } }
+    class Shape14 : Shape { public override int Sides() { return 17; } }
+    class Shape15 : Shape { public override int Sides() { return 18; } }
+
+    public class TypePreload
+    {
+        const string ProfileName = "typepreload.profile";
+
+        const int ShapeCount = 16;
+
+        // See src/vm/multicorejitimpl.h: every record starts with its kind in
+        // the top 8 bits and its size in bytes in the low 24 bits; the header
+        // has six 32-bit fields, then the 16-bit counters, of which counter 13
+        // is the number of recorded types the player loaded
+        const int JitInfoRecordId = 3;
+        const uint ModuleDependency = 0x800000;
+        const uint TypeLoad = 0x200000;
+        const int TypesLoadedOffset = 6 * 4 + 13 * 2;
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        static Shape[] CreateShapes()
+        {
+            return new Shape[]
+            {
+                new Shape0(), new Shape1(), new Shape2(), new Shape3(),
+                new Shape4(), new Shape5(), new Shape6(), new Shape7(),
+                new Shape8(), new Shape9(), new Shape10(), new Shape11(),
+                new Shape12(), new Shape13(), new Shape14(), new Shape15(),
+            };
+        }
+
+        static int CheckShapes()
+        {
+            Shape[] shapes = CreateShapes();
+            for (int i = 0; i < ShapeCount; i++)
+            {
+                if (shapes[i].Sides() != i + 3)
+                {
+                    Console.WriteLine("FAIL: Shape{0} has {1} sides, expected {2}", i, shapes[i].Sides(), i + 3);
+                    return 101;
+                }
+            }
+            return 100;
+        }
+
+        // Counts the type load records of the profile written by the "record" run
+        static int CountTypeLoadRecords()
+        {
+            byte[] profile = File.ReadAllBytes(ProfileName);
+            int typeLoads = 0;
+            int pos = 0;
+
+            while (pos + 4 <= profile.Length)
+            {
+                uint recordId = BitConverter.ToUInt32(profile, pos);
+                int size = (int)(recordId & 0xFFFFFF);
+
+                if (size < 4)
+                {
+                    break;
+                }
+
+                if ((recordId >> 24) == JitInfoRecordId)
+                {
+                    for (int entry = pos + 4; entry + 4 <= pos + size; entry += 4)
+                    {
+                        uint info = BitConverter.ToUInt32(profile, entry);
+                        if ((info & (ModuleDependency | TypeLoad)) == TypeLoad)
+                        {
+                            typeLoads++;
+                        }
+                    }
+                }
+
+                pos += size;
+            }
+
+            return typeLoads;
+        }
+
+        static int RunProfile(bool play)
+        {
+            if (play && Environment.ProcessorCount >= 2)
+            {
+                int typeLoads = CountTypeLoadRecords();
+
+                Console.WriteLine("{0} type loads recorded", typeLoads);
+
+                if (typeLoads < ShapeCount)
+                {
+                    Console.WriteLine("FAIL: the profile records {0} type loads, expected at least {1}", typeLoads, ShapeCount);
+                    return 103;
+                }
+            }
+
+            AssemblyLoadContext.Default.SetProfileOptimizationRoot(Directory.GetCurrentDirectory());
+            AssemblyLoadContext.Default.StartProfileOptimization(ProfileName);
+
+            if (play)
+            {
+                // Give the player a head start on the types of the profile
+                Thread.Sleep(200);
+            }
+
+            int result = CheckShapes();
+
+            if (play)
+            {
+                // Let the player thread finish, its statistics are written
+                // to the profile when the process exits
+                Thread.Sleep(1000);
+            }
+
+            return result;
+        }
+
+        // Reads the statistics that the "play" run wrote to the profile
+        static int CheckPreloaded()
+        {
+            if (Environment.ProcessorCount < 2)
+            {
+                Console.WriteLine("Single processor, multicore JIT is off");
+                return 100;
+            }
+
+            byte[] profile = File.ReadAllBytes(ProfileName);
+            int typesLoaded = BitConverter.ToUInt16(profile, TypesLoadedOffset);
+
+            Console.WriteLine("{0} types loaded by the player", typesLoaded);
+
+            if (typesLoaded == 0)
+            {
+                Console.WriteLine("FAIL: the player loaded none of the recorded types");
+                return 104;
+            }
+
+            return 100;
+        }
+
+        static int Main(string[] args)
+        {
+            string mode = args.Length > 0 ? args[0] : "check";
+            int result;
+
+            try
+            {
+                if (mode == "record" || mode == "play")
+                {
+                    result = RunProfile(mode == "play");
+                }
+                else
+                {
+                    result = CheckPreloaded();
+                }
+            }
+            catch (Exception e)
+            {
+                Console.WriteLine("FAIL: {0}", e);
+                return 102;
+            }
+
+            if (result == 100)
+            {
+                Console.WriteLine("PASS");
+            }
+            return result;
+        }
+    }
+}
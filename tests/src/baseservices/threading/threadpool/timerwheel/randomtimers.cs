@@ -0,0 +1,182 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Randomized check of the timer queues behind System.Threading.Timer.
+// Random due times, changes and disposals move the managed timers between
+// the short and long lists of TimerQueue (333ms threshold). Every change to
+// the earliest managed timer reprograms the native timer, which moves it
+// across the levels of the native timer wheel (256ms and 16384ms). The
+// rounds are separated by idle periods without any timer. Each timer must
+// fire exactly once, not before it is due, and within LateToleranceMs.
+
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+public class RandomTimers
+{
+    const int Rounds = 3;
+    const int TimersPerRound = 100;
+    const int LongTimersPerRound = 2;
+    const int LongDueTime = 16384 + 500;
+
+    // The tick count the timers use is only as precise as the system timer.
+    // A timer missed by the queues would be late by a whole level of the
+    // native wheel or a threshold period of the managed lists, so the late
+    // tolerance only leaves room for the system timer and thread scheduling.
+    const long EarlyToleranceMs = 20;
+    const long LateToleranceMs = 200;
+
+    // How long to keep waiting for timers that are late, so that they are
+    // reported as late rather than as not fired
+    const long StragglerWaitMs = 10000;
+
+    class TimerState
+    {
+        public Timer Timer;
+        public long DueTime;
+        public long ArmedAt;
+        public long FiredAt = -1;
+        public int FireCount;
+        public bool Disposed;
+    }
+
+    static readonly Stopwatch s_clock = Stopwatch.StartNew();
+
+    static void OnTimer(object state)
+    {
+        TimerState timerState = (TimerState) state;
+        lock (timerState)
+        {
+            timerState.FireCount++;
+            timerState.FiredAt = s_clock.ElapsedMilliseconds;
+        }
+    }
+
+    static bool RunRound(Random random, int round)
+    {
+        int count = TimersPerRound + LongTimersPerRound;
+        TimerState[] timers = new TimerState[count];
+        long maxDueAt = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            TimerState timerState = new TimerState();
+            timerState.DueTime = (i < TimersPerRound) ? random.Next(0, 3000) : LongDueTime + random.Next(0, 500);
+            timers[i] = timerState;
+
+            lock (timerState)
+            {
+                timerState.Timer = new Timer(OnTimer, timerState, Timeout.Infinite, Timeout.Infinite);
+                timerState.ArmedAt = s_clock.ElapsedMilliseconds;
+                timerState.Timer.Change(timerState.DueTime, Timeout.Infinite);
+            }
+        }
+
+        // Move some timers around and cancel others while the wheel is busy
+        for (int i = 0; i < TimersPerRound / 2; i++)
+        {
+            TimerState timerState = timers[random.Next(0, TimersPerRound)];
+            lock (timerState)
+            {
+                // Leave alone the timers that may already be queued to fire
+                long remaining = timerState.ArmedAt + timerState.DueTime - s_clock.ElapsedMilliseconds;
+                if (timerState.FireCount != 0 || timerState.Disposed || remaining < 200)
+                    continue;
+
+                if (random.Next(0, 4) == 0)
+                {
+                    timerState.Timer.Dispose();
+                    timerState.Disposed = true;
+                }
+                else
+                {
+                    timerState.DueTime = random.Next(0, 3000);
+                    timerState.ArmedAt = s_clock.ElapsedMilliseconds;
+                    timerState.Timer.Change(timerState.DueTime, Timeout.Infinite);
+                }
+            }
+            Thread.Sleep(random.Next(0, 20));
+        }
+
+        foreach (TimerState timerState in timers)
+        {
+            maxDueAt = Math.Max(maxDueAt, timerState.ArmedAt + timerState.DueTime);
+        }
+
+        // Wait for the last one, then give late timers a chance to show up
+        while (s_clock.ElapsedMilliseconds < maxDueAt + StragglerWaitMs)
+        {
+            bool pending = false;
+            foreach (TimerState timerState in timers)
+            {
+                lock (timerState)
+                {
+                    pending |= !timerState.Disposed && timerState.FireCount == 0;
+                }
+            }
+            if (!pending)
+                break;
+            Thread.Sleep(50);
+        }
+        Thread.Sleep(100);
+
+        bool passed = true;
+        for (int i = 0; i < count; i++)
+        {
+            TimerState timerState = timers[i];
+            lock (timerState)
+            {
+                if (timerState.Disposed)
+                {
+                    // A timer may already have been queued when it was disposed
+                    if (timerState.FireCount > 1)
+                    {
+                        Console.WriteLine("Round {0}: disposed timer {1} fired {2} times", round, i, timerState.FireCount);
+                        passed = false;
+                    }
+                    continue;
+                }
+
+                timerState.Timer.Dispose();
+
+                if (timerState.FireCount != 1)
+                {
+                    Console.WriteLine("Round {0}: timer {1} due in {2}ms fired {3} times", round, i, timerState.DueTime, timerState.FireCount);
+                    passed = false;
+                    continue;
+                }
+
+                long elapsed = timerState.FiredAt - timerState.ArmedAt;
+                if (elapsed < timerState.DueTime - EarlyToleranceMs || elapsed > timerState.DueTime + LateToleranceMs)
+                {
+                    Console.WriteLine("Round {0}: timer {1} due in {2}ms fired after {3}ms", round, i, timerState.DueTime, elapsed);
+                    passed = false;
+                }
+            }
+        }
+
+        return passed;
+    }
+
+    static int Main(string[] args)
+    {
+        int seed = (args.Length > 0) ? int.Parse(args[0]) : Environment.TickCount;
+        Console.WriteLine("Seed: {0}", seed);
+
+        Random random = new Random(seed);
+        bool passed = true;
+
+        for (int round = 0; round < Rounds; round++)
+        {
+            passed &= RunRound(random, round);
+
+            // No timers for a while, the timer thread sleeps without a timeout
+            Thread.Sleep(1000 + random.Next(0, 1000));
+        }
+
+        Console.WriteLine(passed ? "PASS" : "FAIL");
+        return passed ? 100 : 101;
+    }
+}
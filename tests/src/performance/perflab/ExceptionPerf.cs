@@ -0,0 +1,60 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using Microsoft.Xunit.Performance;
+using System;
+using System.Runtime.CompilerServices;
+
+public class ExceptionPerf
+{
+    static readonly InvalidOperationException s_exception = new InvalidOperationException();
+    public static int s_caught;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void ThrowAtDepth(int depth)
+    {
+        if (depth == 0)
+            throw s_exception;
+
+        ThrowAtDepth(depth - 1);
+    }
+
+    static void ThrowAndCatch(int depth)
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            try
+            {
+                ThrowAtDepth(depth);
+            }
+            catch (InvalidOperationException)
+            {
+                s_caught++;
+            }
+        }
+    }
+
+    [Benchmark]
+    public static void ThrowCatchDepth1()
+    {
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                ThrowAndCatch(1);
+    }
+
+    [Benchmark]
+    public static void ThrowCatchDepth10()
+    {
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                ThrowAndCatch(10);
+    }
+
+    [Benchmark]
+    public static void ThrowCatchDepth100()
+    {
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                ThrowAndCatch(100);
+    }
+}
@@ -0,0 +1,87 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using Microsoft.Xunit.Performance;
+using System;
+using System.Collections.Generic;
+
+namespace InterfaceDispatchPerf
+{
+    public interface IDispatch0 { int M0(); }
+    public interface IDispatch1 { int M1(); }
+    public interface IDispatch2 { int M2(); }
+    public interface IDispatch3 { int M3(); }
+
+    public class Wrap0<T> { }
+    public class Wrap1<T> { }
+    public class Wrap2<T> { }
+
+    public class Impl<T> : IDispatch0, IDispatch1, IDispatch2, IDispatch3
+    {
+        public int M0() { return 0; }
+        public int M1() { return 1; }
+        public int M2() { return 2; }
+        public int M3() { return 3; }
+    }
+
+    // Calls through a handful of interface call sites with ~10k distinct receiver
+    // types, so that the (type, interface method) pairs far exceed the default
+    // size of the resolve stub cache.
+    public class MegamorphicDispatch
+    {
+        // 3^0 + 3^1 + ... + 3^8 = 9841 types, times 4 interface methods.
+        const int Depth = 8;
+
+        static object[] s_objects;
+        public static int s_sum;
+
+        static void Build<T>(List<object> objects, int depth)
+        {
+            objects.Add(new Impl<T>());
+            if (depth > 0)
+            {
+                Build<Wrap0<T>>(objects, depth - 1);
+                Build<Wrap1<T>>(objects, depth - 1);
+                Build<Wrap2<T>>(objects, depth - 1);
+            }
+        }
+
+        static object[] GetObjects()
+        {
+            if (s_objects == null)
+            {
+                List<object> objects = new List<object>();
+                Build<object>(objects, Depth);
+                s_objects = objects.ToArray();
+            }
+            return s_objects;
+        }
+
+        static int CallAll(object[] objects)
+        {
+            int sum = 0;
+            for (int i = 0; i < objects.Length; i++)
+            {
+                object o = objects[i];
+                sum += ((IDispatch0)o).M0();
+                sum += ((IDispatch1)o).M1();
+                sum += ((IDispatch2)o).M2();
+                sum += ((IDispatch3)o).M3();
+            }
+            return sum;
+        }
+
+        [Benchmark]
+        public static void InterfaceCallManyTypes()
+        {
+            object[] objects = GetObjects();
+
+            // Warm up so that every pair has gone through the resolve worker once.
+            s_sum = CallAll(objects);
+
+            foreach (var iteration in Benchmark.Iterations)
+                using (iteration.StartMeasurement())
+                    s_sum = CallAll(objects);
+        }
+    }
+}
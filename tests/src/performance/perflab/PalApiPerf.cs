@@ -0,0 +1,273 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.Xunit.Performance;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text;
+using Xunit;
+
+// Calls PAL entry points through the exports of libcoreclr, the ones the
+// framework calls. Each one looks up the current CPalThread, so together
+// they measure InternalGetCurrentThread and the entry and exit work of the
+// PAL. Calls that create or open something close it again, and the file
+// and handle APIs work on objects that are created once. Without the PAL,
+// on Windows, the benchmarks measure nothing.
+public class PalApiPerf
+{
+    const int CallsPerIteration = 1000;
+
+    const uint GENERIC_READ = 0x80000000;
+    const uint GENERIC_WRITE = 0x40000000;
+    const uint FILE_SHARE_READ_WRITE = 0x3;
+    const uint CREATE_ALWAYS = 2;
+    const uint OPEN_EXISTING = 3;
+    const uint FILE_ATTRIBUTE_NORMAL = 0x80;
+    const uint FILE_BEGIN = 0;
+    const uint DUPLICATE_SAME_ACCESS = 0x2;
+    const uint LMEM_MOVEABLE = 0x2;
+    const uint CP_UTF8 = 65001;
+    const int STD_OUTPUT_HANDLE = -11;
+    const int FileSize = 4096;
+
+    static class Pal
+    {
+        [DllImport("libcoreclr")] public static extern uint GetCurrentThreadId();
+        [DllImport("libcoreclr")] public static extern uint GetCurrentProcessId();
+        [DllImport("libcoreclr")] public static extern IntPtr GetCurrentProcess();
+        [DllImport("libcoreclr")] public static extern bool QueryPerformanceCounter(out long count);
+        [DllImport("libcoreclr")] public static extern bool QueryPerformanceFrequency(out long frequency);
+        [DllImport("libcoreclr")] public static extern uint GetACP();
+        [DllImport("libcoreclr")] public static extern uint GetConsoleCP();
+        [DllImport("libcoreclr")] public static extern uint GetConsoleOutputCP();
+        [DllImport("libcoreclr")] public static extern IntPtr GetStdHandle(int stdHandle);
+        [DllImport("libcoreclr")] public static extern uint GetFileType(IntPtr file);
+        [DllImport("libcoreclr")] public static extern bool CloseHandle(IntPtr handle);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern IntPtr CreateEventW(IntPtr attributes, bool manualReset, bool initialState, string name);
+        [DllImport("libcoreclr")] public static extern bool SetEvent(IntPtr handle);
+        [DllImport("libcoreclr")] public static extern bool ResetEvent(IntPtr handle);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern IntPtr CreateMutexW(IntPtr attributes, bool initialOwner, string name);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern IntPtr CreateSemaphoreW(IntPtr attributes, int initialCount, int maximumCount, string name);
+        [DllImport("libcoreclr")] public static extern bool ReleaseSemaphore(IntPtr handle, int releaseCount, out int previousCount);
+        [DllImport("libcoreclr")] public static extern bool DuplicateHandle(IntPtr sourceProcess, IntPtr source, IntPtr targetProcess, out IntPtr target, uint access, bool inherit, uint options);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern uint GetEnvironmentVariableW(string name, char[] buffer, uint size);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern bool SetEnvironmentVariableW(string name, string value);
+        [DllImport("libcoreclr")] public static extern IntPtr GetEnvironmentStringsW();
+        [DllImport("libcoreclr")] public static extern bool FreeEnvironmentStringsW(IntPtr block);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern uint GetCurrentDirectoryW(uint size, char[] buffer);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern uint GetFullPathNameW(string fileName, uint size, char[] buffer, IntPtr filePart);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern uint GetLongPathNameW(string shortPath, char[] buffer, uint size);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern uint GetTempPathW(uint size, char[] buffer);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern bool GetFileAttributesExW(string fileName, int infoLevel, byte[] data);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern bool SetFileAttributesW(string fileName, uint attributes);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern IntPtr CreateFileW(string fileName, uint access, uint share, IntPtr attributes, uint disposition, uint flags, IntPtr template);
+        [DllImport("libcoreclr")] public static extern bool ReadFile(IntPtr file, byte[] buffer, uint count, out uint read, IntPtr overlapped);
+        [DllImport("libcoreclr")] public static extern bool WriteFile(IntPtr file, byte[] buffer, uint count, out uint written, IntPtr overlapped);
+        [DllImport("libcoreclr")] public static extern uint SetFilePointer(IntPtr file, int distance, IntPtr distanceHigh, uint method);
+        [DllImport("libcoreclr")] public static extern uint GetFileSize(IntPtr file, IntPtr sizeHigh);
+        [DllImport("libcoreclr")] public static extern bool LockFile(IntPtr file, uint offsetLow, uint offsetHigh, uint lengthLow, uint lengthHigh);
+        [DllImport("libcoreclr")] public static extern bool UnlockFile(IntPtr file, uint offsetLow, uint offsetHigh, uint lengthLow, uint lengthHigh);
+        [DllImport("libcoreclr")] public static extern bool SetEndOfFile(IntPtr file);
+        [DllImport("libcoreclr")] public static extern bool SetFileTime(IntPtr file, IntPtr creationTime, IntPtr lastAccessTime, IntPtr lastWriteTime);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern IntPtr FindFirstFileW(string fileName, byte[] findData);
+        [DllImport("libcoreclr")] public static extern bool FindClose(IntPtr find);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern int MultiByteToWideChar(uint codePage, uint flags, byte[] source, int sourceCount, char[] destination, int destinationCount);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern int WideCharToMultiByte(uint codePage, uint flags, char[] source, int sourceCount, byte[] destination, int destinationCount, IntPtr defaultChar, IntPtr usedDefaultChar);
+        [DllImport("libcoreclr")] public static extern int lstrlenA(byte[] value);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern int lstrlenW(char[] value);
+        [DllImport("libcoreclr")] public static extern IntPtr LocalAlloc(uint flags, UIntPtr bytes);
+        [DllImport("libcoreclr")] public static extern IntPtr LocalReAlloc(IntPtr memory, UIntPtr bytes, uint flags);
+        [DllImport("libcoreclr")] public static extern IntPtr LocalFree(IntPtr memory);
+        [DllImport("libcoreclr")] public static extern IntPtr CoTaskMemAlloc(UIntPtr bytes);
+        [DllImport("libcoreclr")] public static extern IntPtr CoTaskMemRealloc(IntPtr memory, UIntPtr bytes);
+        [DllImport("libcoreclr")] public static extern void CoTaskMemFree(IntPtr memory);
+        [DllImport("libcoreclr", CharSet = CharSet.Unicode)] public static extern IntPtr SysAllocStringLen(string value, uint length);
+        [DllImport("libcoreclr")] public static extern void SysFreeString(IntPtr value);
+        [DllImport("libcoreclr")] public static extern uint SysStringLen(IntPtr value);
+        [DllImport("libcoreclr")] public static extern int CoCreateGuid(out Guid guid);
+        [DllImport("libcoreclr")] public static extern void PAL_Random(bool strong, byte[] buffer, uint length);
+        [DllImport("libcoreclr")] public static extern void GetSystemInfo(byte[] info);
+        [DllImport("libcoreclr")] public static extern IntPtr VirtualQuery(IntPtr address, byte[] buffer, IntPtr length);
+        [DllImport("libcoreclr")] public static extern void RtlZeroMemory(byte[] destination, UIntPtr length);
+    }
+
+    static bool? s_palAvailable;
+
+    static string s_fileName;
+    static IntPtr s_file;
+    static IntPtr s_event;
+    static IntPtr s_semaphore;
+    static IntPtr s_localMemory;
+    static IntPtr s_taskMemory;
+    static IntPtr s_string;
+
+    static readonly byte[] s_buffer = new byte[FileSize];
+    static readonly char[] s_chars = new char[1024];
+    static readonly byte[] s_utf8 = Encoding.UTF8.GetBytes("The quick brown fox jumps over the lazy dog\0");
+    static readonly char[] s_utf16 = "The quick brown fox jumps over the lazy dog\0".ToCharArray();
+
+    static bool IsPalAvailable()
+    {
+        if (s_palAvailable == null)
+        {
+            try
+            {
+                Pal.GetCurrentThreadId();
+                s_palAvailable = true;
+            }
+            catch (DllNotFoundException)
+            {
+                s_palAvailable = false;
+            }
+            catch (EntryPointNotFoundException)
+            {
+                s_palAvailable = false;
+            }
+        }
+        return s_palAvailable.Value;
+    }
+
+    // The objects that the calls below work on, left open for the life of the process
+    static void CreateObjects()
+    {
+        if (s_fileName != null)
+            return;
+
+        s_fileName = Path.Combine(Path.GetTempPath(), "PalApiPerf.tmp");
+        s_file = Pal.CreateFileW(s_fileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ_WRITE, IntPtr.Zero, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, IntPtr.Zero);
+        if (s_file == (IntPtr) (-1))
+            throw new IOException(s_fileName);
+
+        uint written;
+        Pal.WriteFile(s_file, s_buffer, FileSize, out written, IntPtr.Zero);
+
+        s_event = Pal.CreateEventW(IntPtr.Zero, true, false, null);
+        s_semaphore = Pal.CreateSemaphoreW(IntPtr.Zero, 0, int.MaxValue, null);
+        s_localMemory = Pal.LocalAlloc(0, (UIntPtr) 64);
+        s_taskMemory = Pal.CoTaskMemAlloc((UIntPtr) 64);
+        s_string = Pal.SysAllocStringLen("PalApiPerf", 10);
+    }
+
+    static readonly Dictionary<string, Action> s_calls = new Dictionary<string, Action>
+    {
+        { "GetCurrentThreadId", () => Pal.GetCurrentThreadId() },
+        { "GetCurrentProcessId", () => Pal.GetCurrentProcessId() },
+        { "GetCurrentProcess", () => Pal.GetCurrentProcess() },
+        { "QueryPerformanceCounter", () => { long count; Pal.QueryPerformanceCounter(out count); } },
+        { "QueryPerformanceFrequency", () => { long frequency; Pal.QueryPerformanceFrequency(out frequency); } },
+        { "GetACP", () => Pal.GetACP() },
+        { "GetConsoleCP", () => Pal.GetConsoleCP() },
+        { "GetConsoleOutputCP", () => Pal.GetConsoleOutputCP() },
+        { "GetStdHandle", () => Pal.GetStdHandle(STD_OUTPUT_HANDLE) },
+        { "GetFileType", () => Pal.GetFileType(s_file) },
+        { "CreateEventW", () => Pal.CloseHandle(Pal.CreateEventW(IntPtr.Zero, true, false, null)) },
+        { "SetEvent", () => Pal.SetEvent(s_event) },
+        { "ResetEvent", () => Pal.ResetEvent(s_event) },
+        { "CreateMutexW", () => Pal.CloseHandle(Pal.CreateMutexW(IntPtr.Zero, false, null)) },
+        { "CreateSemaphoreW", () => Pal.CloseHandle(Pal.CreateSemaphoreW(IntPtr.Zero, 0, 1, null)) },
+        { "ReleaseSemaphore", () => { int previous; Pal.ReleaseSemaphore(s_semaphore, 1, out previous); } },
+        { "DuplicateHandle", () => { IntPtr target; Pal.DuplicateHandle(Pal.GetCurrentProcess(), s_event, Pal.GetCurrentProcess(), out target, 0, false, DUPLICATE_SAME_ACCESS); Pal.CloseHandle(target); } },
+        { "GetEnvironmentVariableW", () => Pal.GetEnvironmentVariableW("PATH", s_chars, (uint) s_chars.Length) },
+        { "SetEnvironmentVariableW", () => Pal.SetEnvironmentVariableW("PAL_API_PERF", "1") },
+        { "GetEnvironmentStringsW", () => Pal.FreeEnvironmentStringsW(Pal.GetEnvironmentStringsW()) },
+        { "GetCurrentDirectoryW", () => Pal.GetCurrentDirectoryW((uint) s_chars.Length, s_chars) },
+        { "GetFullPathNameW", () => Pal.GetFullPathNameW("PalApiPerf.tmp", (uint) s_chars.Length, s_chars, IntPtr.Zero) },
+        { "GetLongPathNameW", () => Pal.GetLongPathNameW(s_fileName, s_chars, (uint) s_chars.Length) },
+        { "GetTempPathW", () => Pal.GetTempPathW((uint) s_chars.Length, s_chars) },
+        { "GetFileAttributesExW", () => Pal.GetFileAttributesExW(s_fileName, 0, s_buffer) },
+        { "SetFileAttributesW", () => Pal.SetFileAttributesW(s_fileName, FILE_ATTRIBUTE_NORMAL) },
+        { "CreateFileW", () => Pal.CloseHandle(Pal.CreateFileW(s_fileName, GENERIC_READ, FILE_SHARE_READ_WRITE, IntPtr.Zero, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, IntPtr.Zero)) },
+        { "ReadFile", () => { uint read; Pal.SetFilePointer(s_file, 0, IntPtr.Zero, FILE_BEGIN); Pal.ReadFile(s_file, s_buffer, 64, out read, IntPtr.Zero); } },
+        { "WriteFile", () => { uint written; Pal.SetFilePointer(s_file, 0, IntPtr.Zero, FILE_BEGIN); Pal.WriteFile(s_file, s_buffer, 64, out written, IntPtr.Zero); } },
+        { "SetFilePointer", () => Pal.SetFilePointer(s_file, 0, IntPtr.Zero, FILE_BEGIN) },
+        { "GetFileSize", () => Pal.GetFileSize(s_file, IntPtr.Zero) },
+        { "LockFile", () => { Pal.LockFile(s_file, 0, 0, 64, 0); Pal.UnlockFile(s_file, 0, 0, 64, 0); } },
+        { "SetEndOfFile", () => { Pal.SetFilePointer(s_file, FileSize, IntPtr.Zero, FILE_BEGIN); Pal.SetEndOfFile(s_file); } },
+        { "SetFileTime", () => Pal.SetFileTime(s_file, IntPtr.Zero, IntPtr.Zero, IntPtr.Zero) },
+        { "FindFirstFileW", () => Pal.FindClose(Pal.FindFirstFileW(s_fileName, s_buffer)) },
+        { "MultiByteToWideChar", () => Pal.MultiByteToWideChar(CP_UTF8, 0, s_utf8, s_utf8.Length, s_chars, s_chars.Length) },
+        { "WideCharToMultiByte", () => Pal.WideCharToMultiByte(CP_UTF8, 0, s_utf16, s_utf16.Length, s_buffer, s_buffer.Length, IntPtr.Zero, IntPtr.Zero) },
+        { "lstrlenA", () => Pal.lstrlenA(s_utf8) },
+        { "lstrlenW", () => Pal.lstrlenW(s_utf16) },
+        { "LocalAlloc", () => Pal.LocalFree(Pal.LocalAlloc(0, (UIntPtr) 64)) },
+        { "LocalReAlloc", () => s_localMemory = Pal.LocalReAlloc(s_localMemory, (UIntPtr) 64, LMEM_MOVEABLE) },
+        { "CoTaskMemAlloc", () => Pal.CoTaskMemFree(Pal.CoTaskMemAlloc((UIntPtr) 64)) },
+        { "CoTaskMemRealloc", () => s_taskMemory = Pal.CoTaskMemRealloc(s_taskMemory, (UIntPtr) 64) },
+        { "SysAllocStringLen", () => Pal.SysFreeString(Pal.SysAllocStringLen("PalApiPerf", 10)) },
+        { "SysStringLen", () => Pal.SysStringLen(s_string) },
+        { "CoCreateGuid", () => { Guid guid; Pal.CoCreateGuid(out guid); } },
+        { "PAL_Random", () => Pal.PAL_Random(false, s_buffer, 16) },
+        { "GetSystemInfo", () => Pal.GetSystemInfo(s_buffer) },
+        { "VirtualQuery", () => Pal.VirtualQuery(s_localMemory, s_buffer, (IntPtr) 64) },
+        { "RtlZeroMemory", () => Pal.RtlZeroMemory(s_buffer, (UIntPtr) 64) },
+    };
+
+    [Benchmark]
+    [InlineData("GetCurrentThreadId")]
+    [InlineData("GetCurrentProcessId")]
+    [InlineData("GetCurrentProcess")]
+    [InlineData("QueryPerformanceCounter")]
+    [InlineData("QueryPerformanceFrequency")]
+    [InlineData("GetACP")]
+    [InlineData("GetConsoleCP")]
+    [InlineData("GetConsoleOutputCP")]
+    [InlineData("GetStdHandle")]
+    [InlineData("GetFileType")]
+    [InlineData("CreateEventW")]
+    [InlineData("SetEvent")]
+    [InlineData("ResetEvent")]
+    [InlineData("CreateMutexW")]
+    [InlineData("CreateSemaphoreW")]
+    [InlineData("ReleaseSemaphore")]
+    [InlineData("DuplicateHandle")]
+    [InlineData("GetEnvironmentVariableW")]
+    [InlineData("SetEnvironmentVariableW")]
+    [InlineData("GetEnvironmentStringsW")]
+    [InlineData("GetCurrentDirectoryW")]
+    [InlineData("GetFullPathNameW")]
+    [InlineData("GetLongPathNameW")]
+    [InlineData("GetTempPathW")]
+    [InlineData("GetFileAttributesExW")]
+    [InlineData("SetFileAttributesW")]
+    [InlineData("CreateFileW")]
+    [InlineData("ReadFile")]
+    [InlineData("WriteFile")]
+    [InlineData("SetFilePointer")]
+    [InlineData("GetFileSize")]
+    [InlineData("LockFile")]
+    [InlineData("SetEndOfFile")]
+    [InlineData("SetFileTime")]
+    [InlineData("FindFirstFileW")]
+    [InlineData("MultiByteToWideChar")]
+    [InlineData("WideCharToMultiByte")]
+    [InlineData("lstrlenA")]
+    [InlineData("lstrlenW")]
+    [InlineData("LocalAlloc")]
+    [InlineData("LocalReAlloc")]
+    [InlineData("CoTaskMemAlloc")]
+    [InlineData("CoTaskMemRealloc")]
+    [InlineData("SysAllocStringLen")]
+    [InlineData("SysStringLen")]
+    [InlineData("CoCreateGuid")]
+    [InlineData("PAL_Random")]
+    [InlineData("GetSystemInfo")]
+    [InlineData("VirtualQuery")]
+    [InlineData("RtlZeroMemory")]
+    public static void CallPalApi(string api)
+    {
+        if (!IsPalAvailable())
+            return;
+
+        CreateObjects();
+
+        Action call = s_calls[api];
+
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                for (int i = 0; i < CallsPerIteration; i++)
+                    call();
+    }
+}
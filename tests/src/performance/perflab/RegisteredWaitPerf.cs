@@ -0,0 +1,66 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.Xunit.Performance;
+using System;
+using System.Threading;
+
+// Time from signaling a handle registered with RegisterWaitForSingleObject to
+// its callback running, with a few or many other registered waits. Run with
+// COMPlus_ThreadPool_UseWaitSet=1 to measure the PAL wait set instead of the
+// wait threads.
+public class RegisteredWaitPerf
+{
+    const int ManyWaits = 10000;
+    const int FewWaits = 10;
+
+    static readonly AutoResetEvent s_callbackDone = new AutoResetEvent(false);
+
+    static void OnSignaled(object state, bool timedOut)
+    {
+        s_callbackDone.Set();
+    }
+
+    static void MeasureWakeup(int waitCount)
+    {
+        AutoResetEvent[] events = new AutoResetEvent[waitCount];
+        RegisteredWaitHandle[] waits = new RegisteredWaitHandle[waitCount];
+
+        for (int i = 0; i < waitCount; i++)
+        {
+            events[i] = new AutoResetEvent(false);
+            waits[i] = ThreadPool.RegisterWaitForSingleObject(events[i], OnSignaled, null, Timeout.Infinite, false);
+        }
+
+        // Signal the waits in an order unrelated to their registration
+        int next = 0;
+        foreach (var iteration in Benchmark.Iterations)
+        {
+            next = (next + 7919) % waitCount;
+            using (iteration.StartMeasurement())
+            {
+                events[next].Set();
+                s_callbackDone.WaitOne();
+            }
+        }
+
+        for (int i = 0; i < waitCount; i++)
+        {
+            waits[i].Unregister(null);
+            events[i].Dispose();
+        }
+    }
+
+    [Benchmark]
+    public static void WakeupWithFewWaits()
+    {
+        MeasureWakeup(FewWaits);
+    }
+
+    [Benchmark]
+    public static void WakeupWithManyWaits()
+    {
+        MeasureWakeup(ManyWaits);
+    }
+}
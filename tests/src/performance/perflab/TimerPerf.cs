@@ -0,0 +1,115 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.Xunit.Performance;
+using System;
+using System.Threading;
+
+// System.Threading.Timer with a few or many other timers pending, like a
+// server with a timeout armed for every request in flight. Timeouts measures
+// arming and cancelling a timeout, the throughput of the timer queue. Firing
+// measures the time from arming a short timer to its callback running; the
+// lateness of the timer is the time above ShortDueTime.
+public class TimerPerf
+{
+    const int ManyTimers = 100000;
+    const int FewTimers = 10;
+
+    const int ShortDueTime = 10;
+    const int TimeoutDueTime = 30000;
+
+    static readonly AutoResetEvent s_callbackDone = new AutoResetEvent(false);
+
+    static void OnTimer(object state)
+    {
+        s_callbackDone.Set();
+    }
+
+    static void OnPendingTimer(object state)
+    {
+    }
+
+    // Timers due later than any run of the benchmark, so that they stay pending
+    static Timer[] CreatePendingTimers(int timerCount)
+    {
+        Random random = new Random(timerCount);
+        Timer[] timers = new Timer[timerCount];
+
+        for (int i = 0; i < timerCount; i++)
+        {
+            timers[i] = new Timer(OnPendingTimer, null, 3600000 + random.Next(0, 3600000), Timeout.Infinite);
+        }
+
+        return timers;
+    }
+
+    static void DisposeTimers(Timer[] timers)
+    {
+        foreach (Timer timer in timers)
+        {
+            timer.Dispose();
+        }
+    }
+
+    static void MeasureTimeouts(int timerCount)
+    {
+        Timer[] timers = CreatePendingTimers(timerCount);
+
+        foreach (var iteration in Benchmark.Iterations)
+        {
+            using (iteration.StartMeasurement())
+            {
+                for (int i = 0; i < 1000; i++)
+                {
+                    new Timer(OnPendingTimer, null, TimeoutDueTime, Timeout.Infinite).Dispose();
+                }
+            }
+        }
+
+        DisposeTimers(timers);
+    }
+
+    static void MeasureFiring(int timerCount)
+    {
+        Timer[] timers = CreatePendingTimers(timerCount);
+
+        using (Timer timer = new Timer(OnTimer, null, Timeout.Infinite, Timeout.Infinite))
+        {
+            foreach (var iteration in Benchmark.Iterations)
+            {
+                using (iteration.StartMeasurement())
+                {
+                    timer.Change(ShortDueTime, Timeout.Infinite);
+                    s_callbackDone.WaitOne();
+                }
+            }
+        }
+
+        DisposeTimers(timers);
+    }
+
+    [Benchmark]
+    public static void TimeoutsWithFewTimers()
+    {
+        MeasureTimeouts(FewTimers);
+    }
+
+    [Benchmark]
+    public static void TimeoutsWithManyTimers()
+    {
+        MeasureTimeouts(ManyTimers);
+    }
+
+    [Benchmark]
+    public static void FiringWithFewTimers()
+    {
+        MeasureFiring(FewTimers);
+    }
+
+    [Benchmark]
+    public static void FiringWithManyTimers()
+    {
+        MeasureFiring(ManyTimers);
+    }
+}
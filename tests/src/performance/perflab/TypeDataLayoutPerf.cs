@@ -0,0 +1,134 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.Xunit.Performance;
+using System;
+
+// Casting and interface dispatch over objects of many dynamically loaded
+// types, visited in an order unrelated to their load order, so that the
+// MethodTables they read do not stay in the cache. Run with
+// COMPlus_SplitHotColdTypeData=1 to measure MethodTables packed away from
+// their FieldDescs and MethodDescs.
+public class TypeDataLayoutPerf
+{
+    public interface IDispatchTarget
+    {
+        int Get();
+    }
+
+    public interface IOtherTarget
+    {
+    }
+
+    public class TargetBase
+    {
+        public int m_i;
+    }
+
+    public class Target<T, U> : TargetBase, IOtherTarget, IDispatchTarget
+    {
+        public T m_t;
+        public U m_u;
+
+        public int Get() { return m_i; }
+        public virtual int GetVirtual() { return m_i; }
+    }
+
+    static readonly Type[] s_args = new Type[]
+    {
+        typeof(byte), typeof(sbyte), typeof(short), typeof(ushort), typeof(int), typeof(uint),
+        typeof(long), typeof(ulong), typeof(float), typeof(double), typeof(decimal), typeof(char),
+        typeof(bool), typeof(string), typeof(object), typeof(DateTime), typeof(TimeSpan), typeof(Guid),
+        typeof(IntPtr), typeof(UIntPtr), typeof(Version), typeof(Uri), typeof(Exception), typeof(Type),
+        typeof(byte[]), typeof(int[]), typeof(string[]), typeof(object[]), typeof(Action), typeof(EventArgs),
+        typeof(Random), typeof(Attribute),
+    };
+
+    const int Visits = 1000;
+
+    static object[] s_objects;
+    static int[] s_order;
+
+    static void CreateObjects()
+    {
+        if (s_objects != null)
+            return;
+
+        // 32 * 32 instantiations, each loaded from scratch
+        s_objects = new object[s_args.Length * s_args.Length];
+        int next = 0;
+        foreach (Type t in s_args)
+        {
+            foreach (Type u in s_args)
+            {
+                s_objects[next++] = Activator.CreateInstance(typeof(Target<,>).MakeGenericType(t, u));
+            }
+        }
+
+        s_order = new int[Visits];
+        Random random = new Random(42);
+        for (int i = 0; i < Visits; i++)
+        {
+            s_order[i] = random.Next(0, s_objects.Length);
+        }
+    }
+
+    [Benchmark]
+    public static int CastToInterfaceOfManyTypes()
+    {
+        CreateObjects();
+
+        int count = 0;
+        foreach (var iteration in Benchmark.Iterations)
+        {
+            using (iteration.StartMeasurement())
+            {
+                for (int i = 0; i < Visits; i++)
+                {
+                    if (s_objects[s_order[i]] is IOtherTarget)
+                        count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    [Benchmark]
+    public static int CastToClassOfManyTypes()
+    {
+        CreateObjects();
+
+        int count = 0;
+        foreach (var iteration in Benchmark.Iterations)
+        {
+            using (iteration.StartMeasurement())
+            {
+                for (int i = 0; i < Visits; i++)
+                {
+                    count += ((TargetBase)s_objects[s_order[i]]).m_i;
+                }
+            }
+        }
+        return count;
+    }
+
+    [Benchmark]
+    public static int InterfaceDispatchOnManyTypes()
+    {
+        CreateObjects();
+
+        int count = 0;
+        foreach (var iteration in Benchmark.Iterations)
+        {
+            using (iteration.StartMeasurement())
+            {
+                for (int i = 0; i < Visits; i++)
+                {
+                    count += ((IDispatchTarget)s_objects[s_order[i]]).Get();
+                }
+            }
+        }
+        return count;
+    }
+}
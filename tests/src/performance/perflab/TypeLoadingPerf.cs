@@ -0,0 +1,232 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.Xunit.Performance;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Runtime.Loader;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+
+public class TypeLoadingPerf
+{
+    public class G<T, U, V> { public T t; public U u; public V v; }
+    public struct W<T> { public T t; }
+    public struct X<T> { public T t; }
+    public struct Y<T> { public T t; }
+    public struct Z<T> { public T t; }
+
+    // Generic types whose methods override methods of System.Private.CoreLib. Loading
+    // them matches the signature of every override against the base class methods
+    // of the same name in another module. Both writers override the same methods,
+    // so their override signatures share blobs and are compared with the same
+    // base class signatures.
+    public class OverridingWriter<T> : TextWriter
+    {
+        public T Last;
+        public override Encoding Encoding { get { return Encoding.UTF8; } }
+        public override void Write(char value) { }
+        public override void Write(string value) { }
+        public override void Write(int value) { }
+        public override void Write(long value) { }
+        public override void Write(bool value) { }
+        public override void Write(double value) { }
+        public override void Write(char[] buffer, int index, int count) { }
+        public override void WriteLine(string value) { }
+        public override void WriteLine(object value) { }
+        public override void Flush() { }
+    }
+
+    public class OtherOverridingWriter<T> : TextWriter
+    {
+        public T Last;
+        public override Encoding Encoding { get { return Encoding.Unicode; } }
+        public override void Write(char value) { }
+        public override void Write(string value) { }
+        public override void Write(int value) { }
+        public override void Write(long value) { }
+        public override void Write(bool value) { }
+        public override void Write(double value) { }
+        public override void Write(char[] buffer, int index, int count) { }
+        public override void WriteLine(string value) { }
+        public override void WriteLine(object value) { }
+        public override void Flush() { }
+    }
+
+    public class OverridingStream<T> : Stream
+    {
+        public T Last;
+        public override bool CanRead { get { return true; } }
+        public override bool CanSeek { get { return true; } }
+        public override bool CanWrite { get { return true; } }
+        public override long Length { get { return 0; } }
+        public override long Position { get { return 0; } set { } }
+        public override void Flush() { }
+        public override int Read(byte[] buffer, int offset, int count) { return 0; }
+        public override long Seek(long offset, SeekOrigin origin) { return 0; }
+        public override void SetLength(long value) { }
+        public override void Write(byte[] buffer, int offset, int count) { }
+    }
+
+    // Loads a new copy of this assembly, so that its types are loaded from scratch
+    class FreshLoadContext : AssemblyLoadContext
+    {
+        protected override Assembly Load(AssemblyName assemblyName)
+        {
+            return null;
+        }
+    }
+
+    static readonly string[] s_overridingTypeNames = new string[]
+    {
+        typeof(OverridingWriter<>).FullName, typeof(OtherOverridingWriter<>).FullName, typeof(OverridingStream<>).FullName,
+    };
+
+    const int TypesPerIteration = 200;
+
+    // Stress configuration: many threads loading new instantiations at once
+    const int StressThreadCount = 32;
+    const int StressTypesPerIteration = 50000;
+
+    static readonly Type[] s_args = new Type[]
+    {
+        typeof(int), typeof(long), typeof(string), typeof(object), typeof(byte),
+        typeof(char), typeof(double), typeof(short), typeof(DateTime), typeof(Guid),
+        typeof(uint), typeof(ulong), typeof(sbyte), typeof(ushort), typeof(float),
+        typeof(decimal), typeof(TimeSpan), typeof(Version), typeof(Uri), typeof(Exception),
+    };
+    static readonly Type[] s_wrappers = new Type[] { typeof(W<>), typeof(X<>), typeof(Y<>), typeof(Z<>) };
+    static int s_next = -1;
+
+    // Returns arguments for an instantiation of G that has not been loaded yet.
+    // Once every combination of the arguments has been used, they are wrapped
+    // in a new combination of W, X, Y and Z so that the next ones are new as
+    // well. Threads only share a counter, so they do not serialize here
+    // instead of in the type loader.
+    static Type[] NextArguments()
+    {
+        int count = s_args.Length;
+        int n = Interlocked.Increment(ref s_next);
+        int depth = n / (count * count * count);
+        n %= count * count * count;
+
+        return new Type[] { Wrap(s_args[n % count], depth), Wrap(s_args[(n / count) % count], depth), Wrap(s_args[n / (count * count)], depth) };
+    }
+
+    // Each depth gets its own sequence of wrappers, and the nesting only
+    // grows with the log of the depth
+    static Type Wrap(Type t, int depth)
+    {
+        while (depth > 0)
+        {
+            depth--;
+            t = s_wrappers[depth % s_wrappers.Length].MakeGenericType(t);
+            depth /= s_wrappers.Length;
+        }
+        return t;
+    }
+
+    static void LoadTypes(int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            Type t = typeof(G<,,>).MakeGenericType(NextArguments());
+            EnsureLoaded(t);
+        }
+    }
+
+    static void LoadTypesInParallel(int threadCount, int count)
+    {
+        Task[] tasks = new Task[threadCount];
+        for (int i = 0; i < tasks.Length; i++)
+        {
+            // Each thread loads its share; dedicated threads so that all of
+            // them run at once instead of as the thread pool ramps up
+            int share = count / threadCount + ((i < count % threadCount) ? 1 : 0);
+            tasks[i] = Task.Factory.StartNew(() => LoadTypes(share), TaskCreationOptions.LongRunning);
+        }
+        Task.WaitAll(tasks);
+    }
+
+    static void EnsureLoaded(Type t)
+    {
+        // Make sure the type is fully loaded, not just its handle
+        if (t.GetTypeInfo().DeclaredFields == null)
+            throw new Exception();
+    }
+
+    [Benchmark]
+    public static void LoadGenericInstantiations()
+    {
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                LoadTypes(TypesPerIteration);
+    }
+
+    [Benchmark]
+    public static void LoadGenericInstantiationsParallel()
+    {
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                LoadTypesInParallel(Environment.ProcessorCount, Environment.ProcessorCount * TypesPerIteration);
+    }
+
+    // The two stress benchmarks load the same number of new instantiations.
+    // The ratio of their times is the contention metric: it is the number of
+    // threads when loads do not contend at all, and 1 when they serialize.
+    [Benchmark]
+    public static void LoadGenericInstantiationsStressSerial()
+    {
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                LoadTypes(StressTypesPerIteration);
+    }
+
+    [Benchmark]
+    public static void LoadGenericInstantiationsStress32Threads()
+    {
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                LoadTypesInParallel(StressThreadCount, StressTypesPerIteration);
+    }
+
+    // Type load time of generic types that override methods of another module. Each
+    // iteration loads a new copy of this assembly, so the overrides are matched again.
+    [Benchmark]
+    public static void LoadTypesOverridingOtherModule()
+    {
+        string path = typeof(TypeLoadingPerf).GetTypeInfo().Assembly.Location;
+
+        foreach (var iteration in Benchmark.Iterations)
+        {
+            Assembly assembly = new FreshLoadContext().LoadFromAssemblyPath(path);
+
+            using (iteration.StartMeasurement())
+            {
+                foreach (string name in s_overridingTypeNames)
+                {
+                    Type definition = assembly.GetType(name, true);
+                    for (int i = 0; i < 8; i++)
+                        EnsureLoaded(definition.MakeGenericType(s_args[i]));
+                }
+            }
+        }
+    }
+
+    [Benchmark]
+    public static void ParseLoadedTypeNames()
+    {
+        List<string> names = new List<string>();
+        for (int i = 0; i < TypesPerIteration; i++)
+            names.Add(typeof(G<,,>).MakeGenericType(NextArguments()).AssemblyQualifiedName);
+
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                foreach (string name in names)
+                    Type.GetType(name, true);
+    }
+}
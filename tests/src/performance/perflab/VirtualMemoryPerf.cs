@@ -0,0 +1,194 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+using Microsoft.Xunit.Performance;
+using System;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+
+// Commits, decommits and queries pages of reserved regions from several
+// threads. On Unix the calls go to the PAL through the exports of libcoreclr,
+// so they measure its region index and per-region locks. Each pair of serial
+// and parallel benchmarks does the same operations; the ratio of their times
+// is the number of threads when the regions do not contend.
+public class VirtualMemoryPerf
+{
+    const uint MEM_COMMIT = 0x1000;
+    const uint MEM_RESERVE = 0x2000;
+    const uint MEM_DECOMMIT = 0x4000;
+    const uint MEM_RELEASE = 0x8000;
+    const uint PAGE_NOACCESS = 0x01;
+    const uint PAGE_READWRITE = 0x04;
+
+    const int PageSize = 4096;
+    const int PagesPerRegion = 256;
+    const int OperationsPerThread = 2000;
+
+    [StructLayout(LayoutKind.Sequential)]
+    struct MEMORY_BASIC_INFORMATION
+    {
+        public IntPtr BaseAddress;
+        public IntPtr AllocationBase;
+        public uint AllocationProtect;
+        public IntPtr RegionSize;
+        public uint State;
+        public uint Protect;
+        public uint Type;
+    }
+
+    static class Kernel32
+    {
+        [DllImport("kernel32", SetLastError = true)]
+        public static extern IntPtr VirtualAlloc(IntPtr lpAddress, IntPtr dwSize, uint flAllocationType, uint flProtect);
+        [DllImport("kernel32", SetLastError = true)]
+        public static extern bool VirtualFree(IntPtr lpAddress, IntPtr dwSize, uint dwFreeType);
+        [DllImport("kernel32", SetLastError = true)]
+        public static extern IntPtr VirtualQuery(IntPtr lpAddress, out MEMORY_BASIC_INFORMATION lpBuffer, IntPtr dwLength);
+    }
+
+    static class Pal
+    {
+        [DllImport("libcoreclr", SetLastError = true)]
+        public static extern IntPtr VirtualAlloc(IntPtr lpAddress, IntPtr dwSize, uint flAllocationType, uint flProtect);
+        [DllImport("libcoreclr", SetLastError = true)]
+        public static extern bool VirtualFree(IntPtr lpAddress, IntPtr dwSize, uint dwFreeType);
+        [DllImport("libcoreclr", SetLastError = true)]
+        public static extern IntPtr VirtualQuery(IntPtr lpAddress, out MEMORY_BASIC_INFORMATION lpBuffer, IntPtr dwLength);
+    }
+
+    static bool? s_usePal;
+
+    static bool UsePal()
+    {
+        if (s_usePal == null)
+        {
+            try
+            {
+                MEMORY_BASIC_INFORMATION info;
+                Kernel32.VirtualQuery(IntPtr.Zero, out info, (IntPtr) Marshal.SizeOf<MEMORY_BASIC_INFORMATION>());
+                s_usePal = false;
+            }
+            catch (DllNotFoundException)
+            {
+                s_usePal = true;
+            }
+        }
+        return s_usePal.Value;
+    }
+
+    static IntPtr VirtualAlloc(IntPtr address, long size, uint type, uint protect)
+    {
+        IntPtr result = UsePal() ? Pal.VirtualAlloc(address, (IntPtr) size, type, protect)
+                                 : Kernel32.VirtualAlloc(address, (IntPtr) size, type, protect);
+        if (result == IntPtr.Zero)
+            throw new OutOfMemoryException();
+        return result;
+    }
+
+    static void VirtualFree(IntPtr address, long size, uint type)
+    {
+        bool result = UsePal() ? Pal.VirtualFree(address, (IntPtr) size, type)
+                               : Kernel32.VirtualFree(address, (IntPtr) size, type);
+        if (!result)
+            throw new InvalidOperationException();
+    }
+
+    static void VirtualQuery(IntPtr address)
+    {
+        MEMORY_BASIC_INFORMATION info;
+        IntPtr length = (IntPtr) Marshal.SizeOf<MEMORY_BASIC_INFORMATION>();
+        IntPtr result = UsePal() ? Pal.VirtualQuery(address, out info, length)
+                                 : Kernel32.VirtualQuery(address, out info, length);
+        if (result == IntPtr.Zero)
+            throw new InvalidOperationException();
+    }
+
+    static IntPtr[] ReserveRegions(int count)
+    {
+        IntPtr[] regions = new IntPtr[count];
+        for (int i = 0; i < count; i++)
+            regions[i] = VirtualAlloc(IntPtr.Zero, (long) PagesPerRegion * PageSize, MEM_RESERVE, PAGE_NOACCESS);
+        return regions;
+    }
+
+    static void ReleaseRegions(IntPtr[] regions)
+    {
+        foreach (IntPtr region in regions)
+            VirtualFree(region, 0, MEM_RELEASE);
+    }
+
+    static void CommitDecommit(IntPtr region, int seed)
+    {
+        for (int i = 0; i < OperationsPerThread; i++)
+        {
+            IntPtr page = region + ((seed + i * 7) % PagesPerRegion) * PageSize;
+            VirtualAlloc(page, PageSize, MEM_COMMIT, PAGE_READWRITE);
+            VirtualFree(page, PageSize, MEM_DECOMMIT);
+        }
+    }
+
+    static void Query(IntPtr region, int seed)
+    {
+        for (int i = 0; i < OperationsPerThread; i++)
+            VirtualQuery(region + ((seed + i * 7) % PagesPerRegion) * PageSize);
+    }
+
+    static void RunParallel(IntPtr[] regions, Action<IntPtr, int> operation)
+    {
+        Task[] tasks = new Task[regions.Length];
+        for (int i = 0; i < tasks.Length; i++)
+        {
+            IntPtr region = regions[i];
+            int seed = i;
+            tasks[i] = Task.Factory.StartNew(() => operation(region, seed), TaskCreationOptions.LongRunning);
+        }
+        Task.WaitAll(tasks);
+    }
+
+    static void RunSerial(IntPtr[] regions, Action<IntPtr, int> operation)
+    {
+        for (int i = 0; i < regions.Length; i++)
+            operation(regions[i], i);
+    }
+
+    [Benchmark]
+    public static void CommitDecommitSerial()
+    {
+        IntPtr[] regions = ReserveRegions(Environment.ProcessorCount);
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                RunSerial(regions, CommitDecommit);
+        ReleaseRegions(regions);
+    }
+
+    [Benchmark]
+    public static void CommitDecommitParallel()
+    {
+        IntPtr[] regions = ReserveRegions(Environment.ProcessorCount);
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                RunParallel(regions, CommitDecommit);
+        ReleaseRegions(regions);
+    }
+
+    [Benchmark]
+    public static void QuerySerial()
+    {
+        IntPtr[] regions = ReserveRegions(Environment.ProcessorCount);
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                RunSerial(regions, Query);
+        ReleaseRegions(regions);
+    }
+
+    [Benchmark]
+    public static void QueryParallel()
+    {
+        IntPtr[] regions = ReserveRegions(Environment.ProcessorCount);
+        foreach (var iteration in Benchmark.Iterations)
+            using (iteration.StartMeasurement())
+                RunParallel(regions, Query);
+        ReleaseRegions(regions);
+    }
+}
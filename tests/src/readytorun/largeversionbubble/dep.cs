@@ -0,0 +1,26 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+//
+
+// Referenced by lib only: code of lib inlined into main refers to this
+// assembly, which the IL metadata of main does not reference.
+public class DepBox
+{
+    public int Value;
+
+    public DepBox(int value)
+    {
+        Value = value;
+    }
+}
+
+public static class Dep
+{
+    public static int Value = 42;
+
+    public static int Get()
+    {
+        return Value;
+    }
+}
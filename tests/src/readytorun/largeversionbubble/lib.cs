@@ -0,0 +1,29 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+//
+
+using System.Collections.Generic;
+
+// Small methods that crossgen /LargeVersionBubble inlines into main
+public static class Lib
+{
+    public static int Field = 1;
+
+    public static int GetValue()
+    {
+        return Dep.Get() + Field;
+    }
+
+    public static int GetBoxValue(int value)
+    {
+        return new DepBox(value).Value;
+    }
+
+    public static List<DepBox> MakeList(int value)
+    {
+        List<DepBox> list = new List<DepBox>();
+        list.Add(new DepBox(value));
+        return list;
+    }
+}
@@ -0,0 +1,48 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+//
+
+using System;
+
+// Compiled with crossgen /LargeVersionBubble together with lib and dep, so that
+// the methods of Lib are inlined into Main and the fixups of the inlined code
+// refer to types and fields of lib and dep across assemblies.
+class Program
+{
+    static int Main()
+    {
+        int failures = 0;
+
+        if (Lib.GetValue() != 43)
+        {
+            Console.WriteLine("FAIL: Lib.GetValue() returned {0}", Lib.GetValue());
+            failures++;
+        }
+
+        Lib.Field = 2;
+        if (Lib.GetValue() != 44)
+        {
+            Console.WriteLine("FAIL: Lib.GetValue() returned {0} after the field was set", Lib.GetValue());
+            failures++;
+        }
+
+        if (Lib.GetBoxValue(7) != 7)
+        {
+            Console.WriteLine("FAIL: Lib.GetBoxValue(7) returned {0}", Lib.GetBoxValue(7));
+            failures++;
+        }
+
+        if (Lib.MakeList(5)[0].Value != 5)
+        {
+            Console.WriteLine("FAIL: Lib.MakeList(5) returned a wrong list");
+            failures++;
+        }
+
+        if (failures != 0)
+            return 101;
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}